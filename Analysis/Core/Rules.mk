@@ -1,3 +1,4 @@
 SUBDIRS 	:=
-LIB_DEPS 	:=
+LIB_DEPS 	:= Objects
 LIB_EXTRA :=
+REQUIRES_CMSSW := 0
@@ -45,6 +45,7 @@ class AnalysisBase {
   unsigned retry_pause_;
   unsigned retry_attempts_;
   bool timings_;
+  bool load_hash_trees_;
 
  public:
   AnalysisBase(std::string const& analysis_name,
@@ -74,6 +75,8 @@ class AnalysisBase {
   void RetryFileAfterFailure(unsigned pause_in_seconds,
                              unsigned retry_attempts);
   void CalculateTimings(bool const& value);
+  /// Add the HashTree of each input file, if it has one, to ic::Unhash
+  void LoadHashTrees(bool const& value);
 };
 }
 
@@ -0,0 +1,89 @@
+#ifndef ICHiggsTauTau_Core_FileService_h
+#define ICHiggsTauTau_Core_FileService_h
+
+#ifdef IC_STANDALONE
+
+#include <string>
+#include <typeinfo>
+#include "TClass.h"
+#include "TDirectory.h"
+class TFile;
+
+namespace ic {
+
+/**
+ * @brief A directory in the output file of a FileService, in which
+ * histograms and trees can be created
+ *
+ * This has the same interface as the TFileDirectory of CMSSW, so that the
+ * Utilities and Modules code can use either one. Copies refer to the same
+ * directory.
+ */
+class FileDirectory {
+ public:
+  explicit FileDirectory(TDirectory *dir) : dir_(dir) {}
+
+  /**
+   * @brief Create a new T with the arguments `args` in this directory
+   *
+   * Objects that ROOT can attach to a directory, like histograms and trees,
+   * are written to the file when the FileService is destroyed.
+   */
+  template <class T, class... Args>
+  T * make(Args const&... args) const {
+    TDirectory *dir = cd();
+    T *obj = new T(args...);
+    TClass *cls = TClass::GetClass(typeid(T));
+    ROOT::DirAutoAdd_t add = cls ? cls->GetDirectoryAutoAdd() : nullptr;
+    if (add) add(obj, dir);
+    return obj;
+  }
+
+  /// The subdirectory `dir`, which is created if it does not exist yet
+  FileDirectory mkdir(std::string const& dir,
+                      std::string const& descr = "") const;
+
+  /// Make this the current ROOT directory
+  TDirectory * cd() const;
+
+  inline TDirectory * getBareDirectory() const { return dir_; }
+
+ protected:
+  TDirectory *dir_;
+};
+
+/**
+ * @brief Owns an output file for histograms, replacing
+ * fwlite::TFileService in the standalone build
+ *
+ * The file is created when the service is constructed and everything made
+ * in it is written when the service is destroyed.
+ */
+class FileService : public FileDirectory {
+ public:
+  explicit FileService(std::string const& file_name);
+  ~FileService();
+
+  inline TFile & file() const { return *file_; }
+
+ private:
+  FileService(FileService const&) = delete;
+  FileService & operator=(FileService const&) = delete;
+
+  TFile *file_;
+};
+}
+
+#else
+
+#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "CommonTools/Utils/interface/TFileDirectory.h"
+
+namespace ic {
+typedef fwlite::TFileService FileService;
+typedef ::TFileDirectory FileDirectory;
+}
+
+#endif
+
+#endif
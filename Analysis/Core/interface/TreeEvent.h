@@ -16,6 +16,8 @@ class TTree;
 
 namespace ic {
 
+class EventInfo;
+
 class TreeEvent : public Event {
  private:
   std::map<std::string, BranchHandlerBase*> handlers_;
@@ -44,10 +46,17 @@ class TreeEvent : public Event {
     }
   }
 
+  // Reset the transient state of a product that has just been read for a
+  // new entry. Only EventInfo has any: its slot weights
+  template <class T>
+  void ResetTransient(T*) {}
+  void ResetTransient(EventInfo* info);
+
   template <class T>
   void CopyPtr(std::string const& prod_name, BranchHandler<T>* bh,
                    int64_t event) {
     bh->GetEntry(event);
+    ResetTransient(bh->GetPtr());
     bh->SetNoOverwrite(true);
     Add(prod_name, bh->GetPtr());
   }
@@ -13,6 +13,8 @@
 #include "TDirectory.h"
 #include "Core/interface/ModuleBase.h"
 #include "Core/interface/TreeEvent.h"
+#include "Objects/interface/EventInfo.hh"
+#include "Objects/interface/Unhash.h"
 
 namespace ic {
 
@@ -31,7 +33,8 @@ AnalysisBase::AnalysisBase(std::string const& analysis_name,
       retry_on_fail_(false),
       retry_pause_(5),
       retry_attempts_(1),
-      timings_(false) {}
+      timings_(false),
+      load_hash_trees_(false) {}
 
 AnalysisBase::~AnalysisBase() { ; }
 
@@ -97,6 +100,9 @@ int AnalysisBase::RunAnalysis() {
   if (ttree_caching_) {
     std::cout << ">> TTree caching enabled\n";
   }
+  if (load_hash_trees_) {
+    std::cout << ">> Loading HashTrees into ic::Unhash\n";
+  }
 
   for (auto & seq : seqs_) {
     seq.counters.resize(seq.modules.size());
@@ -154,6 +160,7 @@ int AnalysisBase::RunAnalysis() {
         throw std::runtime_error("Input file could not be opened");
       }
     }
+    if (load_hash_trees_ && file_ptr) ic::Unhash::Load(file_ptr);
     tree_ptr = dynamic_cast<TTree*>(gDirectory->Get(tree_path_.c_str()));
     if (!tree_ptr) {
       std::cerr << ">> Error: Unable to find TTree \"" << tree_path_
@@ -256,6 +263,11 @@ int AnalysisBase::RunAnalysis() {
       }
       if (skim_event) {
         tree_ptr->GetEntry(evt);
+        // Weights set through slots are transient, so copy them into the
+        // persisted maps of the EventInfo that is about to be written
+        if (event_.ExistsInEvent("eventInfo")) {
+          event_.GetPtr<EventInfo>("eventInfo")->flatten_weights();
+        }
         outtree->Fill();
       }
       ++events_processed_;
@@ -341,4 +353,8 @@ void AnalysisBase::WriteSkimHere(std::string const& seq_name) {
 void AnalysisBase::CalculateTimings(bool const& value) {
   timings_ = value;
 }
+
+void AnalysisBase::LoadHashTrees(bool const& value) {
+  load_hash_trees_ = value;
+}
 }
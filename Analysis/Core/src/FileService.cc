@@ -0,0 +1,44 @@
+#include "Core/interface/FileService.h"
+
+#ifdef IC_STANDALONE
+
+#include <stdexcept>
+#include "TFile.h"
+
+namespace ic {
+
+FileDirectory FileDirectory::mkdir(std::string const& dir,
+                                   std::string const& descr) const {
+  TDirectory *parent = cd();
+  TDirectory *sub = parent->GetDirectory(dir.c_str());
+  if (!sub) sub = parent->mkdir(dir.c_str(), descr.c_str());
+  if (!sub) {
+    throw std::runtime_error("Directory " + dir + " could not be created in " +
+                             parent->GetPath());
+  }
+  return FileDirectory(sub);
+}
+
+TDirectory * FileDirectory::cd() const {
+  dir_->cd();
+  return dir_;
+}
+
+FileService::FileService(std::string const& file_name)
+    : FileDirectory(nullptr),
+      file_(TFile::Open(file_name.c_str(), "RECREATE")) {
+  if (!file_ || file_->IsZombie()) {
+    throw std::runtime_error("Output file " + file_name +
+                             " could not be opened");
+  }
+  dir_ = file_;
+}
+
+FileService::~FileService() {
+  file_->Write();
+  file_->Close();
+  delete file_;
+}
+}
+
+#endif
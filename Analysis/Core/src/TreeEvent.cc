@@ -1,4 +1,5 @@
 #include "Core/interface/TreeEvent.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
 
 class TTree;
 
@@ -17,6 +18,10 @@ void TreeEvent::SetEvent(int64_t event) {
   for (auto bh : handlers_) bh.second->SetNoOverwrite(false);
 }
 
+void TreeEvent::ResetTransient(EventInfo* info) {
+  if (info) info->clear_slot_weights();
+}
+
 void TreeEvent::SetTree(TTree* tree) {
   tree_ = tree;
   DeleteAndClearHandlers();
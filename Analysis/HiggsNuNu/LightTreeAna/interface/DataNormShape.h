@@ -44,6 +44,9 @@ namespace ic {
     virtual ~DataNormShape();
     virtual int Init(TFile*);
     virtual int Run(LTFiles*);
+    virtual std::vector<std::string> Inputs();
+    virtual std::vector<std::string> Outputs();
+    virtual std::vector<LTShapeRequest> Shapes();
   };
 
 }
@@ -33,6 +33,9 @@ namespace ic {
     virtual ~DataShape();
     virtual int Init(TFile*);
     virtual int Run(LTFiles*);
+    virtual std::vector<std::string> Inputs();
+    virtual std::vector<std::string> Outputs();
+    virtual std::vector<LTShapeRequest> Shapes();
   };
 
 }
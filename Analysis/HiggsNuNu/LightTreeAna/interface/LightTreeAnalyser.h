@@ -26,8 +26,12 @@ namespace ic{
     void SetInFolder(std::string);
     void SetEosFolders(std::string,std::string);
     void SetInputParams(std::string);
+    void SetThreads(unsigned);
 
     bool PostModule(int);
+    //Group the modules into stages, each module going in the stage after
+    //the last module before it that it depends on through the output file
+    std::vector<std::vector<unsigned> > ScheduleModules();
     int RunAnalysis();
   };
 
@@ -3,7 +3,9 @@
 #include <vector>
 #include <map>
 #include <utility>
+#include <memory>
 #include "HiggsNuNu/interface/HiggsNuNuAnalysisTools.h"
+#include "Utilities/interface/TreeDraw.h"
 #include "TTree.h"
 #include "TFile.h"
 #include "TH1F.h"
@@ -13,6 +15,17 @@
 
 namespace ic{
 
+  //A shape of a set that will be asked for with GetSetShape, so that it can
+  //be drawn ahead of time by LTFiles::PrefetchSetShapes
+  struct LTShapeRequest{
+    std::string set;
+    std::string variable;
+    std::string selection;
+    std::string category;
+    std::string weight;
+    bool do_lumixs_weights;
+  };
+
   class LTFile{
     CLASS_MEMBER(LTFile,std::string,name)
     CLASS_MEMBER(LTFile,std::string,set)
@@ -20,7 +33,18 @@ namespace ic{
     protected:
     TFile * tfile_;
     TTree * tree_;
+    std::string filename_;
     std::vector<std::pair<std::string,std::string> > friendTrees;
+    //Entry lists of the distinct sets of cuts seen so far, keyed on the
+    //sorted cuts joined with " && ". They are kept when the file is closed.
+    struct CachedEntryList{
+      std::vector<std::string> cuts;
+      std::shared_ptr<TEntryList> list;
+    };
+    std::map<std::string,CachedEntryList> entrylists_;
+    //Shapes drawn ahead of time, keyed on the variable and the full cut
+    //string. They are kept when the file is closed.
+    std::map<std::string,TH1F> prefetched_;
     public:
     LTFile();
     LTFile(std::string,std::string);
@@ -31,10 +55,19 @@ namespace ic{
     int AddFriend(std::string,std::string);
     TEntryList GetEntryList(std::string const&, std::string const&, std::string const&);
     TTree* GetSubTree(TEntryList);
+    //Entries passing selection && category, or 0 if there are no cuts. Built
+    //from the intersection of the cached lists of any subsets of the cuts,
+    //and cached in turn.
+    TEntryList* GetCachedEntryList(std::string const&, std::string const&);
     bool GetShape(TH1F & shape, std::string const&, std::string const&, std::string const&, std::string const&, const bool);
     bool GetShape2D(TH2F & shape, std::string const&, std::string const&, std::string const&, std::string const&, const bool);
     TH3F GetShape3D(std::string const&, std::string const&, std::string const&, std::string const&);
     TTree* GetTree();
+    void AddPrefetchedShape(std::string const&, std::string const&, TH1F const&);
+    //The prefetched shape for a variable and full cut string, or 0
+    TH1F const* GetPrefetchedShape(std::string const&, std::string const&) const;
+    inline std::string GetFileName() const { return filename_; }
+    inline std::vector<std::pair<std::string,std::string> > const& GetFriends() const { return friendTrees; }
   };
 
   class LTFiles{
@@ -42,6 +75,9 @@ namespace ic{
     CLASS_MEMBER(LTFiles,std::string,dataeosfolder)
     CLASS_MEMBER(LTFiles,std::string,mceosfolder)
     CLASS_MEMBER(LTFiles,std::string,input_params)
+    //Draw the files of a set concurrently on this many threads, 0 draws them in turn
+    CLASS_MEMBER(LTFiles,unsigned,n_threads)
+    CLASS_MEMBER(LTFiles,long long,entries_per_task)
     protected:								
     std::map<std::string,LTFile> files_;					
     std::map<std::string,std::vector<std::pair<std::string,bool> > > setlists_;
@@ -81,7 +117,13 @@ namespace ic{
     bool GetShape(TH1F &shape, std::string,std::string const&, std::string const&, std::string const&, std::string const&, const bool);
     bool GetSetShape(TH1F & shape, std::string,std::string const&, std::string const&, std::string const&, std::string const&,const bool, const bool);
     TH1F GetShape(std::string,std::string const&, std::string const&, std::string const&, std::string const&);
+    //Concurrent version of GetSetShape for variables with explicit binning
+    bool GetSetShapeConcurrent(TH1F & shape, std::string, std::string const&, std::string const&, TH1F const&, std::string const&, std::string const&, std::string const&,const bool, const bool);
     TH1F GetSetShape(std::string,std::string const&, std::string const&, std::string const&, std::string const&,const bool);
+    //Draw the 1D shapes of the requests with explicit binning in one pass
+    //over each file, for GetSetShape to pick up later. Does nothing if
+    //n_threads is 0.
+    int PrefetchSetShapes(std::vector<LTShapeRequest> const&);
     TH1F GetSetsShape(std::vector<std::string>,std::string const&, std::string const&, std::string const&, std::string const&,const bool);
     bool GetShape2D(TH2F & shape,std::string,std::string const&, std::string const&, std::string const&, std::string const&, const bool);
     bool GetSetShape2D(TH2F & shape, std::string,std::string const&, std::string const&, std::string const&, std::string const&,const bool, const bool);
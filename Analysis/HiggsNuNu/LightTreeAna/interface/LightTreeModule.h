@@ -14,6 +14,14 @@ namespace ic{
     std::string module_name();
     virtual int Init(TFile*) =0;
     virtual int Run(LTFiles*)=0;
+    //Directories of the output file the module reads from and writes to,
+    //which LTAnalyser uses to work out which modules depend on each other.
+    //"*" stands for any directory, the default for modules that don't say.
+    virtual std::vector<std::string> Inputs();
+    virtual std::vector<std::string> Outputs();
+    //Shapes the module will ask the LTFiles for that are known before it
+    //runs, so they can be drawn together with those of other modules
+    virtual std::vector<LTShapeRequest> Shapes();
   };
 
 }
@@ -16,6 +16,9 @@ namespace ic {
     CLASS_MEMBER(MVAApply,std::string,weightDir)
     CLASS_MEMBER(MVAApply,std::string,friendDir)
     CLASS_MEMBER(MVAApply,bool,setorfile)
+    //Number of events read and evaluated together. The files are processed
+    //concurrently on the n_threads of the LTFiles.
+    CLASS_MEMBER(MVAApply,unsigned,block_size)
   public:
     MVAApply(std::string);
     virtual ~MVAApply();
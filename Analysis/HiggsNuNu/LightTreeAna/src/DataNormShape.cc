@@ -238,4 +238,54 @@ namespace ic{
     return 0;
   };
 
+  std::vector<std::string> DataNormShape::Inputs(){
+    std::vector<std::string> inputs;
+    for(unsigned iBkg=0;iBkg<contbkgextrafactordir_.size();iBkg++){
+      if(contbkgextrafactordir_[iBkg]!="") inputs.push_back(contbkgextrafactordir_[iBkg]);
+    }
+    return inputs;
+  };
+
+  std::vector<std::string> DataNormShape::Outputs(){
+    std::vector<std::string> outputs(1,dirname_=="" ? sigmcset_ : dirname_);
+    if(do_subsets_) outputs.insert(outputs.end(),subsetdirs_.begin(),subsetdirs_.end());
+    return outputs;
+  };
+
+  std::vector<LTShapeRequest> DataNormShape::Shapes(){
+    //The same shapes as Run asks for, except those of control backgrounds
+    //weighted by factors from other modules
+    std::vector<LTShapeRequest> shapes;
+    std::string normshape="jet2_pt(200,0.,1000.)";
+    LTShapeRequest contmc={contmcset_,normshape,basesel_,contcat_+contmcextrasel_,contmcweight_,false};
+    shapes.push_back(contmc);
+    for(unsigned iBkg=0;iBkg<contbkgset_.size();iBkg++){
+      if(contbkgextrafactordir_.size()==0){
+	LTShapeRequest contbkg={contbkgset_[iBkg],normshape,basesel_,contcat_+contbkgextrasel_,contmcweight_,false};
+	shapes.push_back(contbkg);
+      }
+      else if(contbkgextrafactordir_.size()==contbkgset_.size() && contbkgextrafactordir_[iBkg]==""){
+	std::string unitfactor="*"+boost::lexical_cast<std::string>(double(1));
+	bool isz=contbkgisz_.size()==contbkgset_.size() && contbkgisz_[iBkg]!=0;
+	LTShapeRequest contbkg={contbkgset_[iBkg],normshape,basesel_,
+				(isz ? zextracontcat_ : contcat_)+contbkgextrasel_,
+				(isz ? contmczweight_ : contmcweight_)+unitfactor,false};
+	shapes.push_back(contbkg);
+      }
+    }
+    LTShapeRequest contdata={contdataset_,normshape,basesel_,contcat_+contdataextrasel_,contdataweight_,false};
+    shapes.push_back(contdata);
+    for(unsigned iShape=0;iShape<shape_.size();iShape++){
+      LTShapeRequest sigmc={sigmcset_,shape_[iShape],basesel_,sigcat_,sigmcweight_,false};
+      shapes.push_back(sigmc);
+      if(do_subsets_){
+	for(unsigned isubset=0;isubset<subsets_.size();isubset++){
+	  LTShapeRequest subset={subsets_[isubset],shape_[iShape],basesel_,sigcat_,sigmcweight_,false};
+	  shapes.push_back(subset);
+	}
+      }
+    }
+    return shapes;
+  };
+
 }
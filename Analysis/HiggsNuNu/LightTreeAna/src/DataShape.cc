@@ -91,4 +91,26 @@ namespace ic{
     return 0;
   };
 
+  std::vector<std::string> DataShape::Inputs(){
+    return std::vector<std::string>();
+  };
+
+  std::vector<std::string> DataShape::Outputs(){
+    return std::vector<std::string>(1,dirname_=="" ? module_name_ : dirname_);
+  };
+
+  std::vector<LTShapeRequest> DataShape::Shapes(){
+    std::vector<LTShapeRequest> shapes;
+    for(unsigned iShape=0;iShape<shape_.size();iShape++){
+      //2D shapes, named as in Run, are not prefetched
+      std::string histname=shapename_.size()<=iShape ? shape_[iShape].substr(0,shape_[iShape].find("(")) : shapename_[iShape];
+      if(histname.find(":")!=histname.npos) continue;
+      for(unsigned iset=0;iset<dataset_.size();iset++){
+	LTShapeRequest request={dataset_[iset],shape_[iShape],basesel_,cat_,dataweight_,false};
+	shapes.push_back(request);
+      }
+    }
+    return shapes;
+  };
+
 }
@@ -7,6 +7,19 @@
 
 namespace ic{
 
+  namespace {
+    //Whether two lists of output file directories have one in common, "*"
+    //being in common with any directory
+    bool ShareDirectory(std::vector<std::string> const& a, std::vector<std::string> const& b){
+      for(unsigned ia=0;ia<a.size();++ia){
+	for(unsigned ib=0;ib<b.size();++ib){
+	  if(a[ia]=="*" || b[ib]=="*" || a[ia]==b[ib]) return true;
+	}
+      }
+      return false;
+    }
+  }
+
   LTAnalyser::LTAnalyser(std::string outputname){
     verbosity_=1;
     outputname_=outputname;
@@ -64,6 +77,10 @@ namespace ic{
     filemanager_.set_input_params(inputparams);
   };
 
+  void LTAnalyser::SetThreads(unsigned nthreads){
+    filemanager_.set_n_threads(nthreads);
+  };
+
   bool LTAnalyser::PostModule(int status) {
     if (status > 0) {
 
@@ -73,6 +90,30 @@ namespace ic{
     }
   }
 
+  std::vector<std::vector<unsigned> > LTAnalyser::ScheduleModules(){
+    std::vector<std::vector<std::string> > inputs, outputs;
+    for (unsigned module = 0; module < modulelist_.size(); ++module) {
+      inputs.push_back(modulelist_[module]->Inputs());
+      outputs.push_back(modulelist_[module]->Outputs());
+    }
+    //A module depends on an earlier one that writes a directory it reads,
+    //reads a directory it writes or writes the same directory
+    std::vector<unsigned> stageof(modulelist_.size(), 0);
+    std::vector<std::vector<unsigned> > stages;
+    for (unsigned module = 0; module < modulelist_.size(); ++module) {
+      for (unsigned before = 0; before < module; ++before) {
+	if (ShareDirectory(outputs[before], inputs[module]) ||
+	    ShareDirectory(inputs[before], outputs[module]) ||
+	    ShareDirectory(outputs[before], outputs[module])) {
+	  stageof[module] = std::max(stageof[module], stageof[before] + 1);
+	}
+      }
+      if (stages.size() <= stageof[module]) stages.resize(stageof[module] + 1);
+      stages[stageof[module]].push_back(module);
+    }
+    return stages;
+  }
+
   int LTAnalyser::RunAnalysis(){
     TH1::SetDefaultSumw2(true);
     if (print_module_list_) {
@@ -94,10 +135,39 @@ namespace ic{
     std::cout << "-------------------------------------" << std::endl;
     std::cout << "Beginning Main Analysis Sequence" << std::endl;
     std::cout << "-------------------------------------" << std::endl;
-    for (unsigned module = 0; module < modulelist_.size(); ++module) {
-      int status = modulelist_[module]->Run(&filemanager_);
-      if (!PostModule(status)) {
-	if (status == 1) break;
+    if (filemanager_.n_threads() == 0) {
+      for (unsigned module = 0; module < modulelist_.size(); ++module) {
+	int status = modulelist_[module]->Run(&filemanager_);
+	if (!PostModule(status)) {
+	  if (status == 1) break;
+	}
+      }
+    } else {
+      //The shapes the modules of a stage declare are drawn up front in one
+      //pass over each file, then the modules run in turn as they all write
+      //to the same output file
+      std::vector<std::vector<unsigned> > stages = ScheduleModules();
+      bool stop = false;
+      for (unsigned stage = 0; stage < stages.size() && !stop; ++stage) {
+	std::cout << "Stage " << stage << ":";
+	std::vector<LTShapeRequest> shapes;
+	for (unsigned i = 0; i < stages[stage].size(); ++i) {
+	  LTModule *module = modulelist_[stages[stage][i]];
+	  std::cout << " " << module->module_name();
+	  std::vector<LTShapeRequest> moduleshapes = module->Shapes();
+	  shapes.insert(shapes.end(), moduleshapes.begin(), moduleshapes.end());
+	}
+	std::cout << std::endl;
+	filemanager_.PrefetchSetShapes(shapes);
+	for (unsigned i = 0; i < stages[stage].size(); ++i) {
+	  int status = modulelist_[stages[stage][i]]->Run(&filemanager_);
+	  if (!PostModule(status)) {
+	    if (status == 1) {
+	      stop = true;
+	      break;
+	    }
+	  }
+	}
       }
     }
     std::cout<<"All modules ran and exited with status 0."<<std::endl;
@@ -1,11 +1,60 @@
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsNuNu/LightTreeAna/interface/LightTreeFiles.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsNuNu/interface/HiggsNuNuAnalysisTools.h"
 #include "boost/lexical_cast.hpp"
+#include "boost/algorithm/string.hpp"
 #include <iostream>
+#include <algorithm>
 #include <vector>
+#include <set>
 #include <cstring>
+#include <stdexcept>
 
 namespace ic{
+
+  namespace {
+    //Split a selection into its top-level "&&" terms, or a single term if it
+    //has a top-level "||"
+    std::vector<std::string> SplitCuts(std::string cut){
+      std::vector<std::string> cuts;
+      boost::trim(cut);
+      //Remove parentheses around the whole selection
+      while(cut.size()>1 && cut[0]=='(' && cut[cut.size()-1]==')'){
+	int depth=0;
+	bool enclosing=true;
+	for(unsigned i=0;i<cut.size()-1;++i){
+	  if(cut[i]=='(') ++depth;
+	  if(cut[i]==')') --depth;
+	  if(depth==0){
+	    enclosing=false;
+	    break;
+	  }
+	}
+	if(!enclosing) break;
+	cut=boost::trim_copy(cut.substr(1,cut.size()-2));
+      }
+      if(cut=="") return cuts;
+      int depth=0;
+      unsigned start=0;
+      for(unsigned i=0;i<cut.size();++i){
+	if(cut[i]=='(') ++depth;
+	else if(cut[i]==')') --depth;
+	else if(depth==0 && i+1<cut.size() && cut.compare(i,2,"||")==0){
+	  cuts.assign(1,cut);
+	  return cuts;
+	}
+	else if(depth==0 && i+1<cut.size() && cut.compare(i,2,"&&")==0){
+	  std::string term=boost::trim_copy(cut.substr(start,i-start));
+	  if(term!="") cuts.push_back(term);
+	  start=i+2;
+	  ++i;
+	}
+      }
+      std::string term=boost::trim_copy(cut.substr(start));
+      if(term!="") cuts.push_back(term);
+      return cuts;
+    }
+  }
+
   LTFile::LTFile(){
   };
 
@@ -33,7 +82,8 @@ namespace ic{
       //std::cout << " File " << dataeosfolder << infolder << filepath << " is data." << std::endl;
       isMC=false;
     }
-    TFile * tmp = isMC?TFile::Open((mceosfolder+infolder+"/"+this->path()).c_str()) : TFile::Open((dataeosfolder+infolder+"/"+this->path()).c_str());
+    filename_ = isMC ? (mceosfolder+infolder+"/"+this->path()) : (dataeosfolder+infolder+"/"+this->path());
+    TFile * tmp = TFile::Open(filename_.c_str());
     if (!tmp) {
       std::cerr << "Warning, file " << this->name() << " could not be opened." << std::endl;
       return 1;
@@ -81,6 +131,53 @@ namespace ic{
     return *list;
   }
 
+  TEntryList* LTFile::GetCachedEntryList(std::string const& selection, std::string const& category){
+    std::vector<std::string> cuts=SplitCuts(selection);
+    std::vector<std::string> catcuts=SplitCuts(category);
+    //Make sure the selection on its own is cached, it is usually shared by
+    //many modules with different categories
+    if(cuts.size()>0 && catcuts.size()>0) GetCachedEntryList(selection,"");
+    cuts.insert(cuts.end(),catcuts.begin(),catcuts.end());
+    std::sort(cuts.begin(),cuts.end());
+    cuts.erase(std::unique(cuts.begin(),cuts.end()),cuts.end());
+    if(cuts.size()==0) return 0;
+    //Each term may be a whole selection with a top level ||, so keep it
+    //together when it is and-ed with the others
+    std::string key="("+boost::algorithm::join(cuts,") && (")+")";
+    auto it=entrylists_.find(key);
+    if(it!=entrylists_.end()) return it->second.list.get();
+
+    //Only entries passing every cached subset of the cuts can pass
+    std::unique_ptr<TEntryList> start;
+    for(auto const& cached : entrylists_){
+      if(!std::includes(cuts.begin(),cuts.end(),cached.second.cuts.begin(),cached.second.cuts.end())) continue;
+      if(!start){
+	start.reset(new TEntryList(*cached.second.list));
+      }
+      else{
+	TEntryList notincached(*start);
+	notincached.Subtract(cached.second.list.get());
+	start->Subtract(&notincached);
+      }
+    }
+    std::string name="ltentrylist"+boost::lexical_cast<std::string>(entrylists_.size());
+    if(start) tree_->SetEntryList(start.get());
+    tree_->Draw((">>"+name).c_str(),key.c_str(),"entrylist");
+    tree_->SetEntryList(0);
+    TEntryList *list=(TEntryList*)gDirectory->Get(name.c_str());
+    if(!list){
+      std::cout<<"WARNING: could not build entry list for "<<key<<" in "<<name_<<std::endl;
+      return 0;
+    }
+    list->SetDirectory(0);
+    list->ResetBit(kCanDelete);
+    CachedEntryList cached;
+    cached.cuts=cuts;
+    cached.list.reset(list);
+    entrylists_[key]=cached;
+    return list;
+  }
+
   TTree* LTFile::GetSubTree(TEntryList list){
     tree_->SetEntryList(&list);
     TTree *small = tree_->CopyTree("");
@@ -96,7 +193,23 @@ namespace ic{
       //temp.SetName("EMPTY");
       return false;
     }
+    TH1F const* prefetched=GetPrefetchedShape(variable,BuildCutString(selection,category,weight));
+    if(prefetched){
+      if(!toadd){
+	temp=*prefetched;
+	temp.SetName("myshape");
+      }
+      else if(!temp.Add(prefetched)){
+	std::cout << " Failed adding shape." << std::endl;
+	return false;
+      }
+      std::cout << variable << " nEvtsIntegrated = " << temp.GetEntries() << " " << temp.Integral() << " (prefetched)" << std::endl;
+      return true;
+    }
+    TEntryList *list=GetCachedEntryList(selection,category);
+    if(list) tree_->SetEntryList(list);
     bool success = ic::GetShape(temp,variable,selection,category,weight,tree_,toadd);
+    tree_->SetEntryList(0);
     //if(strcmp(temp.GetName(),"ERROR")==0){
     //std::cout<<"File with problem is: "<<name_<<std::endl;
     //return false;
@@ -111,7 +224,10 @@ namespace ic{
       //temp.SetName("EMPTY");
       return false;
     }
+    TEntryList *list=GetCachedEntryList(selection,category);
+    if(list) tree_->SetEntryList(list);
     bool success =ic::GetShape2D(temp,variable,selection,category,weight,tree_,toadd);
+    tree_->SetEntryList(0);
     //if(strcmp(temp.GetName(),"ERROR")==0){
     //std::cout<<"File with problem is: "<<name_<<std::endl;
     //return false;
@@ -126,7 +242,10 @@ namespace ic{
       temp.SetName("EMPTY");
       return temp;
     }
+    TEntryList *list=GetCachedEntryList(selection,category);
+    if(list) tree_->SetEntryList(list);
     temp=ic::GetShape3D(variable,selection,category,weight,tree_);
+    tree_->SetEntryList(0);
     if(strcmp(temp.GetName(),"ERROR")==0){
       std::cout<<"File with problem is: "<<name_<<std::endl;
       return temp;
@@ -138,22 +257,41 @@ namespace ic{
     return tree_;
   }
 
+  void LTFile::AddPrefetchedShape(std::string const& variable, std::string const& fullselection, TH1F const& shape){
+    TH1F & cached=prefetched_[variable+"|"+fullselection];
+    cached=shape;
+    cached.SetDirectory(0);
+  }
+
+  TH1F const* LTFile::GetPrefetchedShape(std::string const& variable, std::string const& fullselection) const{
+    auto cached=prefetched_.find(variable+"|"+fullselection);
+    return cached==prefetched_.end() ? 0 : &(cached->second);
+  }
+
 
 
 
   LTFiles::LTFiles(){
+    n_threads_=0;
+    entries_per_task_=500000;
   };
 
   LTFiles::LTFiles(std::string name, std::string set, std::string path){
+    n_threads_=0;
+    entries_per_task_=500000;
     files_[name]=LTFile(name,set,path);
     setlists_[set].push_back(std::pair<std::string,bool>(name,true));
   };
 
   LTFiles::LTFiles(std::string name, std::string path){
+    n_threads_=0;
+    entries_per_task_=500000;
     files_[name]=LTFile(name,path);
   };
   
   LTFiles::LTFiles(std::vector<std::string> names,std::vector<std::string> sets, std::vector<std::string> paths){
+    n_threads_=0;
+    entries_per_task_=500000;
     if(names.size()!=sets.size() || sets.size()!=paths.size()) std::cout<<"Error different numbers of names, sets and paths making empty Files object"<<std::endl;
     else{
       for(unsigned iname=0;iname<names.size();iname++){
@@ -164,6 +302,8 @@ namespace ic{
   };
 
   LTFiles::LTFiles(LTFile file){
+    n_threads_=0;
+    entries_per_task_=500000;
     files_[file.name()]=file;
     if(file.set()!=""){
       setlists_[file.set()].push_back(std::pair<std::string,bool>(file.name(),true));
@@ -171,6 +311,8 @@ namespace ic{
   };
   
   LTFiles::LTFiles(std::vector<LTFile> files){
+    n_threads_=0;
+    entries_per_task_=500000;
     for(unsigned ifile=0;ifile<files.size();ifile++){
       files_[files[ifile].name()]=files[ifile];
       if(files[ifile].set()!=""){
@@ -401,6 +543,11 @@ namespace ic{
 	//TH1F temp;
 	return false;
       }
+      std::string expression;
+      TH1F binning;
+      if(n_threads_>0 && ParseBinnedVariable(variable,expression,binning)){
+	return GetSetShapeConcurrent(setshape,setname,variable,expression,binning,selection,category,weight,do_lumixs_weights_,toadd);
+      }
       bool first=toadd?false:true;
       for(auto iter=setlists_[setname].begin(); iter!=setlists_[setname].end();++iter){
 	if (!(*iter).second) continue;
@@ -445,6 +592,132 @@ namespace ic{
     return oneok;
   };
 
+  bool LTFiles::GetSetShapeConcurrent(TH1F & setshape, std::string setname, std::string const& variable, std::string const& expression, TH1F const& binning, std::string const& selection, std::string const& category, std::string const& weight, const bool do_lumixs_weights_, const bool toadd){
+    //The set is already open: collect one draw per file then close them,
+    //each task opens its own copy of the file. Prefetched shapes are taken
+    //as they are.
+    std::vector<TreeDrawJob> jobs;
+    std::vector<std::string> jobnames;
+    std::vector<TH1F const*> prefetched;
+    for(auto iter=setlists_[setname].begin(); iter!=setlists_[setname].end();++iter){
+      if (!(*iter).second) continue;
+      LTFile & file=files_[(*iter).first];
+      double lumixsweight=1;
+      if(do_lumixs_weights_){
+	lumixsweight=this->GetLumiXSWeight(file);
+      }
+      std::string fullselection=BuildCutString(selection,category,weight+"*"+boost::lexical_cast<std::string>(lumixsweight));
+      TH1F const* cached=file.GetPrefetchedShape(variable,fullselection);
+      if(cached){
+	jobnames.push_back((*iter).first);
+	prefetched.push_back(cached);
+	CloseFile((*iter).first);
+	continue;
+      }
+      long long entries=file.GetTree()->GetEntries();
+      TEntryList *list=entries<1 ? 0 : file.GetCachedEntryList(selection,category);
+      if(entries<1){
+	std::cout<<"WARNING: "<<file.name()<<" is empty."<<std::endl;
+	CloseFile((*iter).first);
+	continue;
+      }
+      TreeDrawJob job;
+      job.file=file.GetFileName();
+      job.tree="LightTree";
+      job.friends=file.GetFriends();
+      job.expression=expression;
+      job.selection=fullselection;
+      job.entries=list ? list->GetN() : entries;
+      job.entrylist=list;
+      job.binning=binning;
+      jobs.push_back(job);
+      jobnames.push_back((*iter).first);
+      prefetched.push_back(0);
+      CloseFile((*iter).first);
+    }
+    if(jobnames.size()==0) return false;
+    std::vector<TH1F> shapes;
+    try{
+      shapes=DrawTrees(TaskExecutor(n_threads_),jobs,entries_per_task_);
+    }
+    catch(std::exception const& e){
+      std::cout<<e.what()<<" --- Error, Skipping set "<<setname<<std::endl;
+      return false;
+    }
+    unsigned idrawn=0;
+    for(unsigned ijob=0;ijob<jobnames.size();++ijob){
+      TH1F const* shape=prefetched[ijob] ? prefetched[ijob] : &shapes[idrawn++];
+      if(ijob==0 && !toadd){
+	setshape=*shape;
+	setshape.SetName("myshape");
+      }
+      else if(!setshape.Add(shape)){
+	std::cout << " Failed adding shape." << std::endl;
+	return false;
+      }
+      std::cout << "Set: " << setname << ", sample " << jobnames[ijob] << ": " << expression << " nEvtsIntegrated = " << setshape.GetEntries() << " " << setshape.Integral() << std::endl;
+    }
+    return true;
+  }
+
+  int LTFiles::PrefetchSetShapes(std::vector<LTShapeRequest> const& requests){
+    if(n_threads_==0) return 0;
+    //One job per file and distinct shape, the jobs of a file are then drawn
+    //in a single pass over its tree
+    std::vector<TreeDrawJob> jobs;
+    std::vector<std::string> jobfiles;
+    std::vector<std::string> jobvariables;
+    std::set<std::string> seen;
+    for(unsigned ireq=0;ireq<requests.size();++ireq){
+      LTShapeRequest const& req=requests[ireq];
+      std::string expression;
+      TH1F binning;
+      if(setlists_.count(req.set)==0 || !ParseBinnedVariable(req.variable,expression,binning)) continue;
+      if(OpenSet(req.set)==1) continue;
+      for(auto iter=setlists_[req.set].begin(); iter!=setlists_[req.set].end();++iter){
+	if (!(*iter).second) continue;
+	LTFile & file=files_[(*iter).first];
+	double lumixsweight=1;
+	if(req.do_lumixs_weights){
+	  lumixsweight=this->GetLumiXSWeight(file);
+	}
+	std::string fullselection=BuildCutString(req.selection,req.category,req.weight+"*"+boost::lexical_cast<std::string>(lumixsweight));
+	long long entries=file.GetTree()->GetEntries();
+	if(entries<1 || file.GetPrefetchedShape(req.variable,fullselection) || !seen.insert((*iter).first+"|"+req.variable+"|"+fullselection).second){
+	  CloseFile((*iter).first);
+	  continue;
+	}
+	TreeDrawJob job;
+	job.file=file.GetFileName();
+	job.tree="LightTree";
+	job.friends=file.GetFriends();
+	job.expression=expression;
+	job.selection=fullselection;
+	job.entries=entries;
+	job.binning=binning;
+	jobs.push_back(job);
+	jobfiles.push_back((*iter).first);
+	jobvariables.push_back(req.variable);
+	CloseFile((*iter).first);
+      }
+    }
+    if(jobs.size()==0) return 0;
+    std::cout<<"Prefetching "<<jobs.size()<<" shapes"<<std::endl;
+    std::vector<TH1F> shapes;
+    try{
+      shapes=DrawTreesShared(TaskExecutor(n_threads_),jobs,entries_per_task_);
+    }
+    catch(std::exception const& e){
+      //Not fatal, the shapes are drawn when they are asked for instead
+      std::cout<<e.what()<<" --- Error, not prefetching"<<std::endl;
+      return 1;
+    }
+    for(unsigned ijob=0;ijob<shapes.size();++ijob){
+      files_[jobfiles[ijob]].AddPrefetchedShape(jobvariables[ijob],jobs[ijob].selection,shapes[ijob]);
+    }
+    return 0;
+  }
+
   TH1F LTFiles::GetSetsShape(std::vector<std::string> setnames, std::string const& variable, std::string const& selection, std::string const& category, std::string const& weight, const bool do_lumixs_weights_){
     TH1F setsshape;
     setsshape.Sumw2();
@@ -10,4 +10,16 @@ namespace ic{
   std::string LTModule::module_name(){
     return module_name_;
   };
+
+  std::vector<std::string> LTModule::Inputs(){
+    return std::vector<std::string>(1,"*");
+  };
+
+  std::vector<std::string> LTModule::Outputs(){
+    return std::vector<std::string>(1,"*");
+  };
+
+  std::vector<LTShapeRequest> LTModule::Shapes(){
+    return std::vector<LTShapeRequest>();
+  };
 }
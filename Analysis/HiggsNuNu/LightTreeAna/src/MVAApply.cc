@@ -4,9 +4,15 @@
 #include "TH1F.h"
 #include "TCanvas.h"
 #include <map>
-#include "TMVA/Reader.h"
-#include "TMVA/Tools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/TaskExecutor.h"
 #include "TTreeFormula.h"
+#include "TROOT.h"
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
 
 namespace ic{
 
@@ -14,6 +20,7 @@ namespace ic{
     weightDir_="weights";
     friendDir_="friends";
     setorfile_=false;
+    block_size_=1024;
   };
 
   MVAApply::~MVAApply(){ ;};
@@ -34,76 +41,126 @@ namespace ic{
 
   int MVAApply::Run(LTFiles* filemanager){
     std::cout<<module_name_<<":"<<std::endl;
-    // MAKE TMVA READER                                                                                                              
-    TMVA::Reader *reader = new TMVA::Reader( "Color:!Silent" );
-
-    //ADD ALL THE VARIABLES
-    Double_t var[variables_.size()];
+    //SPLIT THE VARIABLES INTO LABELS AND EXPRESSIONS
+    //THE BLANKS ARE TAKEN OUT OF THE EXPRESSIONS, AS TMVA DOES BEFORE WRITING
+    //THEM TO THE WEIGHT FILE
+    std::vector<std::string> formulavar;
     for(unsigned iVar=0;iVar<variables_.size();iVar++){
-      reader->AddVariable(variables_[iVar].c_str(),(Float_t*)&var[iVar]);
+      std::string expression=variables_[iVar];
+      if(expression.find(":=")!=std::string::npos) expression=expression.substr(expression.find(":=")+2);
+      expression.erase(std::remove_if(expression.begin(),expression.end(),[](char c){return std::isspace(static_cast<unsigned char>(c));}),expression.end());
+      formulavar.push_back(expression);
     }
 
-    //BOOK METHODS
-    for(unsigned iMethod=0;iMethod<methodNames_.size();iMethod++){
-      reader->BookMVA( methodNames_[iMethod].c_str(), (weightDir_+"/"+weightFiles_[iMethod]).c_str() );
+    //LOAD THE FORESTS
+    std::vector<std::unique_ptr<BDTForest> > forests;
+    try{
+      for(unsigned iMethod=0;iMethod<methodNames_.size();iMethod++){
+	forests.push_back(std::unique_ptr<BDTForest>(new BDTForest(weightDir_+"/"+weightFiles_[iMethod])));
+	forests.back()->CheckVariables(formulavar);
+      }
+    }
+    catch(std::exception const& e){
+      std::cout<<e.what()<<std::endl;
+      return 1;
     }
-    //SET LOOP
+
+    //COLLECT THE FILES, EACH TASK OPENS ITS OWN COPY
+    struct FriendJob{
+      std::string name;
+      std::string file;
+      std::vector<std::pair<std::string,std::string> > friends;
+    };
+    std::vector<FriendJob> jobs;
     for(unsigned iVec=0;iVec<sets_.size();iVec++){
       std::vector<LTFile> files;
       if(setorfile_)files=filemanager->GetFileSet(sets_[iVec]);
       else files.push_back(filemanager->GetFile(sets_[iVec]));
       std::cout<<"Processing "<<sets_[iVec]<<std::endl;
-      //FILE LOOP
       for(unsigned iFile=0;iFile<files.size();iFile++){
-	//MAKE A TREE TO BE THE FRIEND TREE AND SET UP THE BRANCHES
 	std::cout<<"  "<<files[iFile].name()<<std::endl;
-	TFile* friendfile=new TFile((friendDir_+"/"+files[iFile].name()+"_mvafriend.root").c_str(),"RECREATE");
-	TTree* friendtree=new TTree("mvafriend","Friend to Light Trees to store MVA values");
-	double mvavalues[methodNames_.size()];
-	for(unsigned iMethod=0;iMethod<methodNames_.size();iMethod++){
-	  friendtree->Branch(methodNames_[iMethod].c_str(),&mvavalues[iMethod]);
+	if(files[iFile].Open(filemanager->infolder())!=0) continue;
+	FriendJob job;
+	job.name=files[iFile].name();
+	job.file=files[iFile].GetFileName();
+	job.friends=files[iFile].GetFriends();
+	jobs.push_back(job);
+	files[iFile].Close();
+      }
+    }
+
+    unsigned nvars=variables_.size();
+    unsigned blocksize=block_size_>0?block_size_:1;
+    std::vector<std::function<void()> > tasks;
+    for(unsigned iJob=0;iJob<jobs.size();iJob++){
+      tasks.push_back([&,iJob](){
+	FriendJob const& job=jobs[iJob];
+	std::unique_ptr<TFile> infile(TFile::Open(job.file.c_str()));
+	if(!infile || infile->IsZombie()) throw std::runtime_error("[MVAApply] Unable to open "+job.file);
+	TTree *ttree_=dynamic_cast<TTree*>(infile->Get("LightTree"));
+	if(!ttree_) throw std::runtime_error("[MVAApply] No LightTree in "+job.file);
+	for(unsigned iFr=0;iFr<job.friends.size();iFr++){
+	  ttree_->AddFriend(job.friends[iFr].first.c_str(),job.friends[iFr].second.c_str());
 	}
 
-        //GET TREE
-	files[iFile].Open(filemanager->infolder());
-	TTree *ttree_ =files[iFile].GetTree();
-	std::vector<TTreeFormula*> formulas;
+	//SET UP TTREEFORMULAS, WHICH ONLY READ THE BRANCHES THEY USE
+	std::vector<std::unique_ptr<TTreeFormula> > formulas;
+	for(unsigned iVar=0;iVar<nvars;iVar++){
+	  formulas.push_back(std::unique_ptr<TTreeFormula>(new TTreeFormula(variables_[iVar].c_str(),formulavar[iVar].c_str(),ttree_)));
+	  if(formulas.back()->GetNdim()==0) throw std::runtime_error("[MVAApply] Invalid variable "+formulavar[iVar]+" for "+job.file);
+	}
 
-	//SET UP TTREEFORMULAS
-	std::vector<std::string> formulavar;
-	for(unsigned iVar=0;iVar<variables_.size();iVar++){
-	  if(variables_[iVar].find(":=")!=std::string::npos) formulavar.push_back(variables_[iVar].substr(variables_[iVar].find(":=")+2));
-	  else formulavar.push_back(variables_[iVar]);
-	  formulas.push_back(new TTreeFormula(variables_[iVar].c_str(),formulavar[iVar].c_str(),ttree_));
+	//MAKE A TREE TO BE THE FRIEND TREE AND SET UP THE BRANCHES
+	std::unique_ptr<TFile> friendfile(new TFile((friendDir_+"/"+job.name+"_mvafriend.root").c_str(),"RECREATE"));
+	TTree* friendtree=new TTree("mvafriend","Friend to Light Trees to store MVA values");
+	std::vector<double> mvavalues(methodNames_.size());
+	std::vector<TBranch*> branches;
+	for(unsigned iMethod=0;iMethod<methodNames_.size();iMethod++){
+	  branches.push_back(friendtree->Branch(methodNames_[iMethod].c_str(),&mvavalues[iMethod]));
 	}
-	
-	//EVENT LOOP
-	static unsigned processed = 0;
-	for (Long64_t iEvt=0; iEvt<ttree_->GetEntries();iEvt++) {
-	  ttree_->GetEntry(iEvt);
-	  
-	  for(unsigned iVar=0;iVar<variables_.size();iVar++){
-	    formulas[iVar]->EvalInstance(iEvt);
-	    var[iVar]=boost::lexical_cast<double>(formulas[iVar]->PrintValue(0,0,".9f"));
+
+	//BLOCK LOOP: READ THE INPUTS OF A BLOCK OF EVENTS, EVALUATE EVERY
+	//METHOD ON THE WHOLE BLOCK, THEN FILL THE FRIEND TREE ONE BRANCH AT A
+	//TIME
+	std::vector<float> features(blocksize*nvars);
+	std::vector<std::vector<double> > outputs(methodNames_.size(),std::vector<double>(blocksize));
+	Long64_t nentries=ttree_->GetEntries();
+	for(Long64_t first=0;first<nentries;first+=blocksize){
+	  unsigned n=std::min<Long64_t>(blocksize,nentries-first);
+	  for(unsigned iEvt=0;iEvt<n;iEvt++){
+	    ttree_->LoadTree(first+iEvt);
+	    for(unsigned iVar=0;iVar<nvars;iVar++){
+	      //Instance 0 has to be evaluated first, it loads the branches
+	      features[iEvt*nvars+iVar]=formulas[iVar]->GetNdata()>0 ? formulas[iVar]->EvalInstance(0) : std::numeric_limits<float>::quiet_NaN();
+	    }
+	  }
+	  for(unsigned iMethod=0;iMethod<forests.size();iMethod++){
+	    forests[iMethod]->Evaluate(features.data(),n,outputs[iMethod].data());
 	  }
-	  
-          //EVALUATE MVA
-	  for(unsigned iMethod=0;iMethod<methodNames_.size();iMethod++){
-	    mvavalues[iMethod]=reader->EvaluateMVA(methodNames_[iMethod]);
+	  for(unsigned iMethod=0;iMethod<branches.size();iMethod++){
+	    for(unsigned iEvt=0;iEvt<n;iEvt++){
+	      mvavalues[iMethod]=outputs[iMethod][iEvt];
+	      branches[iMethod]->Fill();
+	    }
 	  }
-	  //WRITE TO THE FRIEND TREE
-	  friendtree->Fill();
-	  ++processed;
-	  if (processed == 500) friendtree->OptimizeBaskets();
+	  friendtree->SetEntries(first+n);
+	  if(first==0) friendtree->OptimizeBaskets();
 	}
+
 	//CLEAN UP
 	friendfile->cd();
 	friendtree->Write();
-	friendfile->Write();
 	friendfile->Close();
-	files[iFile].AddFriend("mvafriend",(friendDir_+"/"+files[iFile].name()+"_mvafriend.root").c_str());
-	files[iFile].Close();
-      }
+      });
+    }
+    try{
+      TaskExecutor exec(filemanager->n_threads());
+      if(exec.n_threads()>1) ROOT::EnableThreadSafety();
+      exec.Run(tasks);
+    }
+    catch(std::exception const& e){
+      std::cout<<e.what()<<std::endl;
+      return 1;
     }
     return 0;
   };
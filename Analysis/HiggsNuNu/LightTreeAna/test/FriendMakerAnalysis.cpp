@@ -30,6 +30,7 @@ int main(int argc, char* argv[]){
   std::string settorun;
   std::string basesel;
   std::string jetmetdphicut;
+  unsigned threads;
   
   po::options_description preconfig("Configuration"); 
   preconfig.add_options()("cfg",po::value<std::string>(&cfg)->required());
@@ -46,7 +47,8 @@ int main(int argc, char* argv[]){
     ("jetmetdphicut,j",           po::value<std::string>(&jetmetdphicut)->default_value(""))
     ("input_params,p",           po::value<std::string>(&inputparams)->default_value("../filelists/Dec18/ParamsDec18test.dat"))
     ("filelist,f",               po::value<std::string>(&filelist)->default_value("filelists/filelist.dat"))
-    ("settorun,r",              po::value<std::string>(&settorun)->default_value(""));
+    ("settorun,r",              po::value<std::string>(&settorun)->default_value(""))
+    ("threads",                  po::value<unsigned>(&threads)->default_value(0));
   po::store(po::command_line_parser(argc, argv).options(config).allow_unregistered().run(), vm);
   po::store(po::parse_config_file<char>(cfg.c_str(), config), vm);
   po::notify(vm);
@@ -63,6 +65,7 @@ int main(int argc, char* argv[]){
 
   analysis->SetInFolder(inputfolder);
   analysis->SetInputParams(inputparams);
+  analysis->SetThreads(threads);
 
   //Set selection step common to all categories
   analysis->set_baseselection("");
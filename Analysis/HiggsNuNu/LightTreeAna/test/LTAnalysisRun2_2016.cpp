@@ -136,6 +136,7 @@ int main(int argc, char* argv[]){
   std::string shapePar;
 
   unsigned debug;
+  unsigned threads;
 
   double lumiSF;
 
@@ -175,6 +176,7 @@ int main(int argc, char* argv[]){
     ("blindcutreg",              po::value<bool>(&blindcutreg)->default_value(true))
     ("runblindreg",              po::value<bool>(&runblindreg)->default_value(true))
     ("debug",                    po::value<unsigned>(&debug)->default_value(0))
+    ("threads",                  po::value<unsigned>(&threads)->default_value(0))
     ("do_mcbkg",                 po::value<bool>(&do_mcbkg)->default_value(true))
     ("use_nlo",                  po::value<bool>(&use_nlo)->default_value(false))
     ("jetmetdphicut",            po::value<std::string>(&jetmetdphicut)->default_value("alljetsmetnomu_mindphi>1.0"))
@@ -226,6 +228,7 @@ int main(int argc, char* argv[]){
     analysis->SetInFolder(inputfolder);
   }
   analysis->SetInputParams(inputparams);
+  analysis->SetThreads(threads);
 
   std::cout<<"Base selection: "<<basesel<<std::endl;
 
@@ -1,4 +1,4 @@
 SUBDIRS 	:= LegacySVFit HHKinFit
 LIB_DEPS 	:= Core Utilities Modules Objects HiggsTauTau/LegacySVFit HiggsTauTau/HHKinFit
-LIB_EXTRA := -lCondFormatsJetMETObjects -lboost_serialization 
+LIB_EXTRA := -lboost_serialization
 DICTIONARY := interface/CrystalBallEfficiency.h
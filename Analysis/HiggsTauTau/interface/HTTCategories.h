@@ -8,6 +8,7 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 
 #include <string>
+#include <vector>
 
 namespace ic {
 
@@ -30,6 +31,8 @@ class HTTCategories : public ModuleBase {
   CLASS_MEMBER(HTTCategories, bool, add_Hhh_variables)
   CLASS_MEMBER(HTTCategories, bool, do_HLT_Studies)
   CLASS_MEMBER(HTTCategories, bool, add_nlo_weights)
+  // Names of WeightVector products, each written as a vector<float> branch
+  CLASS_MEMBER(HTTCategories, std::vector<std::string>, weight_vectors)
   CLASS_MEMBER(HTTCategories, std::string, sync_output_name)
   CLASS_MEMBER(HTTCategories, bool, iso_study)
   CLASS_MEMBER(HTTCategories, bool, tau_id_study)
@@ -83,6 +86,7 @@ class HTTCategories : public ModuleBase {
   double wt_nlo_pt_;
   double wt_tau_id_sf_;
   double nlo_pt_;
+  std::vector<std::vector<float>> wt_vectors_;
   float trigweight_1_;
   float trigweight_2_;
   double wt_trig_up_1_;
@@ -0,0 +1,54 @@
+#ifndef ICHiggsTauTau_HiggsTauTau_HTTResultCache_h
+#define ICHiggsTauTau_HiggsTauTau_HTTResultCache_h
+#include <string>
+#include <map>
+#include <utility>
+#include <cstdint>
+#include "TH1F.h"
+
+namespace ic {
+
+  //! Content-addressed cache of yields and shapes drawn from the HTT ntuples
+  /*! Entries are keyed on a hash of the input file identity (path, size and
+      modification time) together with the fully expanded draw strings, so a
+      stale entry is never returned after a file is replaced. Rates can be
+      persisted to a text file and re-used by later processes; shapes are
+      only kept in memory since they depend on the variable being plotted.
+  */
+  class HTTResultCache {
+    public:
+      typedef std::pair<double, double> Value;
+
+      HTTResultCache();
+
+      //! Identity string of a file: "path:size:mtime", or "" if it does not exist
+      static std::string FileIdentity(std::string const& file);
+
+      //! 64-bit FNV-1a hash of \p str as a hex string
+      static std::string Hash(std::string const& str);
+
+      bool GetRate(std::string const& key, Value & result) const;
+      void SetRate(std::string const& key, Value const& value);
+
+      TH1F const* GetShape(std::string const& key) const;
+      void SetShape(std::string const& key, TH1F const& shape);
+
+      //! Load rates from \p file if it exists, returns the number read
+      unsigned Load(std::string const& file);
+      //! Write all rates to \p file if any were added since the last Load/Save
+      void Save(std::string const& file);
+
+      inline unsigned hits() const { return hits_; }
+      inline unsigned misses() const { return misses_; }
+
+    private:
+      std::map<std::string, Value> rates_;
+      std::map<std::string, TH1F> shapes_;
+      bool dirty_;
+      mutable unsigned hits_;
+      mutable unsigned misses_;
+  };
+
+}
+
+#endif
@@ -11,8 +11,10 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TextElement.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/SimpleParamParser.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnRootTools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/TreeDraw.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTConfig.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTAnalysisTools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTResultCache.h"
 #include "RooWorkspace.h"
 
 //! HTTRun2AnalysisTools
@@ -87,6 +89,7 @@ namespace ic {
       HistValuePair GenerateW(unsigned method, std::string var, std::string sel, std::string cat, std::string wt);
       HistValuePair GenerateQCD(unsigned method, std::string var, std::string sel, std::string cat, std::string wt);
       HistValuePair GenerateSignal(std::string sample, std::string var, std::string sel, std::string cat, std::string wt, double xs = -1.0);
+      std::vector<HistValuePair> GenerateSignalVariations(std::string sample, std::string var, std::string sel, std::string cat, std::string wt, std::string wt_vector, unsigned n_wts, double xs = -1.0);
       
       void FillSMSignal(HistValueMap & hmap, 
                         std::vector<std::string> const& masses,
@@ -150,6 +153,29 @@ namespace ic {
                               std::string const& category, 
                               std::string const& weight);
 
+      //! Generate one histogram per entry of a weight vector branch
+      /*! A single TTree::Draw fills a 2D grid with the variation index on
+          the y-axis, so the result matches calling GetShape with the weight
+          "weight*wt_vector[i]" for each i but only reads the tree once.
+          \param wt_vector Name of a vector<float> branch, e.g. as written by
+          HTTCategories::weight_vectors
+          \param n_wts Number of entries to use from the branch
+      */
+      std::vector<TH1F> GetShapes(std::string const& variable,
+                              std::string const& sample,
+                              std::string const& selection,
+                              std::string const& category,
+                              std::string const& weight,
+                              std::string const& wt_vector,
+                              unsigned n_wts);
+      std::vector<TH1F> GetShapes(std::string const& variable,
+                              std::vector<std::string> const& sample,
+                              std::string const& selection,
+                              std::string const& category,
+                              std::string const& weight,
+                              std::string const& wt_vector,
+                              unsigned n_wts);
+
       TH1F GetLumiScaledShape(std::string const& variable,
                               std::string const& sample, 
                               std::string const& selection, 
@@ -322,6 +348,20 @@ namespace ic {
       inline void SetVerbosity(unsigned const& verbosity) { verbosity_ = verbosity; }
       inline void SetSS(){do_ss_ = true;}
 
+      //! Enable or disable the in-memory cache of rates and shapes (on by default)
+      inline void SetUseCache(bool const& use_cache) { use_cache_ = use_cache; }
+      //! Load previously computed rates from \p file, and save new ones there in #SaveCache
+      void SetCacheFile(std::string const& file);
+      void SaveCache();
+
+      //! Draw the samples of each GetShape and GetRate call concurrently on
+      //! \p n_threads threads, with large samples split into ranges of
+      //! entries (see #SetEntriesPerTask). The results are the same for any
+      //! number of threads. Zero (the default) draws each sample in turn with
+      //! a single TTree::Draw. Needs the in-memory cache to be enabled.
+      inline void SetThreads(unsigned const& n_threads) { n_threads_ = n_threads; }
+      inline void SetEntriesPerTask(long long const& entries) { entries_per_task_ = entries; }
+
     private:
       ic::channel ch_;
       std::string year_;
@@ -340,11 +380,25 @@ namespace ic {
       std::map<std::string, TTree *> ttrees_;
       std::map<std::string, std::string> alias_map_;
       std::map<std::string, std::vector<std::string>> samples_alias_map_;
+      std::map<std::string, std::string> file_ids_;
+      HTTResultCache cache_;
+      std::string cache_file_;
+      bool use_cache_;
+      std::map<std::string, std::string> file_names_;
+      unsigned n_threads_;
+      long long entries_per_task_;
 
       std::string BuildCutString(std::string const& selection,
                                  std::string const& category,
                                  std::string const& weight);
       std::string BuildVarString(std::string const& variable);
+      //! Fill the cache with the rates, and shapes of \p variable if it is
+      //! not empty, of all \p samples in one concurrent set of draws
+      void Prefetch(std::string const& variable,
+                    std::vector<std::string> const& samples,
+                    std::string const& selection,
+                    std::string const& category,
+                    std::string const& weight);
 
   };
  
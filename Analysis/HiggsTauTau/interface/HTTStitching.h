@@ -2,6 +2,7 @@
 #define ICHiggsTauTau_Module_HTTStitching_h
 
 #include "UserCode/ICHiggsTauTau/interface/TH2DAsymErr.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BTagWeight.h"
@@ -35,6 +36,8 @@ class HTTStitching : public ModuleBase {
   double zxs0_,zxs1_,zxs2_,zxs3_,zxs4_,z_lo_nlo_corr_,zxsinc_,zxshm_;
   double wxs0_,wxs1_,wxs2_,wxs3_,wxs4_,w_lo_nlo_corr_;
   double wt_lumi_;
+  EventInfo::WeightSlot wsoup_slot_;
+  EventInfo::WeightSlot dysoup_slot_;
 
 
  public:
@@ -0,0 +1,90 @@
+#ifndef ICHiggsTauTau_HiggsTauTau_HTTToyStudy_h
+#define ICHiggsTauTau_HiggsTauTau_HTTToyStudy_h
+
+#include <vector>
+#include <string>
+#include "RooAbsPdf.h"
+#include "RooArgSet.h"
+#include "RooRealVar.h"
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTStatTools.h"
+
+namespace ic {
+
+struct ToyResult {
+	unsigned 						toy;
+	unsigned long long 	seed;
+	int 								status;
+	int 								cov_qual;
+	double 							nll;
+	// Fitted value and error of each of ToyStudy::parameters()
+	std::vector<double> values;
+	std::vector<double> errors;
+};
+
+/*
+	Generates toys from one pdf and fits them with another, as RooMCStudy
+	does, but spread over a number of worker processes (RooFit itself is not
+	thread-safe).
+
+	Toy i is generated after seeding the RooFit random generator with
+	ToySeed(seed, i), and with the parameters of both pdfs reset to their
+	values, errors and constant flags at construction, so the result of every toy is the same whatever
+	the number of workers. Each worker builds the likelihood once and swaps
+	in the data of each of its toys.
+
+	The results are streamed by each worker to its own file as the toys
+	finish, then merged in toy order into a TTree "toys" in the output file,
+	with one entry per toy. Besides the toy number, seed, minimiser status,
+	covariance quality and minimum NLL, there are three branches per floating
+	parameter p of the fit pdf: p, p_err, and p_pull = (p - p_true) / p_err,
+	where p_true is the value of the same parameter of the generating pdf (or
+	the starting value, if it has no such parameter).
+*/
+class ToyStudy {
+	private:
+		RooAbsPdf & 				gen_pdf_;
+		RooAbsPdf & 				fit_pdf_;
+		RooArgSet 					observables_;
+		RooArgSet * 				gen_params_;
+		RooArgSet * 				gen_snapshot_;
+		RooArgSet * 				fit_params_;
+		RooArgSet * 				fit_snapshot_;
+		std::vector<RooRealVar *> floating_;
+		std::vector<std::string> names_;
+		std::vector<double> truth_;
+		unsigned long long 	seed_;
+		unsigned 						workers_;
+		bool 								binned_;
+		int 								strategy_;
+
+		int RunWorker(unsigned worker, unsigned ntoys, double nevents, std::string const& filename);
+
+	public:
+		ToyStudy(RooAbsPdf & gen_pdf, RooAbsPdf & fit_pdf, RooArgSet const& observables);
+		~ToyStudy();
+		inline ToyStudy & set_seed(unsigned long long const& seed) { seed_ = seed; return *this; }
+		inline ToyStudy & set_workers(unsigned const& workers) { workers_ = workers; return *this; }
+		inline ToyStudy & set_binned(bool const& binned) { binned_ = binned; return *this; }
+		inline ToyStudy & set_strategy(int const& strategy) { strategy_ = strategy; return *this; }
+		inline std::vector<std::string> const& parameters() const { return names_; }
+		inline std::vector<double> const& truth() const { return truth_; }
+
+		// Generate and fit ntoys toys of nevents events each, Poisson
+		// fluctuated if the generating pdf is extended. Returns 0 if every toy
+		// was written to output.
+		int Run(unsigned ntoys, double nevents, std::string const& output);
+
+		static unsigned long long ToySeed(unsigned long long seed, unsigned toy);
+};
+
+// Read the output of ToyStudy::Run. Toys are returned in toy order.
+std::vector<ToyResult> ReadToys(std::string const& filename, std::vector<std::string> & parameters);
+
+// Summarise the pull distribution of each parameter of a ToyStudy output,
+// over the toys with a successful minimisation, as a Pull with the mean pull
+// and its RMS in both the b-only and s+b fields
+void PullsFromToys(std::string const& filename, std::vector<ic::Pull> & pullvec, bool verbose);
+
+}
+
+#endif
@@ -2,9 +2,11 @@
 #define ICHiggsTauTau_Module_HTTWeights_h
 
 #include "UserCode/ICHiggsTauTau/interface/TH2DAsymErr.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BTagWeight.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightTable.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTConfig.h"
 #include "PhysicsTools/FWLite/interface/TFileService.h"
 #include "RooWorkspace.h"
@@ -105,12 +107,68 @@ class HTTWeights : public ModuleBase {
   TH1F *ggh_hist_;
   TH1F *ggh_hist_up_;
   TH1F *ggh_hist_down_;
+  WeightTable1D ggh_hist_tab_;
+  WeightTable1D ggh_hist_up_tab_;
+  WeightTable1D ggh_hist_down_tab_;
+  WeightTable2D z_pt_mass_hist_tab_;
+  WeightTable2D mt_idiso_mc_tab_;
+  WeightTable2D mt_idiso_data_tab_;
+  WeightTable2D et_idiso_mc_tab_;
+  WeightTable2D et_idiso_data_tab_;
+  WeightTable2D em_e_idiso_mc_tab_;
+  WeightTable2D em_e_idiso_data_tab_;
+  WeightTable2D em_m_idiso_mc_tab_;
+  WeightTable2D em_m_idiso_data_tab_;
+  WeightTable2D em_m17_trig_mc_tab_;
+  WeightTable2D em_m17_trig_data_tab_;
+  WeightTable2D em_m8_trig_mc_tab_;
+  WeightTable2D em_m8_trig_data_tab_;
+  WeightTable2D em_e17_trig_mc_tab_;
+  WeightTable2D em_e17_trig_data_tab_;
+  WeightTable2D em_e12_trig_mc_tab_;
+  WeightTable2D em_e12_trig_data_tab_;
+  WeightTable2D et_trig_mc_tab_;
+  WeightTable2D et_trig_data_tab_;
+  WeightTable2D et_antiiso1_trig_data_tab_;
+  WeightTable2D et_antiiso2_trig_data_tab_;
+  WeightTable2D et_xtrig_mc_tab_;
+  WeightTable2D et_xtrig_data_tab_;
+  WeightTable2D et_conditional_mc_tab_;
+  WeightTable2D et_conditional_data_tab_;
+  WeightTable2D mt_trig_mc_tab_;
+  WeightTable2D mt_trig_data_tab_;
+  WeightTable2D mt_antiiso1_trig_data_tab_;
+  WeightTable2D mt_antiiso2_trig_data_tab_;
+  WeightTable2D mt_xtrig_mc_tab_;
+  WeightTable2D mt_xtrig_data_tab_;
+  WeightTable2D mt_conditional_mc_tab_;
+  WeightTable2D mt_conditional_data_tab_;
+  WeightTable2D em_qcd_cr1_lt2_tab_;
+  WeightTable2D em_qcd_cr1_2to4_tab_;
+  WeightTable2D em_qcd_cr1_gt4_tab_;
+  WeightTable2D em_qcd_cr2_lt2_tab_;
+  WeightTable2D em_qcd_cr2_2to4_tab_;
+  WeightTable2D em_qcd_cr2_gt4_tab_;
   std::shared_ptr<RooWorkspace> w_;
   mithep::TH2DAsymErr* MuonFakeRateHist_PtEta;
   mithep::TH2DAsymErr* ElectronFakeRateHist_PtEta;
   BTagWeight btag_weight;
   TF1 *tau_fake_weights_;
   std::map<std::string, std::shared_ptr<RooFunctor>> fns_;
+  EventInfo::WeightSlot slot_ggh_;
+  EventInfo::WeightSlot slot_topquark_weight_;
+  EventInfo::WeightSlot slot_tau_fake_weight_;
+  EventInfo::WeightSlot slot_wt_tau_id_sf_;
+  EventInfo::WeightSlot slot_jeteta_weight_;
+  EventInfo::WeightSlot slot_wt_zpt_;
+  EventInfo::WeightSlot slot_wt_tracking_eff_;
+  EventInfo::WeightSlot slot_lepton_;
+  EventInfo::WeightSlot slot_tt_muon_weight_;
+  EventInfo::WeightSlot slot_emu_e_fakerate_;
+  EventInfo::WeightSlot slot_emu_m_fakerate_;
+  EventInfo::WeightSlot slot_etau_fakerate_;
+  EventInfo::WeightSlot slot_mtau_fakerate_;
+  EventInfo::WeightSlot slot_tau_mode_scale_;
 
 
 
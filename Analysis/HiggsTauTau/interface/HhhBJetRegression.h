@@ -4,14 +4,12 @@
 // #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
 #include <string>
-
-namespace TMVA {
-	class Reader;
-}
+#include <vector>
 
 namespace ic {
 
 class TreeEvent;
+class BDTForest;
 
 class HhhBJetRegression : public ModuleBase {
  private:
@@ -19,17 +17,11 @@ class HhhBJetRegression : public ModuleBase {
  	CLASS_MEMBER(HhhBJetRegression, std::string, jets_label)
  	CLASS_MEMBER(HhhBJetRegression, std::string, regression_mva_file)
 
- 	TMVA::Reader *regression_reader_;
-
- 	float prebjet_bcsv;
- 	float prebjet_pt;
- 	float prebjet_eta;
- 	float prebjet_chf;
- 	float prebjet_phf;
- 	float prebjet_nhf;
- 	float prebjet_elf;
- 	float prebjet_muf;
- 	float prebjet_genPt;
+ 	BDTForest *regression_forest_;
+
+  // The inputs for all of the jets in an event, one jet after the other
+  std::vector<float> features_;
+  std::vector<double> scale_factors_;
 
  public:
   HhhBJetRegression(std::string const& name);
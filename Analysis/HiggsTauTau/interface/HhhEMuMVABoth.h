@@ -5,13 +5,10 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
 #include <string>
 
-namespace TMVA {
-	class Reader;
-}
-
 namespace ic {
 
 class TreeEvent;
+class BDTForest;
 
 class HhhEMuMVABoth : public ModuleBase {
  private:
@@ -23,9 +20,8 @@ class HhhEMuMVABoth : public ModuleBase {
   CLASS_MEMBER(HhhEMuMVABoth, std::string, gf_mva_file_bdtg)
 	CLASS_MEMBER(HhhEMuMVABoth, std::string, mva_input_data)
 
- 	TMVA::Reader *gf_reader_bdt_;
-	TMVA::Reader *gf_reader_bdtg_;
-  // TMVA::Reader *vbf_reader_;
+ 	BDTForest *gf_forest_bdt_;
+	BDTForest *gf_forest_bdtg_;
 
   float fpzeta_;
  	float fpzetamiss_;
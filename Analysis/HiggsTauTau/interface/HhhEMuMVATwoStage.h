@@ -5,13 +5,10 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
 #include <string>
 
-namespace TMVA {
-	class Reader;
-}
-
 namespace ic {
 
 class TreeEvent;
+class BDTForest;
 
 class HhhEMuMVATwoStage : public ModuleBase {
  private:
@@ -22,9 +19,8 @@ class HhhEMuMVATwoStage : public ModuleBase {
  	CLASS_MEMBER(HhhEMuMVATwoStage, std::string, gf_mva_file)
   CLASS_MEMBER(HhhEMuMVATwoStage, std::string, gf_mva_file_2)
 
- 	TMVA::Reader *gf_reader_;
-	TMVA::Reader *gf_reader_2_;
-  // TMVA::Reader *vbf_reader_;
+ 	BDTForest *gf_forest_;
+	BDTForest *gf_forest_2_;
 
  	float fpzeta_;
  	float fpzetamiss_;
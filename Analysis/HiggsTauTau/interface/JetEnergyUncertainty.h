@@ -3,8 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
-#include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
-#include "CondFormats/JetMETObjects/interface/JetCorrectionUncertainty.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/JetCorrectionTables.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTConfig.h"
 #include <string>
 #include "boost/bind.hpp"
@@ -19,8 +18,12 @@ class JetEnergyUncertainty : public ModuleBase {
   CLASS_MEMBER(JetEnergyUncertainty, std::string, input_label)
   CLASS_MEMBER(JetEnergyUncertainty, std::string, uncert_file)
   CLASS_MEMBER(JetEnergyUncertainty, std::string, uncert_set)
-  JetCorrectionUncertainty *uncert_;
-  JetCorrectorParameters *params_;
+  // If set, every source in uncert_file is evaluated for every jet and added
+  // to the event as "<sources_label>_up" and "<sources_label>_down", each a
+  // std::vector<std::vector<double>> indexed by [source][jet]
+  CLASS_MEMBER(JetEnergyUncertainty, std::string, sources_label)
+  JetUncertaintySource uncert_;
+  JetUncertaintySources all_uncerts_;
 
  public:
   JetEnergyUncertainty(std::string const& name);
@@ -35,6 +38,8 @@ class JetEnergyUncertainty : public ModuleBase {
 template <class T>
 JetEnergyUncertainty<T>::JetEnergyUncertainty(std::string const& name) : ModuleBase(name) {
   input_label_ = "pfJetsPFlow";
+  jes_shift_mode_ = 0;
+  sources_label_ = "";
 }
 
 template <class T>
@@ -52,24 +57,33 @@ int JetEnergyUncertainty<T>::PreAnalysis() {
   std::cout << boost::format(param_fmt()) % "jes_shift_mode"      % jes_shift_mode_;
   std::cout << boost::format(param_fmt()) % "uncert_file"         % uncert_file_;
   std::cout << boost::format(param_fmt()) % "uncert_set"          % uncert_set_;
-  params_ = new JetCorrectorParameters(uncert_file_, uncert_set_);
-  uncert_ = new JetCorrectionUncertainty(*params_);
+  if (jes_shift_mode_ > 0) {
+    uncert_ = JetUncertaintySource(uncert_file_, uncert_set_);
+  }
+  if (sources_label_ != "") {
+    all_uncerts_ = JetUncertaintySources(uncert_file_);
+    std::cout << boost::format(param_fmt()) % "sources_label"       % sources_label_;
+    std::cout << boost::format(param_fmt()) % "n_sources"           % all_uncerts_.size();
+  }
   return 0;
 }
 
 template <class T>
 int JetEnergyUncertainty<T>::Execute(TreeEvent *event) {
   std::vector<T *> & vec = event->GetPtrVec<T>(input_label_);
+  if (sources_label_ != "") {
+    event->Add(sources_label_ + "_up", all_uncerts_.Evaluate(vec, true));
+    event->Add(sources_label_ + "_down", all_uncerts_.Evaluate(vec, false));
+  }
+  if (jes_shift_mode_ == 0) return 0;
   for (unsigned i = 0; i < vec.size(); ++i) {
     if (fabs(vec[i]->eta()) > 5.0) continue;
-    uncert_->setJetPt(vec[i]->pt());
-    uncert_->setJetEta(vec[i]->eta());
     if (jes_shift_mode_ == 1) {
-      double shift = uncert_->getUncertainty(false); //down
+      double shift = uncert_.Uncertainty(vec[i]->eta(), vec[i]->pt(), false); //down
       vec[i]->set_vector(vec[i]->vector() * (1.0-shift));
     }
     if (jes_shift_mode_ == 2) {
-      double shift = uncert_->getUncertainty(true); //up
+      double shift = uncert_.Uncertainty(vec[i]->eta(), vec[i]->pt(), true); //up
       vec[i]->set_vector(vec[i]->vector() * (1.0+shift));
     }
   }
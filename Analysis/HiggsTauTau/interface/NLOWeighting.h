@@ -17,6 +17,7 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
 #include "PhysicsTools/FWLite/interface/TFileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightVector.h"
 
 namespace nloweights {
 
@@ -25,6 +26,8 @@ extern std::vector<int> marray;
 
 void ReadFile();
 float returnNLOweight(Int_t mass, Int_t tanb, Double_t pt);
+// Returns the graph for a mass/tan(beta) point, or nullptr if out of range
+TGraphErrors* findNLOweight(Int_t mass, Int_t tanb);
 }
 
 
@@ -34,9 +37,15 @@ class NLOWeighting : public ModuleBase {
  private:
   std::string jets_label_;
   CLASS_MEMBER(NLOWeighting, fwlite::TFileService*, fs)
+  // Optional extra (mass, tan(beta)) points, paired by index, evaluated in
+  // the same pass and added to the event as the WeightVector "mssm_nlo_wts"
+  CLASS_MEMBER(NLOWeighting, std::vector<int>, var_masses)
+  CLASS_MEMBER(NLOWeighting, std::vector<int>, var_tanbs)
   TTree *tout;
   double nlo_wt_ = 0.0;
   double nlo_pt_ = 0.0;
+  std::vector<TGraphErrors*> var_funcs_;
+  WeightVector var_wts_;
 
  public:
   NLOWeighting(std::string const& name);
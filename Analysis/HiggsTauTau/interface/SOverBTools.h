@@ -1,17 +1,107 @@
 #ifndef ICHiggsTauTau_HiggsTauTau_SOverBTools_h
 #define ICHiggsTauTau_HiggsTauTau_SOverBTools_h
+#include <vector>
 #include "TH1.h"
+#include "TH2.h"
 
 namespace ch {
+
+enum class SignificanceMetric { s_over_b, s_over_root_b, asimov_z };
+
+// s/b, s/sqrt(b) or the Asimov significance sqrt(2((s+b)ln(1+s/b)-s)), or
+// zero if b is not positive
+double Significance(double s, double b, SignificanceMetric metric);
+
+// Running sum of the in-range bins of a histogram, taking the contents to
+// be spread uniformly over each bin. After the O(bins) set-up an integral
+// between any two points costs a binary search over the edges.
+class HistIntegrator {
+ public:
+  explicit HistIntegrator(TH1 const* hist);
+
+  // As IntegrateFloatRange for limits on the axis. The underflow and
+  // overflow are never included.
+  double Integral(double xmin, double xmax) const;
+  // Integral from the low edge of the axis up to x
+  double Cumulative(double x) const;
+  inline double Total() const { return sums_.back(); }
+  inline std::vector<double> const& edges() const { return edges_; }
+  // sums()[i] is the sum of the bins below edges()[i]
+  inline std::vector<double> const& sums() const { return sums_; }
+
+ private:
+  std::vector<double> edges_;
+  std::vector<double> sums_;
+};
+
 struct SOverBInfo {
   double s;
   double b;
   double x_lo;
   double x_hi;
   SOverBInfo() { ; }
+  // The window between the points, on a grid of steps, that leave (1-frac)/2
+  // of the signal above and below
   SOverBInfo(TH1F const* sig, TH1F const* bkg, unsigned steps, double frac);
+  SOverBInfo(HistIntegrator const& sig, HistIntegrator const& bkg,
+             unsigned steps, double frac);
+  inline double Significance(SignificanceMetric metric) const {
+    return ch::Significance(s, b, metric);
+  }
+};
+
+// The SOverBInfo of each of a set of signals with the same background
+std::vector<SOverBInfo> SOverBInfos(std::vector<TH1F const*> const& sigs,
+                                    TH1F const* bkg, unsigned steps,
+                                    double frac);
+
+// Of the windows between bin edges that are the narrowest to contain at
+// least frac of the signal for their lower edge, the one with the highest
+// metric. All of these are found in a single pass over the edges, assuming
+// the signal has no negative bins.
+SOverBInfo OptimalWindow(HistIntegrator const& sig, HistIntegrator const& bkg,
+                         double frac, SignificanceMetric metric);
+
+struct SOverBInfo2D {
+  double s;
+  double b;
+  double x_lo;
+  double x_hi;
+  double y_lo;
+  double y_hi;
 };
 
+// Summed-area table of the in-range bins of a 2D histogram
+class HistIntegrator2D {
+ public:
+  explicit HistIntegrator2D(TH2 const* hist);
+
+  // Sum of the bins [ix_lo, ix_hi) x [iy_lo, iy_hi), numbered from zero
+  inline double Integral(unsigned ix_lo, unsigned ix_hi, unsigned iy_lo,
+                         unsigned iy_hi) const {
+    return At(ix_hi, iy_hi) - At(ix_lo, iy_hi) - At(ix_hi, iy_lo) +
+           At(ix_lo, iy_lo);
+  }
+  inline double Total() const { return At(nx_, ny_); }
+  inline std::vector<double> const& x_edges() const { return x_edges_; }
+  inline std::vector<double> const& y_edges() const { return y_edges_; }
+
+ private:
+  inline double At(unsigned ix, unsigned iy) const {
+    return sums_[ix * (ny_ + 1) + iy];
+  }
+  unsigned nx_;
+  unsigned ny_;
+  std::vector<double> x_edges_;
+  std::vector<double> y_edges_;
+  std::vector<double> sums_;
+};
+
+// As OptimalWindow for rectangles of bins: for every pair of x edges, the
+// narrowest y windows containing at least frac of the signal are compared
+SOverBInfo2D OptimalWindow2D(TH2 const* sig, TH2 const* bkg, double frac,
+                             SignificanceMetric metric);
+
 double IntegrateFloatRange(TH1F const* hist, double xmin, double xmax);
 }
 
@@ -8,6 +8,7 @@
 #include "Core/interface/TreeEvent.h"
 #include "Core/interface/ModuleBase.h"
 #include "Objects/interface/EventInfo.hh"
+#include "Utilities/interface/WeightVector.h"
 #include "TH1F.h"
 #include "TH2F.h"
 
@@ -19,7 +20,8 @@ namespace ic {
  * Given an existing TH1F creates a TH2F with the same x-binning, and as many
  * y bins as PDF variations. A range of integer PDF indices is also given, and
  * this is used to look-up the relevant event weights from the EventInfo
- * object. At the end of event processing the `PostProcess` method can be
+ * object. The weights can also be extracted once per event into a
+ * WeightVector and shared between several histograms. At the end of event processing the `PostProcess` method can be
  * called to calculate the standard deviation in each histogram. A new 1D
  * histogram is created (`uncert`) with nominal bin content and the std.
  * deviation as the error.
@@ -33,6 +35,7 @@ struct TheorySystHist {
   unsigned end_pdf;
   std::string set_name;
   std::vector<std::string> pdf_strs;
+  WeightVector wts;
 
   TheorySystHist() {;}
 
@@ -43,6 +46,7 @@ struct TheorySystHist {
     for (unsigned i = start_pdf; i <= end_pdf; ++i) {
       pdf_strs.push_back(boost::lexical_cast<std::string>(i));
     }
+    wts = WeightVector(pdf_strs);
     TString base_name = TString(src->GetName()) + "_" + TString(set_name);
     int n = src->GetNbinsX();
     double min = src->GetXaxis()->GetXmin();
@@ -54,11 +58,13 @@ struct TheorySystHist {
   }
 
   void Fill(double val, double wt, EventInfo const* info) {
-    int bin = grid->GetXaxis()->FindBin(val);
-    for (unsigned i = 0; i < pdf_strs.size(); ++i) {
-      double new_wt = wt * info->weight(pdf_strs[i]);
-      grid->SetBinContent(bin, i+1, grid->GetBinContent(bin, i+1) + new_wt);
-    }
+    wts.Fill(info);
+    FillVariations(grid, val, wt, wts);
+  }
+
+  // Use weights already extracted for this event, must follow pdf_strs
+  void Fill(double val, double wt, WeightVector const& ext_wts) {
+    FillVariations(grid, val, wt, ext_wts);
   }
 
   void PostProcessNormal() {
@@ -121,6 +127,8 @@ class TheoryWeights : public ModuleBase {
   TH1F *h_pt_2;
   TH1F *h_eta_1;
   TH1F *h_eta_2;
+  WeightVector pdf_wts;
+  WeightVector scale_wts;
   CLASS_MEMBER(TheoryWeights, fwlite::TFileService*, fs)
 
  public:
@@ -12,6 +12,7 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/SimpleParamParser.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnRootTools.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/th1fmorph.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistMorph.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTConfig.h"
 #include "TPad.h"
 #include "TCanvas.h"
@@ -912,6 +913,8 @@ namespace ic {
       for (unsigned j = 0; j < procs.size(); ++j) {
         TH1F h_low = this->GenerateSignal(names[j]+masses[i], var, sel, cat, wt, fixed_xs).first;
         TH1F h_high = this->GenerateSignal(names[j]+masses[i+1], var, sel, cat, wt, fixed_xs).first;
+        TH1F h_ref = this->GenerateSignal(names[j]+masses[i], var_final, sel, cat, wt, fixed_xs).first;
+        std::vector<double> yields;
         for (unsigned k = 0; k < new_points.size(); ++k) {
           double yield = 1.0;
           double y1 = h_low.Integral();
@@ -921,8 +924,14 @@ namespace ic {
           } else {
             yield = y1 + ((y2 - y1)/(m_high - m_low))*(new_points[k]-m_low);
           }
-          TH1F result = *(th1fmorph("morphed","morphed", &h_low, &h_high, m_low, m_high, new_points[k], yield, 0));
-          TH1F h_ref = this->GenerateSignal(names[j]+masses[i], var_final, sel, cat, wt, fixed_xs).first;
+          yields.push_back(yield);
+        }
+        // Build the cdfs of the pair once and morph to all the new points
+        ic::HistMorph morph(h_low, h_high, m_low, m_high);
+        std::vector<std::vector<double>> morphed = morph.Morph(new_points, yields);
+        for (unsigned k = 0; k < new_points.size(); ++k) {
+          double yield = yields[k];
+          TH1F result = morph.Hist<TH1F>("morphed", morphed[k]);
           result = * ( (TH1F*)result.Rebin(h_ref.GetNbinsX(),"",h_ref.GetXaxis()->GetXbins()->GetArray())  );
           std::string m_str = boost::lexical_cast<std::string>(int(new_points[k]+0.5));
           hmap[procs[j]+infix+m_str+postfix].first = result;
@@ -3,6 +3,7 @@
 #include "UserCode/ICHiggsTauTau/interface/PFJet.hh"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnPredicates.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnPairs.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightVector.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/HHKinFit/include/HHKinFitMaster.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/HHKinFit/include/HHDiJetKinFitMaster.h"
 
@@ -277,6 +278,10 @@ namespace ic {
         outtree_->Branch("wt_nlo_pt",         &wt_nlo_pt_);
         outtree_->Branch("nlo_pt",            &nlo_pt_);
       }
+      wt_vectors_.resize(weight_vectors_.size());
+      for (unsigned i = 0; i < weight_vectors_.size(); ++i) {
+        outtree_->Branch(weight_vectors_[i].c_str(), &wt_vectors_[i]);
+      }
       outtree_->Branch("os",                &os_);
       outtree_->Branch("m_sv",              &m_sv_.var_double);
       outtree_->Branch("mt_sv",             &mt_sv_.var_double);
@@ -1280,6 +1285,12 @@ namespace ic {
     if (event->Exists("wt_em_qcd_down"))    wt_em_qcd_down_ = event->Get<double>("wt_em_qcd_down");
     if(event->Exists("mssm_nlo_wt"))        wt_nlo_pt_ = event->Get<double>("mssm_nlo_wt");
     if(event->Exists("mssm_nlo_pt"))        nlo_pt_ = event->Get<double>("mssm_nlo_pt");
+    for (unsigned i = 0; i < wt_vectors_.size(); ++i) {
+      wt_vectors_[i].clear();
+      if (!event->Exists(weight_vectors_[i])) continue;
+      WeightVector const* wts = event->GetPtr<WeightVector>(weight_vectors_[i]);
+      wt_vectors_[i].assign(wts->values().begin(), wts->values().end());
+    }
 
   
   mc_weight_ = 0.0;
@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -19,8 +19,8 @@ namespace ic {
     met_label_ = "pfMVAMet";
     gf_mva_file_ = "input/vbf_mva/HttEmu_v3.weights.xml";
     // vbf_mva_file_ = "input/vbf_mva/HttEmu_vbf_v1.weights.xml";
-    gf_reader_ = nullptr;
-    // vbf_reader_ = nullptr;
+    gf_forest_ = nullptr;
+    // vbf_forest_ = nullptr;
   }
 
   HTTEMuMVA::~HTTEMuMVA() {
@@ -35,21 +35,9 @@ namespace ic {
     std::cout << boost::format(param_fmt()) % "met_label"       % met_label_;
     std::cout << boost::format(param_fmt()) % "gf_mva_file"     % gf_mva_file_;
     // std::cout << boost::format(param_fmt()) % "vbf_mva_file"    % vbf_mva_file_;
-    gf_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    // vbf_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    std::vector<TMVA::Reader *> readers = {gf_reader_};
-    for (auto & r : readers) {
-      r->AddVariable("pzetavis", &pzetavis_);
-      r->AddVariable("pzetamiss", &pzetamiss_);
-      r->AddVariable("dphi", &dphi_);
-      r->AddVariable("mvamet", &mvamet_);
-      r->AddVariable("mtll", &mt_ll_);
-      r->AddVariable("csv", &csv_);
-      r->AddVariable("d01", &el_dxy_);
-      // r->AddVariable("d02", &mu_dxy_);
-    }
-    // vbf_reader_->BookMVA("BDTG", vbf_mva_file_);
-    gf_reader_->BookMVA("BDTG", gf_mva_file_);
+    gf_forest_ = new BDTForest(gf_mva_file_);
+    // vbf_forest_ = new BDTForest(vbf_mva_file_);
+    gf_forest_->CheckVariables({"pzetavis", "pzetamiss", "dphi", "mvamet", "mtll", "csv", "d01"});
     return 0;
   }
   
@@ -73,14 +61,15 @@ namespace ic {
     }
     el_dxy_ = -1. * dynamic_cast<Electron const*>(ditau->GetCandidate("lepton1"))->dxy_vertex();
     mu_dxy_ = -1. * dynamic_cast<Muon const*>(ditau->GetCandidate("lepton2"))->dxy_vertex();
-    event->Add("em_gf_mva", gf_reader_->EvaluateMVA("BDTG"));
-    // event->Add("em_vbf_mva", vbf_reader_->EvaluateMVA("BDTG"));
+    float const vars[] = {pzetavis_, pzetamiss_, dphi_, mvamet_, mt_ll_, csv_, el_dxy_};
+    event->Add("em_gf_mva", gf_forest_->Evaluate(vars));
+    // event->Add("em_vbf_mva", vbf_forest_->Evaluate(vars));
     return 0;
   }
 
   int HTTEMuMVA::PostAnalysis() {
-    if (gf_reader_) delete gf_reader_;
-    // if (vbf_reader_) delete vbf_reader_;
+    if (gf_forest_) delete gf_forest_;
+    // if (vbf_forest_) delete vbf_forest_;
     return 0;
   }
 
@@ -29,6 +29,7 @@ int HTTGenEvent::PostAnalysis() {
 
 int HTTGenEvent::Execute(TreeEvent *event) {
   auto const& parts = event->GetPtrVec<GenParticle>(genparticle_label_);
+  GenGraph const& graph = GenGraph::Get(event, genparticle_label_);
 
 
   // Consider either an SM (pdgid = 25) or MSSM (25, 35, 36) Higgs boson
@@ -52,15 +53,15 @@ int HTTGenEvent::Execute(TreeEvent *event) {
   unsigned htt_decays = 0;
   for (unsigned i = 0; i < higgs_list.size(); ++i) {
     gen_event.boson = higgs_list[i];
-    auto daughters = ic::ExtractDaughters(gen_event.boson, parts);
+    auto daughters = graph.ExtractDaughters(gen_event.boson);
     // Sanity test - should only find two daughter particles
     if (daughters.size() == 2) {
       // Both daughters should be taus
       if (std::abs(daughters[0]->pdgid()) == 15 &&
           std::abs(daughters[1]->pdgid()) == 15) {
         ++htt_decays;
-        gen_event.tau_0 = BuildTauInfo(daughters[0], parts, is_pythia8_);
-        gen_event.tau_1 = BuildTauInfo(daughters[1], parts, is_pythia8_);
+        gen_event.tau_0 = BuildTauInfo(daughters[0], graph, is_pythia8_);
+        gen_event.tau_1 = BuildTauInfo(daughters[1], graph, is_pythia8_);
       }
     }
   }
@@ -80,8 +81,8 @@ int HTTGenEvent::Execute(TreeEvent *event) {
         p->status() == 3 && std::abs(p->pdgid()) == 15);
     });
     if (list.size() == 2) {
-      gen_event.tau_0 = BuildTauInfo(list[0], parts, is_pythia8_);
-      gen_event.tau_1 = BuildTauInfo(list[1], parts, is_pythia8_);
+      gen_event.tau_0 = BuildTauInfo(list[0], graph, is_pythia8_);
+      gen_event.tau_1 = BuildTauInfo(list[1], graph, is_pythia8_);
     }
   }
 
@@ -117,7 +118,7 @@ int HTTGenEvent::Execute(TreeEvent *event) {
 }
 
 GenEvent_Tau HTTGenEvent::BuildTauInfo(
-    GenParticle *tau, std::vector<GenParticle *> const &parts, bool is_pythia8) {
+    GenParticle *tau, GenGraph const &graph, bool is_pythia8) {
   GenEvent_Tau info;
   // We could have been given a status 3 or status 2 tau
   if (tau->status() == 3) {
@@ -126,7 +127,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
     // be just where the tau is copied from the matrix element to tauola for
     // doing the decay)
     info.tau_st3 = tau;
-    auto daughters = ExtractDaughters(tau, parts);
+    auto daughters = graph.ExtractDaughters(tau);
     if (daughters.size() != 1) {
       throw std::runtime_error(
           "[HTTGenEvent::BuildTauInfo] Status 3 tau does not have exactly one "
@@ -160,7 +161,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
   // directly to pions
   // if (is_pythia8) extracted_fsr = true;
   // Start by getting a list of daughters
-  auto fsr_scan = ExtractDaughters(info.tau_st2_pre_fsr, parts);
+  auto fsr_scan = graph.ExtractDaughters(info.tau_st2_pre_fsr);
   if (!is_pythia8) {
     while (!extracted_fsr) {
       bool has_fsr = false;
@@ -175,7 +176,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
         }
       }
       if (has_fsr) {
-        fsr_scan = ExtractDaughters(tau_st2_post_fsr, parts);
+        fsr_scan = graph.ExtractDaughters(tau_st2_post_fsr);
       } else {
         extracted_fsr = true;
       }
@@ -196,7 +197,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
             info.fsr.push_back(t);
           }
         }
-        fsr_scan = ExtractDaughters(tau_st2_post_fsr, parts);
+        fsr_scan = graph.ExtractDaughters(tau_st2_post_fsr);
       } else {
         extracted_fsr = true;
       }
@@ -204,10 +205,10 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
   }
   info.tau_st2_post_fsr = tau_st2_post_fsr;
 
-  info.all_vis = ExtractStableDaughters(tau_st2_post_fsr, parts);
+  info.all_vis = graph.ExtractStableDaughters(tau_st2_post_fsr);
 
   // Now get the daughters of the actual tau decay
-  auto post_fsr_dts = ExtractDaughters(tau_st2_post_fsr, parts);
+  auto post_fsr_dts = graph.ExtractDaughters(tau_st2_post_fsr);
   for (auto const& t : post_fsr_dts) {
     // Should always find a neutrino
     if (std::abs(t->pdgid()) == 16) info.tau_nu = t;
@@ -258,7 +259,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
   // eta 221 (unstable)
   // photon 22 (stable)
   if (info.had) {
-    auto had_decay = ExtractDaughters(info.had, parts);
+    auto had_decay = graph.ExtractDaughters(info.had);
     if (is_pythia8) {
       ic::erase_if(had_decay, [](GenParticle *p) {
         return std::abs(p->pdgid()) == 16;
@@ -279,7 +280,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
         // the fsr?
         info.fsr.push_back(t);
       } else if (t->pdgid() == 221) {
-        auto eta_decay = ExtractDaughters(t, parts);
+        auto eta_decay = graph.ExtractDaughters(t);
         if (eta_decay.size() == 2 &&
             eta_decay[0]->pdgid() == 22 &&
             eta_decay[1]->pdgid() == 22) {
@@ -288,7 +289,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
           info.other_neutral.push_back(t);
         }
       } else if (std::abs(t->pdgid()) == 311) {  // K0
-        auto t_daughters = ExtractDaughters(t, parts);
+        auto t_daughters = graph.ExtractDaughters(t);
         for (auto const& t_d : t_daughters) {
           if (t_d->pdgid() == 130 || t_d->pdgid() == 310) {
             info.other_neutral.push_back(t_d);
@@ -298,7 +299,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
           }
         }
       } else if (t->pdgid() == 223) {
-        auto t_daughters = ExtractDaughters(t, parts);
+        auto t_daughters = graph.ExtractDaughters(t);
         for (auto const& t_d : t_daughters) {
           if (std::abs(t_d->pdgid()) == 211) {
             info.pi_charged.push_back(t_d);
@@ -312,7 +313,7 @@ GenEvent_Tau HTTGenEvent::BuildTauInfo(
       }else {
         std::cout << "Odd had decay:\n";
         t->Print();
-        auto t_daughters = ExtractDaughters(t, parts);
+        auto t_daughters = graph.ExtractDaughters(t);
         for (auto const& t_d : t_daughters) {
             t_d->Print();
         }
@@ -45,7 +45,7 @@ int HTTMuonEfficiency::Execute(TreeEvent* event) {
     std::vector<GenParticle *> tau_decay_sel_particles;
     std::vector<GenParticle *> had_sel_particles;
     for (unsigned i=0; i < particles.size(); ++i){
-      std::vector<bool> status_flags = particles[i]->statusFlags();
+      std::vector<bool> const& status_flags = particles[i]->statusFlags();
       if ( ((abs(particles[i]->pdgid()) == 11 && status_flags[IsPrompt])||(abs(particles[i]->pdgid()) == 13 && status_flags[IsPrompt] && particles[i]->status()==1)) && particles[i]->pt() > 8. ){
         prompt_sel_particles.push_back(particles[i]);
       }
@@ -58,7 +58,7 @@ int HTTMuonEfficiency::Execute(TreeEvent* event) {
     }
 
     
-    std::vector<GenJet> gen_taus = BuildTauJets(particles, false,true);
+    std::vector<GenJet> gen_taus = BuildTauJets(GenGraph::Get(event), false, true);
     std::vector<GenJet *> gen_taus_ptr;
     for (auto & x : gen_taus) gen_taus_ptr.push_back(&x);
     ic::erase_if(gen_taus_ptr, !boost::bind(MinPtMaxEta, _1, 15.0, 999.));
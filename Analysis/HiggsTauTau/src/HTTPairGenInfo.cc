@@ -49,14 +49,14 @@ namespace ic {
     std::vector<GenParticle *> const& particles = event->GetPtrVec<GenParticle>("genParticles");
     std::vector<GenParticle *> sel_particles;
     for (unsigned i=0; i < particles.size(); ++i){
-      std::vector<bool> status_flags_start = particles[i]->statusFlags();
+      std::vector<bool> const& status_flags_start = particles[i]->statusFlags();
       if ( ((abs(particles[i]->pdgid()) == 11 )||(abs(particles[i]->pdgid()) == 13 /*&& particles[i]->status()==1*/)) && particles[i]->pt() > 8. && (status_flags_start[IsPrompt] || status_flags_start[IsDirectPromptTauDecayProduct] /*|| status_flags_start[IsDirectHadronDecayProduct]*/)){
         sel_particles.push_back(particles[i]);
       }
     }
 
     
-    std::vector<GenJet> gen_taus = BuildTauJets(particles, false,true);
+    std::vector<GenJet> gen_taus = BuildTauJets(GenGraph::Get(event), false, true);
     std::vector<GenJet *> gen_taus_ptr;
     for (auto & x : gen_taus) gen_taus_ptr.push_back(&x);
     ic::erase_if(gen_taus_ptr, !boost::bind(MinPtMaxEta, _1, 15.0, 999.));
@@ -360,8 +360,8 @@ namespace ic {
         if (faked_tau_selector_ == 2 && matches.size() > 0) return 1;
       }
       if (hadronic_tau_selector_ > 0 && channel_ != channel::em) {
-        std::vector<GenParticle *> const& particles = event->GetPtrVec<GenParticle>(gen_taus_label_);
-        std::vector<GenJet> gen_taus = BuildTauJets(particles, false,false);
+        std::vector<GenJet> gen_taus =
+            BuildTauJets(GenGraph::Get(event, gen_taus_label_), false, false);
         std::vector<GenJet *> gen_taus_ptr;
         for (auto & x : gen_taus) gen_taus_ptr.push_back(&x);
         ic::erase_if(gen_taus_ptr, !boost::bind(MinPtMaxEta, _1, 18.0, 999.));
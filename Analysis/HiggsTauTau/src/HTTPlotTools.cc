@@ -548,9 +548,7 @@ namespace ic {
     
       ch::SOverBInfo Weights = ch::SOverBInfo(signal, background, 3500, 0.682);
     
-      double s = Weights.s;
-      double b = Weights.b;
-      double AMS = TMath::Sqrt2()*TMath::Sqrt((s+b)*TMath::Log(1+s/b)-s);
+      double AMS = Weights.Significance(ch::SignificanceMetric::asimov_z);
     
       if(supress_output_){
         std::ofstream outfile;
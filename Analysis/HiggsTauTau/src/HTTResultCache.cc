@@ -0,0 +1,105 @@
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTResultCache.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "boost/filesystem.hpp"
+#include "boost/lexical_cast.hpp"
+
+namespace ic {
+
+  HTTResultCache::HTTResultCache() : dirty_(false), hits_(0), misses_(0) {}
+
+  std::string HTTResultCache::FileIdentity(std::string const& file) {
+    boost::system::error_code ec;
+    boost::filesystem::path p = boost::filesystem::canonical(file, ec);
+    if (ec) return "";
+    uintmax_t size = boost::filesystem::file_size(p, ec);
+    if (ec) return "";
+    std::time_t mtime = boost::filesystem::last_write_time(p, ec);
+    if (ec) return "";
+    return p.string() + ":" + boost::lexical_cast<std::string>(size) + ":" +
+           boost::lexical_cast<std::string>(mtime);
+  }
+
+  std::string HTTResultCache::Hash(std::string const& str) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : str) {
+      h ^= c;
+      h *= 1099511628211ULL;
+    }
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << h;
+    return os.str();
+  }
+
+  bool HTTResultCache::GetRate(std::string const& key, Value & result) const {
+    auto it = rates_.find(Hash(key));
+    if (it == rates_.end()) {
+      ++misses_;
+      return false;
+    }
+    ++hits_;
+    result = it->second;
+    return true;
+  }
+
+  void HTTResultCache::SetRate(std::string const& key, Value const& value) {
+    rates_[Hash(key)] = value;
+    dirty_ = true;
+  }
+
+  TH1F const* HTTResultCache::GetShape(std::string const& key) const {
+    auto it = shapes_.find(Hash(key));
+    if (it == shapes_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    return &(it->second);
+  }
+
+  void HTTResultCache::SetShape(std::string const& key, TH1F const& shape) {
+    bool add_dir = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(false);
+    shapes_[Hash(key)] = shape;
+    TH1::AddDirectory(add_dir);
+  }
+
+  unsigned HTTResultCache::Load(std::string const& file) {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return 0;
+    unsigned n = 0;
+    std::string hash;
+    double val, err;
+    while (in >> hash >> val >> err) {
+      rates_[hash] = std::make_pair(val, err);
+      ++n;
+    }
+    dirty_ = false;
+    return n;
+  }
+
+  void HTTResultCache::Save(std::string const& file) {
+    if (!dirty_) return;
+    // Keep entries another process may have added in the meantime
+    std::ifstream in(file.c_str());
+    std::string hash;
+    double val, err;
+    while (in.good() && in >> hash >> val >> err) {
+      rates_.insert(std::make_pair(hash, std::make_pair(val, err)));
+    }
+    in.close();
+    // Write to a temporary file first so that concurrent readers never see
+    // a partially written cache
+    std::string tmp = file + "." + boost::filesystem::unique_path().string() + ".tmp";
+    std::ofstream out(tmp.c_str());
+    out << std::setprecision(17);
+    for (auto const& it : rates_) {
+      out << it.first << " " << it.second.first << " " << it.second.second << "\n";
+    }
+    out.close();
+    boost::filesystem::rename(tmp, file);
+    dirty_ = false;
+  }
+
+}
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <stdexcept>
 #include "boost/lexical_cast.hpp"
 #include "boost/algorithm/string.hpp"
 #include "boost/format.hpp"
@@ -20,6 +22,7 @@
 #include "TEntryList.h"
 #include "TMath.h"
 #include "TH1.h"
+#include "TH2F.h"
 #include "TLegend.h"
 #include "RooDataHist.h"
 #include "RooHistPdf.h"
@@ -32,6 +35,9 @@ namespace ic {
   HTTRun2Analysis::HTTRun2Analysis(ic::channel ch, std::string year, int verbosity, bool is_sm) : ch_(ch), year_(year), verbosity_(verbosity), is_sm_(is_sm) {
     lumi_ = 1.;
     do_ss_ = false;
+    use_cache_ = true;
+    n_threads_ = 0;
+    entries_per_task_ = 500000;
     qcd_os_ss_factor_ = 1.06;
     /*if(ch_ == channel::et){
       w_os_ss_factor_ = 4.09;
@@ -920,10 +926,25 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
       tmp_tree->SetEstimate(100000);
       tfiles_[label] = tmp_file;
       ttrees_[label] = tmp_tree;
+      file_ids_[label] = HTTResultCache::FileIdentity(input_filename);
+      file_names_[label] = input_filename;
     }
     for (auto str : result_summary) std::cout << str;
   }
 
+  void HTTRun2Analysis::SetCacheFile(std::string const& file) {
+    cache_file_ = file;
+    unsigned n = cache_.Load(cache_file_);
+    std::cout << "[HTTRun2Analysis::SetCacheFile] Loaded " << n << " cached rates from " << cache_file_ << std::endl;
+  }
+
+  void HTTRun2Analysis::SaveCache() {
+    if (verbosity_ > 0) {
+      std::cout << "[HTTRun2Analysis::SaveCache] Cache hits: " << cache_.hits() << ", misses: " << cache_.misses() << std::endl;
+    }
+    if (cache_file_ != "") cache_.Save(cache_file_);
+  }
+
   double HTTRun2Analysis::GetLumiScale(std::string const& sample) {
     auto it = sample_info_.find(sample);
     if (it != sample_info_.end()) {
@@ -1309,6 +1330,20 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
     return std::make_pair(signal_shape, signal_norm);
   }
 
+  std::vector<HTTRun2Analysis::HistValuePair> HTTRun2Analysis::GenerateSignalVariations(std::string sample, std::string var, std::string sel, std::string cat, std::string wt, std::string wt_vector, unsigned n_wts, double xs) {
+    cat += "&&" + alias_map_["baseline"];
+    double sf = xs > 0 ? this->GetLumiScaleFixedXS(sample, xs) : GetLumiScale(sample);
+    // Each shape already carries the full rate, including under/overflow, so
+    // no separate GetRate call is needed per variation
+    std::vector<HistValuePair> result;
+    for (TH1F & shape : this->GetShapes(var, sample, sel, cat, wt, wt_vector, n_wts)) {
+      Value signal_norm = std::make_pair(Integral(&shape) * sf, Error(&shape) * sf);
+      SetNorm(&shape, signal_norm.first);
+      result.push_back(std::make_pair(shape, signal_norm));
+    }
+    return result;
+  }
+
   void HTTRun2Analysis::FillSMSignal(HistValueMap & hmap, 
                     std::vector<std::string> const& masses,
                     std::string const& var,
@@ -1554,6 +1589,82 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
     return full_variable;
   }
 
+  void HTTRun2Analysis::Prefetch(std::string const& variable,
+                                 std::vector<std::string> const& samples,
+                                 std::string const& selection,
+                                 std::string const& category,
+                                 std::string const& weight) {
+    if (n_threads_ == 0 || !use_cache_) return;
+    std::string full_selection = BuildCutString(selection, category, weight);
+    // Shapes are only drawn here if the binning is given explicitly, so that
+    // the partial histograms can be added. The cache keys must match the
+    // ones built in GetShape and GetRate.
+    std::string expression;
+    std::string key_variable;
+    TH1F shape_binning;
+    bool do_shapes = variable != "" && ParseBinnedVariable(variable, expression, shape_binning);
+    // The key keeps the [...] bin edges, so that requests for the same
+    // expression with different binnings get their own entries
+    if (do_shapes) key_variable = BuildVarString(variable);
+    // Same as the "0.5>>htemp(1,0,1)" drawn in GetRate
+    std::string rate_expression;
+    TH1F rate_binning;
+    ParseBinnedVariable("0.5(1,0,1)", rate_expression, rate_binning);
+
+    std::vector<TreeDrawJob> jobs;
+    std::vector<std::string> job_keys;
+    std::vector<bool> job_is_shape;
+    std::vector<std::pair<std::string, std::string>> shapes_to_norm;
+    for (auto const& sample : samples) {
+      if (!ttrees_.count(sample) || file_ids_[sample] == "") continue;
+      long long entries = ttrees_[sample]->GetEntries();
+      if (entries == 0) continue;
+      std::string rate_key = file_ids_[sample] + "|rate|" + full_selection;
+      std::string shape_key = file_ids_[sample] + "|shape|" + key_variable + "|" + full_selection;
+      TreeDrawJob job;
+      job.file = file_names_[sample];
+      job.tree = "ntuple";
+      job.selection = full_selection;
+      job.entries = entries;
+      Value rate;
+      if (!cache_.GetRate(rate_key, rate) &&
+          std::find(job_keys.begin(), job_keys.end(), rate_key) == job_keys.end()) {
+        job.expression = rate_expression;
+        job.binning = rate_binning;
+        jobs.push_back(job);
+        job_keys.push_back(rate_key);
+        job_is_shape.push_back(false);
+      }
+      if (do_shapes && !cache_.GetShape(shape_key) &&
+          std::find(job_keys.begin(), job_keys.end(), shape_key) == job_keys.end()) {
+        job.expression = expression;
+        job.binning = shape_binning;
+        jobs.push_back(job);
+        job_keys.push_back(shape_key);
+        job_is_shape.push_back(true);
+        shapes_to_norm.push_back(std::make_pair(shape_key, rate_key));
+      }
+    }
+    if (jobs.size() == 0) return;
+    if (verbosity_ > 1) {
+      std::cout << "[HTTRun2Analysis::Prefetch] " << jobs.size() << " draws on "
+                << n_threads_ << " threads" << std::endl;
+    }
+    std::vector<TH1F> hists = DrawTrees(TaskExecutor(n_threads_), jobs, entries_per_task_);
+    for (unsigned i = 0; i < jobs.size(); ++i) {
+      if (!job_is_shape[i]) {
+        cache_.SetRate(job_keys[i], std::make_pair(Integral(&hists[i]), Error(&hists[i])));
+      }
+    }
+    for (unsigned i = 0, j = 0; i < jobs.size(); ++i) {
+      if (!job_is_shape[i]) continue;
+      Value rate;
+      cache_.GetRate(shapes_to_norm[j++].second, rate);
+      SetNorm(&hists[i], rate.first);
+      cache_.SetShape(job_keys[i], hists[i]);
+    }
+  }
+
 
   TH1F HTTRun2Analysis::GetShape(std::string const& variable,
                                        std::string const& sample, 
@@ -1561,6 +1672,7 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
                                        std::string const& category, 
                                        std::string const& weight) {
     TH1::SetDefaultSumw2(true);
+    Prefetch(variable, {sample}, selection, category, weight);
     std::string full_variable = BuildVarString(variable);
     std::size_t begin_var = full_variable.find("[");
     std::size_t end_var   = full_variable.find("]");
@@ -1596,6 +1708,17 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
       }
       return (*htemp);
     }
+    // Built from the variable before the [...] binning was cut off, as in
+    // Prefetch
+    std::string cache_key = file_ids_[sample] + "|shape|" + BuildVarString(variable) + "|" + full_selection;
+    if (use_cache_ && file_ids_[sample] != "") {
+      TH1F const* cached = cache_.GetShape(cache_key);
+      if (cached) {
+        if (htemp) gDirectory->Delete("htemp;*");
+        TH1::AddDirectory(false);
+        return *cached;
+      }
+    }
     ttrees_[sample]->Draw(full_variable.c_str(), full_selection.c_str(), "goff");
     TH1::AddDirectory(false);
     htemp = (TH1F*)gDirectory->Get("htemp");
@@ -1604,6 +1727,7 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
     auto rate = GetRate(sample, selection, category, weight);
     SetNorm(&result, rate.first);
     if(result.Integral(1,result.GetNbinsX()) == 0) std::cout<<"Warning - no shape for sample "<<sample<<std::endl;
+    if (use_cache_ && file_ids_[sample] != "") cache_.SetShape(cache_key, result);
     return result;
   }
 
@@ -1612,7 +1736,7 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
                                        std::string const& selection, 
                                        std::string const& category, 
                                        std::string const& weight) {
-
+    Prefetch(variable, samples, selection, category, weight);
     TH1F result = GetShape(variable, samples.at(0), selection, category, weight);
     if (samples.size() > 1) {
       for (unsigned i = 1; i < samples.size(); ++i) {
@@ -1624,6 +1748,85 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
   }
 
 
+  std::vector<TH1F> HTTRun2Analysis::GetShapes(std::string const& variable,
+                                       std::string const& sample,
+                                       std::string const& selection,
+                                       std::string const& category,
+                                       std::string const& weight,
+                                       std::string const& wt_vector,
+                                       unsigned n_wts) {
+    TH1::SetDefaultSumw2(true);
+    // Work out the x-axis binning from either the [] or () syntax
+    std::string full_variable = variable;
+    std::vector<double> bin_vec;
+    bool fixed_bins = false;
+    std::size_t begin_var = full_variable.find("[");
+    std::size_t end_var   = full_variable.find("]");
+    if (begin_var == full_variable.npos || end_var == full_variable.npos) {
+      begin_var = full_variable.find_last_of("(");
+      end_var   = full_variable.find_last_of(")");
+      fixed_bins = true;
+    }
+    if (begin_var == full_variable.npos || end_var == full_variable.npos) {
+      throw std::runtime_error("[HTTRun2Analysis::GetShapes] Variable " +
+                               variable + " has no binning");
+    }
+    std::string binning = full_variable.substr(begin_var+1, end_var-begin_var-1);
+    std::vector<std::string> string_vec;
+    boost::split(string_vec, binning, boost::is_any_of(","));
+    for (auto str : string_vec) bin_vec.push_back(boost::lexical_cast<double>(str));
+    full_variable.erase(begin_var, full_variable.npos);
+    TH1::AddDirectory(true);
+    TH2F *hgrid = nullptr;
+    if (fixed_bins) {
+      hgrid = new TH2F("hgrid", "hgrid", int(bin_vec[0]), bin_vec[1], bin_vec[2],
+                       n_wts, -0.5, double(n_wts) - 0.5);
+    } else {
+      hgrid = new TH2F("hgrid", "hgrid", bin_vec.size()-1, &(bin_vec[0]),
+                       n_wts, -0.5, double(n_wts) - 0.5);
+    }
+    // Iteration$ runs over the entries of the weight vector, and since it
+    // appears in the selection the scalar variable is repeated for each one
+    if (ttrees_[sample]->GetEntries() > 0) {
+      std::string full_selection = BuildCutString(selection, category,
+          weight == "" ? wt_vector : "(" + weight + ")*" + wt_vector);
+      ttrees_[sample]->Draw(("Iteration$:" + full_variable + ">>hgrid").c_str(),
+          full_selection.c_str(), "goff");
+    }
+    TH1::AddDirectory(false);
+    std::vector<TH1F> result;
+    int nx = hgrid->GetNbinsX();
+    for (unsigned i = 0; i < n_wts; ++i) {
+      TH1F hist = fixed_bins
+          ? TH1F("htemp", "htemp", nx, bin_vec[1], bin_vec[2])
+          : TH1F("htemp", "htemp", nx, &(bin_vec[0]));
+      for (int j = 0; j <= nx + 1; ++j) {
+        hist.SetBinContent(j, hgrid->GetBinContent(j, i+1));
+        hist.SetBinError(j, hgrid->GetBinError(j, i+1));
+      }
+      result.push_back(hist);
+    }
+    gDirectory->Delete("hgrid;*");
+    return result;
+  }
+
+  std::vector<TH1F> HTTRun2Analysis::GetShapes(std::string const& variable,
+                                       std::vector<std::string> const& samples,
+                                       std::string const& selection,
+                                       std::string const& category,
+                                       std::string const& weight,
+                                       std::string const& wt_vector,
+                                       unsigned n_wts) {
+    std::vector<TH1F> result = GetShapes(variable, samples.at(0), selection,
+                                         category, weight, wt_vector, n_wts);
+    for (unsigned i = 1; i < samples.size(); ++i) {
+      std::vector<TH1F> tmp = GetShapes(variable, samples.at(i), selection,
+                                        category, weight, wt_vector, n_wts);
+      for (unsigned j = 0; j < result.size(); ++j) result[j].Add(&tmp[j]);
+    }
+    return result;
+  }
+
   TH1F HTTRun2Analysis::GetLumiScaledShape(std::string const& variable,
                                        std::string const& sample, 
                                        std::string const& selection, 
@@ -1639,7 +1842,7 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
                                        std::string const& selection, 
                                        std::string const& category, 
                                        std::string const& weight) {
-
+    Prefetch(variable, samples, selection, category, weight);
     TH1F result = GetLumiScaledShape(variable, samples.at(0), selection, category, weight);
     if (samples.size() > 1) {
       for (unsigned i = 1; i < samples.size(); ++i) {
@@ -1657,15 +1860,23 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
                                       std::string const& weight) {
     if(verbosity_>2){ std::cout << "--GetRate-- Sample:\"" << sample << "\" Selection:\"" << selection << "\" Category:\"" 
       << category << "\" Weight:\"" << weight << "\"" << std::endl;}
+    Prefetch("", {sample}, selection, category, weight);
     std::string full_selection = BuildCutString(selection, category, weight);
     TH1::AddDirectory(true);
     //If the tree is empty, return 0
     if(ttrees_[sample]->GetEntries() == 0) return std::make_pair(0,0);
+    std::string cache_key = file_ids_[sample] + "|rate|" + full_selection;
+    Value result;
+    if (use_cache_ && file_ids_[sample] != "" && cache_.GetRate(cache_key, result)) {
+      TH1::AddDirectory(false);
+      return result;
+    }
     ttrees_[sample]->Draw("0.5>>htemp(1,0,1)", full_selection.c_str(), "goff");
     TH1::AddDirectory(false);
     TH1F *htemp = (TH1F*)gDirectory->Get("htemp");
-    auto result = std::make_pair(Integral(htemp), Error(htemp));
+    result = std::make_pair(Integral(htemp), Error(htemp));
     gDirectory->Delete("htemp;*");
+    if (use_cache_ && file_ids_[sample] != "") cache_.SetRate(cache_key, result);
     return result;
   }
 
@@ -1673,6 +1884,7 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
                                       std::string const& selection, 
                                       std::string const& category, 
                                       std::string const& weight) {
+    Prefetch("", samples, selection, category, weight);
     auto result = GetRate(samples.at(0),selection,category,weight);
     double err_sqr = result.second*result.second;
     if(samples.size() > 1){
@@ -1704,6 +1916,7 @@ push_back(sample_names_,this->ResolveSamplesAlias("data_samples"));
                                       std::string const& selection, 
                                       std::string const& category, 
                                       std::string const& weight) {
+    Prefetch("", samples, selection, category, weight);
     auto result = GetLumiScaledRate(samples.at(0), selection, category, weight);
     double err_sqr = result.second * result.second;
     if (samples.size() > 1) {
@@ -65,6 +65,7 @@
 #include "Modules/interface/CheckEvents.h"
 #include "Modules/interface/GenericModule.h"
 #include "HiggsTauTau/interface/NLOWeighting.h"
+#include "Modules/interface/WeightVectorProducer.h"
 
 
 namespace ic {
@@ -664,10 +665,31 @@ void HTTSequence::BuildSequence(){
   }
 
 
+std::vector<std::string> weight_vectors;
 if(js["test_nlo_reweight"].asBool()) {
   nloweights::ReadFile();
+  std::vector<int> nlo_masses, nlo_tanbs;
+  for (auto const& pt : js["nlo_reweight_points"]) {
+    nlo_masses.push_back(pt[0u].asInt());
+    nlo_tanbs.push_back(pt[1u].asInt());
+  }
+  if (nlo_masses.size() > 0) weight_vectors.push_back("mssm_nlo_wts");
   BuildModule(NLOWeighting("NLOWeights")
-    .set_fs(fs.get()));
+    .set_fs(fs.get())
+    .set_var_masses(nlo_masses)
+    .set_var_tanbs(nlo_tanbs));
+}
+
+// Each entry "name": [first_id, last_id] extracts a range of LHE weights
+// into a WeightVector, stored in the ntuple as a vector<float> branch
+if(!is_data && js["weight_vectors"].isObject()) {
+  for (auto const& wv : js["weight_vectors"].getMemberNames()) {
+    BuildModule(WeightVectorProducer(wv+"Producer")
+      .set_output_label(wv)
+      .set_first_id(js["weight_vectors"][wv][0u].asUInt())
+      .set_last_id(js["weight_vectors"][wv][1u].asUInt()));
+    weight_vectors.push_back(wv);
+  }
 }
 
 
@@ -1657,6 +1679,7 @@ BuildModule(HTTCategories("HTTCategories")
     .set_optimisation_study(js["optimisation_study"].asBool())
     .set_mass_shift(mass_shift)
     .set_add_nlo_weights(js["test_nlo_reweight"].asBool())
+    .set_weight_vectors(weight_vectors)
     .set_is_embedded(is_embedded)
     .set_is_data(is_data)
     .set_systematic_shift(addit_output_folder!="")
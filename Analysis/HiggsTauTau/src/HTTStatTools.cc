@@ -1,6 +1,8 @@
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTStatTools.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTAnalysisTools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/SOverBTools.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnRootTools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/ShapeCache.h"
 #include <vector>
 #include <map>
 #include <string>
@@ -498,30 +500,11 @@ namespace ic {
 			TH1F bkg_shape = this->key_match(keys[i]).backgrounds().GetShape();
 
 			// Find the range from the lowest edge containing 15.9% of the signal
-			double xmin = sig_shape.GetXaxis()->GetXmin();
-			double xmax = sig_shape.GetXaxis()->GetXmax();
-			unsigned steps = 350;
-			double step_size = (xmax-xmin)/double(steps);
-			double sig_tot = sig_shape.Integral();
-			double lower_limit = 0;
-			double upper_limit = 0;
-			for (unsigned j = 0; j < steps; ++j) {
-				double integral = IntegrateFloatRange(&sig_shape, xmin, xmin+(step_size*double(j)));
-				if (integral/sig_tot > 0.159) {
-					lower_limit = xmin+(step_size*double(j));
-					break;
-				}
-			}
-			for (unsigned j = 0; j < steps; ++j) {
-				double integral = IntegrateFloatRange(&sig_shape, xmax - (step_size*double(j)), xmax);
-				if (integral/sig_tot > 0.159) {
-					upper_limit = xmax - (step_size*double(j));
-					break;
-				}
-			}
-			std::cout << "Found 68\% limits at " << lower_limit << "," << upper_limit << std::endl;
-			double signal_yield = IntegrateFloatRange(&sig_shape, lower_limit, upper_limit);
-			double backgr_yield = IntegrateFloatRange(&bkg_shape, lower_limit, upper_limit);			
+			// to the highest edge containing 15.9% of the signal
+			ch::SOverBInfo info(&sig_shape, &bkg_shape, 350, 0.682);
+			std::cout << "Found 68\% limits at " << info.x_lo << "," << info.x_hi << std::endl;
+			double signal_yield = info.s;
+			double backgr_yield = info.b;
 			double weight = signal_yield / backgr_yield;
 			std::cout << "S/B: " << weight << std::endl;
 			for (unsigned j = 0; j < obs_.size(); ++j) {
@@ -639,26 +622,27 @@ namespace ic {
 	}
 
 	int HTTSetup::ParseROOTFile(const std::string & filename, std::string const& channel, std::string era) {
-		// Try and find shapes for each known process
-		TFile *f = new TFile(filename.c_str());
-		if (!f) return 1;
-		f->cd();
+		// Try and find shapes for each known process. The histograms are read
+		// through a ShapeCache, so only the first job after the file changes
+		// has to go through ROOT I/O
+		ShapeCache cache;
+		if (!cache.AddFile(filename)) return 1;
+		auto get = [&](std::string const& cat, std::string const& name) -> TH1F* {
+			if (!cache.HasDirectory(filename, cat)) {
+				std::cerr << "Warning, category " << cat << " not found in ROOT File" << std::endl;
+				return nullptr;
+			}
+			TH1F* hist = cache.GetTH1F(filename, cat + "/" + name);
+			if (!hist) std::cerr << "Warning, histogram " << name << " not found in ROOT File" << std::endl;
+			return hist;
+		};
+
 		for (unsigned i = 0; i < processes_.size(); ++i) {
 			if (processes_[i].channel == channel && processes_[i].era == era) {
-				std::string cat = processes_[i].category;
-				if (!gDirectory->cd(("/"+cat).c_str())) {
-					std::cerr << "Warning, category " << cat << " not found in ROOT File" << std::endl;
-					continue;
-				} 
 				std::string name = processes_[i].process;
 				if (processes_[i].process_id <= 0) name += processes_[i].mass;
-				TH1F* hist = (TH1F*)gDirectory->Get(name.c_str());
-				if (!hist) {
-					std::cerr << "Warning, histogram " << name << " not found in ROOT File" << std::endl;
-					continue;
-				} else {
-					hist = (TH1F*)hist->Clone();
-				}
+				TH1F* hist = get(processes_[i].category, name);
+				if (!hist) continue;
 				processes_[i].shape = hist;
 				processes_[i].rate = hist->Integral();
 			}
@@ -666,19 +650,8 @@ namespace ic {
 
 		for (unsigned i = 0; i < obs_.size(); ++i) {
 			if (obs_[i].channel == channel && obs_[i].era == era) {
-				std::string cat = obs_[i].category;
-				if (!gDirectory->cd(("/"+cat).c_str())) {
-					std::cerr << "Warning, category " << cat << " not found in ROOT File" << std::endl;
-					continue;
-				} 
-				std::string name = obs_[i].process;
-				TH1F* hist = (TH1F*)gDirectory->Get(name.c_str());
-				if (!hist) {
-					std::cerr << "Warning, histogram " << name << " not found in ROOT File" << std::endl;
-					continue;
-				} else {
-					hist = (TH1F*)hist->Clone();
-				}
+				TH1F* hist = get(obs_[i].category, obs_[i].process);
+				if (!hist) continue;
 				obs_[i].shape = hist;
 				// Create poisson errors
 				obs_[i].errors = new TGraphAsymmErrors(BuildPoissonErrors(*hist));
@@ -690,43 +663,22 @@ namespace ic {
 			if (params_[i].channel != channel || params_[i].era != era) continue;
 
 			std::string cat = params_[i].category;
-			if (!gDirectory->cd(("/"+cat).c_str())) {
-				std::cerr << "Warning, category " << cat << " not found in ROOT File" << std::endl;
-				continue;
-			} 
 			std::string name = params_[i].process;
 			if (params_[i].process_id <= 0) name += params_[i].mass;
-			std::string up_name = name + "_" + params_[i].nuisance + "Up";
-			std::string down_name = name + "_" + params_[i].nuisance + "Down";
 
-			TH1F* hist = (TH1F*)gDirectory->Get(name.c_str());
-			if (!hist) {
-				std::cerr << "Warning, histogram " << name << " not found in ROOT File" << std::endl;
-				continue;
-			} else {
-				params_[i].shape = (TH1F*)hist->Clone();	
-			}
+			TH1F* hist = get(cat, name);
+			if (!hist) continue;
+			params_[i].shape = hist;
 
-			TH1F* up_hist = (TH1F*)gDirectory->Get(up_name.c_str());
-			if (!up_hist) {
-				std::cerr << "Warning, histogram " << up_name << " not found in ROOT File" << std::endl;
-				continue;
-			} else {
-				params_[i].shape_up = (TH1F*)up_hist->Clone();	
-			}
-
-			TH1F* down_hist = (TH1F*)gDirectory->Get(down_name.c_str());
-			if (!down_hist) {
-				std::cerr << "Warning, histogram " << down_name << " not found in ROOT File" << std::endl;
-				continue;
-			} else {
-				params_[i].shape_down = (TH1F*)down_hist->Clone();	
-			}
+			TH1F* up_hist = get(cat, name + "_" + params_[i].nuisance + "Up");
+			if (!up_hist) continue;
+			params_[i].shape_up = up_hist;
 
+			TH1F* down_hist = get(cat, name + "_" + params_[i].nuisance + "Down");
+			if (!down_hist) continue;
+			params_[i].shape_down = down_hist;
 		}
 		return 0;
-
-		// Try and find shapes for each known shape nuisance
 	}
 
 	int HTTSetup::ParseDatacard(const std::string & filename, std::string const& channel, int category_id, std::string era, std::string mass) {
@@ -23,6 +23,8 @@ namespace ic {
     do_dy_soup_htbinned_      = false;
     do_w_soup_htbinned_      = false;
     fs_ = NULL;
+    wsoup_slot_               = EventInfo::register_weight("wsoup");
+    dysoup_slot_              = EventInfo::register_weight("dysoup");
   }
   HTTStitching::~HTTStitching() {
     ;
@@ -217,13 +219,13 @@ namespace ic {
         std::cerr << "Error making soup, event has " << partons << " partons!" << std::endl;
         throw;
       }
-      if (partons == 1) eventInfo->set_weight("wsoup", w1_);
-      if (partons == 2) eventInfo->set_weight("wsoup", w2_);
-      if (partons == 3) eventInfo->set_weight("wsoup", w3_);
-      if (partons == 4) eventInfo->set_weight("wsoup", w4_);
+      if (partons == 1) eventInfo->set_weight(wsoup_slot_, w1_);
+      if (partons == 2) eventInfo->set_weight(wsoup_slot_, w2_);
+      if (partons == 3) eventInfo->set_weight(wsoup_slot_, w3_);
+      if (partons == 4) eventInfo->set_weight(wsoup_slot_, w4_);
       t_njets_ = partons;
 
-      t_wt_ = eventInfo->weight_defined("wsoup") ? eventInfo->weight("wsoup") : 1.;
+      t_wt_ = eventInfo->weight_defined(wsoup_slot_) ? eventInfo->weight(wsoup_slot_) : 1.;
       if(fs_) t_gen_info_->Fill();
     }
 
@@ -278,13 +280,13 @@ namespace ic {
         std::cerr << "Error making soup, event has " << partons << " partons!" << std::endl;
         throw;
       }
-      if (partons == 1) eventInfo->set_weight("dysoup", zw1_);
-      if (partons == 2) eventInfo->set_weight("dysoup", zw2_);
-      if (partons == 3) eventInfo->set_weight("dysoup", zw3_);
-      if (partons == 4) eventInfo->set_weight("dysoup", zw4_);
+      if (partons == 1) eventInfo->set_weight(dysoup_slot_, zw1_);
+      if (partons == 2) eventInfo->set_weight(dysoup_slot_, zw2_);
+      if (partons == 3) eventInfo->set_weight(dysoup_slot_, zw3_);
+      if (partons == 4) eventInfo->set_weight(dysoup_slot_, zw4_);
       t_njets_ = partons;
 
-      t_wt_ = eventInfo->weight_defined("dysoup") ? eventInfo->weight("dysoup") : 1.;
+      t_wt_ = eventInfo->weight_defined(dysoup_slot_) ? eventInfo->weight(dysoup_slot_) : 1.;
       if(fs_) t_gen_info_->Fill();
 
       // unsigned gen_match_1 = MCOrigin2UInt(event->Get<ic::mcorigin>("gen_match_1"));
@@ -333,38 +335,38 @@ namespace ic {
       // unsigned gen_match_1 = MCOrigin2UInt(event->Get<ic::mcorigin>("gen_match_1"));
       bool is_ztt = (t_decay_ == 2);
       // if(gen_match_1 < 3) is_ztt=false;
-      if (partons == 0 && gen_mll > 150 && is_ztt) eventInfo->set_weight("dysoup",zw0hi_);
-      if (partons == 1 && gen_mll <= 150) eventInfo->set_weight("dysoup", zw1lo_);
-      if (partons == 1 && gen_mll > 150 && !is_ztt) eventInfo->set_weight("dysoup", zw1lo_);
-      if (partons == 1 && gen_mll > 150 && is_ztt) eventInfo->set_weight("dysoup", zw1hi_);
-      if (partons == 2 && gen_mll <= 150) eventInfo->set_weight("dysoup", zw2lo_);
-      if (partons == 2 && gen_mll > 150 && !is_ztt) eventInfo->set_weight("dysoup", zw2lo_);
-      if (partons == 2 && gen_mll > 150 && is_ztt) eventInfo->set_weight("dysoup", zw2hi_);
-      if (partons == 3 && gen_mll <= 150) eventInfo->set_weight("dysoup", zw3lo_);
-      if (partons == 3 && gen_mll > 150 && !is_ztt) eventInfo->set_weight("dysoup", zw3lo_);
-      if (partons == 3 && gen_mll > 150 && is_ztt) eventInfo->set_weight("dysoup", zw3hi_);
-      if (partons == 4 && gen_mll <= 150) eventInfo->set_weight("dysoup", zw4lo_);
-      if (partons == 4 && gen_mll > 150 && !is_ztt) eventInfo->set_weight("dysoup", zw4lo_);
-      if (partons == 4 && gen_mll > 150 && is_ztt) eventInfo->set_weight("dysoup", zw4hi_);
-      t_wt_ = eventInfo->weight_defined("dysoup") ? eventInfo->weight("dysoup") : 1.;
+      if (partons == 0 && gen_mll > 150 && is_ztt) eventInfo->set_weight(dysoup_slot_,zw0hi_);
+      if (partons == 1 && gen_mll <= 150) eventInfo->set_weight(dysoup_slot_, zw1lo_);
+      if (partons == 1 && gen_mll > 150 && !is_ztt) eventInfo->set_weight(dysoup_slot_, zw1lo_);
+      if (partons == 1 && gen_mll > 150 && is_ztt) eventInfo->set_weight(dysoup_slot_, zw1hi_);
+      if (partons == 2 && gen_mll <= 150) eventInfo->set_weight(dysoup_slot_, zw2lo_);
+      if (partons == 2 && gen_mll > 150 && !is_ztt) eventInfo->set_weight(dysoup_slot_, zw2lo_);
+      if (partons == 2 && gen_mll > 150 && is_ztt) eventInfo->set_weight(dysoup_slot_, zw2hi_);
+      if (partons == 3 && gen_mll <= 150) eventInfo->set_weight(dysoup_slot_, zw3lo_);
+      if (partons == 3 && gen_mll > 150 && !is_ztt) eventInfo->set_weight(dysoup_slot_, zw3lo_);
+      if (partons == 3 && gen_mll > 150 && is_ztt) eventInfo->set_weight(dysoup_slot_, zw3hi_);
+      if (partons == 4 && gen_mll <= 150) eventInfo->set_weight(dysoup_slot_, zw4lo_);
+      if (partons == 4 && gen_mll > 150 && !is_ztt) eventInfo->set_weight(dysoup_slot_, zw4lo_);
+      if (partons == 4 && gen_mll > 150 && is_ztt) eventInfo->set_weight(dysoup_slot_, zw4hi_);
+      t_wt_ = eventInfo->weight_defined(dysoup_slot_) ? eventInfo->weight(dysoup_slot_) : 1.;
       if(fs_) t_gen_info_->Fill();
     }
 
    if (do_w_soup_htbinned_){
      double gen_ht = eventInfo->gen_ht() ;
-     if (100 <= gen_ht&&gen_ht <200) eventInfo->set_weight("wsoup", w1_);
-     if (200 <= gen_ht&&gen_ht <400) eventInfo->set_weight("wsoup", w2_);
-     if (400 <= gen_ht &&gen_ht<600) eventInfo->set_weight("wsoup", w3_);
-     if (gen_ht >= 600) eventInfo->set_weight("wsoup", w4_);
+     if (100 <= gen_ht&&gen_ht <200) eventInfo->set_weight(wsoup_slot_, w1_);
+     if (200 <= gen_ht&&gen_ht <400) eventInfo->set_weight(wsoup_slot_, w2_);
+     if (400 <= gen_ht &&gen_ht<600) eventInfo->set_weight(wsoup_slot_, w3_);
+     if (gen_ht >= 600) eventInfo->set_weight(wsoup_slot_, w4_);
    }
 
 
    if (do_dy_soup_htbinned_){
      double gen_ht = eventInfo->gen_ht() ;
-     if (100 <= gen_ht&&gen_ht <200) eventInfo->set_weight("dysoup", zw1_);
-     if (200 <= gen_ht&&gen_ht <400) eventInfo->set_weight("dysoup", zw2_);
-     if (400 <= gen_ht &&gen_ht<600) eventInfo->set_weight("dysoup", zw3_);
-     if (gen_ht >= 600) eventInfo->set_weight("dysoup", zw4_);
+     if (100 <= gen_ht&&gen_ht <200) eventInfo->set_weight(dysoup_slot_, zw1_);
+     if (200 <= gen_ht&&gen_ht <400) eventInfo->set_weight(dysoup_slot_, zw2_);
+     if (400 <= gen_ht &&gen_ht<600) eventInfo->set_weight(dysoup_slot_, zw3_);
+     if (gen_ht >= 600) eventInfo->set_weight(dysoup_slot_, zw4_);
    }
 
     return 0;
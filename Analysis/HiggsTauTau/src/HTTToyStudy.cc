@@ -0,0 +1,349 @@
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTToyStudy.h"
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "TFile.h"
+#include "TTree.h"
+#include "TIterator.h"
+#include "TRandom.h"
+#include "RooRandom.h"
+#include "RooAbsData.h"
+#include "RooAbsReal.h"
+#include "RooMinimizer.h"
+#include "RooFitResult.h"
+#include "RooGlobalFunc.h"
+#include "boost/lexical_cast.hpp"
+
+namespace ic {
+
+	namespace {
+		// The parameters of a toys tree, from its p_pull branches
+		std::vector<std::string> ToyParameters(TTree *tree) {
+			std::vector<std::string> parameters;
+			TObjArray *branches = tree->GetListOfBranches();
+			for (int i = 0; i < branches->GetEntries(); ++i) {
+				std::string name = branches->At(i)->GetName();
+				std::size_t len = name.size();
+				if (len > 5 && name.substr(len - 5) == "_pull") parameters.push_back(name.substr(0, len - 5));
+			}
+			return parameters;
+		}
+
+		// Reset params to snapshot. Assigning a RooArgSet only copies the
+		// values, but the minimiser takes its initial step sizes from the
+		// errors, so these and the constant flags are reset too.
+		void ResetParameters(RooArgSet & params, RooArgSet const& snapshot) {
+			params = snapshot;
+			TIterator *it = params.createIterator();
+			while (RooAbsArg *arg = static_cast<RooAbsArg *>(it->Next())) {
+				RooRealVar *var = dynamic_cast<RooRealVar *>(arg);
+				RooRealVar const* snap = dynamic_cast<RooRealVar const*>(snapshot.find(arg->GetName()));
+				if (!var || !snap) continue;
+				var->setError(snap->getError());
+				if (snap->hasAsymError()) {
+					var->setAsymError(snap->getAsymErrorLo(), snap->getAsymErrorHi());
+				} else {
+					var->removeAsymError();
+				}
+				var->setConstant(snap->isConstant());
+			}
+			delete it;
+		}
+	}
+
+	ToyStudy::ToyStudy(RooAbsPdf & gen_pdf, RooAbsPdf & fit_pdf, RooArgSet const& observables)
+		: gen_pdf_(gen_pdf),
+			fit_pdf_(fit_pdf),
+			observables_(observables),
+			seed_(1),
+			workers_(1),
+			binned_(false),
+			strategy_(0) {
+		gen_params_ = gen_pdf_.getParameters(observables_);
+		gen_snapshot_ = static_cast<RooArgSet *>(gen_params_->snapshot());
+		fit_params_ = fit_pdf_.getParameters(observables_);
+		fit_snapshot_ = static_cast<RooArgSet *>(fit_params_->snapshot());
+		TIterator *it = fit_params_->createIterator();
+		while (RooAbsArg *arg = static_cast<RooAbsArg *>(it->Next())) {
+			RooRealVar *var = dynamic_cast<RooRealVar *>(arg);
+			if (!var || var->isConstant()) continue;
+			floating_.push_back(var);
+			names_.push_back(var->GetName());
+			RooRealVar *gen_var = dynamic_cast<RooRealVar *>(gen_snapshot_->find(var->GetName()));
+			truth_.push_back(gen_var ? gen_var->getVal() : var->getVal());
+		}
+		delete it;
+	}
+
+	ToyStudy::~ToyStudy() {
+		delete gen_params_;
+		delete gen_snapshot_;
+		delete fit_params_;
+		delete fit_snapshot_;
+	}
+
+	unsigned long long ToyStudy::ToySeed(unsigned long long seed, unsigned toy) {
+		// splitmix64 of the (seed, toy) pair, so neighbouring toys get
+		// unrelated seeds. TRandom3 treats a seed of zero as "seed from the
+		// clock", and SetSeed only takes the low 32 bits, so a zero low word
+		// is avoided.
+		unsigned long long z = seed + 0x9E3779B97F4A7C15ULL * (static_cast<unsigned long long>(toy) + 1);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		z = z ^ (z >> 31);
+		return (z & 0xFFFFFFFFULL) == 0 ? z | 1 : z;
+	}
+
+	int ToyStudy::RunWorker(unsigned worker, unsigned ntoys, double nevents, std::string const& filename) {
+		std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+		if (!out) {
+			std::cerr << "[ToyStudy] Unable to write " << filename << std::endl;
+			return 1;
+		}
+		bool gen_extended = gen_pdf_.canBeExtended();
+		bool fit_extended = fit_pdf_.canBeExtended();
+		// The likelihood is built on the first toy and keeps a reference to
+		// the data of the current toy after that
+		std::unique_ptr<RooAbsReal> nll;
+		std::unique_ptr<RooAbsData> data;
+		for (unsigned toy = worker; toy < ntoys; toy += workers_) {
+			ToyResult result;
+			result.toy = toy;
+			result.seed = ToySeed(seed_, toy);
+			RooRandom::randomGenerator()->SetSeed(result.seed);
+			ResetParameters(*gen_params_, *gen_snapshot_);
+			std::unique_ptr<RooAbsData> toy_data(binned_
+				? static_cast<RooAbsData *>(gen_pdf_.generateBinned(observables_, RooFit::NumEvents(nevents), RooFit::Extended(gen_extended)))
+				: static_cast<RooAbsData *>(gen_pdf_.generate(observables_, RooFit::NumEvents(nevents), RooFit::Extended(gen_extended))));
+			ResetParameters(*fit_params_, *fit_snapshot_);
+			if (!nll) {
+				nll.reset(fit_pdf_.createNLL(*toy_data, RooFit::Extended(fit_extended)));
+			} else {
+				nll->setData(*toy_data, false);
+			}
+			data.swap(toy_data);
+
+			RooMinimizer minim(*nll);
+			minim.setPrintLevel(-1);
+			minim.setStrategy(strategy_);
+			result.status = minim.migrad();
+			minim.hesse();
+			std::unique_ptr<RooFitResult> fit_result(minim.save());
+			result.cov_qual = fit_result->covQual();
+			result.nll = fit_result->minNll();
+
+			// Fixed-size records: toy, seed, status, covariance quality, NLL,
+			// then the value and error of each parameter
+			out.write(reinterpret_cast<char const*>(&result.toy), sizeof(result.toy));
+			out.write(reinterpret_cast<char const*>(&result.seed), sizeof(result.seed));
+			out.write(reinterpret_cast<char const*>(&result.status), sizeof(result.status));
+			out.write(reinterpret_cast<char const*>(&result.cov_qual), sizeof(result.cov_qual));
+			out.write(reinterpret_cast<char const*>(&result.nll), sizeof(result.nll));
+			for (unsigned i = 0; i < floating_.size(); ++i) {
+				double val = floating_[i]->getVal();
+				double err = floating_[i]->getError();
+				out.write(reinterpret_cast<char const*>(&val), sizeof(val));
+				out.write(reinterpret_cast<char const*>(&err), sizeof(err));
+			}
+			out.flush();
+			if (!out) return 1;
+		}
+		return 0;
+	}
+
+	int ToyStudy::Run(unsigned ntoys, double nevents, std::string const& output) {
+		unsigned workers = std::max(1u, std::min(workers_, ntoys));
+		unsigned saved_workers = workers_;
+		workers_ = workers;
+		std::vector<std::string> parts;
+		for (unsigned w = 0; w < workers; ++w) {
+			parts.push_back(output + ".worker" + boost::lexical_cast<std::string>(w));
+		}
+
+		int status = 0;
+		if (workers == 1) {
+			status = RunWorker(0, ntoys, nevents, parts[0]);
+		} else {
+			std::cout.flush();
+			std::cerr.flush();
+			std::vector<pid_t> children;
+			for (unsigned w = 0; w < workers; ++w) {
+				pid_t pid = fork();
+				if (pid < 0) {
+					std::perror("[ToyStudy] fork");
+					status = 1;
+					break;
+				}
+				if (pid == 0) {
+					int code = RunWorker(w, ntoys, nevents, parts[w]);
+					std::cout.flush();
+					std::cerr.flush();
+					_exit(code);
+				}
+				children.push_back(pid);
+			}
+			for (unsigned i = 0; i < children.size(); ++i) {
+				int child_status = 0;
+				if (waitpid(children[i], &child_status, 0) < 0 ||
+						!WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0) {
+					status = 1;
+				}
+			}
+		}
+		workers_ = saved_workers;
+
+		// Merge the complete records of every worker, in toy order
+		std::vector<ToyResult> results(ntoys);
+		std::vector<bool> done(ntoys, false);
+		unsigned nparams = names_.size();
+		for (unsigned w = 0; w < parts.size(); ++w) {
+			std::ifstream in(parts[w].c_str(), std::ios::in | std::ios::binary);
+			ToyResult result;
+			result.values.resize(nparams);
+			result.errors.resize(nparams);
+			while (in.read(reinterpret_cast<char *>(&result.toy), sizeof(result.toy))) {
+				in.read(reinterpret_cast<char *>(&result.seed), sizeof(result.seed));
+				in.read(reinterpret_cast<char *>(&result.status), sizeof(result.status));
+				in.read(reinterpret_cast<char *>(&result.cov_qual), sizeof(result.cov_qual));
+				in.read(reinterpret_cast<char *>(&result.nll), sizeof(result.nll));
+				for (unsigned i = 0; i < nparams; ++i) {
+					in.read(reinterpret_cast<char *>(&result.values[i]), sizeof(double));
+					in.read(reinterpret_cast<char *>(&result.errors[i]), sizeof(double));
+				}
+				if (!in || result.toy >= ntoys) break;
+				results[result.toy] = result;
+				done[result.toy] = true;
+			}
+			in.close();
+			std::remove(parts[w].c_str());
+		}
+
+		TFile fout(output.c_str(), "RECREATE");
+		if (fout.IsZombie()) {
+			std::cerr << "[ToyStudy] Unable to write " << output << std::endl;
+			return 1;
+		}
+		TTree *tree = new TTree("toys", "toys");
+		ToyResult entry;
+		entry.values.resize(nparams);
+		entry.errors.resize(nparams);
+		std::vector<double> pulls(nparams);
+		tree->Branch("toy", &entry.toy, "toy/i");
+		tree->Branch("seed", &entry.seed, "seed/l");
+		tree->Branch("status", &entry.status, "status/I");
+		tree->Branch("cov_qual", &entry.cov_qual, "cov_qual/I");
+		tree->Branch("nll", &entry.nll, "nll/D");
+		for (unsigned i = 0; i < nparams; ++i) {
+			tree->Branch(names_[i].c_str(), &entry.values[i], (names_[i] + "/D").c_str());
+			tree->Branch((names_[i] + "_err").c_str(), &entry.errors[i], (names_[i] + "_err/D").c_str());
+			tree->Branch((names_[i] + "_pull").c_str(), &pulls[i], (names_[i] + "_pull/D").c_str());
+		}
+		unsigned nmissing = 0;
+		for (unsigned t = 0; t < ntoys; ++t) {
+			if (!done[t]) {
+				++nmissing;
+				continue;
+			}
+			entry.toy = results[t].toy;
+			entry.seed = results[t].seed;
+			entry.status = results[t].status;
+			entry.cov_qual = results[t].cov_qual;
+			entry.nll = results[t].nll;
+			for (unsigned i = 0; i < nparams; ++i) {
+				entry.values[i] = results[t].values[i];
+				entry.errors[i] = results[t].errors[i];
+				pulls[i] = entry.errors[i] > 0. ? (entry.values[i] - truth_[i]) / entry.errors[i] : 0.;
+			}
+			tree->Fill();
+		}
+		fout.Write();
+		fout.Close();
+		if (nmissing > 0) {
+			std::cerr << "[ToyStudy] " << nmissing << " of " << ntoys << " toys did not finish" << std::endl;
+			status = 1;
+		}
+		return status;
+	}
+
+	std::vector<ToyResult> ReadToys(std::string const& filename, std::vector<std::string> & parameters) {
+		std::vector<ToyResult> results;
+		TFile fin(filename.c_str());
+		TTree *tree = fin.IsZombie() ? NULL : dynamic_cast<TTree *>(fin.Get("toys"));
+		if (!tree) {
+			std::cerr << "[ReadToys] No toys tree in " << filename << std::endl;
+			return results;
+		}
+		parameters = ToyParameters(tree);
+		ToyResult entry;
+		entry.values.resize(parameters.size());
+		entry.errors.resize(parameters.size());
+		tree->SetBranchAddress("toy", &entry.toy);
+		tree->SetBranchAddress("seed", &entry.seed);
+		tree->SetBranchAddress("status", &entry.status);
+		tree->SetBranchAddress("cov_qual", &entry.cov_qual);
+		tree->SetBranchAddress("nll", &entry.nll);
+		for (unsigned i = 0; i < parameters.size(); ++i) {
+			tree->SetBranchAddress(parameters[i].c_str(), &entry.values[i]);
+			tree->SetBranchAddress((parameters[i] + "_err").c_str(), &entry.errors[i]);
+		}
+		for (Long64_t e = 0; e < tree->GetEntries(); ++e) {
+			tree->GetEntry(e);
+			results.push_back(entry);
+		}
+		tree->ResetBranchAddresses();
+		return results;
+	}
+
+	void PullsFromToys(std::string const& filename, std::vector<ic::Pull> & pullvec, bool verbose) {
+		TFile fin(filename.c_str());
+		TTree *tree = fin.IsZombie() ? NULL : dynamic_cast<TTree *>(fin.Get("toys"));
+		if (!tree) {
+			std::cerr << "[PullsFromToys] No toys tree in " << filename << std::endl;
+			return;
+		}
+		std::vector<std::string> parameters = ToyParameters(tree);
+		int status = 0;
+		std::vector<double> pulls(parameters.size());
+		tree->SetBranchStatus("*", 0);
+		tree->SetBranchStatus("status", 1);
+		tree->SetBranchAddress("status", &status);
+		for (unsigned i = 0; i < parameters.size(); ++i) {
+			tree->SetBranchStatus((parameters[i] + "_pull").c_str(), 1);
+			tree->SetBranchAddress((parameters[i] + "_pull").c_str(), &pulls[i]);
+		}
+		std::vector<double> sum(parameters.size(), 0.);
+		std::vector<double> sum2(parameters.size(), 0.);
+		unsigned n = 0;
+		for (Long64_t e = 0; e < tree->GetEntries(); ++e) {
+			tree->GetEntry(e);
+			if (status != 0) continue;
+			++n;
+			for (unsigned i = 0; i < parameters.size(); ++i) {
+				sum[i] += pulls[i];
+				sum2[i] += pulls[i] * pulls[i];
+			}
+		}
+		tree->ResetBranchAddresses();
+		for (unsigned i = 0; i < parameters.size(); ++i) {
+			double mean = n > 0 ? sum[i] / n : 0.;
+			double rms = n > 0 ? std::sqrt(std::max(0., sum2[i] / n - mean * mean)) : 0.;
+			pullvec.push_back(ic::Pull());
+			ic::Pull & new_pull = pullvec.back();
+			new_pull.name = parameters[i];
+			new_pull.prefit = 0.;
+			new_pull.prefit_err = 1.;
+			new_pull.bonly = mean;
+			new_pull.bonly_err = rms;
+			new_pull.splusb = mean;
+			new_pull.splusb_err = rms;
+			new_pull.rho = 0.;
+			if (verbose) new_pull.Print();
+		}
+	}
+}
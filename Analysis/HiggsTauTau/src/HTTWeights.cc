@@ -94,6 +94,20 @@ namespace ic {
     muon_tracking_sf_         = nullptr;
     scalefactor_file_         = "";
     do_tau_id_sf_             = false;
+    slot_ggh_                 = EventInfo::register_weight("ggh");
+    slot_topquark_weight_     = EventInfo::register_weight("topquark_weight");
+    slot_tau_fake_weight_     = EventInfo::register_weight("tau_fake_weight");
+    slot_wt_tau_id_sf_        = EventInfo::register_weight("wt_tau_id_sf");
+    slot_jeteta_weight_       = EventInfo::register_weight("jeteta_weight");
+    slot_wt_zpt_              = EventInfo::register_weight("wt_zpt");
+    slot_wt_tracking_eff_     = EventInfo::register_weight("wt_tracking_eff");
+    slot_lepton_              = EventInfo::register_weight("lepton");
+    slot_tt_muon_weight_      = EventInfo::register_weight("tt_muon_weight");
+    slot_emu_e_fakerate_      = EventInfo::register_weight("emu_e_fakerate");
+    slot_emu_m_fakerate_      = EventInfo::register_weight("emu_m_fakerate");
+    slot_etau_fakerate_       = EventInfo::register_weight("etau_fakerate");
+    slot_mtau_fakerate_       = EventInfo::register_weight("mtau_fakerate");
+    slot_tau_mode_scale_      = EventInfo::register_weight("tau_mode_scale");
   }
   HTTWeights::~HTTWeights() {
     ;
@@ -167,6 +181,52 @@ namespace ic {
       ggh_hist_down_ = (TH1F*)gDirectory->Get("Down");
     }
 
+    if (ggh_hist_) {
+      ggh_hist_tab_ = WeightTable1D(ggh_hist_);
+      ggh_hist_up_tab_ = WeightTable1D(ggh_hist_up_);
+      ggh_hist_down_tab_ = WeightTable1D(ggh_hist_down_);
+    }
+    // Flat copies of the TH2D inputs for the per-event lookups below
+    if (z_pt_mass_hist_) z_pt_mass_hist_tab_ = WeightTable2D(z_pt_mass_hist_);
+    if (mt_idiso_mc_) mt_idiso_mc_tab_ = WeightTable2D(mt_idiso_mc_);
+    if (mt_idiso_data_) mt_idiso_data_tab_ = WeightTable2D(mt_idiso_data_);
+    if (et_idiso_mc_) et_idiso_mc_tab_ = WeightTable2D(et_idiso_mc_);
+    if (et_idiso_data_) et_idiso_data_tab_ = WeightTable2D(et_idiso_data_);
+    if (em_e_idiso_mc_) em_e_idiso_mc_tab_ = WeightTable2D(em_e_idiso_mc_);
+    if (em_e_idiso_data_) em_e_idiso_data_tab_ = WeightTable2D(em_e_idiso_data_);
+    if (em_m_idiso_mc_) em_m_idiso_mc_tab_ = WeightTable2D(em_m_idiso_mc_);
+    if (em_m_idiso_data_) em_m_idiso_data_tab_ = WeightTable2D(em_m_idiso_data_);
+    if (em_m17_trig_mc_) em_m17_trig_mc_tab_ = WeightTable2D(em_m17_trig_mc_);
+    if (em_m17_trig_data_) em_m17_trig_data_tab_ = WeightTable2D(em_m17_trig_data_);
+    if (em_m8_trig_mc_) em_m8_trig_mc_tab_ = WeightTable2D(em_m8_trig_mc_);
+    if (em_m8_trig_data_) em_m8_trig_data_tab_ = WeightTable2D(em_m8_trig_data_);
+    if (em_e17_trig_mc_) em_e17_trig_mc_tab_ = WeightTable2D(em_e17_trig_mc_);
+    if (em_e17_trig_data_) em_e17_trig_data_tab_ = WeightTable2D(em_e17_trig_data_);
+    if (em_e12_trig_mc_) em_e12_trig_mc_tab_ = WeightTable2D(em_e12_trig_mc_);
+    if (em_e12_trig_data_) em_e12_trig_data_tab_ = WeightTable2D(em_e12_trig_data_);
+    if (et_trig_mc_) et_trig_mc_tab_ = WeightTable2D(et_trig_mc_);
+    if (et_trig_data_) et_trig_data_tab_ = WeightTable2D(et_trig_data_);
+    if (et_antiiso1_trig_data_) et_antiiso1_trig_data_tab_ = WeightTable2D(et_antiiso1_trig_data_);
+    if (et_antiiso2_trig_data_) et_antiiso2_trig_data_tab_ = WeightTable2D(et_antiiso2_trig_data_);
+    if (et_xtrig_mc_) et_xtrig_mc_tab_ = WeightTable2D(et_xtrig_mc_);
+    if (et_xtrig_data_) et_xtrig_data_tab_ = WeightTable2D(et_xtrig_data_);
+    if (et_conditional_mc_) et_conditional_mc_tab_ = WeightTable2D(et_conditional_mc_);
+    if (et_conditional_data_) et_conditional_data_tab_ = WeightTable2D(et_conditional_data_);
+    if (mt_trig_mc_) mt_trig_mc_tab_ = WeightTable2D(mt_trig_mc_);
+    if (mt_trig_data_) mt_trig_data_tab_ = WeightTable2D(mt_trig_data_);
+    if (mt_antiiso1_trig_data_) mt_antiiso1_trig_data_tab_ = WeightTable2D(mt_antiiso1_trig_data_);
+    if (mt_antiiso2_trig_data_) mt_antiiso2_trig_data_tab_ = WeightTable2D(mt_antiiso2_trig_data_);
+    if (mt_xtrig_mc_) mt_xtrig_mc_tab_ = WeightTable2D(mt_xtrig_mc_);
+    if (mt_xtrig_data_) mt_xtrig_data_tab_ = WeightTable2D(mt_xtrig_data_);
+    if (mt_conditional_mc_) mt_conditional_mc_tab_ = WeightTable2D(mt_conditional_mc_);
+    if (mt_conditional_data_) mt_conditional_data_tab_ = WeightTable2D(mt_conditional_data_);
+    if (em_qcd_cr1_lt2_) em_qcd_cr1_lt2_tab_ = WeightTable2D(em_qcd_cr1_lt2_);
+    if (em_qcd_cr1_2to4_) em_qcd_cr1_2to4_tab_ = WeightTable2D(em_qcd_cr1_2to4_);
+    if (em_qcd_cr1_gt4_) em_qcd_cr1_gt4_tab_ = WeightTable2D(em_qcd_cr1_gt4_);
+    if (em_qcd_cr2_lt2_) em_qcd_cr2_lt2_tab_ = WeightTable2D(em_qcd_cr2_lt2_);
+    if (em_qcd_cr2_2to4_) em_qcd_cr2_2to4_tab_ = WeightTable2D(em_qcd_cr2_2to4_);
+    if (em_qcd_cr2_gt4_) em_qcd_cr2_gt4_tab_ = WeightTable2D(em_qcd_cr2_gt4_);
+
     if (do_emu_e_fakerates_ || do_emu_m_fakerates_) {
       std::string electron_fr_file, muon_fr_file;
       if (era_ == era::data_2012_rereco) {
@@ -285,15 +345,15 @@ namespace ic {
       }
       double h_pt = higgs->pt();
       double pt_weight = 1.0;
-      int fbin = ggh_hist_->FindBin(h_pt);
-      if (fbin > 0 && fbin <= ggh_hist_->GetNbinsX()) {
-        pt_weight =  ggh_hist_->GetBinContent(fbin);
+      int fbin = ggh_hist_tab_.FindBin(h_pt);
+      if (fbin > 0 && fbin <= ggh_hist_tab_.xaxis().nbins()) {
+        pt_weight =  ggh_hist_tab_.GetBinContent(fbin);
         //std::cout << "pt: " << h_pt << "\tweight: " <<  pt_weight << std::endl;
       }
-      eventInfo->set_weight("ggh", pt_weight);
+      eventInfo->set_weight(slot_ggh_, pt_weight);
       if (mc_ == mc::summer12_53X || mc_ == mc::fall11_42X) {
-        double weight_up   = ggh_hist_up_->GetBinContent(fbin)   / pt_weight;
-        double weight_down = ggh_hist_down_->GetBinContent(fbin) / pt_weight;
+        double weight_up   = ggh_hist_up_tab_.GetBinContent(fbin)   / pt_weight;
+        double weight_down = ggh_hist_down_tab_.GetBinContent(fbin) / pt_weight;
         event->Add("wt_ggh_pt_up", weight_up);
         event->Add("wt_ggh_pt_down", weight_down);
       }
@@ -330,14 +390,14 @@ namespace ic {
       top_wt_down = 1.0;
       event->Add("wt_tquark_up", top_wt_up / top_wt);
       event->Add("wt_tquark_down", top_wt_down / top_wt);
-      eventInfo->set_weight("topquark_weight", top_wt);
+      eventInfo->set_weight(slot_topquark_weight_, top_wt);
     }
     
     if (do_tau_fake_weights_) {
       Tau const* tau = dynamic_cast<Tau const*>(dilepton[0]->GetCandidate("lepton2"));
       double fake_pt = tau->pt() < 200. ? tau->pt() : 200.;
       double fake_weight = tau_fake_weights_->Eval(fake_pt);
-      eventInfo->set_weight("tau_fake_weight",fake_weight);
+      eventInfo->set_weight(slot_tau_fake_weight_,fake_weight);
       double weight_up   = (fake_weight + 0.5*(1.0-fake_weight)) / fake_weight;
       double weight_down = (fake_weight - 0.5*(1.0-fake_weight)) / fake_weight;
       event->Add("wt_tau_fake_up", weight_up);
@@ -347,8 +407,8 @@ namespace ic {
     if (do_tau_id_weights_) {
       if(era_ != era::data_2015 && era_!=era::data_2016){
         std::vector<Candidate *> tau = { (dilepton[0]->GetCandidate("lepton2")) };
-        std::vector<GenParticle *> const& particles = event->GetPtrVec<GenParticle>(gen_tau_collection_);
-        std::vector<GenJet> gen_taus = BuildTauJets(particles, false,false);
+        std::vector<GenJet> gen_taus =
+            BuildTauJets(GenGraph::Get(event, gen_tau_collection_), false, false);
         std::vector<GenJet *> gen_taus_ptr;
         for (auto & x : gen_taus) gen_taus_ptr.push_back(&x);
         std::vector<std::pair<Candidate*, GenJet*> > matches = MatchByDR(tau, gen_taus_ptr, 0.5, true, true);
@@ -415,7 +475,7 @@ namespace ic {
         tau_sf_1 = (gen_match_1==5) ? fns_["t_iso_mva_t_pt40_eta2p1_sf"]->eval(args_1.data()) : 1.0;
         tau_sf_2 = (gen_match_2==5) ? fns_["t_iso_mva_t_pt40_eta2p1_sf"]->eval(args_2.data()) : 1.0;
       }
-     eventInfo->set_weight("wt_tau_id_sf",tau_sf_1*tau_sf_2);
+     eventInfo->set_weight(slot_wt_tau_id_sf_,tau_sf_1*tau_sf_2);
     }
     if (do_em_qcd_weights_){
       if(channel_ == channel::em){
@@ -449,16 +509,16 @@ namespace ic {
          }
        } else if (era_==era::data_2016){
          if(deltaR < 2){
-           qcd_weight = em_qcd_cr1_lt2_->GetBinContent(em_qcd_cr1_lt2_->FindBin(trail_pt,lead_pt));
-           qcd_weight_up = em_qcd_cr2_lt2_->GetBinContent(em_qcd_cr2_lt2_->FindBin(trail_pt,lead_pt));
+           qcd_weight = em_qcd_cr1_lt2_tab_.Evaluate(trail_pt,lead_pt);
+           qcd_weight_up = em_qcd_cr2_lt2_tab_.Evaluate(trail_pt,lead_pt);
            qcd_weight_down = qcd_weight*qcd_weight/qcd_weight_up;
          } else if (deltaR <=4){
-           qcd_weight = em_qcd_cr1_2to4_->GetBinContent(em_qcd_cr1_2to4_->FindBin(trail_pt,lead_pt));
-           qcd_weight_up = em_qcd_cr2_2to4_->GetBinContent(em_qcd_cr2_2to4_->FindBin(trail_pt,lead_pt));
+           qcd_weight = em_qcd_cr1_2to4_tab_.Evaluate(trail_pt,lead_pt);
+           qcd_weight_up = em_qcd_cr2_2to4_tab_.Evaluate(trail_pt,lead_pt);
            qcd_weight_down = qcd_weight*qcd_weight/qcd_weight_up;
          } else {
-           qcd_weight = em_qcd_cr1_gt4_->GetBinContent(em_qcd_cr1_gt4_->FindBin(trail_pt,lead_pt));
-           qcd_weight_up = em_qcd_cr2_gt4_->GetBinContent(em_qcd_cr2_gt4_->FindBin(trail_pt,lead_pt));
+           qcd_weight = em_qcd_cr1_gt4_tab_.Evaluate(trail_pt,lead_pt);
+           qcd_weight_up = em_qcd_cr2_gt4_tab_.Evaluate(trail_pt,lead_pt);
            qcd_weight_down = qcd_weight*qcd_weight/qcd_weight_up;
          }
        }   
@@ -499,7 +559,7 @@ namespace ic {
         if (eta >= 1.6 && eta < 2.0)               { wt = 1.07689347695; }
         if (eta >= 2.0)                            { wt = 1.13656881923; }
       }
-      eventInfo->set_weight("jeteta_weight", wt);
+      eventInfo->set_weight(slot_jeteta_weight_, wt);
     }
     
     if (do_top_factors_) {
@@ -531,10 +591,10 @@ namespace ic {
     if (do_zpt_weight_){
       double zpt = event->Exists("genpT") ? event->Get<double>("genpT") : 0;
       double zmass = event->Exists("genM") ? event->Get<double>("genM") : 0;
-      double wtzpt = z_pt_mass_hist_->GetBinContent(z_pt_mass_hist_->GetXaxis()->FindBin(zmass),z_pt_mass_hist_->GetYaxis()->FindBin(zpt));
+      double wtzpt = z_pt_mass_hist_tab_.Evaluate(zmass, zpt);
       double wtzpt_down=1.0;
       double wtzpt_up = wtzpt*wtzpt; 
-      eventInfo->set_weight("wt_zpt",wtzpt);
+      eventInfo->set_weight(slot_wt_zpt_,wtzpt);
       event->Add("wt_zpt_up",wtzpt_up/wtzpt);
       event->Add("wt_zpt_down",wtzpt_down/wtzpt);
     }
@@ -564,7 +624,7 @@ namespace ic {
       }
       event->Add("trackingweight_1",tracking_wt_1);
       event->Add("trackingweight_2",tracking_wt_2);
-      eventInfo->set_weight("wt_tracking_eff",tracking_wt_1*tracking_wt_2);
+      eventInfo->set_weight(slot_wt_tracking_eff_,tracking_wt_1*tracking_wt_2);
     }
          
 
@@ -650,21 +710,21 @@ namespace ic {
           }
         } else if (mc_ == mc::spring15_74X){
           if(e_pt<100){
-            ele_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),et_trig_data_->GetYaxis()->FindBin(e_pt));
-            ele_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),et_trig_mc_->GetYaxis()->FindBin(e_pt));
+            ele_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt));
+            ele_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e_eta), et_trig_mc_tab_.FindBinY(e_pt));
           } else {
-            ele_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),(et_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            ele_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),(et_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
+            ele_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt)-1);
+            ele_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e_eta), et_trig_mc_tab_.FindBinY(e_pt)-1);
           }         
           tau_trg=1;
           tau_trg_mc=1;
         } else if (mc_ == mc::fall15_76X ){
           if(e_pt<150){
-            ele_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),et_trig_data_->GetYaxis()->FindBin(e_pt));
-            ele_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),et_trig_mc_->GetYaxis()->FindBin(e_pt));
+            ele_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt));
+            ele_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e_eta), et_trig_mc_tab_.FindBinY(e_pt));
           } else {
-            ele_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),(et_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            ele_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),(et_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
+            ele_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt)-1);
+            ele_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e_eta), et_trig_mc_tab_.FindBinY(e_pt)-1);
           }         
           tau_trg=1;
           tau_trg_mc=1;
@@ -674,30 +734,30 @@ namespace ic {
               if(do_single_lepton_trg_ && !do_cross_trg_){
                 if(e_iso < 0.1){
                   if(e_pt<1000){
-                    ele_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),et_trig_data_->GetYaxis()->FindBin(e_pt));
+                    ele_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt));
                     //ele_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),et_trig_mc_->GetYaxis()->FindBin(e_pt));
                   } else {
-                    ele_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),(et_trig_data_->GetYaxis()->FindBin(e_pt)-1));
+                    ele_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt)-1);
                     //ele_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),(et_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
                   }         
                   tau_trg=1;
                   tau_trg_mc=1;
                 }else if(e_iso <0.2){
                   if(e_pt<1000){
-                    ele_trg = et_antiiso1_trig_data_->GetBinContent(et_antiiso1_trig_data_->GetXaxis()->FindBin(e_eta),et_antiiso1_trig_data_->GetYaxis()->FindBin(e_pt));
+                    ele_trg = et_antiiso1_trig_data_tab_.GetBinContent(et_antiiso1_trig_data_tab_.FindBinX(e_eta), et_antiiso1_trig_data_tab_.FindBinY(e_pt));
                     //ele_trg_mc = et_trig_antiiso1_mc_->GetBinContent(et_trig_antiiso1_mc_->GetXaxis()->FindBin(e_eta),et_trig_antiiso1_mc_->GetYaxis()->FindBin(e_pt));
                   } else {
-                    ele_trg = et_antiiso1_trig_data_->GetBinContent(et_antiiso1_trig_data_->GetXaxis()->FindBin(e_eta),(et_antiiso1_trig_data_->GetYaxis()->FindBin(e_pt)-1));
+                    ele_trg = et_antiiso1_trig_data_tab_.GetBinContent(et_antiiso1_trig_data_tab_.FindBinX(e_eta), et_antiiso1_trig_data_tab_.FindBinY(e_pt)-1);
                     //ele_trg_mc = et_trig_antiiso1_mc_->GetBinContent(et_trig_antiiso1_mc_->GetXaxis()->FindBin(e_eta),(et_trig_antiiso1_mc_->GetYaxis()->FindBin(e_pt)-1));
                   }         
                   tau_trg=1;
                   tau_trg_mc=1;
                } else {//efficiencies only derived for iso<0.5!
                   if(e_pt<1000){
-                    ele_trg = et_antiiso2_trig_data_->GetBinContent(et_antiiso2_trig_data_->GetXaxis()->FindBin(e_eta),et_antiiso2_trig_data_->GetYaxis()->FindBin(e_pt));
+                    ele_trg = et_antiiso2_trig_data_tab_.GetBinContent(et_antiiso2_trig_data_tab_.FindBinX(e_eta), et_antiiso2_trig_data_tab_.FindBinY(e_pt));
                     //ele_trg_mc = et_trig_antiiso2_mc_->GetBinContent(et_trig_antiiso2_mc_->GetXaxis()->FindBin(e_eta),et_trig_antiiso2_mc_->GetYaxis()->FindBin(e_pt));
                   } else {
-                    ele_trg = et_antiiso2_trig_data_->GetBinContent(et_antiiso2_trig_data_->GetXaxis()->FindBin(e_eta),(et_antiiso2_trig_data_->GetYaxis()->FindBin(e_pt)-1));
+                    ele_trg = et_antiiso2_trig_data_tab_.GetBinContent(et_antiiso2_trig_data_tab_.FindBinX(e_eta), et_antiiso2_trig_data_tab_.FindBinY(e_pt)-1);
                     //ele_trg_mc = et_trig_antiiso2_mc_->GetBinContent(et_trig_antiiso2_mc_->GetXaxis()->FindBin(e_eta),(et_trig_antiiso2_mc_->GetYaxis()->FindBin(e_pt)-1));
                   }         
                   tau_trg=1;
@@ -705,11 +765,11 @@ namespace ic {
                 }
               } else if(do_cross_trg_ && !do_single_lepton_trg_){
                 if(e_pt<1000){
-                  ele_trg = et_xtrig_data_->GetBinContent(et_xtrig_data_->GetXaxis()->FindBin(e_eta),et_xtrig_data_->GetYaxis()->FindBin(e_pt));
-                  ele_trg_mc = et_xtrig_mc_->GetBinContent(et_xtrig_mc_->GetXaxis()->FindBin(e_eta),et_xtrig_mc_->GetYaxis()->FindBin(e_pt));
+                  ele_trg = et_xtrig_data_tab_.GetBinContent(et_xtrig_data_tab_.FindBinX(e_eta), et_xtrig_data_tab_.FindBinY(e_pt));
+                  ele_trg_mc = et_xtrig_mc_tab_.GetBinContent(et_xtrig_mc_tab_.FindBinX(e_eta), et_xtrig_mc_tab_.FindBinY(e_pt));
                 } else {
-                  ele_trg = et_xtrig_data_->GetBinContent(et_xtrig_data_->GetXaxis()->FindBin(e_eta),(et_xtrig_data_->GetYaxis()->FindBin(e_pt)-1));
-                  ele_trg_mc = et_xtrig_mc_->GetBinContent(et_xtrig_mc_->GetXaxis()->FindBin(e_eta),(et_xtrig_mc_->GetYaxis()->FindBin(e_pt)-1));
+                  ele_trg = et_xtrig_data_tab_.GetBinContent(et_xtrig_data_tab_.FindBinX(e_eta), et_xtrig_data_tab_.FindBinY(e_pt)-1);
+                  ele_trg_mc = et_xtrig_mc_tab_.GetBinContent(et_xtrig_mc_tab_.FindBinX(e_eta), et_xtrig_mc_tab_.FindBinY(e_pt)-1);
                 }         
                 tau_trg_mc=1;
                 unsigned gm2_ = MCOrigin2UInt(event->Get<ic::mcorigin>("gen_match_2"));
@@ -724,19 +784,19 @@ namespace ic {
                 double ele_cond_trg=1.0;
                 double ele_cond_trg_mc=1.0;
                 if(e_pt<1000){
-                  ele_trg = et_xtrig_data_->GetBinContent(et_xtrig_data_->GetXaxis()->FindBin(e_eta),et_xtrig_data_->GetYaxis()->FindBin(e_pt));
-                  ele_trg_mc = et_xtrig_mc_->GetBinContent(et_xtrig_mc_->GetXaxis()->FindBin(e_eta),et_xtrig_mc_->GetYaxis()->FindBin(e_pt));
-                  ele_sgl_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),et_trig_data_->GetYaxis()->FindBin(e_pt));
-                  ele_sgl_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),et_trig_mc_->GetYaxis()->FindBin(e_pt));
-                  ele_cond_trg = et_conditional_data_->GetBinContent(et_conditional_data_->GetXaxis()->FindBin(e_eta),et_conditional_data_->GetYaxis()->FindBin(e_pt));
-                  ele_cond_trg_mc = et_conditional_mc_->GetBinContent(et_conditional_mc_->GetXaxis()->FindBin(e_eta),et_conditional_mc_->GetYaxis()->FindBin(e_pt));
+                  ele_trg = et_xtrig_data_tab_.GetBinContent(et_xtrig_data_tab_.FindBinX(e_eta), et_xtrig_data_tab_.FindBinY(e_pt));
+                  ele_trg_mc = et_xtrig_mc_tab_.GetBinContent(et_xtrig_mc_tab_.FindBinX(e_eta), et_xtrig_mc_tab_.FindBinY(e_pt));
+                  ele_sgl_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt));
+                  ele_sgl_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e_eta), et_trig_mc_tab_.FindBinY(e_pt));
+                  ele_cond_trg = et_conditional_data_tab_.GetBinContent(et_conditional_data_tab_.FindBinX(e_eta), et_conditional_data_tab_.FindBinY(e_pt));
+                  ele_cond_trg_mc = et_conditional_mc_tab_.GetBinContent(et_conditional_mc_tab_.FindBinX(e_eta), et_conditional_mc_tab_.FindBinY(e_pt));
                 } else {
-                  ele_trg = et_xtrig_data_->GetBinContent(et_xtrig_data_->GetXaxis()->FindBin(e_eta),(et_xtrig_data_->GetYaxis()->FindBin(e_pt)-1));
-                  ele_trg_mc = et_xtrig_mc_->GetBinContent(et_xtrig_mc_->GetXaxis()->FindBin(e_eta),(et_xtrig_mc_->GetYaxis()->FindBin(e_pt)-1));
-                  ele_sgl_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e_eta),(et_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-                  ele_sgl_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e_eta),(et_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
-                  ele_cond_trg = et_conditional_data_->GetBinContent(et_conditional_data_->GetXaxis()->FindBin(e_eta),(et_conditional_data_->GetYaxis()->FindBin(e_pt)-1));
-                  ele_cond_trg_mc = et_conditional_mc_->GetBinContent(et_conditional_mc_->GetXaxis()->FindBin(e_eta),(et_conditional_mc_->GetYaxis()->FindBin(e_pt)-1));
+                  ele_trg = et_xtrig_data_tab_.GetBinContent(et_xtrig_data_tab_.FindBinX(e_eta), et_xtrig_data_tab_.FindBinY(e_pt)-1);
+                  ele_trg_mc = et_xtrig_mc_tab_.GetBinContent(et_xtrig_mc_tab_.FindBinX(e_eta), et_xtrig_mc_tab_.FindBinY(e_pt)-1);
+                  ele_sgl_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e_eta), et_trig_data_tab_.FindBinY(e_pt)-1);
+                  ele_sgl_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e_eta), et_trig_mc_tab_.FindBinY(e_pt)-1);
+                  ele_cond_trg = et_conditional_data_tab_.GetBinContent(et_conditional_data_tab_.FindBinX(e_eta), et_conditional_data_tab_.FindBinY(e_pt)-1);
+                  ele_cond_trg_mc = et_conditional_mc_tab_.GetBinContent(et_conditional_mc_tab_.FindBinX(e_eta), et_conditional_mc_tab_.FindBinY(e_pt)-1);
                 }         
                 tau_trg_mc=1;
                 unsigned gm2_ = MCOrigin2UInt(event->Get<ic::mcorigin>("gen_match_2"));
@@ -879,21 +939,21 @@ namespace ic {
           }
         } else if (mc_ == mc::spring15_74X){ //fall15 only to exercise code, SF's are applicable to spring15 only
           if(pt<100){
-            mu_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),mt_trig_data_->GetYaxis()->FindBin(pt));
-            mu_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),mt_trig_mc_->GetYaxis()->FindBin(pt));
+            mu_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt));
+            mu_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m_eta), mt_trig_mc_tab_.FindBinY(pt));
           } else {
-            mu_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),(mt_trig_data_->GetYaxis()->FindBin(pt)-1));
-            mu_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt)-1));
+            mu_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt)-1);
+            mu_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m_eta), mt_trig_mc_tab_.FindBinY(pt)-1);
           }         
           tau_trg=1;
           tau_trg_mc=1;
         } else if (mc_ == mc::fall15_76X ){
           if(pt<150){
-            mu_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),mt_trig_data_->GetYaxis()->FindBin(pt));
-            mu_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),mt_trig_mc_->GetYaxis()->FindBin(pt));
+            mu_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt));
+            mu_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m_eta), mt_trig_mc_tab_.FindBinY(pt));
           } else {
-            mu_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),(mt_trig_data_->GetYaxis()->FindBin(pt)-1));
-            mu_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt)-1));
+            mu_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt)-1);
+            mu_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m_eta), mt_trig_mc_tab_.FindBinY(pt)-1);
           }         
           tau_trg=1;
           tau_trg_mc=1;
@@ -903,30 +963,30 @@ namespace ic {
               if(do_single_lepton_trg_ && !do_cross_trg_){
                 if(m_iso<0.15){
                   if(pt<1000){
-                    mu_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),mt_trig_data_->GetYaxis()->FindBin(pt));
+                    mu_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt));
                    // mu_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),mt_trig_mc_->GetYaxis()->FindBin(pt));
                   } else {
-                    mu_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),(mt_trig_data_->GetYaxis()->FindBin(pt)-1));
+                    mu_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt)-1);
                     //mu_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt)-1));
                   }         
                   tau_trg=1;
                   tau_trg_mc=1;
                 } else if (m_iso<0.25){
                   if(pt<1000){
-                    mu_trg = mt_antiiso1_trig_data_->GetBinContent(mt_antiiso1_trig_data_->GetXaxis()->FindBin(m_eta),mt_antiiso1_trig_data_->GetYaxis()->FindBin(pt));
+                    mu_trg = mt_antiiso1_trig_data_tab_.GetBinContent(mt_antiiso1_trig_data_tab_.FindBinX(m_eta), mt_antiiso1_trig_data_tab_.FindBinY(pt));
     //                mu_trg_mc = mt_antiiso1_trig_mc_->GetBinContent(mt_antiiso1_trig_mc_->GetXaxis()->FindBin(m_eta),mt_antiiso1_trig_mc_->GetYaxis()->FindBin(pt));
                   } else {
-                    mu_trg = mt_antiiso1_trig_data_->GetBinContent(mt_antiiso1_trig_data_->GetXaxis()->FindBin(m_eta),(mt_antiiso1_trig_data_->GetYaxis()->FindBin(pt)-1));
+                    mu_trg = mt_antiiso1_trig_data_tab_.GetBinContent(mt_antiiso1_trig_data_tab_.FindBinX(m_eta), mt_antiiso1_trig_data_tab_.FindBinY(pt)-1);
                     //mu_trg_mc = mt_antiiso1_trig_mc_->GetBinContent(mt_antiiso1_trig_mc_->GetXaxis()->FindBin(m_eta),(mt_antiiso1_trig_mc_->GetYaxis()->FindBin(pt)-1));
                   }         
                   tau_trg=1;
                   tau_trg_mc=1;
                 } else { //scale factors only derived for iso<0.5!
                   if(pt<1000){
-                    mu_trg = mt_antiiso2_trig_data_->GetBinContent(mt_antiiso2_trig_data_->GetXaxis()->FindBin(m_eta),mt_antiiso2_trig_data_->GetYaxis()->FindBin(pt));
+                    mu_trg = mt_antiiso2_trig_data_tab_.GetBinContent(mt_antiiso2_trig_data_tab_.FindBinX(m_eta), mt_antiiso2_trig_data_tab_.FindBinY(pt));
                     //mu_trg_mc = mt_antiiso2_trig_mc_->GetBinContent(mt_antiiso2_trig_mc_->GetXaxis()->FindBin(m_eta),mt_antiiso2_trig_mc_->GetYaxis()->FindBin(pt));
                   } else {
-                    mu_trg = mt_antiiso2_trig_data_->GetBinContent(mt_antiiso2_trig_data_->GetXaxis()->FindBin(m_eta),(mt_antiiso2_trig_data_->GetYaxis()->FindBin(pt)-1));
+                    mu_trg = mt_antiiso2_trig_data_tab_.GetBinContent(mt_antiiso2_trig_data_tab_.FindBinX(m_eta), mt_antiiso2_trig_data_tab_.FindBinY(pt)-1);
                     //mu_trg_mc = mt_antiiso2_trig_mc_->GetBinContent(mt_antiiso2_trig_mc_->GetXaxis()->FindBin(m_eta),(mt_antiiso2_trig_mc_->GetYaxis()->FindBin(pt)-1));
                   }         
                   tau_trg=1;
@@ -934,11 +994,11 @@ namespace ic {
                 }
               } else if(do_cross_trg_ &&!do_single_lepton_trg_){
                  if(pt<1000){
-                  mu_trg = mt_xtrig_data_->GetBinContent(mt_xtrig_data_->GetXaxis()->FindBin(m_eta),mt_xtrig_data_->GetYaxis()->FindBin(pt));
-                  mu_trg_mc = mt_xtrig_mc_->GetBinContent(mt_xtrig_mc_->GetXaxis()->FindBin(m_eta),mt_xtrig_mc_->GetYaxis()->FindBin(pt));
+                  mu_trg = mt_xtrig_data_tab_.GetBinContent(mt_xtrig_data_tab_.FindBinX(m_eta), mt_xtrig_data_tab_.FindBinY(pt));
+                  mu_trg_mc = mt_xtrig_mc_tab_.GetBinContent(mt_xtrig_mc_tab_.FindBinX(m_eta), mt_xtrig_mc_tab_.FindBinY(pt));
                 } else {
-                  mu_trg = mt_xtrig_data_->GetBinContent(mt_xtrig_data_->GetXaxis()->FindBin(m_eta),(mt_xtrig_data_->GetYaxis()->FindBin(pt)-1));
-                  mu_trg_mc = mt_xtrig_mc_->GetBinContent(mt_xtrig_mc_->GetXaxis()->FindBin(m_eta),(mt_xtrig_mc_->GetYaxis()->FindBin(pt)-1));
+                  mu_trg = mt_xtrig_data_tab_.GetBinContent(mt_xtrig_data_tab_.FindBinX(m_eta), mt_xtrig_data_tab_.FindBinY(pt)-1);
+                  mu_trg_mc = mt_xtrig_mc_tab_.GetBinContent(mt_xtrig_mc_tab_.FindBinX(m_eta), mt_xtrig_mc_tab_.FindBinY(pt)-1);
                 }         
                 tau_trg_mc=1;
                 unsigned gm2_ = MCOrigin2UInt(event->Get<ic::mcorigin>("gen_match_2"));
@@ -953,19 +1013,19 @@ namespace ic {
                 double mu_cond_trg = 1.0;
                 double mu_cond_trg_mc = 1.0;
                  if(pt<1000){
-                  mu_trg = mt_xtrig_data_->GetBinContent(mt_xtrig_data_->GetXaxis()->FindBin(m_eta),mt_xtrig_data_->GetYaxis()->FindBin(pt));
-                  mu_trg_mc = mt_xtrig_mc_->GetBinContent(mt_xtrig_mc_->GetXaxis()->FindBin(m_eta),mt_xtrig_mc_->GetYaxis()->FindBin(pt));
-                  mu_sgl_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),mt_trig_data_->GetYaxis()->FindBin(pt));
-                  mu_sgl_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),mt_trig_mc_->GetYaxis()->FindBin(pt));
-                  mu_cond_trg = mt_conditional_data_->GetBinContent(mt_conditional_data_->GetXaxis()->FindBin(m_eta),mt_conditional_data_->GetYaxis()->FindBin(pt));
-                  mu_cond_trg_mc = mt_conditional_mc_->GetBinContent(mt_conditional_mc_->GetXaxis()->FindBin(m_eta),mt_conditional_mc_->GetYaxis()->FindBin(pt));
+                  mu_trg = mt_xtrig_data_tab_.GetBinContent(mt_xtrig_data_tab_.FindBinX(m_eta), mt_xtrig_data_tab_.FindBinY(pt));
+                  mu_trg_mc = mt_xtrig_mc_tab_.GetBinContent(mt_xtrig_mc_tab_.FindBinX(m_eta), mt_xtrig_mc_tab_.FindBinY(pt));
+                  mu_sgl_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt));
+                  mu_sgl_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m_eta), mt_trig_mc_tab_.FindBinY(pt));
+                  mu_cond_trg = mt_conditional_data_tab_.GetBinContent(mt_conditional_data_tab_.FindBinX(m_eta), mt_conditional_data_tab_.FindBinY(pt));
+                  mu_cond_trg_mc = mt_conditional_mc_tab_.GetBinContent(mt_conditional_mc_tab_.FindBinX(m_eta), mt_conditional_mc_tab_.FindBinY(pt));
                 } else {
-                  mu_trg = mt_xtrig_data_->GetBinContent(mt_xtrig_data_->GetXaxis()->FindBin(m_eta),(mt_xtrig_data_->GetYaxis()->FindBin(pt)-1));
-                  mu_trg_mc = mt_xtrig_mc_->GetBinContent(mt_xtrig_mc_->GetXaxis()->FindBin(m_eta),(mt_xtrig_mc_->GetYaxis()->FindBin(pt)-1));
-                  mu_sgl_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m_eta),mt_trig_data_->GetYaxis()->FindBin(pt)-1);
-                  mu_sgl_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m_eta),mt_trig_mc_->GetYaxis()->FindBin(pt)-1);
-                  mu_cond_trg = mt_conditional_data_->GetBinContent(mt_conditional_data_->GetXaxis()->FindBin(m_eta),mt_conditional_data_->GetYaxis()->FindBin(pt)-1);
-                  mu_cond_trg_mc = mt_conditional_mc_->GetBinContent(mt_conditional_mc_->GetXaxis()->FindBin(m_eta),mt_conditional_mc_->GetYaxis()->FindBin(pt)-1);
+                  mu_trg = mt_xtrig_data_tab_.GetBinContent(mt_xtrig_data_tab_.FindBinX(m_eta), mt_xtrig_data_tab_.FindBinY(pt)-1);
+                  mu_trg_mc = mt_xtrig_mc_tab_.GetBinContent(mt_xtrig_mc_tab_.FindBinX(m_eta), mt_xtrig_mc_tab_.FindBinY(pt)-1);
+                  mu_sgl_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m_eta), mt_trig_data_tab_.FindBinY(pt)-1);
+                  mu_sgl_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m_eta), mt_trig_mc_tab_.FindBinY(pt)-1);
+                  mu_cond_trg = mt_conditional_data_tab_.GetBinContent(mt_conditional_data_tab_.FindBinX(m_eta), mt_conditional_data_tab_.FindBinY(pt)-1);
+                  mu_cond_trg_mc = mt_conditional_mc_tab_.GetBinContent(mt_conditional_mc_tab_.FindBinX(m_eta), mt_conditional_mc_tab_.FindBinY(pt)-1);
                 }         
                 tau_trg_mc=1;
                 unsigned gm2_ = MCOrigin2UInt(event->Get<ic::mcorigin>("gen_match_2"));
@@ -1122,74 +1182,74 @@ namespace ic {
           }
         } else if (mc_ == mc::spring15_74X){
           if(e_pt<100){
-            e_trg_17 = em_e17_trig_data_->GetBinContent(em_e17_trig_data_->GetXaxis()->FindBin(e_eta),em_e17_trig_data_->GetYaxis()->FindBin(e_pt));
-            e_trg_17_mc = em_e17_trig_mc_->GetBinContent(em_e17_trig_mc_->GetXaxis()->FindBin(e_eta),em_e17_trig_mc_->GetYaxis()->FindBin(e_pt));
-            e_trg_12 = em_e12_trig_data_->GetBinContent(em_e12_trig_data_->GetXaxis()->FindBin(e_eta),em_e12_trig_data_->GetYaxis()->FindBin(e_pt));
-            e_trg_12_mc = em_e12_trig_mc_->GetBinContent(em_e12_trig_mc_->GetXaxis()->FindBin(e_eta),em_e12_trig_mc_->GetYaxis()->FindBin(e_pt));
+            e_trg_17 = em_e17_trig_data_tab_.GetBinContent(em_e17_trig_data_tab_.FindBinX(e_eta), em_e17_trig_data_tab_.FindBinY(e_pt));
+            e_trg_17_mc = em_e17_trig_mc_tab_.GetBinContent(em_e17_trig_mc_tab_.FindBinX(e_eta), em_e17_trig_mc_tab_.FindBinY(e_pt));
+            e_trg_12 = em_e12_trig_data_tab_.GetBinContent(em_e12_trig_data_tab_.FindBinX(e_eta), em_e12_trig_data_tab_.FindBinY(e_pt));
+            e_trg_12_mc = em_e12_trig_mc_tab_.GetBinContent(em_e12_trig_mc_tab_.FindBinX(e_eta), em_e12_trig_mc_tab_.FindBinY(e_pt));
           } else {
-            e_trg_17 = em_e17_trig_data_->GetBinContent(em_e17_trig_data_->GetXaxis()->FindBin(e_eta),(em_e17_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_17_mc = em_e17_trig_mc_->GetBinContent(em_e17_trig_mc_->GetXaxis()->FindBin(e_eta),(em_e17_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_12 = em_e12_trig_data_->GetBinContent(em_e12_trig_data_->GetXaxis()->FindBin(e_eta),(em_e12_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_12_mc = em_e12_trig_mc_->GetBinContent(em_e12_trig_mc_->GetXaxis()->FindBin(e_eta),(em_e12_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
+            e_trg_17 = em_e17_trig_data_tab_.GetBinContent(em_e17_trig_data_tab_.FindBinX(e_eta), em_e17_trig_data_tab_.FindBinY(e_pt)-1);
+            e_trg_17_mc = em_e17_trig_mc_tab_.GetBinContent(em_e17_trig_mc_tab_.FindBinX(e_eta), em_e17_trig_mc_tab_.FindBinY(e_pt)-1);
+            e_trg_12 = em_e12_trig_data_tab_.GetBinContent(em_e12_trig_data_tab_.FindBinX(e_eta), em_e12_trig_data_tab_.FindBinY(e_pt)-1);
+            e_trg_12_mc = em_e12_trig_mc_tab_.GetBinContent(em_e12_trig_mc_tab_.FindBinX(e_eta), em_e12_trig_mc_tab_.FindBinY(e_pt)-1);
           }         
           if(m_pt<100){
-            m_trg_17 = em_m17_trig_data_->GetBinContent(em_m17_trig_data_->GetXaxis()->FindBin(m_eta),em_m17_trig_data_->GetYaxis()->FindBin(m_pt));
-            m_trg_17_mc = em_m17_trig_mc_->GetBinContent(em_m17_trig_mc_->GetXaxis()->FindBin(m_eta),em_m17_trig_mc_->GetYaxis()->FindBin(m_pt));
-            m_trg_8 = em_m8_trig_data_->GetBinContent(em_m8_trig_data_->GetXaxis()->FindBin(m_eta),em_m8_trig_data_->GetYaxis()->FindBin(m_pt));
-            m_trg_8_mc = em_m8_trig_mc_->GetBinContent(em_m8_trig_mc_->GetXaxis()->FindBin(m_eta),em_m8_trig_mc_->GetYaxis()->FindBin(m_pt));
+            m_trg_17 = em_m17_trig_data_tab_.GetBinContent(em_m17_trig_data_tab_.FindBinX(m_eta), em_m17_trig_data_tab_.FindBinY(m_pt));
+            m_trg_17_mc = em_m17_trig_mc_tab_.GetBinContent(em_m17_trig_mc_tab_.FindBinX(m_eta), em_m17_trig_mc_tab_.FindBinY(m_pt));
+            m_trg_8 = em_m8_trig_data_tab_.GetBinContent(em_m8_trig_data_tab_.FindBinX(m_eta), em_m8_trig_data_tab_.FindBinY(m_pt));
+            m_trg_8_mc = em_m8_trig_mc_tab_.GetBinContent(em_m8_trig_mc_tab_.FindBinX(m_eta), em_m8_trig_mc_tab_.FindBinY(m_pt));
           } else {
-            m_trg_17 = em_m17_trig_data_->GetBinContent(em_m17_trig_data_->GetXaxis()->FindBin(m_eta),(em_m17_trig_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_17_mc = em_m17_trig_mc_->GetBinContent(em_m17_trig_mc_->GetXaxis()->FindBin(m_eta),(em_m17_trig_mc_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_8 = em_m8_trig_data_->GetBinContent(em_m8_trig_data_->GetXaxis()->FindBin(m_eta),(em_m8_trig_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_8_mc = em_m8_trig_mc_->GetBinContent(em_m8_trig_mc_->GetXaxis()->FindBin(m_eta),(em_m8_trig_mc_->GetYaxis()->FindBin(m_pt)-1));
+            m_trg_17 = em_m17_trig_data_tab_.GetBinContent(em_m17_trig_data_tab_.FindBinX(m_eta), em_m17_trig_data_tab_.FindBinY(m_pt)-1);
+            m_trg_17_mc = em_m17_trig_mc_tab_.GetBinContent(em_m17_trig_mc_tab_.FindBinX(m_eta), em_m17_trig_mc_tab_.FindBinY(m_pt)-1);
+            m_trg_8 = em_m8_trig_data_tab_.GetBinContent(em_m8_trig_data_tab_.FindBinX(m_eta), em_m8_trig_data_tab_.FindBinY(m_pt)-1);
+            m_trg_8_mc = em_m8_trig_mc_tab_.GetBinContent(em_m8_trig_mc_tab_.FindBinX(m_eta), em_m8_trig_mc_tab_.FindBinY(m_pt)-1);
           }         
        } else if (mc_ == mc::fall15_76X){
           if(e_pt<150){
-            e_trg_17 = em_e17_trig_data_->GetBinContent(em_e17_trig_data_->GetXaxis()->FindBin(e_eta),em_e17_trig_data_->GetYaxis()->FindBin(e_pt));
-            e_trg_17_mc = em_e17_trig_mc_->GetBinContent(em_e17_trig_mc_->GetXaxis()->FindBin(e_eta),em_e17_trig_mc_->GetYaxis()->FindBin(e_pt));
-            e_trg_12 = em_e12_trig_data_->GetBinContent(em_e12_trig_data_->GetXaxis()->FindBin(e_eta),em_e12_trig_data_->GetYaxis()->FindBin(e_pt));
-            e_trg_12_mc = em_e12_trig_mc_->GetBinContent(em_e12_trig_mc_->GetXaxis()->FindBin(e_eta),em_e12_trig_mc_->GetYaxis()->FindBin(e_pt));
+            e_trg_17 = em_e17_trig_data_tab_.GetBinContent(em_e17_trig_data_tab_.FindBinX(e_eta), em_e17_trig_data_tab_.FindBinY(e_pt));
+            e_trg_17_mc = em_e17_trig_mc_tab_.GetBinContent(em_e17_trig_mc_tab_.FindBinX(e_eta), em_e17_trig_mc_tab_.FindBinY(e_pt));
+            e_trg_12 = em_e12_trig_data_tab_.GetBinContent(em_e12_trig_data_tab_.FindBinX(e_eta), em_e12_trig_data_tab_.FindBinY(e_pt));
+            e_trg_12_mc = em_e12_trig_mc_tab_.GetBinContent(em_e12_trig_mc_tab_.FindBinX(e_eta), em_e12_trig_mc_tab_.FindBinY(e_pt));
           } else {
-            e_trg_17 = em_e17_trig_data_->GetBinContent(em_e17_trig_data_->GetXaxis()->FindBin(e_eta),(em_e17_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_17_mc = em_e17_trig_mc_->GetBinContent(em_e17_trig_mc_->GetXaxis()->FindBin(e_eta),(em_e17_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_12 = em_e12_trig_data_->GetBinContent(em_e12_trig_data_->GetXaxis()->FindBin(e_eta),(em_e12_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_12_mc = em_e12_trig_mc_->GetBinContent(em_e12_trig_mc_->GetXaxis()->FindBin(e_eta),(em_e12_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
+            e_trg_17 = em_e17_trig_data_tab_.GetBinContent(em_e17_trig_data_tab_.FindBinX(e_eta), em_e17_trig_data_tab_.FindBinY(e_pt)-1);
+            e_trg_17_mc = em_e17_trig_mc_tab_.GetBinContent(em_e17_trig_mc_tab_.FindBinX(e_eta), em_e17_trig_mc_tab_.FindBinY(e_pt)-1);
+            e_trg_12 = em_e12_trig_data_tab_.GetBinContent(em_e12_trig_data_tab_.FindBinX(e_eta), em_e12_trig_data_tab_.FindBinY(e_pt)-1);
+            e_trg_12_mc = em_e12_trig_mc_tab_.GetBinContent(em_e12_trig_mc_tab_.FindBinX(e_eta), em_e12_trig_mc_tab_.FindBinY(e_pt)-1);
           }         
           if(m_pt<150){
-            m_trg_17 = em_m17_trig_data_->GetBinContent(em_m17_trig_data_->GetXaxis()->FindBin(m_eta),em_m17_trig_data_->GetYaxis()->FindBin(m_pt));
-            m_trg_17_mc = em_m17_trig_mc_->GetBinContent(em_m17_trig_mc_->GetXaxis()->FindBin(m_eta),em_m17_trig_mc_->GetYaxis()->FindBin(m_pt));
-            m_trg_8 = em_m8_trig_data_->GetBinContent(em_m8_trig_data_->GetXaxis()->FindBin(m_eta),em_m8_trig_data_->GetYaxis()->FindBin(m_pt));
-            m_trg_8_mc = em_m8_trig_mc_->GetBinContent(em_m8_trig_mc_->GetXaxis()->FindBin(m_eta),em_m8_trig_mc_->GetYaxis()->FindBin(m_pt));
+            m_trg_17 = em_m17_trig_data_tab_.GetBinContent(em_m17_trig_data_tab_.FindBinX(m_eta), em_m17_trig_data_tab_.FindBinY(m_pt));
+            m_trg_17_mc = em_m17_trig_mc_tab_.GetBinContent(em_m17_trig_mc_tab_.FindBinX(m_eta), em_m17_trig_mc_tab_.FindBinY(m_pt));
+            m_trg_8 = em_m8_trig_data_tab_.GetBinContent(em_m8_trig_data_tab_.FindBinX(m_eta), em_m8_trig_data_tab_.FindBinY(m_pt));
+            m_trg_8_mc = em_m8_trig_mc_tab_.GetBinContent(em_m8_trig_mc_tab_.FindBinX(m_eta), em_m8_trig_mc_tab_.FindBinY(m_pt));
           } else {
-            m_trg_17 = em_m17_trig_data_->GetBinContent(em_m17_trig_data_->GetXaxis()->FindBin(m_eta),(em_m17_trig_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_17_mc = em_m17_trig_mc_->GetBinContent(em_m17_trig_mc_->GetXaxis()->FindBin(m_eta),(em_m17_trig_mc_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_8 = em_m8_trig_data_->GetBinContent(em_m8_trig_data_->GetXaxis()->FindBin(m_eta),(em_m8_trig_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_8_mc = em_m8_trig_mc_->GetBinContent(em_m8_trig_mc_->GetXaxis()->FindBin(m_eta),(em_m8_trig_mc_->GetYaxis()->FindBin(m_pt)-1));
+            m_trg_17 = em_m17_trig_data_tab_.GetBinContent(em_m17_trig_data_tab_.FindBinX(m_eta), em_m17_trig_data_tab_.FindBinY(m_pt)-1);
+            m_trg_17_mc = em_m17_trig_mc_tab_.GetBinContent(em_m17_trig_mc_tab_.FindBinX(m_eta), em_m17_trig_mc_tab_.FindBinY(m_pt)-1);
+            m_trg_8 = em_m8_trig_data_tab_.GetBinContent(em_m8_trig_data_tab_.FindBinX(m_eta), em_m8_trig_data_tab_.FindBinY(m_pt)-1);
+            m_trg_8_mc = em_m8_trig_mc_tab_.GetBinContent(em_m8_trig_mc_tab_.FindBinX(m_eta), em_m8_trig_mc_tab_.FindBinY(m_pt)-1);
           }         
 
        } else if (mc_ == mc::spring16_80X){
       /*    if(e_pt<1000){
 
-            e_trg_17 = em_e17_trig_data_->GetBinContent(em_e17_trig_data_->GetXaxis()->FindBin(e_eta),em_e17_trig_data_->GetYaxis()->FindBin(e_pt));
-            e_trg_17_mc = em_e17_trig_mc_->GetBinContent(em_e17_trig_mc_->GetXaxis()->FindBin(e_eta),em_e17_trig_mc_->GetYaxis()->FindBin(e_pt));
-            e_trg_12 = em_e12_trig_data_->GetBinContent(em_e12_trig_data_->GetXaxis()->FindBin(e_eta),em_e12_trig_data_->GetYaxis()->FindBin(e_pt));
-            e_trg_12_mc = em_e12_trig_mc_->GetBinContent(em_e12_trig_mc_->GetXaxis()->FindBin(e_eta),em_e12_trig_mc_->GetYaxis()->FindBin(e_pt));
+            e_trg_17 = em_e17_trig_data_tab_.GetBinContent(em_e17_trig_data_tab_.FindBinX(e_eta), em_e17_trig_data_tab_.FindBinY(e_pt));
+            e_trg_17_mc = em_e17_trig_mc_tab_.GetBinContent(em_e17_trig_mc_tab_.FindBinX(e_eta), em_e17_trig_mc_tab_.FindBinY(e_pt));
+            e_trg_12 = em_e12_trig_data_tab_.GetBinContent(em_e12_trig_data_tab_.FindBinX(e_eta), em_e12_trig_data_tab_.FindBinY(e_pt));
+            e_trg_12_mc = em_e12_trig_mc_tab_.GetBinContent(em_e12_trig_mc_tab_.FindBinX(e_eta), em_e12_trig_mc_tab_.FindBinY(e_pt));
           } else {
-            e_trg_17 = em_e17_trig_data_->GetBinContent(em_e17_trig_data_->GetXaxis()->FindBin(e_eta),(em_e17_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_17_mc = em_e17_trig_mc_->GetBinContent(em_e17_trig_mc_->GetXaxis()->FindBin(e_eta),(em_e17_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_12 = em_e12_trig_data_->GetBinContent(em_e12_trig_data_->GetXaxis()->FindBin(e_eta),(em_e12_trig_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_trg_12_mc = em_e12_trig_mc_->GetBinContent(em_e12_trig_mc_->GetXaxis()->FindBin(e_eta),(em_e12_trig_mc_->GetYaxis()->FindBin(e_pt)-1));
+            e_trg_17 = em_e17_trig_data_tab_.GetBinContent(em_e17_trig_data_tab_.FindBinX(e_eta), em_e17_trig_data_tab_.FindBinY(e_pt)-1);
+            e_trg_17_mc = em_e17_trig_mc_tab_.GetBinContent(em_e17_trig_mc_tab_.FindBinX(e_eta), em_e17_trig_mc_tab_.FindBinY(e_pt)-1);
+            e_trg_12 = em_e12_trig_data_tab_.GetBinContent(em_e12_trig_data_tab_.FindBinX(e_eta), em_e12_trig_data_tab_.FindBinY(e_pt)-1);
+            e_trg_12_mc = em_e12_trig_mc_tab_.GetBinContent(em_e12_trig_mc_tab_.FindBinX(e_eta), em_e12_trig_mc_tab_.FindBinY(e_pt)-1);
           }         
           if(m_pt<1000){
-            m_trg_17 = em_m17_trig_data_->GetBinContent(em_m17_trig_data_->GetXaxis()->FindBin(m_eta),em_m17_trig_data_->GetYaxis()->FindBin(m_pt));
-            m_trg_17_mc = em_m17_trig_mc_->GetBinContent(em_m17_trig_mc_->GetXaxis()->FindBin(m_eta),em_m17_trig_mc_->GetYaxis()->FindBin(m_pt));
-            m_trg_8 = em_m8_trig_data_->GetBinContent(em_m8_trig_data_->GetXaxis()->FindBin(m_eta),em_m8_trig_data_->GetYaxis()->FindBin(m_pt));
-            m_trg_8_mc = em_m8_trig_mc_->GetBinContent(em_m8_trig_mc_->GetXaxis()->FindBin(m_eta),em_m8_trig_mc_->GetYaxis()->FindBin(m_pt));
+            m_trg_17 = em_m17_trig_data_tab_.GetBinContent(em_m17_trig_data_tab_.FindBinX(m_eta), em_m17_trig_data_tab_.FindBinY(m_pt));
+            m_trg_17_mc = em_m17_trig_mc_tab_.GetBinContent(em_m17_trig_mc_tab_.FindBinX(m_eta), em_m17_trig_mc_tab_.FindBinY(m_pt));
+            m_trg_8 = em_m8_trig_data_tab_.GetBinContent(em_m8_trig_data_tab_.FindBinX(m_eta), em_m8_trig_data_tab_.FindBinY(m_pt));
+            m_trg_8_mc = em_m8_trig_mc_tab_.GetBinContent(em_m8_trig_mc_tab_.FindBinX(m_eta), em_m8_trig_mc_tab_.FindBinY(m_pt));
           } else {
-            m_trg_17 = em_m17_trig_data_->GetBinContent(em_m17_trig_data_->GetXaxis()->FindBin(m_eta),(em_m17_trig_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_17_mc = em_m17_trig_mc_->GetBinContent(em_m17_trig_mc_->GetXaxis()->FindBin(m_eta),(em_m17_trig_mc_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_8 = em_m8_trig_data_->GetBinContent(em_m8_trig_data_->GetXaxis()->FindBin(m_eta),(em_m8_trig_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_trg_8_mc = em_m8_trig_mc_->GetBinContent(em_m8_trig_mc_->GetXaxis()->FindBin(m_eta),(em_m8_trig_mc_->GetYaxis()->FindBin(m_pt)-1));
+            m_trg_17 = em_m17_trig_data_tab_.GetBinContent(em_m17_trig_data_tab_.FindBinX(m_eta), em_m17_trig_data_tab_.FindBinY(m_pt)-1);
+            m_trg_17_mc = em_m17_trig_mc_tab_.GetBinContent(em_m17_trig_mc_tab_.FindBinX(m_eta), em_m17_trig_mc_tab_.FindBinY(m_pt)-1);
+            m_trg_8 = em_m8_trig_data_tab_.GetBinContent(em_m8_trig_data_tab_.FindBinX(m_eta), em_m8_trig_data_tab_.FindBinY(m_pt)-1);
+            m_trg_8_mc = em_m8_trig_mc_tab_.GetBinContent(em_m8_trig_mc_tab_.FindBinX(m_eta), em_m8_trig_mc_tab_.FindBinY(m_pt)-1);
           }*/         
           auto args_1 = std::vector<double>{e_pt,e_eta};
           auto args_2 = std::vector<double>{m_pt,m_eta};
@@ -1465,35 +1525,35 @@ namespace ic {
         if(era_ == era::data_2015 || era_==era::data_2016) e1_eta = fabs(elec->eta());
         if (mc_ == mc::fall15_76X){
           if(e1_pt<150){
-            ele1_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e1_eta),et_trig_data_->GetYaxis()->FindBin(e1_pt));
-            ele1_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e1_eta),et_trig_mc_->GetYaxis()->FindBin(e1_pt));
+            ele1_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e1_eta), et_trig_data_tab_.FindBinY(e1_pt));
+            ele1_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e1_eta), et_trig_mc_tab_.FindBinY(e1_pt));
           } else {
-            ele1_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e1_eta),(et_trig_data_->GetYaxis()->FindBin(e1_pt)-1));
-            ele1_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e1_eta),(et_trig_mc_->GetYaxis()->FindBin(e1_pt)-1));
+            ele1_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e1_eta), et_trig_data_tab_.FindBinY(e1_pt)-1);
+            ele1_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e1_eta), et_trig_mc_tab_.FindBinY(e1_pt)-1);
           }         
 
           if (e2_pt<150){
-            ele2_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e2_eta),et_trig_data_->GetYaxis()->FindBin(e2_pt));
-            ele2_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e2_eta),et_trig_mc_->GetYaxis()->FindBin(e2_pt));
+            ele2_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e2_eta), et_trig_data_tab_.FindBinY(e2_pt));
+            ele2_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e2_eta), et_trig_mc_tab_.FindBinY(e2_pt));
           } else {
-            ele2_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e2_eta),(et_trig_data_->GetYaxis()->FindBin(e2_pt)-1));
-            ele2_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e2_eta),(et_trig_mc_->GetYaxis()->FindBin(e2_pt)-1));
+            ele2_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e2_eta), et_trig_data_tab_.FindBinY(e2_pt)-1);
+            ele2_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e2_eta), et_trig_mc_tab_.FindBinY(e2_pt)-1);
           }
         } else if (mc_ == mc::spring16_80X){
           if(scalefactor_file_==""){
               if(e1_pt<1000){
-                ele1_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e1_eta),et_trig_data_->GetYaxis()->FindBin(e1_pt));
-                ele1_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e1_eta),et_trig_mc_->GetYaxis()->FindBin(e1_pt));
+                ele1_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e1_eta), et_trig_data_tab_.FindBinY(e1_pt));
+                ele1_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e1_eta), et_trig_mc_tab_.FindBinY(e1_pt));
               } else {
-                ele1_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e1_eta),(et_trig_data_->GetYaxis()->FindBin(e1_pt)-1));
-                ele1_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e1_eta),(et_trig_mc_->GetYaxis()->FindBin(e1_pt)-1));
+                ele1_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e1_eta), et_trig_data_tab_.FindBinY(e1_pt)-1);
+                ele1_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e1_eta), et_trig_mc_tab_.FindBinY(e1_pt)-1);
               }         
               if(e2_pt<1000){
-                ele2_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e2_eta),et_trig_data_->GetYaxis()->FindBin(e2_pt));
-                ele2_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e2_eta),et_trig_mc_->GetYaxis()->FindBin(e2_pt));
+                ele2_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e2_eta), et_trig_data_tab_.FindBinY(e2_pt));
+                ele2_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e2_eta), et_trig_mc_tab_.FindBinY(e2_pt));
               } else {
-                ele2_trg = et_trig_data_->GetBinContent(et_trig_data_->GetXaxis()->FindBin(e2_eta),(et_trig_data_->GetYaxis()->FindBin(e2_pt)-1));
-                ele2_trg_mc = et_trig_mc_->GetBinContent(et_trig_mc_->GetXaxis()->FindBin(e2_eta),(et_trig_mc_->GetYaxis()->FindBin(e2_pt)-1));
+                ele2_trg = et_trig_data_tab_.GetBinContent(et_trig_data_tab_.FindBinX(e2_eta), et_trig_data_tab_.FindBinY(e2_pt)-1);
+                ele2_trg_mc = et_trig_mc_tab_.GetBinContent(et_trig_mc_tab_.FindBinX(e2_eta), et_trig_mc_tab_.FindBinY(e2_pt)-1);
               }         
           } else {
              ele1_trg = 1;
@@ -1539,35 +1599,35 @@ namespace ic {
         double mu2_trg_mc = 1.0;
         if (mc_ == mc::fall15_76X){
           if(pt1<150){
-            mu1_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m1_eta),mt_trig_data_->GetYaxis()->FindBin(pt1));
-            mu1_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m1_eta),mt_trig_mc_->GetYaxis()->FindBin(pt1));
+            mu1_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m1_eta), mt_trig_data_tab_.FindBinY(pt1));
+            mu1_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m1_eta), mt_trig_mc_tab_.FindBinY(pt1));
           } else {
-            mu1_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m1_eta),(mt_trig_data_->GetYaxis()->FindBin(pt1)-1));
-            mu1_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m1_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt1)-1));
+            mu1_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m1_eta), mt_trig_data_tab_.FindBinY(pt1)-1);
+            mu1_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m1_eta), mt_trig_mc_tab_.FindBinY(pt1)-1);
           }         
 
           if(pt2<150){
-            mu2_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m2_eta),mt_trig_data_->GetYaxis()->FindBin(pt2));
-            mu2_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m2_eta),mt_trig_mc_->GetYaxis()->FindBin(pt2));
+            mu2_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m2_eta), mt_trig_data_tab_.FindBinY(pt2));
+            mu2_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m2_eta), mt_trig_mc_tab_.FindBinY(pt2));
           } else {
-            mu2_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m2_eta),(mt_trig_data_->GetYaxis()->FindBin(pt2)-1));
-            mu2_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m2_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt2)-1));
+            mu2_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m2_eta), mt_trig_data_tab_.FindBinY(pt2)-1);
+            mu2_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m2_eta), mt_trig_mc_tab_.FindBinY(pt2)-1);
           }
          } else if(mc_ == mc::spring16_80X){
           if(scalefactor_file_==""){
            if(pt1<1000){
-              mu1_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m1_eta),mt_trig_data_->GetYaxis()->FindBin(pt1));
-              mu1_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m1_eta),mt_trig_mc_->GetYaxis()->FindBin(pt1));
+              mu1_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m1_eta), mt_trig_data_tab_.FindBinY(pt1));
+              mu1_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m1_eta), mt_trig_mc_tab_.FindBinY(pt1));
             } else {
-              mu1_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m1_eta),(mt_trig_data_->GetYaxis()->FindBin(pt1)-1));
-              mu1_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m1_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt1)-1));
+              mu1_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m1_eta), mt_trig_data_tab_.FindBinY(pt1)-1);
+              mu1_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m1_eta), mt_trig_mc_tab_.FindBinY(pt1)-1);
             }         
             if(pt2<1000){
-              mu2_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m2_eta),mt_trig_data_->GetYaxis()->FindBin(pt2));
-              mu2_trg_mc = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m2_eta),mt_trig_data_->GetYaxis()->FindBin(pt2));
+              mu2_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m2_eta), mt_trig_data_tab_.FindBinY(pt2));
+              mu2_trg_mc = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m2_eta), mt_trig_data_tab_.FindBinY(pt2));
             } else {
-              mu2_trg = mt_trig_data_->GetBinContent(mt_trig_data_->GetXaxis()->FindBin(m2_eta),(mt_trig_data_->GetYaxis()->FindBin(pt2)-1));
-              mu2_trg_mc = mt_trig_mc_->GetBinContent(mt_trig_mc_->GetXaxis()->FindBin(m2_eta),(mt_trig_mc_->GetYaxis()->FindBin(pt2)-1));
+              mu2_trg = mt_trig_data_tab_.GetBinContent(mt_trig_data_tab_.FindBinX(m2_eta), mt_trig_data_tab_.FindBinY(pt2)-1);
+              mu2_trg_mc = mt_trig_mc_tab_.GetBinContent(mt_trig_mc_tab_.FindBinX(m2_eta), mt_trig_mc_tab_.FindBinY(pt2)-1);
             }
 
           } else {
@@ -1644,11 +1704,11 @@ namespace ic {
           if (pt > 30.0 && sc_eta >= 1.479)               { ele_id = 0.9689; ele_iso = 0.9971; }
         } else if (mc_ == mc::spring15_74X || mc_ ==mc::fall15_76X){
           if(pt<100){
-            ele_idiso_data = et_idiso_data_->GetBinContent(et_idiso_data_->GetXaxis()->FindBin(sc_eta),et_idiso_data_->GetYaxis()->FindBin(pt));
-            ele_idiso_mc = et_idiso_mc_->GetBinContent(et_idiso_mc_->GetXaxis()->FindBin(sc_eta),et_idiso_mc_->GetYaxis()->FindBin(pt));
+            ele_idiso_data = et_idiso_data_tab_.GetBinContent(et_idiso_data_tab_.FindBinX(sc_eta), et_idiso_data_tab_.FindBinY(pt));
+            ele_idiso_mc = et_idiso_mc_tab_.GetBinContent(et_idiso_mc_tab_.FindBinX(sc_eta), et_idiso_mc_tab_.FindBinY(pt));
           } else {
-            ele_idiso_data = et_idiso_data_->GetBinContent(et_idiso_data_->GetXaxis()->FindBin(sc_eta),(et_idiso_data_->GetYaxis()->FindBin(pt)-1));
-            ele_idiso_mc = et_idiso_mc_->GetBinContent(et_idiso_mc_->GetXaxis()->FindBin(sc_eta),(et_idiso_mc_->GetYaxis()->FindBin(pt)-1));
+            ele_idiso_data = et_idiso_data_tab_.GetBinContent(et_idiso_data_tab_.FindBinX(sc_eta), et_idiso_data_tab_.FindBinY(pt)-1);
+            ele_idiso_mc = et_idiso_mc_tab_.GetBinContent(et_idiso_mc_tab_.FindBinX(sc_eta), et_idiso_mc_tab_.FindBinY(pt)-1);
           }         
             ele_idiso = ele_idiso_data/ele_idiso_mc;
 
@@ -1703,11 +1763,11 @@ namespace ic {
           if (pt > 30.0 && m_eta >= 1.2)                                { mu_id = 0.9829; mu_iso = 0.9960; }
         } else if (mc_ == mc::spring15_74X ||mc_ == mc::fall15_76X){
           if(pt<100){
-            mu_idiso_data = mt_idiso_data_->GetBinContent(mt_idiso_data_->GetXaxis()->FindBin(m_eta),mt_idiso_data_->GetYaxis()->FindBin(pt));
-            mu_idiso_mc = mt_idiso_mc_->GetBinContent(mt_idiso_mc_->GetXaxis()->FindBin(m_eta),mt_idiso_mc_->GetYaxis()->FindBin(pt));
+            mu_idiso_data = mt_idiso_data_tab_.GetBinContent(mt_idiso_data_tab_.FindBinX(m_eta), mt_idiso_data_tab_.FindBinY(pt));
+            mu_idiso_mc = mt_idiso_mc_tab_.GetBinContent(mt_idiso_mc_tab_.FindBinX(m_eta), mt_idiso_mc_tab_.FindBinY(pt));
           } else {
-            mu_idiso_data = mt_idiso_data_->GetBinContent(mt_idiso_data_->GetXaxis()->FindBin(m_eta),(mt_idiso_data_->GetYaxis()->FindBin(pt)-1));
-            mu_idiso_mc = mt_idiso_mc_->GetBinContent(mt_idiso_mc_->GetXaxis()->FindBin(m_eta),(mt_idiso_mc_->GetYaxis()->FindBin(pt)-1));
+            mu_idiso_data = mt_idiso_data_tab_.GetBinContent(mt_idiso_data_tab_.FindBinX(m_eta), mt_idiso_data_tab_.FindBinY(pt)-1);
+            mu_idiso_mc = mt_idiso_mc_tab_.GetBinContent(mt_idiso_mc_tab_.FindBinX(m_eta), mt_idiso_mc_tab_.FindBinY(pt)-1);
           }         
             mu_idiso = mu_idiso_data/mu_idiso_mc;
 
@@ -1829,18 +1889,18 @@ namespace ic {
           }
         } else if (mc_ == mc::spring15_74X || mc_ ==mc::fall15_76X){
           if(m_pt<100){
-            m_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_eta),em_m_idiso_data_->GetYaxis()->FindBin(m_pt));
-            m_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_eta),em_m_idiso_mc_->GetYaxis()->FindBin(m_pt));
+            m_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_eta), em_m_idiso_data_tab_.FindBinY(m_pt));
+            m_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_eta), em_m_idiso_mc_tab_.FindBinY(m_pt));
           } else {
-            m_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_eta),(em_m_idiso_data_->GetYaxis()->FindBin(m_pt)-1));
-            m_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_eta),(em_m_idiso_mc_->GetYaxis()->FindBin(m_pt)-1));
+            m_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_eta), em_m_idiso_data_tab_.FindBinY(m_pt)-1);
+            m_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_eta), em_m_idiso_mc_tab_.FindBinY(m_pt)-1);
           }         
           if(e_pt<100){
-            e_idiso_data = em_e_idiso_data_->GetBinContent(em_e_idiso_data_->GetXaxis()->FindBin(e_eta),em_e_idiso_data_->GetYaxis()->FindBin(e_pt));
-            e_idiso_mc = em_e_idiso_mc_->GetBinContent(em_e_idiso_mc_->GetXaxis()->FindBin(e_eta),em_e_idiso_mc_->GetYaxis()->FindBin(e_pt));
+            e_idiso_data = em_e_idiso_data_tab_.GetBinContent(em_e_idiso_data_tab_.FindBinX(e_eta), em_e_idiso_data_tab_.FindBinY(e_pt));
+            e_idiso_mc = em_e_idiso_mc_tab_.GetBinContent(em_e_idiso_mc_tab_.FindBinX(e_eta), em_e_idiso_mc_tab_.FindBinY(e_pt));
           } else {
-            e_idiso_data = em_e_idiso_data_->GetBinContent(em_e_idiso_data_->GetXaxis()->FindBin(e_eta),(em_e_idiso_data_->GetYaxis()->FindBin(e_pt)-1));
-            e_idiso_mc = em_e_idiso_mc_->GetBinContent(em_e_idiso_mc_->GetXaxis()->FindBin(e_eta),(em_e_idiso_mc_->GetYaxis()->FindBin(e_pt)-1));
+            e_idiso_data = em_e_idiso_data_tab_.GetBinContent(em_e_idiso_data_tab_.FindBinX(e_eta), em_e_idiso_data_tab_.FindBinY(e_pt)-1);
+            e_idiso_mc = em_e_idiso_mc_tab_.GetBinContent(em_e_idiso_mc_tab_.FindBinX(e_eta), em_e_idiso_mc_tab_.FindBinY(e_pt)-1);
           }         
 
             m_idiso = m_idiso_data/m_idiso_mc;
@@ -1902,18 +1962,18 @@ namespace ic {
         double m_2_idiso_data = 1.0;
         if (mc_ == mc::spring15_74X || mc_==mc::fall15_76X){
           if(m_1_pt<100){
-            m_1_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_1_eta),em_m_idiso_data_->GetYaxis()->FindBin(m_1_pt));
-            m_1_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_1_eta),em_m_idiso_mc_->GetYaxis()->FindBin(m_1_pt));
+            m_1_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_1_eta), em_m_idiso_data_tab_.FindBinY(m_1_pt));
+            m_1_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_1_eta), em_m_idiso_mc_tab_.FindBinY(m_1_pt));
           } else {
-            m_1_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_1_eta),(em_m_idiso_data_->GetYaxis()->FindBin(m_1_pt)-1));
-            m_1_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_1_eta),(em_m_idiso_mc_->GetYaxis()->FindBin(m_1_pt)-1));
+            m_1_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_1_eta), em_m_idiso_data_tab_.FindBinY(m_1_pt)-1);
+            m_1_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_1_eta), em_m_idiso_mc_tab_.FindBinY(m_1_pt)-1);
           }         
           if(m_2_pt<100){
-            m_2_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_2_eta),em_m_idiso_data_->GetYaxis()->FindBin(m_2_pt));
-            m_2_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_2_eta),em_m_idiso_mc_->GetYaxis()->FindBin(m_2_pt));
+            m_2_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_2_eta), em_m_idiso_data_tab_.FindBinY(m_2_pt));
+            m_2_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_2_eta), em_m_idiso_mc_tab_.FindBinY(m_2_pt));
           } else {
-            m_2_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_2_eta),(em_m_idiso_data_->GetYaxis()->FindBin(m_2_pt)-1));
-            m_2_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_2_eta),(em_m_idiso_mc_->GetYaxis()->FindBin(m_2_pt)-1));
+            m_2_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_2_eta), em_m_idiso_data_tab_.FindBinY(m_2_pt)-1);
+            m_2_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_2_eta), em_m_idiso_mc_tab_.FindBinY(m_2_pt)-1);
           }         
 
             m_1_idiso = m_1_idiso_data/m_1_idiso_mc;
@@ -1926,18 +1986,18 @@ namespace ic {
            m_1_idiso = fns_["m_id_ratio"]->eval(args1_1.data()) * fns_["m_iso_binned_ratio"]->eval(args1_2.data()) ;
            m_2_idiso = fns_["m_id_ratio"]->eval(args2_1.data()) * fns_["m_iso_binned_ratio"]->eval(args2_2.data()) ;
           /*if(m_1_pt<1000){
-            m_1_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_1_eta),em_m_idiso_data_->GetYaxis()->FindBin(m_1_pt));
-            m_1_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_1_eta),em_m_idiso_mc_->GetYaxis()->FindBin(m_1_pt));
+            m_1_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_1_eta), em_m_idiso_data_tab_.FindBinY(m_1_pt));
+            m_1_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_1_eta), em_m_idiso_mc_tab_.FindBinY(m_1_pt));
           } else {
-            m_1_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_1_eta),(em_m_idiso_data_->GetYaxis()->FindBin(m_1_pt)-1));
-            m_1_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_1_eta),(em_m_idiso_mc_->GetYaxis()->FindBin(m_1_pt)-1));
+            m_1_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_1_eta), em_m_idiso_data_tab_.FindBinY(m_1_pt)-1);
+            m_1_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_1_eta), em_m_idiso_mc_tab_.FindBinY(m_1_pt)-1);
           }         
           if(m_2_pt<1000){
-            m_2_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_2_eta),em_m_idiso_data_->GetYaxis()->FindBin(m_2_pt));
-            m_2_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_2_eta),em_m_idiso_mc_->GetYaxis()->FindBin(m_2_pt));
+            m_2_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_2_eta), em_m_idiso_data_tab_.FindBinY(m_2_pt));
+            m_2_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_2_eta), em_m_idiso_mc_tab_.FindBinY(m_2_pt));
           } else {
-            m_2_idiso_data = em_m_idiso_data_->GetBinContent(em_m_idiso_data_->GetXaxis()->FindBin(m_2_eta),(em_m_idiso_data_->GetYaxis()->FindBin(m_2_pt)-1));
-            m_2_idiso_mc = em_m_idiso_mc_->GetBinContent(em_m_idiso_mc_->GetXaxis()->FindBin(m_2_eta),(em_m_idiso_mc_->GetYaxis()->FindBin(m_2_pt)-1));
+            m_2_idiso_data = em_m_idiso_data_tab_.GetBinContent(em_m_idiso_data_tab_.FindBinX(m_2_eta), em_m_idiso_data_tab_.FindBinY(m_2_pt)-1);
+            m_2_idiso_mc = em_m_idiso_mc_tab_.GetBinContent(em_m_idiso_mc_tab_.FindBinX(m_2_eta), em_m_idiso_mc_tab_.FindBinY(m_2_pt)-1);
           }         
 
             m_1_idiso = m_1_idiso_data/m_1_idiso_mc;
@@ -1968,18 +2028,18 @@ namespace ic {
         if (mc_ == mc::spring15_74X || mc_==mc::fall15_76X){
 
           if(e_1_pt<100){
-            e_1_idiso_data = em_e_idiso_data_->GetBinContent(em_e_idiso_data_->GetXaxis()->FindBin(e_1_eta),em_e_idiso_data_->GetYaxis()->FindBin(e_1_pt));
-            e_1_idiso_mc = em_e_idiso_mc_->GetBinContent(em_e_idiso_mc_->GetXaxis()->FindBin(e_1_eta),em_e_idiso_mc_->GetYaxis()->FindBin(e_1_pt));
+            e_1_idiso_data = em_e_idiso_data_tab_.GetBinContent(em_e_idiso_data_tab_.FindBinX(e_1_eta), em_e_idiso_data_tab_.FindBinY(e_1_pt));
+            e_1_idiso_mc = em_e_idiso_mc_tab_.GetBinContent(em_e_idiso_mc_tab_.FindBinX(e_1_eta), em_e_idiso_mc_tab_.FindBinY(e_1_pt));
           } else {
-            e_1_idiso_data = em_e_idiso_data_->GetBinContent(em_e_idiso_data_->GetXaxis()->FindBin(e_1_eta),(em_e_idiso_data_->GetYaxis()->FindBin(e_1_pt)-1));
-            e_1_idiso_mc = em_e_idiso_mc_->GetBinContent(em_e_idiso_mc_->GetXaxis()->FindBin(e_1_eta),(em_e_idiso_mc_->GetYaxis()->FindBin(e_1_pt)-1));
+            e_1_idiso_data = em_e_idiso_data_tab_.GetBinContent(em_e_idiso_data_tab_.FindBinX(e_1_eta), em_e_idiso_data_tab_.FindBinY(e_1_pt)-1);
+            e_1_idiso_mc = em_e_idiso_mc_tab_.GetBinContent(em_e_idiso_mc_tab_.FindBinX(e_1_eta), em_e_idiso_mc_tab_.FindBinY(e_1_pt)-1);
           }         
           if(e_2_pt<100){
-            e_2_idiso_data = em_e_idiso_data_->GetBinContent(em_e_idiso_data_->GetXaxis()->FindBin(e_2_eta),em_e_idiso_data_->GetYaxis()->FindBin(e_2_pt));
-            e_2_idiso_mc = em_e_idiso_mc_->GetBinContent(em_e_idiso_mc_->GetXaxis()->FindBin(e_2_eta),em_e_idiso_mc_->GetYaxis()->FindBin(e_2_pt));
+            e_2_idiso_data = em_e_idiso_data_tab_.GetBinContent(em_e_idiso_data_tab_.FindBinX(e_2_eta), em_e_idiso_data_tab_.FindBinY(e_2_pt));
+            e_2_idiso_mc = em_e_idiso_mc_tab_.GetBinContent(em_e_idiso_mc_tab_.FindBinX(e_2_eta), em_e_idiso_mc_tab_.FindBinY(e_2_pt));
           } else {
-            e_2_idiso_data = em_e_idiso_data_->GetBinContent(em_e_idiso_data_->GetXaxis()->FindBin(e_2_eta),(em_e_idiso_data_->GetYaxis()->FindBin(e_2_pt)-1));
-            e_2_idiso_mc = em_e_idiso_mc_->GetBinContent(em_e_idiso_mc_->GetXaxis()->FindBin(e_2_eta),(em_e_idiso_mc_->GetYaxis()->FindBin(e_2_pt)-1));
+            e_2_idiso_data = em_e_idiso_data_tab_.GetBinContent(em_e_idiso_data_tab_.FindBinX(e_2_eta), em_e_idiso_data_tab_.FindBinY(e_2_pt)-1);
+            e_2_idiso_mc = em_e_idiso_mc_tab_.GetBinContent(em_e_idiso_mc_tab_.FindBinX(e_2_eta), em_e_idiso_mc_tab_.FindBinY(e_2_pt)-1);
           }         
 
             e_1_idiso = e_1_idiso_data/e_1_idiso_mc;
@@ -2000,7 +2060,7 @@ namespace ic {
         event->Add("isoweight_2", double(1.0));
        }
     }
-    eventInfo->set_weight("lepton", weight);
+    eventInfo->set_weight(slot_lepton_, weight);
 
 
     if (do_tt_muon_weights_) {
@@ -2054,7 +2114,7 @@ namespace ic {
         if (m_pt > 75.0 && m_pt <= 100.0) m_wt = 1.056;
         if (m_pt > 100.0)                 m_wt = 1.056;
       }
-      eventInfo->set_weight("tt_muon_weight", m_wt);
+      eventInfo->set_weight(slot_tt_muon_weight_, m_wt);
     }
 
 
@@ -2069,7 +2129,7 @@ namespace ic {
       double elefakerate = eleprob/(1.0 - eleprob);
       //double elefakerate_errlow = ElectronFakeRateHist_PtEta->GetError(elefopt,fabs(elec->eta()),mithep::TH2DAsymErr::kStatErrLow)/pow((1-ElectronFakeRateHist_PtEta->GetError(elefopt,fabs(elec->eta()),mithep::TH2DAsymErr::kStatErrLow)),2);
       //double elefakerate_errhigh = ElectronFakeRateHist_PtEta->GetError(elefopt,fabs(elec->eta()),mithep::TH2DAsymErr::kStatErrHigh)/pow((1-ElectronFakeRateHist_PtEta->GetError(elefopt,fabs(elec->eta()),mithep::TH2DAsymErr::kStatErrHigh)),2);
-      eventInfo->set_weight("emu_e_fakerate", elefakerate);
+      eventInfo->set_weight(slot_emu_e_fakerate_, elefakerate);
     }
 
     if (do_emu_m_fakerates_) {
@@ -2083,7 +2143,7 @@ namespace ic {
       double mufakerate = muprob/(1.0 - muprob);
       //double mufakerate_errlow = MuonFakeRateHist_PtEta->GetError(mufopt,fabs(muon->eta()),mithep::TH2DAsymErr::kStatErrLow)/pow((1-MuonFakeRateHist_PtEta->GetError(mufopt,fabs(muon->eta()),mithep::TH2DAsymErr::kStatErrLow)),2);
       //double mufakerate_errhigh = MuonFakeRateHist_PtEta->GetError(mufopt,fabs(muon->eta()),mithep::TH2DAsymErr::kStatErrHigh)/pow((1-MuonFakeRateHist_PtEta->GetError(mufopt,fabs(muon->eta()),mithep::TH2DAsymErr::kStatErrHigh)),2);
-      eventInfo->set_weight("emu_m_fakerate", mufakerate);
+      eventInfo->set_weight(slot_emu_m_fakerate_, mufakerate);
     }
 
     if (do_etau_fakerate_ && era_!=era::data_2015 && era_!=era::data_2016) {
@@ -2102,20 +2162,20 @@ namespace ic {
       if (matches.size() > 0) {
         if (mc_ == mc::fall11_42X) {
           if (fabs(tau_cand[0]->eta()) < 1.5) {
-            if (tau->decay_mode() == 0) eventInfo->set_weight("etau_fakerate", 1.142);
-            if (tau->decay_mode() == 1) eventInfo->set_weight("etau_fakerate", 1.617);
+            if (tau->decay_mode() == 0) eventInfo->set_weight(slot_etau_fakerate_, 1.142);
+            if (tau->decay_mode() == 1) eventInfo->set_weight(slot_etau_fakerate_, 1.617);
           } else {
-            if (tau->decay_mode() == 0) eventInfo->set_weight("etau_fakerate", 0.859);
-            if (tau->decay_mode() == 1) eventInfo->set_weight("etau_fakerate", 0.610);
+            if (tau->decay_mode() == 0) eventInfo->set_weight(slot_etau_fakerate_, 0.859);
+            if (tau->decay_mode() == 1) eventInfo->set_weight(slot_etau_fakerate_, 0.610);
           }
         } else {
           if (era_ == era::data_2012_rereco) {
             if (fabs(tau_cand[0]->eta()) < 1.5) {
-              if (tau->decay_mode() == 0) eventInfo->set_weight("etau_fakerate", 1.37);
-              if (tau->decay_mode() == 1) eventInfo->set_weight("etau_fakerate", 2.18);
+              if (tau->decay_mode() == 0) eventInfo->set_weight(slot_etau_fakerate_, 1.37);
+              if (tau->decay_mode() == 1) eventInfo->set_weight(slot_etau_fakerate_, 2.18);
             } else {
-              if (tau->decay_mode() == 0) eventInfo->set_weight("etau_fakerate", 1.11);
-              if (tau->decay_mode() == 1) eventInfo->set_weight("etau_fakerate", 0.47);
+              if (tau->decay_mode() == 0) eventInfo->set_weight(slot_etau_fakerate_, 1.11);
+              if (tau->decay_mode() == 1) eventInfo->set_weight(slot_etau_fakerate_, 0.47);
             }
           }
         }
@@ -2149,7 +2209,7 @@ namespace ic {
           } else etau_fakerate_1=1.11;
         }
       }
-     eventInfo->set_weight("etau_fakerate",etau_fakerate_1*etau_fakerate_2);
+     eventInfo->set_weight(slot_etau_fakerate_,etau_fakerate_1*etau_fakerate_2);
     }
 
     if (do_mtau_fakerate_ && era_!=era::data_2016) {
@@ -2162,7 +2222,7 @@ namespace ic {
       std::vector<std::pair<Candidate*, GenParticle*> > matches = MatchByDR(tau_cand, parts, 0.5, true, true);
       //We didnt use this for any of 2011 or 2012 in the end, just leaving the code here with a weight of 1 for now.
       if (matches.size() > 0) {
-       eventInfo->set_weight("mtau_fakerate", 1.00);
+       eventInfo->set_weight(slot_mtau_fakerate_, 1.00);
       }
     }
    
@@ -2217,7 +2277,7 @@ namespace ic {
           }
         }
       }
-     eventInfo->set_weight("mtau_fakerate",mtau_fakerate_1*mtau_fakerate_2);
+     eventInfo->set_weight(slot_mtau_fakerate_,mtau_fakerate_1*mtau_fakerate_2);
     }
 
 
@@ -2225,7 +2285,7 @@ namespace ic {
     if (do_tau_mode_scale_) {
       Tau const* tau = dynamic_cast<Tau const*>(dilepton[0]->GetCandidate("lepton2"));
       if (tau->decay_mode() == 0 && era_ == era::data_2012_rereco) {
-        eventInfo->set_weight("tau_mode_scale", 0.88);
+        eventInfo->set_weight(slot_tau_mode_scale_, 0.88);
       }
     }
 
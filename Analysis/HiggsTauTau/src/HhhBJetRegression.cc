@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -17,7 +17,7 @@ namespace ic {
   HhhBJetRegression::HhhBJetRegression(std::string const& name) : ModuleBase(name) {
     jets_label_ = "pfJetsPFlow";
     regression_mva_file_ = "input/Hhh_regression_mva/factoryJetRegNewGenJetsAll_BDT.weights.xml";
-    regression_reader_ = nullptr;
+    regression_forest_ = nullptr;
   }
 
   HhhBJetRegression::~HhhBJetRegression() {
@@ -30,23 +30,10 @@ namespace ic {
     std::cout << "-------------------------------------" << std::endl;    
     std::cout << boost::format(param_fmt()) % "jets_label"  % jets_label_;
     std::cout << boost::format(param_fmt()) % "regression_mva_file"     % regression_mva_file_;
-    //regression_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    regression_reader_ = new TMVA::Reader();
-    std::vector<TMVA::Reader *> readers = {regression_reader_};
-    for (auto & reader : readers) {
-	  reader->AddVariable("jetBtag", &prebjet_bcsv );
-	  reader->AddVariable("jetPt", &prebjet_pt );
-      reader->AddVariable("jetEta", &prebjet_eta );
-	  reader->AddVariable("jetChf", &prebjet_chf );
-	  reader->AddVariable("jetPhf", &prebjet_phf );
-	  reader->AddVariable("jetNhf", &prebjet_nhf );
-	  reader->AddVariable("jetElf", &prebjet_elf );
-	  reader->AddVariable("jetMuf", &prebjet_muf );
-	  reader->AddSpectator("jetPt",  &prebjet_pt);
-	  reader->AddSpectator("jetGenPt",  &prebjet_genPt );
-	  reader->AddSpectator("jetEta",  &prebjet_eta);
-    }
-    regression_reader_->BookMVA("BDT", regression_mva_file_);
+    regression_forest_ = new BDTForest(regression_mva_file_);
+    // The spectators jetPt, jetGenPt and jetEta are not inputs to the forest
+    regression_forest_->CheckVariables({"jetBtag", "jetPt", "jetEta", "jetChf",
+                                        "jetPhf", "jetNhf", "jetElf", "jetMuf"});
     return 0;
   }
   
@@ -58,35 +45,35 @@ namespace ic {
       prebjets_clone.push_back(*(prebjets[i]));
     }
 
-    std::vector<PFJet>::iterator it;
+    // Fill the inputs for every jet first, so the forest can evaluate them
+    // all in one go
+    unsigned nvars = regression_forest_->variables().size();
+    features_.resize(prebjets_clone.size() * nvars);
+    scale_factors_.resize(prebjets_clone.size());
+    for (unsigned i = 0; i < prebjets_clone.size(); ++i) {
+      PFJet const& jet = prebjets_clone[i];
+      float *vars = &features_[i * nvars];
+      vars[0] = jet.GetBDiscriminator("combinedSecondaryVertexBJetTags");
+      vars[1] = jet.pt();
+      vars[2] = jet.eta();
+      vars[3] = jet.charged_had_energy_frac();
+      vars[4] = jet.photon_energy_frac();
+      vars[5] = jet.neutral_had_energy_frac();
+      vars[6] = jet.electron_energy_frac();
+      vars[7] = jet.muon_energy_frac();
+    }
+    regression_forest_->Evaluate(features_.data(), prebjets_clone.size(), scale_factors_.data());
+
     std::vector<PFJet> vec_out;
     std::vector<PFJet*> ptr_vec_out;
-    for(it=prebjets_clone.begin(); it!=prebjets_clone.end(); ++it) { 
-      prebjet_bcsv   =0;
-      prebjet_pt     =0;
-      prebjet_genPt  =0;
-      prebjet_eta    =0;
-      prebjet_chf    =0;
-      prebjet_elf    =0;
-      prebjet_muf    =0;
-      prebjet_nhf    =0;
-      prebjet_phf    =0;
-
-      prebjet_bcsv   = (*it).GetBDiscriminator("combinedSecondaryVertexBJetTags");
-      prebjet_pt     = (*it).pt();
-      prebjet_eta    = (*it).eta();
-      prebjet_chf    = (*it).charged_had_energy_frac();
-      prebjet_elf    = (*it).electron_energy_frac();
-      prebjet_muf    = (*it).muon_energy_frac();
-      prebjet_nhf    = (*it).neutral_had_energy_frac();
-      prebjet_phf    = (*it).photon_energy_frac();
-          
-      double SF = regression_reader_->EvaluateMVA("BDT");
-      double pt_corr = prebjet_pt*SF;
-      double E_corr = (*it).energy()*SF;
-      (*it).set_pt(pt_corr);
-      (*it).set_energy(E_corr);
-      vec_out.push_back(*it); 
+    for (unsigned i = 0; i < prebjets_clone.size(); ++i) {
+      PFJet & jet = prebjets_clone[i];
+      double SF = scale_factors_[i];
+      double pt_corr = float(jet.pt())*SF;
+      double E_corr = jet.energy()*SF;
+      jet.set_pt(pt_corr);
+      jet.set_energy(E_corr);
+      vec_out.push_back(jet);
     }
     //Set of corrected jets saved as a new collection. Each jet will exist even though the correction is only valid for pt>20.
     event->Add(jets_label_+"CorrectedProduct", vec_out);
@@ -101,7 +88,7 @@ namespace ic {
   }
 
   int HhhBJetRegression::PostAnalysis() {
-    if (regression_reader_) delete regression_reader_;
+    if (regression_forest_) delete regression_forest_;
     return 0;
   }
 
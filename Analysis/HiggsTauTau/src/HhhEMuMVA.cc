@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -20,8 +20,8 @@ namespace ic {
     jets_label_ = "pfJetsPFlow";
     gf_mva_file_ = "input/Hhh_mva/SingleBDT_BDTG.weights.xml";
     // vbf_mva_file_ = "input/vbf_mva/HttEmu_vbf_v1.weights.xml";
-    gf_reader_ = nullptr;
-    // vbf_reader_ = nullptr;
+    gf_forest_ = nullptr;
+    // vbf_forest_ = nullptr;
   }
 
   HhhEMuMVA::~HhhEMuMVA() {
@@ -36,21 +36,9 @@ namespace ic {
     std::cout << boost::format(param_fmt()) % "met_label"       % met_label_;
     std::cout << boost::format(param_fmt()) % "gf_mva_file"     % gf_mva_file_;
     // std::cout << boost::format(param_fmt()) % "vbf_mva_file"    % vbf_mva_file_;
-    gf_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    // vbf_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    std::vector<TMVA::Reader *> readers = {gf_reader_};
-    for (auto & r : readers) {
-      r->AddVariable("pt_1", &fpt_1_);
-      r->AddVariable("met", &fmet_);
-      r->AddVariable("mt_ll", &fmt_ll_);
-      r->AddVariable("pzetamiss", &fpzetamiss_);
-      r->AddVariable("pt_2", &fpt_2_);
-			r->AddVariable("emu_dphi",&femu_dphi_);
-      r->AddVariable("pzeta", &fpzeta_);
-      // r->AddVariable("d02", &mu_dxy_);
-    }
-    // vbf_reader_->BookMVA("BDTG", vbf_mva_file_);
-    gf_reader_->BookMVA("BDTG", gf_mva_file_);
+    gf_forest_ = new BDTForest(gf_mva_file_);
+    // vbf_forest_ = new BDTForest(vbf_mva_file_);
+    gf_forest_->CheckVariables({"pt_1", "met", "mt_ll", "pzetamiss", "pt_2", "emu_dphi", "pzeta"});
     return 0;
   }
   
@@ -71,14 +59,15 @@ namespace ic {
 		fpt_2_ = (float) lep2->pt();
     fmt_ll_ = (float) MT(ditau, met);
 		fmet_ = (float) met->pt();
-    event->Add("em_gf_mva", gf_reader_->EvaluateMVA("BDTG"));
-    // event->Add("em_vbf_mva", vbf_reader_->EvaluateMVA("BDTG"));
+    float const vars[] = {fpt_1_, fmet_, fmt_ll_, fpzetamiss_, fpt_2_, femu_dphi_, fpzeta_};
+    event->Add("em_gf_mva", gf_forest_->Evaluate(vars));
+    // event->Add("em_vbf_mva", vbf_forest_->Evaluate(vars));
     return 0;
   }
 
   int HhhEMuMVA::PostAnalysis() {
-    if (gf_reader_) delete gf_reader_;
-    // if (vbf_reader_) delete vbf_reader_;
+    if (gf_forest_) delete gf_forest_;
+    // if (vbf_forest_) delete vbf_forest_;
     return 0;
   }
 
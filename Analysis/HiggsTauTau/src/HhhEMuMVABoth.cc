@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -21,8 +21,8 @@ namespace ic {
 		gf_mva_file_bdt_ = "input/Hhh_mva/HhhEmuMVAInit_BDT.weights.xml";
 		gf_mva_file_bdtg_ = "input/Hhh_mva/HhhEmuMVAInit_BDTG.weights.xml";
 		mva_input_data_ = "scripts/TMVAinputs.dat";
-		gf_reader_bdt_ = nullptr;
-		gf_reader_bdtg_ = nullptr;
+		gf_forest_bdt_ = nullptr;
+		gf_forest_bdtg_ = nullptr;
 	}
 
 	HhhEMuMVABoth::~HhhEMuMVABoth() {
@@ -37,9 +37,9 @@ namespace ic {
 		std::cout << boost::format(param_fmt()) % "met_label"       % met_label_;
 		std::cout << boost::format(param_fmt()) % "gf_mva_file"     % gf_mva_file_bdt_;
 		std::cout << boost::format(param_fmt()) % "gf_mva_file_2"    % gf_mva_file_bdtg_;
-		gf_reader_bdt_ = new TMVA::Reader("!Color:!Silent:Error");
-		gf_reader_bdtg_ = new TMVA::Reader("!Color:!Silent:Error");
-		std::vector<TMVA::Reader *> readers = {gf_reader_bdt_,gf_reader_bdtg_};
+		gf_forest_bdt_ = new BDTForest(gf_mva_file_bdt_);
+		gf_forest_bdtg_ = new BDTForest(gf_mva_file_bdtg_);
+		std::vector<BDTForest *> forests = {gf_forest_bdt_,gf_forest_bdtg_};
 
 /*		std::vector<std::string> vars;
 		ifstream parafile(mva_input_data_.c_str());
@@ -59,36 +59,10 @@ namespace ic {
 
 
 
-		for (auto & r : readers) {
-			/*for(unsigned int varit=0;varit<vars.size();++varit){
-				r->AddVariable((vars.at(varit)).c_str(),&(floatvars.at(varit)));
-			}*/
-			r->AddVariable("pt_1",&fpt_1_);
-			r->AddVariable("pt_2",&fpt_2_);
-			r->AddVariable("met",&fmet_);
-			r->AddVariable("mt_ll",&fmt_ll_);
-			r->AddVariable("pzeta",&fpzeta_);
-			r->AddVariable("pzetamiss",&fpzetamiss_);
-			r->AddVariable("emu_dphi",&femu_dphi_);
-//			r->AddVariable("prebjetbcsv_1",&fprebjetbcsv_1_);
-//			r->AddVariable("prebjetbcsv_2",&fprebjetbcsv_2_);
-//			r->AddVariable("prebjet_deta",&fprebjet_deta_);
-			r->AddSpectator("n_prebjets",&nprebjets_);
-			
-
-
-			/*r->AddVariable("pt_1", &fpt_1_);
-				r->AddVariable("met", &fmet_);
-				r->AddVariable("mt_ll", &fmt_ll_);
-				r->AddVariable("pzetamiss", &fpzetamiss_);
-				r->AddVariable("pt_2", &fpt_2_);
-				r->AddVariable("emu_dphi",&femu_dphi_);
-				r->AddVariable("pzeta", &fpzeta_);
-			 */
-			// r->AddVariable("d02", &mu_dxy_);
+		// The spectator n_prebjets is not an input to the forests
+		for (auto & f : forests) {
+			f->CheckVariables({"pt_1", "pt_2", "met", "mt_ll", "pzeta", "pzetamiss", "emu_dphi"});
 		}
-		gf_reader_bdtg_->BookMVA("BDTG", gf_mva_file_bdtg_);
-		gf_reader_bdt_->BookMVA("BDT", gf_mva_file_bdt_);
 		return 0;
 	}
 
@@ -137,14 +111,15 @@ namespace ic {
 		}
 		
 
-		event->Add("em_gf_mva_bdtg", gf_reader_bdtg_->EvaluateMVA("BDTG"));
-		event->Add("em_gf_mva_bdt", gf_reader_bdt_->EvaluateMVA("BDT"));
+		float const vars[] = {fpt_1_, fpt_2_, fmet_, fmt_ll_, fpzeta_, fpzetamiss_, femu_dphi_};
+		event->Add("em_gf_mva_bdtg", gf_forest_bdtg_->Evaluate(vars));
+		event->Add("em_gf_mva_bdt", gf_forest_bdt_->Evaluate(vars));
 		return 0;
 	}
 
 	int HhhEMuMVABoth::PostAnalysis() {
-		if (gf_reader_bdt_) delete gf_reader_bdt_;
-		if (gf_reader_bdtg_) delete gf_reader_bdtg_;
+		if (gf_forest_bdt_) delete gf_forest_bdt_;
+		if (gf_forest_bdtg_) delete gf_forest_bdtg_;
 		return 0;
 	}
 
@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -20,8 +20,8 @@ namespace ic {
     jets_label_ = "pfJetsPFlow";
     gf_mva_file_ = "input/Hhh_mva/StageOne_BDTG.weights.xml";
     gf_mva_file_2_ = "input/Hhh_mva/StageTwo_90pc_BDTG.weights.xml";
-    gf_reader_ = nullptr;
-    gf_reader_2_ = nullptr;
+    gf_forest_ = nullptr;
+    gf_forest_2_ = nullptr;
   }
 
   HhhEMuMVATwoStage::~HhhEMuMVATwoStage() {
@@ -36,21 +36,12 @@ namespace ic {
     std::cout << boost::format(param_fmt()) % "met_label"       % met_label_;
     std::cout << boost::format(param_fmt()) % "gf_mva_file"     % gf_mva_file_;
     std::cout << boost::format(param_fmt()) % "gf_mva_file_2"    % gf_mva_file_2_;
-    gf_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    gf_reader_2_ = new TMVA::Reader("!Color:!Silent:Error");
-    std::vector<TMVA::Reader *> readers = {gf_reader_,gf_reader_2_};
-    for (auto & r : readers) {
-      r->AddVariable("pt_1", &fpt_1_);
-      r->AddVariable("met", &fmet_);
-      r->AddVariable("mt_ll", &fmt_ll_);
-      r->AddVariable("pzetamiss", &fpzetamiss_);
-      r->AddVariable("pt_2", &fpt_2_);
-			r->AddVariable("emu_dphi",&femu_dphi_);
-      r->AddVariable("pzeta", &fpzeta_);
-      // r->AddVariable("d02", &mu_dxy_);
+    gf_forest_ = new BDTForest(gf_mva_file_);
+    gf_forest_2_ = new BDTForest(gf_mva_file_2_);
+    std::vector<BDTForest *> forests = {gf_forest_,gf_forest_2_};
+    for (auto & f : forests) {
+      f->CheckVariables({"pt_1", "met", "mt_ll", "pzetamiss", "pt_2", "emu_dphi", "pzeta"});
     }
-    gf_reader_2_->BookMVA("BDTG", gf_mva_file_2_);
-    gf_reader_->BookMVA("BDTG", gf_mva_file_);
     return 0;
   }
   
@@ -71,14 +62,15 @@ namespace ic {
 		fpt_2_ = (float) lep2->pt();
     fmt_ll_ = (float) MT(ditau, met);
 		fmet_ = (float) met->pt();
-    event->Add("em_gf_mva_stage_one", gf_reader_->EvaluateMVA("BDTG"));
-    event->Add("em_gf_mva_stage_two", gf_reader_2_->EvaluateMVA("BDTG"));
+    float const vars[] = {fpt_1_, fmet_, fmt_ll_, fpzetamiss_, fpt_2_, femu_dphi_, fpzeta_};
+    event->Add("em_gf_mva_stage_one", gf_forest_->Evaluate(vars));
+    event->Add("em_gf_mva_stage_two", gf_forest_2_->Evaluate(vars));
     return 0;
   }
 
   int HhhEMuMVATwoStage::PostAnalysis() {
-    if (gf_reader_) delete gf_reader_;
-    if (gf_reader_2_) delete gf_reader_2_;
+    if (gf_forest_) delete gf_forest_;
+    if (gf_forest_2_) delete gf_forest_2_;
     return 0;
   }
 
@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -22,7 +22,7 @@ namespace ic {
 gf_mva_file_bdt_ = "input/Hhh_mva/2jetinclusive_leppt_BDT.weights.xml";
 		//gf_mva_file_bdtg_ = "input/Hhh_mva/final_with_bpt_BDTG.weights.xml";
 		mva_input_data_ = "scripts/TMVAinputshad.dat";
-		gf_reader_bdt_ = nullptr;
+		gf_forest_bdt_ = nullptr;
 	}
 
 	HhhMTMVABoth::~HhhMTMVABoth() {
@@ -37,45 +37,10 @@ gf_mva_file_bdt_ = "input/Hhh_mva/2jetinclusive_leppt_BDT.weights.xml";
 		std::cout << boost::format(param_fmt()) % "met_label"       % met_label_;
 		std::cout << boost::format(param_fmt()) % "gf_mva_file"     % gf_mva_file_bdt_;
 		//std::cout << boost::format(param_fmt()) % "gf_mva_file_2"    % gf_mva_file_bdtg_;
-		gf_reader_bdt_ = new TMVA::Reader("!Color:!Silent:Error");
-	//	gf_reader_bdtg_ = new TMVA::Reader("!Color:!Silent:Error");
-		std::vector<TMVA::Reader *> readers = {gf_reader_bdt_};
-
-		
-
-
-
-		for (auto & r : readers) {
-			r->AddVariable("met",&fmet_);
-			r->AddVariable("mt_1",&fmt_1_);
-			r->AddVariable("emu_dphi",&femu_dphi_);
-			r->AddVariable("pzeta",&fpzeta_);
-     	r->AddVariable("pt_1",&fpt_1_);
-			r->AddVariable("pt_2",&fpt_2_);
-			r->AddSpectator("n_prebjets",&nprebjets_);
-			r->AddSpectator("prebjetbcsv_1",&fprebjetbcsv_1_);
-			r->AddSpectator("prebjetbcsv_2",&fprebjetbcsv_2_);
-			
-			
-/*			r->AddVariable("mt_2",&fmt_2_);
-			r->AddVariable("pt_1",&fpt_1_);
-			r->AddVariable("pt_2",&fpt_2_);
-			r->AddVariable("mutau_dR",&fmutau_dR_);
-			r->AddVariable("prebjetpt_bb",&fprebjetpt_bb_);
-			r->AddVariable("prebjet_dR",&fprebjet_dR_);
-			r->AddVariable("prebjetpt_1",&fprebjetpt_1_);
-			r->AddVariable("prebjetpt_2",&fprebjetpt_2_);
-			r->AddVariable("pt_tt",&fpt_tt_);
-			r->AddSpectator("mt_1",&fmt_1_);
-			r->AddSpectator("n_prebjets",&nprebjets_);
-			r->AddSpectator("prebjetbcsv_1",&fprebjetbcsv_1_);
-			r->AddSpectator("prebjetbcsv_2",&fprebjetbcsv_2_);
-			*/
-
-
-
-		}
-		gf_reader_bdt_->BookMVA("BDT", gf_mva_file_bdt_);
+		gf_forest_bdt_ = new BDTForest(gf_mva_file_bdt_);
+		// The spectators n_prebjets, prebjetbcsv_1 and prebjetbcsv_2 are not
+		// inputs to the forest
+		gf_forest_bdt_->CheckVariables({"met", "mt_1", "emu_dphi", "pzeta", "pt_1", "pt_2"});
 		return 0;
 	}
 
@@ -126,12 +91,13 @@ gf_mva_file_bdt_ = "input/Hhh_mva/2jetinclusive_leppt_BDT.weights.xml";
 		
 	
 
-		event->Add("em_gf_mva_bdt", gf_reader_bdt_->EvaluateMVA("BDT"));
+		float const vars[] = {fmet_, fmt_1_, femu_dphi_, fpzeta_, fpt_1_, fpt_2_};
+		event->Add("em_gf_mva_bdt", gf_forest_bdt_->Evaluate(vars));
 		return 0;
 	}
 
 	int HhhMTMVABoth::PostAnalysis() {
-		if (gf_reader_bdt_) delete gf_reader_bdt_;
+		if (gf_forest_bdt_) delete gf_forest_bdt_;
 		return 0;
 	}
 
@@ -5,7 +5,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "TMVA/Reader.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/BDTForest.h"
 #include "Math/VectorUtil.h"
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -22,8 +22,8 @@ namespace ic {
     //gf_mva_file_2_ = "input/Hhh_mva/2jet2tag_leppt_BDT.weights.xml";
 		gf_mva_file_ = "input/Hhh_mva/2jet1tag_leppt_BDT.weights.xml";
 		gf_mva_file_2_ = "input/Hhh_mva/2jet2tag_leppt_BDT.weights.xml";
-    gf_reader_ = nullptr;
-    gf_reader_2_ = nullptr;
+    gf_forest_ = nullptr;
+    gf_forest_2_ = nullptr;
   }
 
   HhhMTMVACategory::~HhhMTMVACategory() {
@@ -38,40 +38,14 @@ namespace ic {
     std::cout << boost::format(param_fmt()) % "met_label"       % met_label_;
     std::cout << boost::format(param_fmt()) % "gf_mva_file"     % gf_mva_file_;
     std::cout << boost::format(param_fmt()) % "gf_mva_file_2"    % gf_mva_file_2_;
-    gf_reader_ = new TMVA::Reader("!Color:!Silent:Error");
-    gf_reader_2_ = new TMVA::Reader("!Color:!Silent:Error");
-    std::vector<TMVA::Reader *> readers = {gf_reader_,gf_reader_2_};
-    for (auto & r : readers) {
-			r->AddVariable("met",&fmet_);
-			r->AddVariable("mt_1",&fmt_1_);
-			r->AddVariable("emu_dphi",&femu_dphi_);
-			r->AddVariable("pzeta",&fpzeta_);
-     	r->AddVariable("pt_1",&fpt_1_);
-			r->AddVariable("pt_2",&fpt_2_);
-			r->AddSpectator("n_prebjets",&nprebjets_);
-			r->AddSpectator("prebjetbcsv_1",&fprebjetbcsv_1_);
-			r->AddSpectator("prebjetbcsv_2",&fprebjetbcsv_2_);
-			
-		/*	r->AddVariable("mt_2",&fmt_2_);
-			r->AddVariable("pt_1",&fpt_1_);
-			r->AddVariable("pt_2",&fpt_2_);
-			r->AddVariable("mutau_dR",&fmutau_dR_);
-			r->AddVariable("prebjetpt_bb",&fprebjetpt_bb_);
-			r->AddVariable("prebjet_dR",&fprebjet_dR_);
-			r->AddVariable("prebjetpt_1",&fprebjetpt_1_);
-			r->AddVariable("prebjetpt_2",&fprebjetpt_2_);
-			r->AddVariable("pt_tt",&fpt_tt_);
-			r->AddSpectator("mt_1",&fmt_1_);
-			r->AddSpectator("n_prebjets",&nprebjets_);
-			r->AddSpectator("prebjetbcsv_1",&fprebjetbcsv_1_);
-			r->AddSpectator("prebjetbcsv_2",&fprebjetbcsv_2_);
-			*/
-
-			
-      // r->AddVariable("d02", &mu_dxy_);
+    gf_forest_ = new BDTForest(gf_mva_file_);
+    gf_forest_2_ = new BDTForest(gf_mva_file_2_);
+    std::vector<BDTForest *> forests = {gf_forest_,gf_forest_2_};
+    // The spectators n_prebjets, prebjetbcsv_1 and prebjetbcsv_2 are not
+    // inputs to the forests
+    for (auto & f : forests) {
+      f->CheckVariables({"met", "mt_1", "emu_dphi", "pzeta", "pt_1", "pt_2"});
     }
-    gf_reader_2_->BookMVA("BDT", gf_mva_file_2_);
-    gf_reader_->BookMVA("BDT", gf_mva_file_);
     return 0;
   }
   
@@ -120,13 +94,14 @@ namespace ic {
 		}
 
 
+		float const vars[] = {fmet_, fmt_1_, femu_dphi_, fpzeta_, fpt_1_, fpt_2_};
 		if(nprebjets_>1&&fprebjetbcsv_1_>0.679&&fprebjetbcsv_2_<=0.679){
-    event->Add("mt_bdt_2jet1tag", gf_reader_->EvaluateMVA("BDT"));
+    event->Add("mt_bdt_2jet1tag", gf_forest_->Evaluate(vars));
 		event->Add("mt_bdt_2jet2tag",1.);
 		}
 		else if(nprebjets_>1&&fprebjetbcsv_1_>0.679&&fprebjetbcsv_2_>0.679){
 		event->Add("mt_bdt_2jet1tag",1.);
-		event->Add("mt_bdt_2jet2tag",gf_reader_2_->EvaluateMVA("BDT"));
+		event->Add("mt_bdt_2jet2tag",gf_forest_2_->Evaluate(vars));
 		}
 
 		else{
@@ -138,8 +113,8 @@ namespace ic {
   }
 
   int HhhMTMVACategory::PostAnalysis() {
-    if (gf_reader_) delete gf_reader_;
-    if (gf_reader_2_) delete gf_reader_2_;
+    if (gf_forest_) delete gf_forest_;
+    if (gf_forest_2_) delete gf_forest_2_;
     return 0;
   }
 
@@ -9,6 +9,8 @@
 #include "TH1.h"
 #include <iostream>
 #include <vector>
+#include <stdexcept>
+#include <algorithm>
 #include "TROOT.h"
 #include "TGraphErrors.h"
 #include "HiggsTauTau/interface/NLOWeighting.h"
@@ -72,6 +74,12 @@ float returnNLOweight(Int_t mass, Int_t tanb, Double_t pt){
 
 }
 
+TGraphErrors* findNLOweight(Int_t mass, Int_t tanb){
+  auto iter = std::find(marray.begin(), marray.end(), mass);
+  if(iter == marray.end() || tanb < 1 || tanb > 60) return nullptr;
+  return func[std::distance(marray.begin(), iter)][tanb-1];
+}
+
 }
 
 namespace ic {
@@ -85,6 +93,21 @@ namespace ic {
   }
 
   int NLOWeighting::PreAnalysis() {
+    if (var_masses_.size() != var_tanbs_.size()) {
+      throw std::runtime_error("[NLOWeighting] var_masses and var_tanbs have different sizes");
+    }
+    std::vector<std::string> labels;
+    for (unsigned i = 0; i < var_masses_.size(); ++i) {
+      TGraphErrors *graph = nloweights::findNLOweight(var_masses_[i], var_tanbs_[i]);
+      if (!graph) {
+        std::cout << "[WARNING] Invalid NLO weight point " << var_masses_[i] << ", "
+                  << var_tanbs_[i] << " -> weight 1" << std::endl;
+      }
+      var_funcs_.push_back(graph);
+      labels.push_back("mssm_nlo_wt_" + std::to_string(var_masses_[i]) + "_" +
+                       std::to_string(var_tanbs_[i]));
+    }
+    var_wts_ = WeightVector(labels);
     if (fs_) {
       tout = fs_->make<TTree>("nlo_pt", "nlo_pt");
       tout->Branch("wt_nlo_pt", &nlo_wt_);
@@ -116,6 +139,13 @@ namespace ic {
     double mssm_nlo_wt = nloweights::returnNLOweight(500, 30, mssm_nlo_pt);
     event->Add("mssm_nlo_wt", mssm_nlo_wt);
     event->Add("mssm_nlo_pt", mssm_nlo_pt);
+    if (var_funcs_.size() > 0) {
+      double pt = std::min(mssm_nlo_pt, 800.);
+      for (unsigned i = 0; i < var_funcs_.size(); ++i) {
+        var_wts_.set(i, var_funcs_[i] ? var_funcs_[i]->Eval(pt) : 1.0);
+      }
+      event->Add("mssm_nlo_wts", &var_wts_);
+    }
     nlo_wt_ = mssm_nlo_wt;
     nlo_pt_ = mssm_nlo_pt;
     tout->Fill();
@@ -1,29 +1,76 @@
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/SOverBTools.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include "TH1.h"
 #include "TAxis.h"
 
 namespace ch {
 
+double Significance(double s, double b, SignificanceMetric metric) {
+  if (b <= 0.) return 0.;
+  switch (metric) {
+    case SignificanceMetric::s_over_b:
+      return s / b;
+    case SignificanceMetric::s_over_root_b:
+      return s / std::sqrt(b);
+    case SignificanceMetric::asimov_z:
+      return std::sqrt(std::max(0., 2. * ((s + b) * std::log(1. + s / b) - s)));
+  }
+  return 0.;
+}
+
+HistIntegrator::HistIntegrator(TH1 const* hist) {
+  TAxis const* axis = hist->GetXaxis();
+  int nbins = axis->GetNbins();
+  edges_.resize(nbins + 1);
+  sums_.resize(nbins + 1);
+  sums_[0] = 0.;
+  for (int i = 1; i <= nbins; ++i) {
+    edges_[i - 1] = axis->GetBinLowEdge(i);
+    sums_[i] = sums_[i - 1] + hist->GetBinContent(i);
+  }
+  edges_[nbins] = axis->GetBinUpEdge(nbins);
+}
+
+double HistIntegrator::Cumulative(double x) const {
+  if (x <= edges_.front()) return 0.;
+  if (x >= edges_.back()) return sums_.back();
+  // The bin containing x, with x on an edge belonging to the bin above as in
+  // TAxis::FindFixBin
+  unsigned k = std::upper_bound(edges_.begin(), edges_.end(), x) -
+               edges_.begin() - 1;
+  return sums_[k] + (sums_[k + 1] - sums_[k]) * (x - edges_[k]) /
+                        (edges_[k + 1] - edges_[k]);
+}
+
+double HistIntegrator::Integral(double xmin, double xmax) const {
+  return Cumulative(xmax) - Cumulative(xmin);
+}
+
 SOverBInfo::SOverBInfo(TH1F const* sig, TH1F const* bkg, unsigned steps,
                        double frac) {
-  double xmin = sig->GetXaxis()->GetXmin();
-  double xmax = sig->GetXaxis()->GetXmax();
+  *this = SOverBInfo(HistIntegrator(sig), HistIntegrator(bkg), steps, frac);
+}
+
+SOverBInfo::SOverBInfo(HistIntegrator const& sig, HistIntegrator const& bkg,
+                       unsigned steps, double frac) {
+  double xmin = sig.edges().front();
+  double xmax = sig.edges().back();
   double step_size = (xmax - xmin) / static_cast<double>(steps);
-  double sig_tot = sig->Integral();
+  double sig_tot = sig.Total();
   double lower_limit = 0;
   double upper_limit = 0;
   double ofrac = (1. - frac) / 2.;
   for (unsigned j = 0; j < steps; ++j) {
-    double integral = ch::IntegrateFloatRange(
-        sig, xmin, xmin + (step_size * static_cast<double>(j)));
+    double integral = sig.Cumulative(xmin + (step_size * static_cast<double>(j)));
     if (integral / sig_tot > ofrac) {
       lower_limit = xmin + (step_size * static_cast<double>(j));
       break;
     }
   }
   for (unsigned j = 0; j < steps; ++j) {
-    double integral = ch::IntegrateFloatRange(
-        sig, xmax - (step_size * static_cast<double>(j)), xmax);
+    double integral = sig_tot - sig.Cumulative(xmax - (step_size * static_cast<double>(j)));
     if (integral / sig_tot > ofrac) {
       upper_limit = xmax - (step_size * static_cast<double>(j));
       break;
@@ -31,8 +78,114 @@ SOverBInfo::SOverBInfo(TH1F const* sig, TH1F const* bkg, unsigned steps,
   }
   x_lo = lower_limit;
   x_hi = upper_limit;
-  s = ch::IntegrateFloatRange(sig, lower_limit, upper_limit);
-  b = ch::IntegrateFloatRange(bkg, lower_limit, upper_limit);
+  s = sig.Integral(lower_limit, upper_limit);
+  b = bkg.Integral(lower_limit, upper_limit);
+}
+
+std::vector<SOverBInfo> SOverBInfos(std::vector<TH1F const*> const& sigs,
+                                    TH1F const* bkg, unsigned steps,
+                                    double frac) {
+  HistIntegrator bkg_int(bkg);
+  std::vector<SOverBInfo> result;
+  result.reserve(sigs.size());
+  for (auto sig : sigs) {
+    result.push_back(SOverBInfo(HistIntegrator(sig), bkg_int, steps, frac));
+  }
+  return result;
+}
+
+SOverBInfo OptimalWindow(HistIntegrator const& sig, HistIntegrator const& bkg,
+                         double frac, SignificanceMetric metric) {
+  std::vector<double> const& edges = sig.edges();
+  std::vector<double> const& sums = sig.sums();
+  unsigned n = edges.size() - 1;
+  double target = frac * sig.Total();
+  SOverBInfo best;
+  best.s = 0.;
+  best.b = 0.;
+  best.x_lo = 0.;
+  best.x_hi = 0.;
+  double best_sig = -1.;
+  // Two pointers: the narrowest upper edge hi for each lower edge lo never
+  // moves down as lo moves up
+  unsigned hi = 1;
+  for (unsigned lo = 0; lo < n; ++lo) {
+    if (hi <= lo) hi = lo + 1;
+    while (hi <= n && sums[hi] - sums[lo] < target) ++hi;
+    if (hi > n) break;
+    double s = sums[hi] - sums[lo];
+    double b = bkg.Integral(edges[lo], edges[hi]);
+    double value = Significance(s, b, metric);
+    if (value > best_sig) {
+      best_sig = value;
+      best.s = s;
+      best.b = b;
+      best.x_lo = edges[lo];
+      best.x_hi = edges[hi];
+    }
+  }
+  return best;
+}
+
+HistIntegrator2D::HistIntegrator2D(TH2 const* hist) {
+  TAxis const* xaxis = hist->GetXaxis();
+  TAxis const* yaxis = hist->GetYaxis();
+  nx_ = xaxis->GetNbins();
+  ny_ = yaxis->GetNbins();
+  for (unsigned i = 1; i <= nx_; ++i) x_edges_.push_back(xaxis->GetBinLowEdge(i));
+  x_edges_.push_back(xaxis->GetBinUpEdge(nx_));
+  for (unsigned j = 1; j <= ny_; ++j) y_edges_.push_back(yaxis->GetBinLowEdge(j));
+  y_edges_.push_back(yaxis->GetBinUpEdge(ny_));
+  sums_.assign((nx_ + 1) * (ny_ + 1), 0.);
+  for (unsigned i = 1; i <= nx_; ++i) {
+    for (unsigned j = 1; j <= ny_; ++j) {
+      sums_[i * (ny_ + 1) + j] = hist->GetBinContent(i, j) + At(i - 1, j) +
+                                 At(i, j - 1) - At(i - 1, j - 1);
+    }
+  }
+}
+
+SOverBInfo2D OptimalWindow2D(TH2 const* sig, TH2 const* bkg, double frac,
+                             SignificanceMetric metric) {
+  if (sig->GetNbinsX() != bkg->GetNbinsX() ||
+      sig->GetNbinsY() != bkg->GetNbinsY()) {
+    throw std::runtime_error(
+        "[OptimalWindow2D] Signal and background binnings differ");
+  }
+  HistIntegrator2D sig_int(sig);
+  HistIntegrator2D bkg_int(bkg);
+  unsigned nx = sig_int.x_edges().size() - 1;
+  unsigned ny = sig_int.y_edges().size() - 1;
+  double target = frac * sig_int.Total();
+  SOverBInfo2D best = {0., 0., 0., 0., 0., 0.};
+  double best_sig = -1.;
+  for (unsigned x_lo = 0; x_lo < nx; ++x_lo) {
+    for (unsigned x_hi = x_lo + 1; x_hi <= nx; ++x_hi) {
+      if (sig_int.Integral(x_lo, x_hi, 0, ny) < target) continue;
+      unsigned y_hi = 1;
+      for (unsigned y_lo = 0; y_lo < ny; ++y_lo) {
+        if (y_hi <= y_lo) y_hi = y_lo + 1;
+        while (y_hi <= ny &&
+               sig_int.Integral(x_lo, x_hi, y_lo, y_hi) < target) {
+          ++y_hi;
+        }
+        if (y_hi > ny) break;
+        double s = sig_int.Integral(x_lo, x_hi, y_lo, y_hi);
+        double b = bkg_int.Integral(x_lo, x_hi, y_lo, y_hi);
+        double value = Significance(s, b, metric);
+        if (value > best_sig) {
+          best_sig = value;
+          best.s = s;
+          best.b = b;
+          best.x_lo = sig_int.x_edges()[x_lo];
+          best.x_hi = sig_int.x_edges()[x_hi];
+          best.y_lo = sig_int.y_edges()[y_lo];
+          best.y_hi = sig_int.y_edges()[y_hi];
+        }
+      }
+    }
+  }
+  return best;
 }
 
 double IntegrateFloatRange(TH1F const* hist, double xmin, double xmax) {
@@ -19,6 +19,8 @@ int TheoryWeights::PreAnalysis() {
   using ROOT::Math::Pi;
   if (!fs_) return 0;
   TFileDirectory dir = fs_->mkdir(this->ModuleName());
+  pdf_wts   = WeightVector(WeightVector::LabelRange(2001, 2100));
+  scale_wts = WeightVector(WeightVector::LabelRange(1002, 1009));
   h_m_ll    = dir.make<TH1F>("m_ll",  "m_ll",   10,   60,   120);
   hpdf_m_ll = TheorySystHist(h_m_ll, &dir, 2001, 2100, "NNPDF3");
   hscale_m_ll = TheorySystHist(h_m_ll, &dir, 1002, 1009, "SCALE");
@@ -77,15 +79,17 @@ int TheoryWeights::Execute(TreeEvent* event) {
   double wt = info->total_weight();
 
   if (fs_) {
+    pdf_wts.Fill(info);
+    scale_wts.Fill(info);
     h_m_ll->Fill(pair->M(), wt);
-    hpdf_m_ll.Fill(pair->M(), wt, info);
-    hscale_m_ll.Fill(pair->M(), wt, info);
+    hpdf_m_ll.Fill(pair->M(), wt, pdf_wts);
+    hscale_m_ll.Fill(pair->M(), wt, scale_wts);
     h_pt_ll->Fill(pair->pt(), wt);
-    hpdf_pt_ll.Fill(pair->pt(), wt, info);
-    hscale_pt_ll.Fill(pair->pt(), wt, info);
+    hpdf_pt_ll.Fill(pair->pt(), wt, pdf_wts);
+    hscale_pt_ll.Fill(pair->pt(), wt, scale_wts);
     h_n_jets->Fill(jets.size(), wt);
-    hpdf_n_jets.Fill(jets.size(), wt, info);
-    hscale_n_jets.Fill(jets.size(), wt, info);
+    hpdf_n_jets.Fill(jets.size(), wt, pdf_wts);
+    hscale_n_jets.Fill(jets.size(), wt, scale_wts);
     h_pt_1->Fill(pair->At(0)->pt(), wt);
     h_pt_2->Fill(pair->At(1)->pt(), wt);
     h_eta_1->Fill(pair->At(0)->eta(), wt);
@@ -12,6 +12,7 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/Plot.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TextElement.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/SimpleParamParser.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/ShapeCache.h"
 #include <boost/algorithm/string.hpp>
 
 namespace po = boost::program_options;
@@ -29,6 +30,19 @@ double Error(TH1F const* hist) {
   return err;
 }
 
+// Yield of a histogram in the cached inputs, or zero if it is missing
+double Integral(ic::ShapeCache const& shapes, string const& file,
+                string const& category, string const& process) {
+  ic::ShapeView const* shape = shapes.Find(file, category, process);
+  return shape ? shape->Integral() : 0.;
+}
+
+double Error(ic::ShapeCache const& shapes, string const& file,
+             string const& category, string const& process) {
+  ic::ShapeView const* shape = shapes.Find(file, category, process);
+  return shape ? shape->IntegralError() : 0.;
+}
+
 void SetStyle(ic::TH1PlotElement & ele, unsigned color) {
   static bool first_time = true;
   static vector<int> colors;
@@ -151,7 +165,7 @@ int main(int argc, char* argv[]){
 
   vector<string> comp_plots;
 
-  vector<TFile *> tfiles(n, NULL);
+  ic::ShapeCache shapes;
   if (mssm_mode == 0) {
     if (mode != 2) {
     std::cout << boost::format("%-25s %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f %-9.2f\n") 
@@ -175,93 +189,88 @@ int main(int argc, char* argv[]){
     }
   }
   for (unsigned i = 0; i < inputs.size(); ++i) {
-    tfiles[i] = new TFile(inputs[i].c_str());
-    if (!tfiles[i]) {
+    if (!shapes.AddFile(inputs[i])) {
       cerr << "Error, file " << inputs[i] << " could not be opened, quitting." << endl;
       exit(1);
     }
-    tfiles[i]->cd();
-    std::string replacement = category;
-
-    gDirectory->cd(replacement.c_str());
-      if((TH1F*)gDirectory->Get("data_obs")) comp_plots.push_back("data_obs");
-      if((TH1F*)gDirectory->Get("ZTT")) comp_plots.push_back("ZTT");
-      if((TH1F*)gDirectory->Get("W")) comp_plots.push_back("W");
-      if((TH1F*)gDirectory->Get("QCD")) comp_plots.push_back("QCD");
-      if((TH1F*)gDirectory->Get("TT")) comp_plots.push_back("TT");
-      if((TH1F*)gDirectory->Get("VV")) comp_plots.push_back("VV");
-      if((TH1F*)gDirectory->Get("ZLL")) comp_plots.push_back("ZLL");
-      if((TH1F*)gDirectory->Get("ZL")) comp_plots.push_back("ZL");
-      if((TH1F*)gDirectory->Get("ZJ")) comp_plots.push_back("ZJ");
+      if (shapes.Find(inputs[i], category, "data_obs")) comp_plots.push_back("data_obs");
+      if (shapes.Find(inputs[i], category, "ZTT")) comp_plots.push_back("ZTT");
+      if (shapes.Find(inputs[i], category, "W")) comp_plots.push_back("W");
+      if (shapes.Find(inputs[i], category, "QCD")) comp_plots.push_back("QCD");
+      if (shapes.Find(inputs[i], category, "TT")) comp_plots.push_back("TT");
+      if (shapes.Find(inputs[i], category, "VV")) comp_plots.push_back("VV");
+      if (shapes.Find(inputs[i], category, "ZLL")) comp_plots.push_back("ZLL");
+      if (shapes.Find(inputs[i], category, "ZL")) comp_plots.push_back("ZL");
+      if (shapes.Find(inputs[i], category, "ZJ")) comp_plots.push_back("ZJ");
     if(mssm_mode == 0){
-      if((TH1F*)gDirectory->Get("VH125")) comp_plots.push_back("VH125");
-      if((TH1F*)gDirectory->Get("ggH125")) comp_plots.push_back("ggH125");
-      if((TH1F*)gDirectory->Get("qqH125")) comp_plots.push_back("qqH125");
+      if (shapes.Find(inputs[i], category, "VH125")) comp_plots.push_back("VH125");
+      if (shapes.Find(inputs[i], category, "ggH125")) comp_plots.push_back("ggH125");
+      if (shapes.Find(inputs[i], category, "qqH125")) comp_plots.push_back("qqH125");
     } else {
-      if((TH1F*)gDirectory->Get("ggH160")) comp_plots.push_back("ggH160");
-      if((TH1F*)gDirectory->Get("bbH160")) comp_plots.push_back("bbH160");
+      if (shapes.Find(inputs[i], category, "ggH160")) comp_plots.push_back("ggH160");
+      if (shapes.Find(inputs[i], category, "bbH160")) comp_plots.push_back("bbH160");
     }
 
     if (mode !=2) {
-      data_obs_yield[i] = (TH1F*)gDirectory->Get("data_obs") ? Integral((TH1F*)gDirectory->Get("data_obs")) : 0;
-      ztt_yield[i] =      (TH1F*)gDirectory->Get("ZTT") ? Integral((TH1F*)gDirectory->Get("ZTT")) : 0;
-      w_yield[i] =        (TH1F*)gDirectory->Get("W") ? Integral((TH1F*)gDirectory->Get("W")) : 0;
-      qcd_yield[i] =      (TH1F*)gDirectory->Get("QCD") ? Integral((TH1F*)gDirectory->Get("QCD")) : 0;
-      top_yield[i] =      (TH1F*)gDirectory->Get("TT") ? Integral((TH1F*)gDirectory->Get("TT")) : 0;
-      vv_yield[i] =       (TH1F*)gDirectory->Get("VV") ? Integral((TH1F*)gDirectory->Get("VV")) : 0;
-      zll_yield[i] =      (TH1F*)gDirectory->Get("ZLL") ? Integral((TH1F*)gDirectory->Get("ZLL")) : 0;
-      zj_yield[i] =       (TH1F*)gDirectory->Get("ZJ") ? Integral((TH1F*)gDirectory->Get("ZJ")) : 0;
-      zl_yield[i] =       (TH1F*)gDirectory->Get("ZL") ? Integral((TH1F*)gDirectory->Get("ZL")) : 0;
-      vh_yield[i] =       (TH1F*)gDirectory->Get("VH125") ? Integral((TH1F*)gDirectory->Get("VH125")) : 0;
-      ggh_yield[i] =       (TH1F*)gDirectory->Get("ggH125") ? Integral((TH1F*)gDirectory->Get("ggH125")) : 0;
-      qqh_yield[i] =       (TH1F*)gDirectory->Get("qqH125") ? Integral((TH1F*)gDirectory->Get("qqH125")) : 0;
-      data_obs_yield_err[i] = (TH1F*)gDirectory->Get("data_obs") ? Error((TH1F*)gDirectory->Get("data_obs")) : 0;
-      ztt_yield_err[i] =      (TH1F*)gDirectory->Get("ZTT") ? Error((TH1F*)gDirectory->Get("ZTT")) : 0;
-      w_yield_err[i] =        (TH1F*)gDirectory->Get("W") ? Error((TH1F*)gDirectory->Get("W")) : 0;
-      qcd_yield_err[i] =      (TH1F*)gDirectory->Get("QCD") ? Error((TH1F*)gDirectory->Get("QCD")) : 0;
-      top_yield_err[i] =      (TH1F*)gDirectory->Get("TT") ? Error((TH1F*)gDirectory->Get("TT")) : 0;
-      vv_yield_err[i] =       (TH1F*)gDirectory->Get("VV") ? Error((TH1F*)gDirectory->Get("VV")) : 0;
-      zll_yield_err[i] =      (TH1F*)gDirectory->Get("ZLL") ? Error((TH1F*)gDirectory->Get("ZLL")) : 0;
-      zj_yield_err[i] =       (TH1F*)gDirectory->Get("ZJ") ? Error((TH1F*)gDirectory->Get("ZJ")) : 0;
-      zl_yield_err[i] =       (TH1F*)gDirectory->Get("ZL") ? Error((TH1F*)gDirectory->Get("ZL")) : 0;
-      vh_yield_err[i] =       (TH1F*)gDirectory->Get("VH125") ? Error((TH1F*)gDirectory->Get("VH125")) : 0;
-      ggh_yield_err[i] =       (TH1F*)gDirectory->Get("ggH125") ? Error((TH1F*)gDirectory->Get("ggH125")) : 0;
-      qqh_yield_err[i] =       (TH1F*)gDirectory->Get("qqH125") ? Error((TH1F*)gDirectory->Get("qqH125")) : 0;
+      data_obs_yield[i] = Integral(shapes, inputs[i], category, "data_obs");
+      ztt_yield[i] =      Integral(shapes, inputs[i], category, "ZTT");
+      w_yield[i] =        Integral(shapes, inputs[i], category, "W");
+      qcd_yield[i] =      Integral(shapes, inputs[i], category, "QCD");
+      top_yield[i] =      Integral(shapes, inputs[i], category, "TT");
+      vv_yield[i] =       Integral(shapes, inputs[i], category, "VV");
+      zll_yield[i] =      Integral(shapes, inputs[i], category, "ZLL");
+      zj_yield[i] =       Integral(shapes, inputs[i], category, "ZJ");
+      zl_yield[i] =       Integral(shapes, inputs[i], category, "ZL");
+      vh_yield[i] =       Integral(shapes, inputs[i], category, "VH125");
+      ggh_yield[i] =       Integral(shapes, inputs[i], category, "ggH125");
+      qqh_yield[i] =       Integral(shapes, inputs[i], category, "qqH125");
+      data_obs_yield_err[i] = Error(shapes, inputs[i], category, "data_obs");
+      ztt_yield_err[i] =      Error(shapes, inputs[i], category, "ZTT");
+      w_yield_err[i] =        Error(shapes, inputs[i], category, "W");
+      qcd_yield_err[i] =      Error(shapes, inputs[i], category, "QCD");
+      top_yield_err[i] =      Error(shapes, inputs[i], category, "TT");
+      vv_yield_err[i] =       Error(shapes, inputs[i], category, "VV");
+      zll_yield_err[i] =      Error(shapes, inputs[i], category, "ZLL");
+      zj_yield_err[i] =       Error(shapes, inputs[i], category, "ZJ");
+      zl_yield_err[i] =       Error(shapes, inputs[i], category, "ZL");
+      vh_yield_err[i] =       Error(shapes, inputs[i], category, "VH125");
+      ggh_yield_err[i] =       Error(shapes, inputs[i], category, "ggH125");
+      qqh_yield_err[i] =       Error(shapes, inputs[i], category, "qqH125");
     } else {
-      data_obs_yield[i] = (TH1F*)gDirectory->Get("data_obs") ? Integral((TH1F*)gDirectory->Get("data_obs")) : 0;
-      ztt_yield[i] =      (TH1F*)gDirectory->Get("ZTT") ? Integral((TH1F*)gDirectory->Get("ZTT")) : 0;
-      zll_yield[i] =      (TH1F*)gDirectory->Get("ZLL") ? Integral((TH1F*)gDirectory->Get("ZLL")) : 0;
-      qcd_yield[i] =      (TH1F*)gDirectory->Get("QCD") ? Integral((TH1F*)gDirectory->Get("QCD")) : 0;
-      w_yield[i] =      (TH1F*)gDirectory->Get("W") ? Integral((TH1F*)gDirectory->Get("W")) : 0;
-      top_yield[i] =      (TH1F*)gDirectory->Get("TT") ? Integral((TH1F*)gDirectory->Get("TT")) : 0;
-      vv_yield[i] =       (TH1F*)gDirectory->Get("VV") ? Integral((TH1F*)gDirectory->Get("VV")) : 0;
-      vh_yield[i] =       (TH1F*)gDirectory->Get("VH125") ? Integral((TH1F*)gDirectory->Get("VH125")) : 0;
-      ggh_yield[i] =       (TH1F*)gDirectory->Get("ggH125") ? Integral((TH1F*)gDirectory->Get("ggH125")) : 0;
-      qqh_yield[i] =       (TH1F*)gDirectory->Get("qqH125") ? Integral((TH1F*)gDirectory->Get("qqH125")) : 0;
-      data_obs_yield_err[i] = (TH1F*)gDirectory->Get("data_obs") ? Error((TH1F*)gDirectory->Get("data_obs")) : 0;
-      ztt_yield_err[i] =      (TH1F*)gDirectory->Get("ZTT") ? Error((TH1F*)gDirectory->Get("ZTT")) : 0;
-      zll_yield_err[i] =      (TH1F*)gDirectory->Get("ZLL") ? Error((TH1F*)gDirectory->Get("ZLL")) : 0;
-      qcd_yield_err[i] =      (TH1F*)gDirectory->Get("QCD") ? Error((TH1F*)gDirectory->Get("QCD")) : 0;
-      w_yield_err[i] =      (TH1F*)gDirectory->Get("W") ? Error((TH1F*)gDirectory->Get("W")) : 0;
-      top_yield_err[i] =      (TH1F*)gDirectory->Get("TT") ? Error((TH1F*)gDirectory->Get("TT")) : 0;
-      vv_yield_err[i] =       (TH1F*)gDirectory->Get("VV") ? Error((TH1F*)gDirectory->Get("VV")) : 0;
-      vh_yield_err[i] =       (TH1F*)gDirectory->Get("VH125") ? Error((TH1F*)gDirectory->Get("VH125")) : 0;
-      ggh_yield_err[i] =       (TH1F*)gDirectory->Get("ggH125") ? Error((TH1F*)gDirectory->Get("ggH125")) : 0;
-      qqh_yield_err[i] =       (TH1F*)gDirectory->Get("qqH125") ? Error((TH1F*)gDirectory->Get("qqH125")) : 0;
+      data_obs_yield[i] = Integral(shapes, inputs[i], category, "data_obs");
+      ztt_yield[i] =      Integral(shapes, inputs[i], category, "ZTT");
+      zll_yield[i] =      Integral(shapes, inputs[i], category, "ZLL");
+      qcd_yield[i] =      Integral(shapes, inputs[i], category, "QCD");
+      w_yield[i] =      Integral(shapes, inputs[i], category, "W");
+      top_yield[i] =      Integral(shapes, inputs[i], category, "TT");
+      vv_yield[i] =       Integral(shapes, inputs[i], category, "VV");
+      vh_yield[i] =       Integral(shapes, inputs[i], category, "VH125");
+      ggh_yield[i] =       Integral(shapes, inputs[i], category, "ggH125");
+      qqh_yield[i] =       Integral(shapes, inputs[i], category, "qqH125");
+      data_obs_yield_err[i] = Error(shapes, inputs[i], category, "data_obs");
+      ztt_yield_err[i] =      Error(shapes, inputs[i], category, "ZTT");
+      zll_yield_err[i] =      Error(shapes, inputs[i], category, "ZLL");
+      qcd_yield_err[i] =      Error(shapes, inputs[i], category, "QCD");
+      w_yield_err[i] =      Error(shapes, inputs[i], category, "W");
+      top_yield_err[i] =      Error(shapes, inputs[i], category, "TT");
+      vv_yield_err[i] =       Error(shapes, inputs[i], category, "VV");
+      vh_yield_err[i] =       Error(shapes, inputs[i], category, "VH125");
+      ggh_yield_err[i] =       Error(shapes, inputs[i], category, "ggH125");
+      qqh_yield_err[i] =       Error(shapes, inputs[i], category, "qqH125");
     }
     if (mssm_mode == 0) {
-      vh_yield[i] =       (TH1F*)gDirectory->Get("VH125") ? Integral((TH1F*)gDirectory->Get("VH125")) : 0;
-      ggh_yield[i] =       (TH1F*)gDirectory->Get("ggH125") ? Integral((TH1F*)gDirectory->Get("ggH125")) : 0;
-      qqh_yield[i] =       (TH1F*)gDirectory->Get("qqH125") ? Integral((TH1F*)gDirectory->Get("qqH125")) : 0;
-      vh_yield_err[i] =       (TH1F*)gDirectory->Get("VH125") ? Error((TH1F*)gDirectory->Get("VH125")) : 0;
-      ggh_yield_err[i] =       (TH1F*)gDirectory->Get("ggH125") ? Error((TH1F*)gDirectory->Get("ggH125")) : 0;
-      qqh_yield_err[i] =       (TH1F*)gDirectory->Get("qqH125") ? Error((TH1F*)gDirectory->Get("qqH125")) : 0;
+      vh_yield[i] =       Integral(shapes, inputs[i], category, "VH125");
+      ggh_yield[i] =       Integral(shapes, inputs[i], category, "ggH125");
+      qqh_yield[i] =       Integral(shapes, inputs[i], category, "qqH125");
+      vh_yield_err[i] =       Error(shapes, inputs[i], category, "VH125");
+      ggh_yield_err[i] =       Error(shapes, inputs[i], category, "ggH125");
+      qqh_yield_err[i] =       Error(shapes, inputs[i], category, "qqH125");
 
     } else {
-      ggh_yield[i] =       (TH1F*)gDirectory->Get("ggH160") ? Integral((TH1F*)gDirectory->Get("ggH160")) : 0;
-      qqh_yield[i] =       (TH1F*)gDirectory->Get("bbH160") ? Integral((TH1F*)gDirectory->Get("bbH160")) : 0;
-      ggh_yield_err[i] =       (TH1F*)gDirectory->Get("ggH160") ? Error((TH1F*)gDirectory->Get("ggH160")) : 0;
-      qqh_yield_err[i] =       (TH1F*)gDirectory->Get("bbH160") ? Error((TH1F*)gDirectory->Get("bbH160")) : 0;
+      ggh_yield[i] =       Integral(shapes, inputs[i], category, "ggH160");
+      qqh_yield[i] =       Integral(shapes, inputs[i], category, "bbH160");
+      ggh_yield_err[i] =       Error(shapes, inputs[i], category, "ggH160");
+      qqh_yield_err[i] =       Error(shapes, inputs[i], category, "bbH160");
 
     }
 
@@ -340,9 +349,8 @@ int main(int argc, char* argv[]){
 
 
       for (unsigned k = 0; k < inputs.size(); ++k) {
-        std::string replacement = category;
       //   std::cout << "Looking for plot: " << comp_plots[j] << std::endl;
-        ele.push_back(ic::TH1PlotElement(labels[k],tfiles[k],replacement,comp_plots[j]));
+        ele.push_back(ic::TH1PlotElement(labels[k],shapes.GetTH1F(inputs[k],category+"/"+comp_plots[j])));
         if (ele.back().hist_ptr()) {
           yields.push_back(Integral(ele.back().hist_ptr()));
           SetStyle(ele.back(), k);
@@ -16,6 +16,7 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/Plot.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnRootTools.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTStatTools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTToyStudy.h"
 
 namespace po = boost::program_options;
 
@@ -56,11 +57,20 @@ int main(int argc, char* argv[]){
   // Set a nice drawing style  
   ic::Plot::SetTdrStyle();
 
-  // Extract pulls from the two input files
+  // Extract pulls from the two input files. A ROOT file is taken to be the
+  // output of a ToyStudy, giving the mean and RMS of the pull of each parameter
   std::vector<ic::Pull> pulls1;
   std::vector<ic::Pull> pulls2;
-  PullsFromFile(input1, pulls1, false);
-  PullsFromFile(input2, pulls2, false);
+  if (boost::ends_with(input1, ".root")) {
+    PullsFromToys(input1, pulls1, false);
+  } else {
+    PullsFromFile(input1, pulls1, false);
+  }
+  if (boost::ends_with(input2, ".root")) {
+    PullsFromToys(input2, pulls2, false);
+  } else {
+    PullsFromFile(input2, pulls2, false);
+  }
 
   // Build new lists of the pulls common to both inputs, and in the same order
   std::vector<ic::Pull> pulls1sorted;
@@ -6,6 +6,8 @@
 #include "TLegend.h"
 #include "TLatex.h"
 #include "TF1.h"
+#include "TFile.h"
+#include "TTree.h"
 #include "RooRealVar.h"
 #include "RooGenericPdf.h"
 #include "RooDataHist.h"
@@ -14,7 +16,6 @@
 #include "RooChi2Var.h"
 #include "RooMinuit.h"
 #include "RooPlot.h"
-#include "RooMCStudy.h"
 #include "RooGaussian.h"
 
 #include "RooFitResult.h"
@@ -26,14 +27,30 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/Plot.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TextElement.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnRootTools.h"
+#include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTToyStudy.h"
+
+namespace po = boost::program_options;
 
 
 using namespace std;
 using namespace ic;
 
 
-int main(int /*argc*/, char* /*argv*/[]){
+int main(int argc, char* argv[]){
 
+unsigned ntoys;
+unsigned workers;
+unsigned long long seed;
+string output;
+po::options_description config("Configuration");
+config.add_options()
+  ("toys",    po::value<unsigned>(&ntoys)->default_value(3000), "number of toys")
+  ("workers", po::value<unsigned>(&workers)->default_value(1), "number of worker processes")
+  ("seed",    po::value<unsigned long long>(&seed)->default_value(1), "seed of the first toy")
+  ("output",  po::value<string>(&output)->default_value("toys.root"), "output file");
+po::variables_map vm;
+po::store(po::command_line_parser(argc, argv).options(config).allow_unregistered().run(), vm);
+po::notify(vm);
 
 unsigned nsig = 50;
 unsigned nbkg = 500;
@@ -88,15 +105,19 @@ lC01->SaveAs("binned.pdf");
 
 
 
-RooMCStudy mgr(*lGenMod,lM,RooFit::FitModel(*lFitMod),RooFit::Silence(),RooFit::Extended(true),RooFit::Verbose(1),RooFit::Binned(kTRUE),RooFit::FitOptions(RooFit::Save(kTRUE),RooFit::Strategy(0)));
-mgr.generateAndFit(3000,nsig+nbkg);
-std::cout << mean.getVal() << std::endl;
-RooPlot* lFrame1 = mgr.plotPull(lNSig,-1.5,1.5,50,true);
-// RooPlot* lFrame1 = mgr.plotParam(lNSig,RooFit::FrameRange(-200, 200),RooFit::FrameBins(100));
+ToyStudy toys(*lGenMod,*lFitMod,RooArgSet(lM));
+toys.set_seed(seed).set_workers(workers).set_binned(true).set_strategy(0);
+toys.Run(ntoys,nsig+nbkg,output);
+std::vector<ic::Pull> pulls;
+PullsFromToys(output,pulls,true);
+TFile toy_file(output.c_str());
+TTree *toy_tree = (TTree*)toy_file.Get("toys");
+TH1F hpull("hpull","hpull",50,-1.5,1.5);
+toy_tree->Draw("nsig_pull>>hpull","status==0","goff");
 TCanvas* lC00 = new TCanvas("pulls","pulls",600,600) ;
 lC00->cd();
-lFrame1->Draw();
-mgr.fitResult(0)->Print();
+hpull.Fit("gaus");
+hpull.Draw();
 lC00->SaveAs("test.pdf");
 
 
@@ -1,3 +1,4 @@
 SUBDIRS 	:=
 LIB_DEPS 	:= Core Utilities Objects
 LIB_EXTRA :=
+REQUIRES_CMSSW := 0
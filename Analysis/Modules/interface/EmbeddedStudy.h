@@ -3,7 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 #include <string>
 
@@ -18,7 +18,7 @@ class EmbeddedStudy : public ModuleBase {
 
 
 
-  CLASS_MEMBER(EmbeddedStudy, fwlite::TFileService*, fs)
+  CLASS_MEMBER(EmbeddedStudy, FileService*, fs)
   CLASS_MEMBER(EmbeddedStudy, bool, is_dyjets)
 
 
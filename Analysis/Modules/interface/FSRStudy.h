@@ -6,7 +6,7 @@
 #include "UserCode/ICHiggsTauTau/interface/GenParticle.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 
 
@@ -21,7 +21,7 @@ class FSRStudy : public ModuleBase {
   CLASS_MEMBER(FSRStudy, double, st1_pt1)
   CLASS_MEMBER(FSRStudy, double, st1_pt2)
   CLASS_MEMBER(FSRStudy, double, st1_eta)
-  CLASS_MEMBER(FSRStudy, fwlite::TFileService*, fs)
+  CLASS_MEMBER(FSRStudy, FileService*, fs)
   DynamicHistoSet* hists_;
 
  public:
@@ -4,8 +4,7 @@
 #include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
 #include "Core/interface/TreeEvent.h"
 #include "Core/interface/ModuleBase.h"
-#include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
-#include "CondFormats/JetMETObjects/interface/FactorizedJetCorrector.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/JetCorrectionTables.h"
 #include <string>
 #include "boost/bind.hpp"
 
@@ -21,11 +20,8 @@ class JetEnergyCorrections : public ModuleBase {
   CLASS_MEMBER(JetEnergyCorrections, std::string, l3_file)
   CLASS_MEMBER(JetEnergyCorrections, std::string, res_file)
   CLASS_MEMBER(JetEnergyCorrections, bool, use_new_mode)
-  JetCorrectorParameters *ResJetPar;
-  JetCorrectorParameters *L3JetPar;
-  JetCorrectorParameters *L2JetPar;
-  JetCorrectorParameters *L1JetPar;
-  FactorizedJetCorrector *JetCorrector;
+  JetCorrectionChain corrector_;
+  std::vector<float> factors_;
 
  public:
   JetEnergyCorrections(std::string const& name);
@@ -58,16 +54,12 @@ int JetEnergyCorrections<T>::PreAnalysis() {
   std::cout << "L2 Source: " << l2_file_ << std::endl;
   std::cout << "L3 Source: " << l3_file_ << std::endl;
   if (is_data_) std::cout << "Residual Source: " << res_file_ << std::endl;
-  if (is_data_) ResJetPar = new JetCorrectorParameters(res_file_);
-  L3JetPar  = new JetCorrectorParameters(l3_file_);
-  L2JetPar  = new JetCorrectorParameters(l2_file_);
-  L1JetPar  = new JetCorrectorParameters(l1_file_);
-  std::vector<JetCorrectorParameters> vPar;
-  vPar.push_back(*L1JetPar);
-  vPar.push_back(*L2JetPar);
-  vPar.push_back(*L3JetPar);
-  if (is_data_) vPar.push_back(*ResJetPar);
-  JetCorrector = new FactorizedJetCorrector(vPar);
+  // The text payloads are parsed once here into per-bin formulae
+  corrector_ = JetCorrectionChain();
+  corrector_.AddLevel(JetCorrectionLevel(l1_file_));
+  corrector_.AddLevel(JetCorrectionLevel(l2_file_));
+  corrector_.AddLevel(JetCorrectionLevel(l3_file_));
+  if (is_data_) corrector_.AddLevel(JetCorrectionLevel(res_file_));
   return 0;
 }
 
@@ -83,17 +75,20 @@ int JetEnergyCorrections<T>::Execute(TreeEvent *event) {
                                : jet->GetJecFactor("Uncorrected");
     double uncorr_pt = uncorr_factor * jet->pt();
     double uncorr_energy = uncorr_factor * jet->energy();
-    JetCorrector->setJetEta(jet->eta());
-    JetCorrector->setJetPt(uncorr_pt);
-    JetCorrector->setJetA(jet->jet_area());
-    JetCorrector->setRho(eventInfo->jet_rho());
+    JetCorrectionInputs inputs;
+    inputs[JetCorrectionInputs::JetEta] = jet->eta();
+    inputs[JetCorrectionInputs::JetPhi] = jet->phi();
+    inputs[JetCorrectionInputs::JetPt]  = uncorr_pt;
+    inputs[JetCorrectionInputs::JetE]   = uncorr_energy;
+    inputs[JetCorrectionInputs::JetA]   = jet->jet_area();
+    inputs[JetCorrectionInputs::Rho]    = eventInfo->jet_rho();
     // std::cout << "--Jet " << i << ": " << vec[i]->vector() << std::endl;
     // std::cout << "-L1FastJet: " << vec[i]->GetJecFactor("L1FastJet") << std::endl;
     // std::cout << "-L2Relative: " << vec[i]->GetJecFactor("L2Relative") << std::endl;
     // std::cout << "-L3Absolute: " << vec[i]->GetJecFactor("L3Absolute") << std::endl;
     // if (is_data_) std::cout << "-L2L3Residual: " << vec[i]->GetJecFactor("L2L3Residual") << std::endl;
-    //double full_corr = JetCorrector->getCorrection();
-    std::vector<float> factors = JetCorrector->getSubCorrections();
+    corrector_.SubCorrections(inputs, factors_);
+    std::vector<float> const& factors = factors_;
     double full_corr = factors.back();
     double new_pt = uncorr_pt * full_corr;
     double new_energy = uncorr_energy * full_corr;
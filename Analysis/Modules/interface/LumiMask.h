@@ -4,6 +4,7 @@
 #include "Core/interface/TreeEvent.h"
 #include "Core/interface/ModuleBase.h"
 #include "Utilities/interface/JsonTools.h"
+#include "Utilities/interface/LumiIndex.h"
 #include <string>
 
 namespace ic {
@@ -11,24 +12,16 @@ namespace ic {
 /**
  * Filters events using a standard CMS luminosity json file
  *
+ * Only the set of all lumi sections seen is recorded per event, the accepted
+ * and rejected sets are derived from it in PostAnalysis.
  */
 class LumiMask : public ModuleBase {
  private:
-  typedef std::map<unsigned, std::set<unsigned>> JsonMap;
-  typedef std::map<unsigned, std::set<unsigned>>::const_iterator JsonIt;
-
-  JsonMap input_json_;
-  JsonMap accept_json_;
-  JsonMap reject_json_;
-  JsonMap all_json_;
+  LumiIndex input_json_;
+  LumiIndex all_json_;
   CLASS_MEMBER(LumiMask, std::string, input_file)
   CLASS_MEMBER(LumiMask, std::string, produce_output_jsons)
 
- private:
-  void FillJsonMapFromJson(JsonMap & jsmap, Json::Value const& js);
-  Json::Value JsonFromJsonMap(JsonMap const& jsmap);
-  void WriteJson(JsonMap const& json, std::ofstream& output);
-
  public:
   LumiMask(std::string const& name);
   virtual ~LumiMask();
@@ -3,6 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/LumiIndex.h"
 #include <string>
 
 namespace ic {
@@ -14,7 +15,10 @@ class MakeRunStats : public ModuleBase {
  private:
   std::map<unsigned, unsigned> yield_map_;
   std::map<unsigned, unsigned> vtx_map_;
+  LumiIndex lumis_;
   CLASS_MEMBER(MakeRunStats, std::string, output_name)
+  // If set, the lumi sections seen are also written to this json file
+  CLASS_MEMBER(MakeRunStats, std::string, lumi_output_name)
 
 
  public:
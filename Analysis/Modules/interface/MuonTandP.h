@@ -3,7 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 #include "boost/function.hpp"
 
@@ -15,7 +15,7 @@ namespace ic {
 class MuonTandP : public ModuleBase {
  private:
   std::string input_name_;
-  fwlite::TFileService *fs_;
+  FileService *fs_;
   DynamicHistoSet *hists_;
 
   std::string output_name_;
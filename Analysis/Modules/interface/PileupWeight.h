@@ -3,6 +3,8 @@
 
 #include "Core/interface/TreeEvent.h"
 #include "Core/interface/ModuleBase.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightTable.h"
 #include <string>
 #include "TH1F.h"
 
@@ -12,12 +14,14 @@ class PileupWeight : public ModuleBase {
  private:
   bool is_valid_;
   TH1* weights_;
+  WeightTable1D weight_table_;
   CLASS_MEMBER(PileupWeight, TH1*, data)
   CLASS_MEMBER(PileupWeight, TH1*, mc)
   CLASS_MEMBER(PileupWeight, bool, print_weights)
   CLASS_MEMBER(PileupWeight, bool, use_sampled_interactions)
   CLASS_MEMBER(PileupWeight, bool, weight_is_active)
   std::string label_;
+  EventInfo::WeightSlot slot_;
 
  public:
   PileupWeight(std::string const& name);
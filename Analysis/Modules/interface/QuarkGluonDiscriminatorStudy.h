@@ -3,7 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 #include <string>
 
@@ -18,7 +18,7 @@ class QuarkGluonDiscriminatorStudy : public ModuleBase {
 
 
 
-  CLASS_MEMBER(QuarkGluonDiscriminatorStudy, fwlite::TFileService*, fs)
+  CLASS_MEMBER(QuarkGluonDiscriminatorStudy, FileService*, fs)
   CLASS_MEMBER(QuarkGluonDiscriminatorStudy, bool, is_dyjets)
 
 
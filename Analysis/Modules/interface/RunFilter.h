@@ -3,6 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/LumiIndex.h"
 #include <string>
 
 namespace ic {
@@ -10,6 +11,7 @@ namespace ic {
 class RunFilter : public ModuleBase {
  private:
   std::set<int> runs_to_filter;
+  LumiIndex lumis_to_filter;
 
  public:
   RunFilter(std::string const& name);
@@ -23,6 +25,11 @@ class RunFilter : public ModuleBase {
   void FilterRun(int const& run) {
     runs_to_filter.insert(run);
   }
+
+  // Also filter every lumi section contained in a CMS luminosity json file
+  void FilterLumis(std::string const& json_file) {
+    lumis_to_filter.Merge(LumiIndex::FromFile(json_file));
+  }
 };
 
 }
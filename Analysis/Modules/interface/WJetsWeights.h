@@ -3,7 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 #include "TTree.h"
 #include "TFile.h"
@@ -16,7 +16,7 @@ namespace ic {
 
 class WJetsWeights : public ModuleBase {
  private:
-  CLASS_MEMBER(WJetsWeights, fwlite::TFileService*, fs)
+  CLASS_MEMBER(WJetsWeights, FileService*, fs)
   DynamicHistoSet* hists_;
   std::vector<double> counts_;
  public:
@@ -0,0 +1,40 @@
+#ifndef ICHiggsTauTau_Module_WeightVectorProducer_h
+#define ICHiggsTauTau_Module_WeightVectorProducer_h
+
+#include "Core/interface/TreeEvent.h"
+#include "Core/interface/ModuleBase.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightVector.h"
+#include <string>
+#include <vector>
+
+namespace ic {
+
+/**
+ * Extracts a set of EventInfo weights into a WeightVector once per event and
+ * adds it to the event as `output_label`. Downstream modules retrieve it with
+ * `event->GetPtr<WeightVector>(output_label)` and can fill all variations in
+ * a single pass. The labels are either given explicitly or as an inclusive
+ * range of integer weight ids.
+ */
+class WeightVectorProducer : public ModuleBase {
+ private:
+  CLASS_MEMBER(WeightVectorProducer, std::string, output_label)
+  CLASS_MEMBER(WeightVectorProducer, std::vector<std::string>, labels)
+  CLASS_MEMBER(WeightVectorProducer, unsigned, first_id)
+  CLASS_MEMBER(WeightVectorProducer, unsigned, last_id)
+  WeightVector wts_;
+
+ public:
+  WeightVectorProducer(std::string const& name);
+  virtual ~WeightVectorProducer();
+
+  virtual int PreAnalysis();
+  virtual int Execute(TreeEvent *event);
+  virtual int PostAnalysis();
+  virtual void PrintInfo();
+};
+
+}
+
+#endif
@@ -3,7 +3,7 @@
 
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/HistoSet.h"
 #include "UserCode/ICHiggsTauTau/Analysis/HiggsTauTau/interface/HTTConfig.h"
 
@@ -17,7 +17,7 @@ class ZJetsControlPlots : public ModuleBase {
   DynamicHistoSet *hset;
   Dynamic2DHistoSet *h2dset;
 
-  CLASS_MEMBER(ZJetsControlPlots, fwlite::TFileService*, fs)
+  CLASS_MEMBER(ZJetsControlPlots, FileService*, fs)
   CLASS_MEMBER(ZJetsControlPlots, ic::channel, channel)
   CLASS_MEMBER(ZJetsControlPlots, std::string, met_label)
 
@@ -3,7 +3,7 @@
 #include "UserCode/ICHiggsTauTau/interface/SuperCluster.hh"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnPredicates.h"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnPairs.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 
 
 namespace ic {
@@ -16,7 +16,7 @@ namespace ic {
   }
 
   int ElectronTandP::PreAnalysis() {
-    fs_ = new fwlite::TFileService("ElectronTandP_"+output_name_+".root");
+    fs_ = new FileService("ElectronTandP_"+output_name_+".root");
     hists_ = new DynamicHistoSet(fs_->mkdir("/"));
     hists_->Create("tt_wp85_SC8", hist_bins_, min_mass_, max_mass_);
     hists_->Create("tf_wp85_SC8", hist_bins_, min_mass_, max_mass_);
@@ -7,6 +7,7 @@ namespace ic {
 
   MakeRunStats::MakeRunStats(std::string const& name) : ModuleBase(name) {
     output_name_ = "default.out";
+    lumi_output_name_ = "";
   }
 
   MakeRunStats::~MakeRunStats() {
@@ -21,6 +22,7 @@ namespace ic {
     EventInfo const *info = event->GetPtr<EventInfo>("eventInfo");
     yield_map_[info->run()] += 1;
     vtx_map_[info->run()] += info->good_vertices();
+    if (lumi_output_name_ != "") lumis_.Insert(info->run(), info->lumi_block());
     return 0;
   }
   int MakeRunStats::PostAnalysis() {
@@ -34,6 +36,10 @@ namespace ic {
     }
 
     output.close();
+    if (lumi_output_name_ != "") {
+      std::cout << "Producing output file: " << lumi_output_name_ << std::endl;
+      lumis_.WriteJson(lumi_output_name_);
+    }
     return 0;
   }
 
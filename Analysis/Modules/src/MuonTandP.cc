@@ -1,7 +1,7 @@
 #include "UserCode/ICHiggsTauTau/Analysis/Modules/interface/MuonTandP.h"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnPredicates.h"
-#include "PhysicsTools/FWLite/interface/TFileService.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 
 
 namespace ic {
@@ -14,7 +14,7 @@ namespace ic {
   }
 
   int MuonTandP::PreAnalysis() {
-    fs_ = new fwlite::TFileService("MuonTandP_"+output_name_+".root");
+    fs_ = new FileService("MuonTandP_"+output_name_+".root");
     hists_ = new DynamicHistoSet(fs_->mkdir("/"));
     hists_->Create("tt", hist_bins_, min_mass_, max_mass_);
     hists_->Create("tf", hist_bins_, min_mass_, max_mass_);
@@ -12,6 +12,7 @@ namespace ic {
     label_          = "pileup";
     use_sampled_interactions_ = false;
     weight_is_active_ = true;
+    slot_           = EventInfo::register_weight(label_);
   }
 
   PileupWeight::PileupWeight(std::string const& name,
@@ -23,6 +24,7 @@ namespace ic {
     label_          = label;
     use_sampled_interactions_ = false;
     weight_is_active_ = true;
+    slot_           = EventInfo::register_weight(label_);
   }
 
   PileupWeight::~PileupWeight() {
@@ -57,6 +59,7 @@ namespace ic {
     mc_->Scale(1./int_mc);
     weights_ = (TH1*)data_->Clone();
     weights_->Divide(mc_);
+    weight_table_ = WeightTable1D(weights_, WeightTable1D::overflow::fixed, 1.0);
     for (unsigned i = 0; i < nbins; ++i) {
       if (print_weights_) std::cout << "nInt = [" << weights_->GetBinLowEdge(i+1) << "," << weights_->GetBinLowEdge(i+2) << "[,\tData = " << data_->GetBinContent(i+1) << ",  MC = " << mc_->GetBinContent(i+1) << ",  Weight = " << weights_->GetBinContent(i+1) << std::endl;
     }
@@ -77,13 +80,8 @@ namespace ic {
       std::cout << "Warning: In-time true_num_interactions not found!" << std::endl;
       return 0;
     }
-    //double weight = 0.0;
-    int found_bin = weights_->FindBin(true_int);
-    double weight = 1.0;
-    if (found_bin >= 1 && found_bin <= weights_->GetNbinsX()) {
-      weight = weights_->GetBinContent(found_bin);
-    }
-    eventInfo->set_weight(label_, weight, weight_is_active_);
+    double weight = weight_table_.Evaluate(true_int);
+    eventInfo->set_weight(slot_, weight, weight_is_active_);
     return 0;
   }
   int PileupWeight::PostAnalysis() {
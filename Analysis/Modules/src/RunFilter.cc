@@ -20,13 +20,17 @@ namespace ic {
     for (std::set<int>::const_iterator it = runs_to_filter.begin(); it != runs_to_filter.end(); ++it) {
       std::cout << *it << std::endl;
     }
+    if (!lumis_to_filter.empty()) {
+      std::cout << "Filtered lumi sections: " << lumis_to_filter.NLumis() << std::endl;
+    }
     return 0;
   }
 
   int RunFilter::Execute(TreeEvent *event) {
     EventInfo const* eventInfo = event->GetPtr<EventInfo>("eventInfo");
     unsigned run = eventInfo->run();
-    if (runs_to_filter.count(run) > 0) {
+    if (runs_to_filter.count(run) > 0 ||
+        lumis_to_filter.Contains(run, eventInfo->lumi_block())) {
       return 1;
     } else {
       return 0;
@@ -0,0 +1,41 @@
+#include "Modules/interface/WeightVectorProducer.h"
+
+namespace ic {
+
+  WeightVectorProducer::WeightVectorProducer(std::string const& name)
+      : ModuleBase(name) {
+    output_label_   = "weight_vector";
+    first_id_       = 0;
+    last_id_        = 0;
+  }
+
+  WeightVectorProducer::~WeightVectorProducer() {
+    ;
+  }
+
+  int WeightVectorProducer::PreAnalysis() {
+    if (labels_.empty() && last_id_ >= first_id_ && last_id_ > 0) {
+      labels_ = WeightVector::LabelRange(first_id_, last_id_);
+    }
+    wts_ = WeightVector(labels_);
+    PrintHeader("WeightVectorProducer");
+    PrintArg("output_label", output_label_);
+    PrintArg("n_weights", wts_.size());
+    return 0;
+  }
+
+  int WeightVectorProducer::Execute(TreeEvent *event) {
+    EventInfo const* info = event->GetPtr<EventInfo>("eventInfo");
+    wts_.Fill(info);
+    event->Add(output_label_, &wts_);
+    return 0;
+  }
+
+  int WeightVectorProducer::PostAnalysis() {
+    return 0;
+  }
+
+  void WeightVectorProducer::PrintInfo() {
+    ;
+  }
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <functional>
+#include "boost/format.hpp"
+#include "boost/program_options.hpp"
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/AnalysisBase.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/ModuleBase.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/TreeEvent.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
+#include "UserCode/ICHiggsTauTau/interface/Electron.hh"
+#include "UserCode/ICHiggsTauTau/interface/Muon.hh"
+#include "UserCode/ICHiggsTauTau/interface/Tau.hh"
+#include "UserCode/ICHiggsTauTau/interface/PFJet.hh"
+#include "UserCode/ICHiggsTauTau/interface/Met.hh"
+#include "UserCode/ICHiggsTauTau/interface/Vertex.hh"
+#include "UserCode/ICHiggsTauTau/interface/PileupInfo.hh"
+#include "UserCode/ICHiggsTauTau/interface/GenParticle.hh"
+#include "UserCode/ICHiggsTauTau/interface/TriggerPath.hh"
+
+namespace po = boost::program_options;
+using namespace ic;
+
+// Measures how fast the typical set of branches can be read through
+// AnalysisBase from ntuples written with different compression settings,
+// e.g. the outputs of RecompressNtuple:
+//
+//   NtupleReadBenchmark --input=lzma.root,zlib.root,lz4.root
+//
+// For each file it reports the compression setting, the compressed and
+// uncompressed size of the branches that were read, and the read rate.
+
+typedef std::function<void(TreeEvent *)> Reader;
+
+// The branches most of our analyses read, with their types
+std::vector<std::pair<std::string, Reader>> TypicalBranches() {
+  return {
+    {"eventInfo",    [](TreeEvent *e) { e->GetPtr<EventInfo>("eventInfo"); }},
+    {"vertices",     [](TreeEvent *e) { e->GetPtrVec<Vertex>("vertices"); }},
+    {"electrons",    [](TreeEvent *e) { e->GetPtrVec<Electron>("electrons"); }},
+    {"muons",        [](TreeEvent *e) { e->GetPtrVec<Muon>("muons"); }},
+    {"taus",         [](TreeEvent *e) { e->GetPtrVec<Tau>("taus"); }},
+    {"pfJetsPFlow",  [](TreeEvent *e) { e->GetPtrVec<PFJet>("pfJetsPFlow"); }},
+    {"ak4PFJetsCHS", [](TreeEvent *e) { e->GetPtrVec<PFJet>("ak4PFJetsCHS"); }},
+    {"pfMet",        [](TreeEvent *e) { e->GetPtrVec<Met>("pfMet"); }},
+    {"pileupInfo",   [](TreeEvent *e) { e->GetPtrVec<PileupInfo>("pileupInfo"); }},
+    {"genParticles", [](TreeEvent *e) { e->GetPtrVec<GenParticle>("genParticles"); }},
+    {"triggerPaths", [](TreeEvent *e) { e->GetPtrVec<TriggerPath>("triggerPaths"); }}
+  };
+}
+
+class ReadBranches : public ModuleBase {
+ private:
+  std::vector<Reader> readers_;
+  unsigned events_;
+
+ public:
+  ReadBranches(std::string const& name, std::vector<Reader> const& readers)
+      : ModuleBase(name), readers_(readers), events_(0) {}
+  virtual int Execute(TreeEvent *event) {
+    for (auto const& read : readers_) read(event);
+    ++events_;
+    return 0;
+  }
+  inline unsigned events() const { return events_; }
+};
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> inputs;
+  std::string tree_path;
+  int max_events;
+  bool ttree_caching;
+  po::options_description config("Configuration");
+  config.add_options()
+    ("help,h",        "print the help message")
+    ("input",         po::value<std::vector<std::string>>(&inputs)->multitoken()->required(),
+                      "the ntuples to compare")
+    ("tree_path",     po::value<std::string>(&tree_path)->default_value("icEventProducer/EventTree"))
+    ("max_events",    po::value<int>(&max_events)->default_value(-1))
+    ("ttree_caching", po::value<bool>(&ttree_caching)->default_value(true));
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(config).run(), vm);
+  if (vm.count("help")) {
+    std::cout << config << "\n";
+    return 0;
+  }
+  po::notify(vm);
+
+  std::vector<boost::format> results;
+  for (auto const& input : inputs) {
+    // Only read the typical branches that this file has
+    std::vector<Reader> readers;
+    double zip_bytes = 0.;
+    double tot_bytes = 0.;
+    int settings = -1;
+    {
+      TFile file(input.c_str());
+      TTree *tree = dynamic_cast<TTree *>(file.Get(tree_path.c_str()));
+      if (!tree) {
+        std::cerr << "No tree " << tree_path << " in " << input << "\n";
+        return 1;
+      }
+      for (auto const& branch : TypicalBranches()) {
+        TBranch *b = tree->GetBranch(branch.first.c_str());
+        if (!b) continue;
+        readers.push_back(branch.second);
+        zip_bytes += b->GetZipBytes("*");
+        tot_bytes += b->GetTotBytes("*");
+        if (settings < 0) settings = b->GetCompressionSettings();
+      }
+      // Scale to the events that will be read
+      if (max_events > 0 && tree->GetEntries() > max_events) {
+        zip_bytes *= double(max_events) / tree->GetEntries();
+        tot_bytes *= double(max_events) / tree->GetEntries();
+      }
+    }
+
+    AnalysisBase analysis("NtupleReadBenchmark", {input}, tree_path, max_events);
+    analysis.SetTTreeCaching(ttree_caching);
+    ReadBranches read("ReadBranches", readers);
+    analysis.AddModule(&read);
+    auto start = std::chrono::steady_clock::now();
+    analysis.RunAnalysis();
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    unsigned events = read.events();
+    results.push_back(boost::format("%-40s %8i %9.1f %9.1f %10.0f %9.1f\n") %
+                      input % settings % (zip_bytes / 1.E6) %
+                      (tot_bytes / 1.E6) % (events / seconds) %
+                      (tot_bytes / 1.E6 / seconds));
+  }
+
+  std::cout << std::string(92, '-') << "\n";
+  std::cout << boost::format("%-40s %8s %9s %9s %10s %9s\n") % "File" %
+                   "Settings" % "Disk/MB" % "Mem/MB" % "Events/s" % "MB/s";
+  for (auto const& line : results) std::cout << line;
+  return 0;
+}
@@ -1,6 +1,7 @@
 SUBDIRS 	:=
 LIB_DEPS 	:=
 LIB_EXTRA :=
+REQUIRES_CMSSW := 0
 DICTIONARY := interface/Candidate.hh interface/PFCandidate.hh
 DICTIONARY += interface/Electron.hh interface/Muon.hh interface/Tau.hh
 DICTIONARY += interface/Photon.hh interface/Jet.hh interface/CaloJet.hh
@@ -9,4 +10,4 @@ DICTIONARY += interface/Track.hh interface/LightTrack.hh interface/Vertex.hh
 DICTIONARY += interface/SecondaryVertex.hh interface/TriggerObject.hh interface/TriggerPath.hh
 DICTIONARY += interface/PileupInfo.hh interface/GenParticle.hh interface/GenJet.hh
 DICTIONARY += interface/SuperCluster.hh interface/EventInfo.hh interface/TH2DAsymErr.h
-DICTIONARY += interface/L1TObject.hh
+DICTIONARY += interface/L1TObject.hh interface/LightPFCandidate.hh
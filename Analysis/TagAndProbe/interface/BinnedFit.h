@@ -0,0 +1,45 @@
+#ifndef ICHiggsTauTau_Analysis_TagAndProbe_BinnedFit_h
+#define ICHiggsTauTau_Analysis_TagAndProbe_BinnedFit_h
+#include <string>
+#include <vector>
+#include <map>
+
+
+    // Result of the simultaneous pass/fail fit of one bin, as kept in the fit
+    // cache
+    struct BinFitResult
+    {
+        BinFitResult();
+        std::string bin;
+        // Hash of the pass and fail histograms and of the fit model
+        std::string hash;
+        double eff;
+        double err;
+        // TMath::Prob(chi2/ndf, 6) of the pass and fail fits, as in fit()
+        double probpass;
+        double probfail;
+        int covqual;
+        // Converged values of the shape parameters
+        std::map<std::string, double> pars;
+        bool goodfit() const;
+    };
+
+    // Group bin labels such as "1B", "2B" and "1Eb" into chains of
+    // neighbouring bins: the bins of each region (the label after the
+    // number), in the order given
+    std::vector<std::vector<std::string> > fitchains(std::vector<std::string> const& bins);
+
+    // Fit every bin of chains with the model of fit() and append the
+    // efficiencies, in the same format, to tpefffile(elec, isdata).
+    //
+    // Each chain is fitted in order on one of up to nworkers processes, and
+    // every bin after the first starts from the converged shape parameters of
+    // the bin before it. The result of each bin is kept in cachedir under a
+    // hash of its input histograms, and bins whose histograms have not
+    // changed since the last run are not refitted. Nothing is plotted: the
+    // fit quality is judged on the same chi2 as in fit(), computed directly
+    // from the input histogram. Returns 0 on success.
+    int fitbins(std::vector<std::vector<std::string> > const& chains, std::string type, bool elec, bool isdata, unsigned nworkers, std::string cachedir);
+
+
+#endif
@@ -3,6 +3,13 @@
 #include <string>
 
 
+    // Prefixes of the pass and fail histograms of a type, e.g. "id_h_TP_"
+    void tphistnames(std::string type, std::string & TP, std::string & TF);
+    // The tag-and-probe output holding the histograms of a type
+    std::string tpinputfile(std::string type, bool elec, bool isdata);
+    // The efficiency table that fit() appends to, read by ScaleFactors
+    std::string tpefffile(bool elec, bool isdata);
+
     int fit(std::string filename, std::string type, bool elec, bool isdata);
     int fitone(std::string filename, std::string type, bool elec, bool isdata, double low, double high, bool isbifurc, bool samemean);
 
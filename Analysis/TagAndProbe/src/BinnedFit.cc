@@ -0,0 +1,446 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cmath>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <TSystem.h>
+#include "TFile.h"
+#include "TMath.h"
+#include "TH1F.h"
+
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataHist.h"
+#include "RooAbsPdf.h"
+#include "RooVoigtian.h"
+#include "RooAddPdf.h"
+#include "RooExponential.h"
+#include "RooSimultaneous.h"
+#include "RooFitResult.h"
+#include "RooFormulaVar.h"
+#include "RooHistError.h"
+
+#include "UserCode/ICHiggsTauTau/Analysis/TagAndProbe/interface/FittingFunction.h"
+#include "UserCode/ICHiggsTauTau/Analysis/TagAndProbe/interface/BinnedFit.h"
+
+using namespace RooFit ;
+using std::cerr;
+using std::endl;
+
+namespace {
+
+    // Changing the model in fitbin() should change this, so that cached
+    // results of the old model are not used
+    const char *kModel = "voigtian+exponential v1";
+
+    // The parameters passed on from one bin of a chain to the next
+    const char *kShapePars[] = {"MeanPass", "WidthPass", "ResolutionPass",
+        "WidthFail", "ResolutionFail", "bkgShapePass", "bkgShapeFail"};
+    const unsigned kNShapePars = sizeof(kShapePars) / sizeof(kShapePars[0]);
+
+    void hashbytes(unsigned long long & hash, void const* data, std::size_t size)
+    {
+        // 64-bit FNV-1a
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for(std::size_t i=0; i<size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    void hashhist(unsigned long long & hash, TH1 const* hist)
+    {
+        int nbins = hist->GetNbinsX();
+        hashbytes(hash, &nbins, sizeof(nbins));
+        for(int i=0; i<=nbins+1; i++)
+        {
+            double values[3] = {hist->GetXaxis()->GetBinLowEdge(i),
+                hist->GetBinContent(i), hist->GetBinError(i)};
+            hashbytes(hash, values, sizeof(values));
+        }
+    }
+
+    // The cache key of a bin. Each bin of a chain is seeded from the result
+    // of the one before, so the key of that bin is included as well: a
+    // change anywhere in a chain invalidates every later bin.
+    std::string histhash(std::string type, TH1 const* hpass, TH1 const* hfail, std::string const& previous)
+    {
+        unsigned long long hash = 14695981039346656037ULL;
+        std::string model = std::string(kModel) + " " + type;
+        hashbytes(hash, model.data(), model.size());
+        hashbytes(hash, previous.data(), previous.size());
+        hashhist(hash, hpass);
+        hashhist(hash, hfail);
+        std::ostringstream out;
+        out << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return out.str();
+    }
+
+    std::string cachefile(std::string cachedir, std::string type, bool elec, bool isdata, std::string bin)
+    {
+        return cachedir + "/" + (elec ? "electron" : "muon") + "_" + (isdata ? "data" : "MC")
+            + "_" + type + "_" + bin + ".fit";
+    }
+
+    bool readcache(std::string path, BinFitResult & result)
+    {
+        std::ifstream in(path.c_str());
+        if(!in) return false;
+        std::string key;
+        while(in >> key)
+        {
+            if(key=="bin") in >> result.bin;
+            else if(key=="hash") in >> result.hash;
+            else if(key=="eff") in >> result.eff;
+            else if(key=="err") in >> result.err;
+            else if(key=="probpass") in >> result.probpass;
+            else if(key=="probfail") in >> result.probfail;
+            else if(key=="covqual") in >> result.covqual;
+            else if(key=="par")
+            {
+                std::string name;
+                double value;
+                in >> name >> value;
+                result.pars[name] = value;
+            }
+            else return false;
+        }
+        return in.eof() && result.hash != "";
+    }
+
+    bool writecache(std::string path, BinFitResult const& result)
+    {
+        // Written to a temporary file and renamed, so that an interrupted run
+        // never leaves a partial result behind
+        std::string temp = path + ".tmp";
+        {
+            std::ofstream out(temp.c_str());
+            out << std::setprecision(17);
+            out << "bin " << result.bin << endl;
+            out << "hash " << result.hash << endl;
+            out << "eff " << result.eff << endl;
+            out << "err " << result.err << endl;
+            out << "probpass " << result.probpass << endl;
+            out << "probfail " << result.probfail << endl;
+            out << "covqual " << result.covqual << endl;
+            std::map<std::string, double>::const_iterator it;
+            for(it = result.pars.begin(); it != result.pars.end(); ++it)
+            {
+                out << "par " << it->first << " " << it->second << endl;
+            }
+            if(!out) return false;
+        }
+        return std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+
+    // chi2/ndf of pdf to the bins of hist with content, as RooPlot::chiSquare
+    // gives for the frames plotted in fit(): the pull of each bin uses the
+    // Poisson interval on the data and the pdf integrated over the bin
+    double reducedchi2(RooAbsPdf & pdf, RooRealVar & mass, TH1 const* hist)
+    {
+        RooArgSet normset(mass);
+        double nexp = pdf.expectedEvents(&normset);
+        double saved = mass.getVal();
+        double chi2 = 0.;
+        int nbins = 0;
+        for(int i=1; i<=hist->GetNbinsX(); i++)
+        {
+            double lo = hist->GetXaxis()->GetBinLowEdge(i);
+            double hi = hist->GetXaxis()->GetBinUpEdge(i);
+            double y = hist->GetBinContent(i);
+            if(lo < mass.getMin() || hi > mass.getMax() || y == 0.) continue;
+            // Simpson's rule over the bin
+            const int nsteps = 4;
+            double step = (hi - lo) / nsteps;
+            double sum = 0.;
+            for(int k=0; k<=nsteps; k++)
+            {
+                mass.setVal(lo + k * step);
+                double weight = (k == 0 || k == nsteps) ? 1. : (k % 2 ? 4. : 2.);
+                sum += weight * pdf.getVal(&normset);
+            }
+            double avg = nexp * sum * step / 3.;
+            double mu1, mu2;
+            int n = int(y + 0.5);
+            RooHistError::instance().getPoissonInterval(n, mu1, mu2, 1.);
+            double ey = (y > avg) ? (n - mu1) : (mu2 - n);
+            if(ey <= 0.) continue;
+            chi2 += (y - avg) * (y - avg) / (ey * ey);
+            nbins++;
+        }
+        mass.setVal(saved);
+        return nbins > 0 ? chi2 / nbins : 0.;
+    }
+
+    // The fit of fit(), started from the shape parameters of seed if given
+    void fitbin(TH1F *hist_pass, TH1F *hist_fail, BinFitResult const* seed, BinFitResult & result)
+    {
+        RooRealVar Mass("Mass","Mass of lepton pair",60.0, 120.0, "GeV/c^{2}");
+        RooCategory sample("sample","");
+        sample.defineType("Pass", 1);
+        sample.defineType("Fail", 2);
+
+        RooDataHist data_pass("data_pass","data_pass", RooArgList(Mass), hist_pass);
+        RooDataHist data_fail("data_fail","data_fail", RooArgList(Mass), hist_fail);
+        RooDataHist data_comb("fitData","fitData", RooArgList(Mass), RooFit::Index(sample),
+            RooFit::Import("Pass",data_pass), RooFit::Import("Fail",data_fail));
+
+        RooRealVar WidthFail("WidthFail","WidthFail", 2, 1, 10);
+        RooRealVar ResolutionFail("ResolutionFail", "ResolutionFail", 2.0, 0.1, 5.);
+        RooRealVar MeanPass("MeanPass","MeanPass", 91.1, 88.8, 93.2);
+        RooRealVar WidthPass("WidthPass","WidthPass", 2.5, 1, 10);
+        RooRealVar ResolutionPass("ResolutionPass", "ResolutionPass", 1.5, 0.1, 5.);
+        RooVoigtian voigtianPassPdf("voigtianPassPdf", "", Mass, MeanPass, WidthPass, ResolutionPass);
+        RooVoigtian voigtianFailPdf("voigtianFailPdf", "", Mass, MeanPass, WidthFail, ResolutionFail);
+
+        RooRealVar bkgShapePass("bkgShapePass","bkgShapePass", -0.0001,-10.,0.);
+        RooRealVar bkgShapeFail("bkgShapeFail","bkgShapeFail", -0.0001,-10.,0.);
+        RooExponential bkgShapePassPdf("bkgShapePassPdf", "bkgShapePassPdf",Mass, bkgShapePass);
+        RooExponential bkgShapeFailPdf("bkgShapeFailPdf", "bkgShapeFailPdf",Mass, bkgShapeFail);
+
+        RooRealVar nSigPass("nSigPass", "nSigPass", 1000,0.0,5000000.0);
+        RooRealVar nSigFail("nSigFail", "nSigFail", 1000,0.0,5000000.0);
+        RooRealVar nBkgPass("nBkgPass","nBkgPass", 1000.0, 0.0, 10000000.0);
+        RooRealVar nBkgFail("nBkgFail","nBkgFail", 1000.0, 0.0, 10000000.0);
+        RooFormulaVar eff("eff","nSigPass/(nSigPass+nSigFail)",RooArgList(nSigPass,nSigFail));
+
+        RooAddPdf pdfPass("pdfPass","extended sum pdf", RooArgList(voigtianPassPdf,bkgShapePassPdf),
+            RooArgList(nSigPass, nBkgPass));
+        RooAddPdf pdfFail("pdfFail","extended sum pdf", RooArgList(voigtianFailPdf,bkgShapeFailPdf),
+            RooArgList(nSigFail, nBkgFail));
+        RooSimultaneous totalPdf("totalPdf","totalPdf", sample);
+        totalPdf.addPdf(pdfPass,"Pass");
+        totalPdf.addPdf(pdfFail,"Fail");
+
+        RooRealVar *shapes[kNShapePars] = {&MeanPass, &WidthPass, &ResolutionPass,
+            &WidthFail, &ResolutionFail, &bkgShapePass, &bkgShapeFail};
+        if(seed)
+        {
+            for(unsigned i=0; i<kNShapePars; i++)
+            {
+                std::map<std::string, double>::const_iterator it = seed->pars.find(kShapePars[i]);
+                if(it != seed->pars.end()) shapes[i]->setVal(it->second);
+            }
+        }
+
+        RooFitResult *fitResult = totalPdf.fitTo(data_comb, RooFit::Save(true),
+            RooFit::Extended(true), RooFit::PrintLevel(-1),SumW2Error(kFALSE));
+        result.covqual = fitResult->covQual();
+        if (result.covqual!=3) cerr << "WARNING -- inaccurate errors in bin " << result.bin << endl;
+        result.eff = eff.getVal();
+        result.err = eff.getPropagatedError(*fitResult);
+        result.probpass = TMath::Prob(reducedchi2(pdfPass, Mass, hist_pass), 6);
+        result.probfail = TMath::Prob(reducedchi2(pdfFail, Mass, hist_fail), 6);
+        for(unsigned i=0; i<kNShapePars; i++)
+        {
+            result.pars[kShapePars[i]] = shapes[i]->getVal();
+        }
+        delete fitResult;
+    }
+
+    // Fit the bins of a chain in order, taking those with an up-to-date
+    // result from the cache. Bins without an entry in hashes are skipped.
+    int fitchain(std::vector<std::string> const& chain, std::string type, bool elec, bool isdata,
+        std::string cachedir, std::map<std::string, std::string> const& hashes)
+    {
+        std::string infile = tpinputfile(type, elec, isdata);
+        TFile f(infile.c_str(), "r");
+        if(f.IsZombie())
+        {
+            cerr << "Unable to open " << infile << endl;
+            return 1;
+        }
+        std::string TP,TF;
+        tphistnames(type, TP, TF);
+
+        BinFitResult previous;
+        bool haveprevious = false;
+        for(unsigned i=0; i<chain.size(); i++)
+        {
+            std::map<std::string, std::string>::const_iterator hash = hashes.find(chain[i]);
+            if(hash == hashes.end()) continue;
+            std::string path = cachefile(cachedir, type, elec, isdata, chain[i]);
+            BinFitResult result;
+            if(!readcache(path, result) || result.hash != hash->second)
+            {
+                result = BinFitResult();
+                result.bin = chain[i];
+                result.hash = hash->second;
+                std::cout << "Fitting " << type << " " << chain[i] << std::endl;
+                TH1F *hist_pass = (TH1F*)f.Get((TP+chain[i]).c_str());
+                TH1F *hist_fail = (TH1F*)f.Get((TF+chain[i]).c_str());
+                fitbin(hist_pass, hist_fail, haveprevious ? &previous : NULL, result);
+                if(!writecache(path, result))
+                {
+                    cerr << "Unable to write " << path << endl;
+                    return 1;
+                }
+            }
+            previous = result;
+            haveprevious = true;
+        }
+        return 0;
+    }
+}
+
+    BinFitResult::BinFitResult()
+        : eff(0.), err(0.), probpass(0.), probfail(0.), covqual(-1) {}
+
+    bool BinFitResult::goodfit() const
+    {
+        return probpass>0.005 && probfail>0.005;
+    }
+
+    std::vector<std::vector<std::string> > fitchains(std::vector<std::string> const& bins)
+    {
+        std::vector<std::string> regions;
+        std::vector<std::vector<std::string> > chains;
+        for(unsigned i=0; i<bins.size(); i++)
+        {
+            std::size_t pos = bins[i].find_first_not_of("0123456789");
+            std::string region = (pos == std::string::npos) ? "" : bins[i].substr(pos);
+            unsigned j = 0;
+            while(j<regions.size() && regions[j]!=region) j++;
+            if(j==regions.size())
+            {
+                regions.push_back(region);
+                chains.push_back(std::vector<std::string>());
+            }
+            chains[j].push_back(bins[i]);
+        }
+        return chains;
+    }
+
+    int fitbins(std::vector<std::vector<std::string> > const& chains, std::string type, bool elec, bool isdata, unsigned nworkers, std::string cachedir)
+    {
+        std::string infile = tpinputfile(type, elec, isdata);
+        if(infile=="")
+        {
+            cerr << "Unknown fit type " << type << endl;
+            return 1;
+        }
+        std::string TP,TF;
+        tphistnames(type, TP, TF);
+        gSystem->mkdir(cachedir.c_str(), true);
+
+        // Hash the input histograms of every bin, and find the chains with a
+        // bin whose cached result is missing or out of date
+        std::map<std::string, std::string> hashes;
+        std::vector<unsigned> todo;
+        unsigned nbins = 0, nfit = 0;
+        {
+            TFile f(infile.c_str(), "r");
+            if(f.IsZombie())
+            {
+                cerr << "Unable to open " << infile << endl;
+                return 1;
+            }
+            for(unsigned c=0; c<chains.size(); c++)
+            {
+                bool stale = false;
+                std::string previous;
+                for(unsigned i=0; i<chains[c].size(); i++)
+                {
+                    std::string const& bin = chains[c][i];
+                    TH1 *hist_pass = dynamic_cast<TH1*>(f.Get((TP+bin).c_str()));
+                    TH1 *hist_fail = dynamic_cast<TH1*>(f.Get((TF+bin).c_str()));
+                    if(!hist_pass || !hist_fail)
+                    {
+                        cerr << "No pass and fail histograms for " << type << " " << bin << " in " << infile << endl;
+                        continue;
+                    }
+                    hashes[bin] = histhash(type, hist_pass, hist_fail, previous);
+                    previous = hashes[bin];
+                    nbins++;
+                    BinFitResult cached;
+                    if(!readcache(cachefile(cachedir, type, elec, isdata, bin), cached) || cached.hash != hashes[bin])
+                    {
+                        stale = true;
+                        nfit++;
+                    }
+                }
+                if(stale) todo.push_back(c);
+            }
+        }
+        std::cout << "Fitting " << nfit << " of " << nbins << " " << type << " bins, the rest are in " << cachedir << std::endl;
+
+        // RooFit is not thread-safe, so the chains are fitted in separate
+        // processes, with at most nworkers running at once. The results are
+        // passed back through the cache.
+        int status = 0;
+        if(nworkers<=1 || todo.size()<=1)
+        {
+            for(unsigned c=0; c<todo.size(); c++)
+            {
+                status |= fitchain(chains[todo[c]], type, elec, isdata, cachedir, hashes);
+            }
+        }
+        else
+        {
+            unsigned running = 0;
+            for(unsigned c=0; c<=todo.size(); c++)
+            {
+                while(running>0 && (running>=nworkers || c==todo.size()))
+                {
+                    int childstatus = 0;
+                    if(wait(&childstatus) < 0) break;
+                    running--;
+                    if(!WIFEXITED(childstatus) || WEXITSTATUS(childstatus)!=0) status = 1;
+                }
+                if(c==todo.size()) break;
+                std::cout.flush();
+                std::cerr.flush();
+                pid_t pid = fork();
+                if(pid < 0)
+                {
+                    std::perror("fork");
+                    status |= fitchain(chains[todo[c]], type, elec, isdata, cachedir, hashes);
+                }
+                else if(pid == 0)
+                {
+                    int code = fitchain(chains[todo[c]], type, elec, isdata, cachedir, hashes);
+                    std::cout.flush();
+                    std::cerr.flush();
+                    _exit(code);
+                }
+                else
+                {
+                    running++;
+                }
+            }
+        }
+
+        // The efficiency table, as written by fit()
+        std::ofstream myfile2(tpefffile(elec, isdata).c_str(), std::ios::out | std::ios::app);
+        for(unsigned c=0; c<chains.size(); c++)
+        {
+            for(unsigned i=0; i<chains[c].size(); i++)
+            {
+                std::string const& bin = chains[c][i];
+                if(hashes.find(bin) == hashes.end()) continue;
+                BinFitResult result;
+                if(!readcache(cachefile(cachedir, type, elec, isdata, bin), result) || result.hash != hashes[bin])
+                {
+                    cerr << "No fit result for " << type << " " << bin << endl;
+                    status = 1;
+                    continue;
+                }
+                if(result.goodfit())
+                {
+                    myfile2 << type << " " << bin << " " << result.eff << " " << result.err << std::endl;
+                }
+                else
+                {
+                    std::cout << "============POOR FIT: " << bin << " ============"<< std::endl;
+                    myfile2 << "============POOR FIT========: " << type << " " << bin << " " << result.eff << " " << result.err << std::endl;
+                }
+            }
+        }
+        myfile2.close();
+        return status;
+    }
@@ -33,18 +33,8 @@ using std::ios;
 using std::cerr;
 using std::endl;
 
-    int fit(std::string filename, std::string type, bool elec, bool isdata){
-
-        RooRealVar* rooMass_ = new RooRealVar("Mass","Mass of lepton pair",60.0, 120.0,
-            "GeV/c^{2}");
-
-        RooRealVar Mass = *rooMass_;
-        RooCategory sample("sample","");
-        sample.defineType("Pass", 1);
-        sample.defineType("Fail", 2); 
-
-        std::string TP,TF;
-
+    void tphistnames(std::string type, std::string & TP, std::string & TF)
+    {
         if(type =="id" || type=="idbins")
         {
             TP="id_h_TP_";
@@ -65,40 +55,40 @@ using std::endl;
             TP="h_TP_";
             TF="h_TF_";
         }
+    }
 
-        TFile* f=NULL;
+    std::string tpinputfile(std::string type, bool elec, bool isdata)
+    {
+        bool idiso = (type=="id" || type=="iso" || type=="idiso"|| type=="idbins" || type=="isobins" || type=="idisobins");
+        if(!idiso && type!="trg") return "";
+        std::string lepton = elec ? "ee" : "mumu";
+        std::string sample = isdata ? "data" : "MC";
+        return lepton + (idiso ? "TandPIdIso" : "TandPtrg") + sample + ".root";
+    }
 
-        if(elec && (type=="id" || type=="iso" || type=="idiso"|| type=="idbins" || type=="isobins" || type=="idisobins") && isdata)
-        {
-            f=new TFile("eeTandPIdIsodata.root","r");
-        }
-        if(elec && (type=="id" || type=="iso" || type=="idiso"|| type=="idbins" || type=="isobins" || type=="idisobins") && !isdata)
-        {
-            f=new TFile("eeTandPIdIsoMC.root","r");
-        }
-        if(elec && (type=="trg") && isdata)
-        {
-            f=new TFile("eeTandPtrgdata.root","r");
-        }
-        if(elec && (type=="trg") && !isdata)
-        {
-            f=new TFile("eeTandPtrgMC.root","r");
-        }
-        if(!elec && (type=="id" || type=="iso" || type=="idiso"|| type=="idbins" || type=="isobins" || type=="idisobins") && isdata)
-        {
-            f=new TFile("mumuTandPIdIsodata.root","r");
-        }
-        if(!elec && (type=="id" || type=="iso" || type=="idiso"|| type=="idbins" || type=="isobins" || type=="idisobins") && !isdata)
-        {
-            f=new TFile("mumuTandPIdIsoMC.root","r");
-        }
-        if(!elec && (type=="trg") && isdata)
-        {
-            f=new TFile("mumuTandPtrgdata.root","r");
-        }
-        if(!elec && (type=="trg") && !isdata)
+    std::string tpefffile(bool elec, bool isdata)
+    {
+        return std::string(elec ? "electron" : "muon") + "_eff_" + (isdata ? "data" : "MC") + ".txt";
+    }
+
+    int fit(std::string filename, std::string type, bool elec, bool isdata){
+
+        RooRealVar* rooMass_ = new RooRealVar("Mass","Mass of lepton pair",60.0, 120.0,
+            "GeV/c^{2}");
+
+        RooRealVar Mass = *rooMass_;
+        RooCategory sample("sample","");
+        sample.defineType("Pass", 1);
+        sample.defineType("Fail", 2); 
+
+        std::string TP,TF;
+        tphistnames(type, TP, TF);
+
+        TFile* f=NULL;
+        std::string infile = tpinputfile(type, elec, isdata);
+        if(infile != "")
         {
-            f=new TFile("mumuTandPtrgMC.root","r");
+            f=new TFile(infile.c_str(),"r");
         }
 
 
@@ -106,22 +96,7 @@ using std::endl;
         f2->cd();
 
         std::ofstream myfile, myfile2;
-        if(elec && isdata)
-        {
-            myfile2.open("electron_eff_data.txt", ios::out | ios::app);
-        }
-        if(!elec && isdata)
-        {
-            myfile2.open("muon_eff_data.txt", ios::out | ios::app);
-        }
-        if(elec && !isdata)
-        {
-            myfile2.open("electron_eff_MC.txt", ios::out | ios::app);
-        }
-        if(!elec && !isdata)
-        {
-            myfile2.open("muon_eff_MC.txt", ios::out | ios::app);
-        }
+        myfile2.open(tpefffile(elec, isdata).c_str(), ios::out | ios::app);
         //Read in the pass and fail histograms, output of eeTagandProbe.C.
         TH1F *hist_pass = (TH1F*)f->Get((TP+filename).c_str());
         TH1F *hist_fail = (TH1F*)f->Get((TF+filename).c_str());
@@ -6,8 +6,28 @@
 #include "TH1F.h"
 #include "TLatex.h"
 #include "TSystem.h"
+#include <map>
+#include <vector>
 #include "boost/lexical_cast.hpp"
 #include "UserCode/ICHiggsTauTau/Analysis/TagAndProbe/interface/FittingFunction.h"
+#include "UserCode/ICHiggsTauTau/Analysis/TagAndProbe/interface/BinnedFit.h"
+
+// With a number of workers the bins are collected here, in order, and fitted
+// together by fitbins(); otherwise each is fitted straight away.
+bool usefitbins = false;
+std::vector<std::string> fittypes;
+std::map<std::string, std::vector<std::string> > fitqueue;
+
+void queuefit(std::string filename, std::string type, bool elec, bool isdata)
+{
+    if(!usefitbins)
+    {
+        fit(filename, type, elec, isdata);
+        return;
+    }
+    if(fitqueue.find(type)==fitqueue.end()) fittypes.push_back(type);
+    fitqueue[type].push_back(filename);
+}
 
 int main(int argc, char* argv[]){
 //using namespace ic;
@@ -23,13 +43,21 @@ bool isdata;
   for (int i = 0; i < argc; ++i){
     std::cout << i << "\t" << argv[i] << std::endl;
   }
-  if (argc != 4){
-    std::cerr << "Need 2 args: <id/iso/idiso/trg> <iselec> <isdata>" << std::endl;
+  if (argc < 4 || argc > 6){
+    std::cerr << "Need 3 args: <id/iso/idiso/trg> <iselec> <isdata> [<nworkers> [<cachedir>]]" << std::endl;
     exit(1);
   }
 
     elec=boost::lexical_cast<bool>(argv[2]);
     isdata=boost::lexical_cast<bool>(argv[3]);
+    unsigned nworkers=0;
+    std::string cachedir="FitCache";
+    if(argc > 4)
+    {
+        usefitbins=true;
+        nworkers=boost::lexical_cast<unsigned>(argv[4]);
+    }
+    if(argc > 5) cachedir=argv[5];
 
 //std::cout << "elec:  " << elec << " argv[2]: " << argv[2]<<std::endl;
 //std::cout << "isdata:  " << isdata << " argv[3]: " << *argv[3] << std::endl;
@@ -48,22 +76,22 @@ bool isdata;
         std::string s9="3Eb";
         if(elec)
         {
-            fit(s1,"id", elec, isdata);
-            fit(s2,"id", elec, isdata);
-            fit(s4,"id", elec, isdata);
-            fit(s5,"id", elec, isdata);
+            queuefit(s1,"id", elec, isdata);
+            queuefit(s2,"id", elec, isdata);
+            queuefit(s4,"id", elec, isdata);
+            queuefit(s5,"id", elec, isdata);
         }
         else
         {
-            fit(s1,"id", elec, isdata);
-            fit(s2,"id", elec, isdata);
-            fit(s3,"id", elec, isdata);
-            fit(s4,"id", elec, isdata);
-            fit(s5,"id", elec, isdata);
-            fit(s6,"id", elec, isdata);
-            fit(s7,"id", elec, isdata);
-            fit(s8,"id", elec, isdata);
-            fit(s9,"id", elec, isdata);
+            queuefit(s1,"id", elec, isdata);
+            queuefit(s2,"id", elec, isdata);
+            queuefit(s3,"id", elec, isdata);
+            queuefit(s4,"id", elec, isdata);
+            queuefit(s5,"id", elec, isdata);
+            queuefit(s6,"id", elec, isdata);
+            queuefit(s7,"id", elec, isdata);
+            queuefit(s8,"id", elec, isdata);
+            queuefit(s9,"id", elec, isdata);
         }
     }
     if(type=="iso")
@@ -79,22 +107,22 @@ bool isdata;
         std::string s9="3Eb";
         if(elec)
         {
-            fit(s1,"iso", elec, isdata);
-            fit(s2,"iso", elec, isdata);
-            fit(s4,"iso", elec, isdata);
-            fit(s5,"iso", elec, isdata);
+            queuefit(s1,"iso", elec, isdata);
+            queuefit(s2,"iso", elec, isdata);
+            queuefit(s4,"iso", elec, isdata);
+            queuefit(s5,"iso", elec, isdata);
         }
         else
         {
-            fit(s1,"iso", elec, isdata);
-            fit(s2,"iso", elec, isdata);
-            fit(s3,"iso", elec, isdata);
-            fit(s4,"iso", elec, isdata);
-            fit(s5,"iso", elec, isdata);
-            fit(s6,"iso", elec, isdata);
-            fit(s7,"iso", elec, isdata);
-            fit(s8,"iso", elec, isdata);
-            fit(s9,"iso", elec, isdata);
+            queuefit(s1,"iso", elec, isdata);
+            queuefit(s2,"iso", elec, isdata);
+            queuefit(s3,"iso", elec, isdata);
+            queuefit(s4,"iso", elec, isdata);
+            queuefit(s5,"iso", elec, isdata);
+            queuefit(s6,"iso", elec, isdata);
+            queuefit(s7,"iso", elec, isdata);
+            queuefit(s8,"iso", elec, isdata);
+            queuefit(s9,"iso", elec, isdata);
         }
     }
     if(type=="idiso")
@@ -110,22 +138,22 @@ bool isdata;
         std::string s9="3Eb";
         if(elec)
         {
-            fit(s1,"idiso", elec, isdata);
-            fit(s2,"idiso", elec, isdata);
-            fit(s4,"idiso", elec, isdata);
-            fit(s5,"idiso", elec, isdata);
+            queuefit(s1,"idiso", elec, isdata);
+            queuefit(s2,"idiso", elec, isdata);
+            queuefit(s4,"idiso", elec, isdata);
+            queuefit(s5,"idiso", elec, isdata);
         }
         else
         {
-            fit(s1,"idiso", elec, isdata);
-            fit(s2,"idiso", elec, isdata);
-            fit(s3,"idiso", elec, isdata);
-            fit(s4,"idiso", elec, isdata);
-            fit(s5,"idiso", elec, isdata);
-            fit(s6,"idiso", elec, isdata);
-            fit(s7,"idiso", elec, isdata);
-            fit(s8,"idiso", elec, isdata);
-            fit(s9,"idiso", elec, isdata);
+            queuefit(s1,"idiso", elec, isdata);
+            queuefit(s2,"idiso", elec, isdata);
+            queuefit(s3,"idiso", elec, isdata);
+            queuefit(s4,"idiso", elec, isdata);
+            queuefit(s5,"idiso", elec, isdata);
+            queuefit(s6,"idiso", elec, isdata);
+            queuefit(s7,"idiso", elec, isdata);
+            queuefit(s8,"idiso", elec, isdata);
+            queuefit(s9,"idiso", elec, isdata);
         }
         
     }
@@ -146,21 +174,21 @@ bool isdata;
         std::string s25="1vtx";
         std::string s26="2vtx";
         std::string s27="3vtx";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
-        fit(s11, "trg", elec, isdata);
-        fit(s12, "trg", elec, isdata);/*
-        fit(s25, "trg", elec, isdata);
-        fit(s26, "trg", elec, isdata);
-        fit(s27, "trg", elec, isdata);*/
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
+        queuefit(s11, "trg", elec, isdata);
+        queuefit(s12, "trg", elec, isdata);/*
+        queuefit(s25, "trg", elec, isdata);
+        queuefit(s26, "trg", elec, isdata);
+        queuefit(s27, "trg", elec, isdata);*/
     }
     if(type=="trgE")
     {
@@ -188,32 +216,32 @@ bool isdata;
         std::string s22="10Eb";
         std::string s23="11Eb";
         std::string s24="12Eb";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
-        fit(s11, "trg", elec, isdata);
-        fit(s12, "trg", elec, isdata);
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
+        queuefit(s11, "trg", elec, isdata);
+        queuefit(s12, "trg", elec, isdata);
         if(!elec)
         {
-            fit(s13, "trg", elec, isdata);
-            fit(s14, "trg", elec, isdata);
-            fit(s15, "trg", elec, isdata);
-            fit(s16, "trg", elec, isdata);
-            fit(s17, "trg", elec, isdata);
-            fit(s18, "trg", elec, isdata);
-            fit(s19, "trg", elec, isdata);
-            fit(s20, "trg", elec, isdata);
-            fit(s21, "trg", elec, isdata);
-            fit(s22, "trg", elec, isdata);
-            fit(s23, "trg", elec, isdata);
-            fit(s24, "trg", elec, isdata);
+            queuefit(s13, "trg", elec, isdata);
+            queuefit(s14, "trg", elec, isdata);
+            queuefit(s15, "trg", elec, isdata);
+            queuefit(s16, "trg", elec, isdata);
+            queuefit(s17, "trg", elec, isdata);
+            queuefit(s18, "trg", elec, isdata);
+            queuefit(s19, "trg", elec, isdata);
+            queuefit(s20, "trg", elec, isdata);
+            queuefit(s21, "trg", elec, isdata);
+            queuefit(s22, "trg", elec, isdata);
+            queuefit(s23, "trg", elec, isdata);
+            queuefit(s24, "trg", elec, isdata);
         }
     }
     if(type=="trgBplus")
@@ -230,18 +258,18 @@ bool isdata;
         std::string s10="10Bplus";
         std::string s11="11Bplus";
         std::string s12="12Bplus";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
-        fit(s11, "trg", elec, isdata);
-        fit(s12, "trg", elec, isdata);
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
+        queuefit(s11, "trg", elec, isdata);
+        queuefit(s12, "trg", elec, isdata);
     }
     if(type=="trgEplus")
     {
@@ -269,32 +297,32 @@ bool isdata;
         std::string s22="10Ebplus";
         std::string s23="11Ebplus";
         std::string s24="12Ebplus";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
-        fit(s11, "trg", elec, isdata);
-        fit(s12, "trg", elec, isdata);
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
+        queuefit(s11, "trg", elec, isdata);
+        queuefit(s12, "trg", elec, isdata);
         if(!elec)
         {
-            fit(s13, "trg", elec, isdata);
-            fit(s14, "trg", elec, isdata);
-            fit(s15, "trg", elec, isdata);
-            fit(s16, "trg", elec, isdata);
-            fit(s17, "trg", elec, isdata);
-            fit(s18, "trg", elec, isdata);
-            fit(s19, "trg", elec, isdata);
-            fit(s20, "trg", elec, isdata);
-            fit(s21, "trg", elec, isdata);
-            fit(s22, "trg", elec, isdata);
-            fit(s23, "trg", elec, isdata);
-            fit(s24, "trg", elec, isdata);
+            queuefit(s13, "trg", elec, isdata);
+            queuefit(s14, "trg", elec, isdata);
+            queuefit(s15, "trg", elec, isdata);
+            queuefit(s16, "trg", elec, isdata);
+            queuefit(s17, "trg", elec, isdata);
+            queuefit(s18, "trg", elec, isdata);
+            queuefit(s19, "trg", elec, isdata);
+            queuefit(s20, "trg", elec, isdata);
+            queuefit(s21, "trg", elec, isdata);
+            queuefit(s22, "trg", elec, isdata);
+            queuefit(s23, "trg", elec, isdata);
+            queuefit(s24, "trg", elec, isdata);
         }
     }
     if(type=="trgBminus")
@@ -311,18 +339,18 @@ bool isdata;
         std::string s10="10Bminus";
         std::string s11="11Bminus";
         std::string s12="12Bminus";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
-        fit(s11, "trg", elec, isdata);
-        fit(s12, "trg", elec, isdata);
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
+        queuefit(s11, "trg", elec, isdata);
+        queuefit(s12, "trg", elec, isdata);
     }
     if(type=="trgEminus")
     {
@@ -350,32 +378,32 @@ bool isdata;
         std::string s22="10Ebminus";
         std::string s23="11Ebminus";
         std::string s24="12Ebminus";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
-        fit(s11, "trg", elec, isdata);
-        fit(s12, "trg", elec, isdata);
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
+        queuefit(s11, "trg", elec, isdata);
+        queuefit(s12, "trg", elec, isdata);
         if(!elec)
         {
-            fit(s13, "trg", elec, isdata);
-            fit(s14, "trg", elec, isdata);
-            fit(s15, "trg", elec, isdata);
-            fit(s16, "trg", elec, isdata);
-            fit(s17, "trg", elec, isdata);
-            fit(s18, "trg", elec, isdata);
-            fit(s19, "trg", elec, isdata);
-            fit(s20, "trg", elec, isdata);
-            fit(s21, "trg", elec, isdata);
-            fit(s22, "trg", elec, isdata);
-            fit(s23, "trg", elec, isdata);
-            fit(s24, "trg", elec, isdata);
+            queuefit(s13, "trg", elec, isdata);
+            queuefit(s14, "trg", elec, isdata);
+            queuefit(s15, "trg", elec, isdata);
+            queuefit(s16, "trg", elec, isdata);
+            queuefit(s17, "trg", elec, isdata);
+            queuefit(s18, "trg", elec, isdata);
+            queuefit(s19, "trg", elec, isdata);
+            queuefit(s20, "trg", elec, isdata);
+            queuefit(s21, "trg", elec, isdata);
+            queuefit(s22, "trg", elec, isdata);
+            queuefit(s23, "trg", elec, isdata);
+            queuefit(s24, "trg", elec, isdata);
         }
     }
     if(type=="trgbins")
@@ -390,16 +418,16 @@ bool isdata;
         std::string s8="8eta";
         std::string s9="9eta";
         std::string s10="10eta";
-        fit(s1, "trg", elec, isdata);
-        fit(s2, "trg", elec, isdata);
-        fit(s3, "trg", elec, isdata);
-        fit(s4, "trg", elec, isdata);
-        fit(s5, "trg", elec, isdata);
-        fit(s6, "trg", elec, isdata);
-        fit(s7, "trg", elec, isdata);
-        fit(s8, "trg", elec, isdata);
-        fit(s9, "trg", elec, isdata);
-        fit(s10, "trg", elec, isdata);
+        queuefit(s1, "trg", elec, isdata);
+        queuefit(s2, "trg", elec, isdata);
+        queuefit(s3, "trg", elec, isdata);
+        queuefit(s4, "trg", elec, isdata);
+        queuefit(s5, "trg", elec, isdata);
+        queuefit(s6, "trg", elec, isdata);
+        queuefit(s7, "trg", elec, isdata);
+        queuefit(s8, "trg", elec, isdata);
+        queuefit(s9, "trg", elec, isdata);
+        queuefit(s10, "trg", elec, isdata);
     }
     if(type=="idbins")
     {
@@ -429,32 +457,32 @@ bool isdata;
         std::string s24="8vtx";
         std::string s25="9vtx";
         std::string s26="10vtx";
-        fit(s1, "idbins", elec, isdata);
-        fit(s2, "idbins", elec, isdata);
-        fit(s3, "idbins", elec, isdata);
-        fit(s4, "idbins", elec, isdata);
-        fit(s5, "idbins", elec, isdata);
-        fit(s6, "idbins", elec, isdata);
-        fit(s7, "idbins", elec, isdata);
-        fit(s8, "idbins", elec, isdata);
-        fit(s9, "idbins", elec, isdata);
-        fit(s10, "idbins", elec, isdata);
-        fit(s11, "idbins", elec, isdata);
-        fit(s12, "idbins", elec, isdata);
-        fit(s13, "idbins", elec, isdata);
-        fit(s14, "idbins", elec, isdata);
-        fit(s15, "idbins", elec, isdata);
-        fit(s16, "idbins", elec, isdata);
-        fit(s17, "idbins", elec, isdata);
-        fit(s18, "idbins", elec, isdata);
-        fit(s19, "idbins", elec, isdata);
-        fit(s20, "idbins", elec, isdata);
-        fit(s21, "idbins", elec, isdata);
-        fit(s22, "idbins", elec, isdata);
-        fit(s23, "idbins", elec, isdata);
-        fit(s24, "idbins", elec, isdata);
-        fit(s25, "idbins", elec, isdata);
-        fit(s26, "idbins", elec, isdata);
+        queuefit(s1, "idbins", elec, isdata);
+        queuefit(s2, "idbins", elec, isdata);
+        queuefit(s3, "idbins", elec, isdata);
+        queuefit(s4, "idbins", elec, isdata);
+        queuefit(s5, "idbins", elec, isdata);
+        queuefit(s6, "idbins", elec, isdata);
+        queuefit(s7, "idbins", elec, isdata);
+        queuefit(s8, "idbins", elec, isdata);
+        queuefit(s9, "idbins", elec, isdata);
+        queuefit(s10, "idbins", elec, isdata);
+        queuefit(s11, "idbins", elec, isdata);
+        queuefit(s12, "idbins", elec, isdata);
+        queuefit(s13, "idbins", elec, isdata);
+        queuefit(s14, "idbins", elec, isdata);
+        queuefit(s15, "idbins", elec, isdata);
+        queuefit(s16, "idbins", elec, isdata);
+        queuefit(s17, "idbins", elec, isdata);
+        queuefit(s18, "idbins", elec, isdata);
+        queuefit(s19, "idbins", elec, isdata);
+        queuefit(s20, "idbins", elec, isdata);
+        queuefit(s21, "idbins", elec, isdata);
+        queuefit(s22, "idbins", elec, isdata);
+        queuefit(s23, "idbins", elec, isdata);
+        queuefit(s24, "idbins", elec, isdata);
+        queuefit(s25, "idbins", elec, isdata);
+        queuefit(s26, "idbins", elec, isdata);
     }
     if(type=="isobins")
     {
@@ -484,32 +512,32 @@ bool isdata;
         std::string s24="8vtx";
         std::string s25="9vtx";
         std::string s26="10vtx";
-        fit(s1, "isobins", elec, isdata);
-        fit(s2, "isobins", elec, isdata);
-        fit(s3, "isobins", elec, isdata);
-        fit(s4, "isobins", elec, isdata);
-        fit(s5, "isobins", elec, isdata);
-        fit(s6, "isobins", elec, isdata);
-        fit(s7, "isobins", elec, isdata);
-        fit(s8, "isobins", elec, isdata);
-        fit(s9, "isobins", elec, isdata);
-        fit(s10, "isobins", elec, isdata);
-        fit(s11, "isobins", elec, isdata);
-        fit(s12, "isobins", elec, isdata);
-        fit(s13, "isobins", elec, isdata);
-        fit(s14, "isobins", elec, isdata);
-        fit(s15, "isobins", elec, isdata);
-        fit(s16, "isobins", elec, isdata);
-        fit(s17, "isobins", elec, isdata);
-        fit(s18, "isobins", elec, isdata);
-        fit(s19, "isobins", elec, isdata);
-        fit(s20, "isobins", elec, isdata);
-        fit(s21, "isobins", elec, isdata);
-        fit(s22, "isobins", elec, isdata);
-        fit(s23, "isobins", elec, isdata);
-        fit(s24, "isobins", elec, isdata);
-        fit(s25, "isobins", elec, isdata);
-        fit(s26, "isobins", elec, isdata);
+        queuefit(s1, "isobins", elec, isdata);
+        queuefit(s2, "isobins", elec, isdata);
+        queuefit(s3, "isobins", elec, isdata);
+        queuefit(s4, "isobins", elec, isdata);
+        queuefit(s5, "isobins", elec, isdata);
+        queuefit(s6, "isobins", elec, isdata);
+        queuefit(s7, "isobins", elec, isdata);
+        queuefit(s8, "isobins", elec, isdata);
+        queuefit(s9, "isobins", elec, isdata);
+        queuefit(s10, "isobins", elec, isdata);
+        queuefit(s11, "isobins", elec, isdata);
+        queuefit(s12, "isobins", elec, isdata);
+        queuefit(s13, "isobins", elec, isdata);
+        queuefit(s14, "isobins", elec, isdata);
+        queuefit(s15, "isobins", elec, isdata);
+        queuefit(s16, "isobins", elec, isdata);
+        queuefit(s17, "isobins", elec, isdata);
+        queuefit(s18, "isobins", elec, isdata);
+        queuefit(s19, "isobins", elec, isdata);
+        queuefit(s20, "isobins", elec, isdata);
+        queuefit(s21, "isobins", elec, isdata);
+        queuefit(s22, "isobins", elec, isdata);
+        queuefit(s23, "isobins", elec, isdata);
+        queuefit(s24, "isobins", elec, isdata);
+        queuefit(s25, "isobins", elec, isdata);
+        queuefit(s26, "isobins", elec, isdata);
     }
     if(type=="idisobins")
     {
@@ -539,33 +567,39 @@ bool isdata;
         std::string s24="8vtx";
         std::string s25="9vtx";
         std::string s26="10vtx";
-        fit(s1, "idisobins", elec, isdata);
-        fit(s2, "idisobins", elec, isdata);
-        fit(s3, "idisobins", elec, isdata);
-        fit(s4, "idisobins", elec, isdata);
-        fit(s5, "idisobins", elec, isdata);
-        fit(s6, "idisobins", elec, isdata);
-        fit(s7, "idisobins", elec, isdata);
-        fit(s8, "idisobins", elec, isdata);
-        fit(s9, "idisobins", elec, isdata);
-        fit(s10, "idisobins", elec, isdata);
-        fit(s11, "idisobins", elec, isdata);
-        fit(s12, "idisobins", elec, isdata);
-        fit(s13, "idisobins", elec, isdata);
-        fit(s14, "idisobins", elec, isdata);
-        fit(s15, "idisobins", elec, isdata);
-        fit(s16, "idisobins", elec, isdata);
-        fit(s17, "idisobins", elec, isdata);
-        fit(s18, "idisobins", elec, isdata);
-        fit(s19, "idisobins", elec, isdata);
-        fit(s20, "idisobins", elec, isdata);
-        fit(s21, "idisobins", elec, isdata);
-        fit(s22, "idisobins", elec, isdata);
-        fit(s23, "idisobins", elec, isdata);
-        fit(s24, "idisobins", elec, isdata);
-        fit(s25, "idisobins", elec, isdata);
-        fit(s26, "idisobins", elec, isdata);
+        queuefit(s1, "idisobins", elec, isdata);
+        queuefit(s2, "idisobins", elec, isdata);
+        queuefit(s3, "idisobins", elec, isdata);
+        queuefit(s4, "idisobins", elec, isdata);
+        queuefit(s5, "idisobins", elec, isdata);
+        queuefit(s6, "idisobins", elec, isdata);
+        queuefit(s7, "idisobins", elec, isdata);
+        queuefit(s8, "idisobins", elec, isdata);
+        queuefit(s9, "idisobins", elec, isdata);
+        queuefit(s10, "idisobins", elec, isdata);
+        queuefit(s11, "idisobins", elec, isdata);
+        queuefit(s12, "idisobins", elec, isdata);
+        queuefit(s13, "idisobins", elec, isdata);
+        queuefit(s14, "idisobins", elec, isdata);
+        queuefit(s15, "idisobins", elec, isdata);
+        queuefit(s16, "idisobins", elec, isdata);
+        queuefit(s17, "idisobins", elec, isdata);
+        queuefit(s18, "idisobins", elec, isdata);
+        queuefit(s19, "idisobins", elec, isdata);
+        queuefit(s20, "idisobins", elec, isdata);
+        queuefit(s21, "idisobins", elec, isdata);
+        queuefit(s22, "idisobins", elec, isdata);
+        queuefit(s23, "idisobins", elec, isdata);
+        queuefit(s24, "idisobins", elec, isdata);
+        queuefit(s25, "idisobins", elec, isdata);
+        queuefit(s26, "idisobins", elec, isdata);
+    }
+
+    int status=0;
+    for(unsigned i=0; i<fittypes.size(); i++)
+    {
+        status |= fitbins(fitchains(fitqueue[fittypes[i]]), fittypes[i], elec, isdata, nworkers, cachedir);
     }
 
-    return 0;
+    return status;
 }
@@ -0,0 +1,83 @@
+#ifndef ICHiggsTauTau_Utilities_BDTForest_h
+#define ICHiggsTauTau_Utilities_BDTForest_h
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace ic {
+
+/**
+ * @brief A boosted decision tree read from a TMVA BDT or BDTG weight file,
+ * evaluated without TMVA
+ *
+ * The trees are stored depth-first in one contiguous array of nodes, each
+ * holding a float threshold and the index of the input variable it cuts on,
+ * with the leaves holding the value they contribute. Evaluate() reproduces
+ * TMVA::Reader::EvaluateMVA: the cuts are made in single precision as in
+ * TMVA, the leaf values are summed in double precision in tree order, and
+ * AdaBoost (and bagged) forests return the boost-weighted average while
+ * gradient-boosted forests, whose leaves always hold a response, return
+ * 2/(1+exp(-2*sum))-1. As in TMVA an event
+ * with a NaN input gets -999.
+ *
+ * Only forests without input variable transformations or Fisher cuts are
+ * supported; anything else throws a std::runtime_error, as does a weight file
+ * that cannot be read.
+ */
+class BDTForest {
+ public:
+  explicit BDTForest(std::string const& weight_file);
+
+  /// Expressions of the input variables, in the order Evaluate() takes them
+  inline std::vector<std::string> const& variables() const { return variables_; }
+  inline unsigned n_trees() const { return roots_.size(); }
+
+  /// Throws unless `names` are the input variables in the right order, as
+  /// TMVA::Reader::BookMVA does for the variables added to the reader
+  void CheckVariables(std::vector<std::string> const& names) const;
+
+  /// The response for one event with variables()[i] in features[i]
+  double Evaluate(float const* features) const;
+  inline double Evaluate(std::vector<float> const& features) const {
+    return Evaluate(features.data());
+  }
+
+  /// The responses for n events stored one after the other, each as in the
+  /// single-event Evaluate()
+  void Evaluate(float const* features, std::size_t n, double* out) const;
+  /// As above, rounding the responses to single precision
+  void Evaluate(float const* features, std::size_t n, float* out) const;
+
+ private:
+  // A leaf if var < 0, in which case value is its contribution. Otherwise
+  // the event continues to child[features[var] >= value].
+  struct Node {
+    float value;
+    int var;
+    unsigned child[2];
+  };
+
+  double Finish(double sum) const;
+  inline double Tree(unsigned root, float const* features) const {
+    Node const* node = &nodes_[root];
+    while (node->var >= 0) {
+      node = &nodes_[node->child[features[node->var] >= node->value]];
+    }
+    return node->value;
+  }
+  bool HasNaN(float const* features) const;
+  template <class T>
+  void EvaluateBlocks(float const* features, std::size_t n, T* out) const;
+
+  std::vector<std::string> variables_;
+  std::vector<Node> nodes_;
+  std::vector<unsigned> roots_;
+  std::vector<double> weights_;
+  double norm_;
+  bool grad_;
+  std::string file_;
+};
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include "UserCode/ICHiggsTauTau/interface/Objects.hh"
 #include "UserCode/ICHiggsTauTau/interface/SuperCluster.hh"
 #include "UserCode/ICHiggsTauTau/interface/CompositeCandidate.hh"
+#include "Utilities/interface/GenGraph.h"
 
 namespace ic {
 
@@ -401,6 +402,10 @@ namespace ic {
 
   std::vector<GenJet> BuildTauJets(std::vector<GenParticle *> const& parts, bool include_leptonic, bool use_prompt);
 
+  /// As above, using a graph of the particles that may be shared with other
+  /// modules through GenGraph::Get()
+  std::vector<GenJet> BuildTauJets(GenGraph const& graph, bool include_leptonic, bool use_prompt);
+
   ROOT::Math::PtEtaPhiEVector reconstructWboson(Candidate const*  lepton, Candidate const* met);
 
   template <class T, class U>
@@ -0,0 +1,131 @@
+#ifndef ICHiggsTauTau_Utilities_GenGraph_h
+#define ICHiggsTauTau_Utilities_GenGraph_h
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Core/interface/TreeEvent.h"
+#include "UserCode/ICHiggsTauTau/interface/GenParticle.hh"
+
+namespace ic {
+
+/**
+ * @brief The mother-daughter graph of a collection of GenParticles, for
+ * walking decay chains without searching the collection at each step
+ *
+ * Each particle is a node, numbered by its position in the input. The
+ * daughters and mothers of all nodes are stored in two flat tables
+ * (compressed sparse rows), keeping only the relatives that are in the
+ * input, in input order. Building the graph is O(n); finding the
+ * daughters of a node is O(out-degree) and the recursive queries only
+ * visit the particles they return. The status flags are packed into one
+ * word per node.
+ *
+ * The GenParticle::index() values of the input must be unique, as they
+ * are in the genParticles branch. Use Get() to share one graph between
+ * all the modules that run on an event.
+ */
+class GenGraph {
+ public:
+  /// A range of node numbers, usable in a range-based for loop
+  class Nodes {
+   public:
+    Nodes(unsigned const* begin, unsigned const* end)
+        : begin_(begin), end_(end) {}
+    inline unsigned const* begin() const { return begin_; }
+    inline unsigned const* end() const { return end_; }
+    inline unsigned size() const { return end_ - begin_; }
+    inline bool empty() const { return begin_ == end_; }
+    inline unsigned operator[](unsigned i) const { return begin_[i]; }
+
+   private:
+    unsigned const* begin_;
+    unsigned const* end_;
+  };
+
+  GenGraph();
+  explicit GenGraph(std::vector<GenParticle *> const& parts);
+
+  /// Replace the graph with the one of `parts`
+  void Build(std::vector<GenParticle *> const& parts);
+
+  /**
+   * @brief The graph of the GenParticle collection `label` in `event`,
+   * built on the first call in each event and stored in the event
+   *
+   * The graph is built from the collection as it is at that point, so
+   * modules that filter the collection in place should do so afterwards
+   * or build their own graph.
+   */
+  static GenGraph const& Get(TreeEvent *event,
+                             std::string const& label = "genParticles");
+
+  inline unsigned size() const { return parts_.size(); }
+  inline GenParticle * particle(unsigned node) const { return parts_[node]; }
+
+  /// The node of the particle with this GenParticle::index(), or -1
+  inline int NodeOfIndex(int index) const {
+    return (index >= 0 && unsigned(index) < node_of_index_.size())
+               ? node_of_index_[index]
+               : -1;
+  }
+
+  /// The node of `part`, or -1 if it is not in the graph
+  inline int Node(GenParticle const* part) const {
+    int node = NodeOfIndex(part->index());
+    return (node >= 0 && parts_[node] == part) ? node : -1;
+  }
+
+  inline Nodes Daughters(unsigned node) const {
+    return Nodes(d_nodes_.data() + d_offsets_[node],
+                 d_nodes_.data() + d_offsets_[node + 1]);
+  }
+  inline Nodes Mothers(unsigned node) const {
+    return Nodes(m_nodes_.data() + m_offsets_[node],
+                 m_nodes_.data() + m_offsets_[node + 1]);
+  }
+
+  /// Test one of the GenStatusBits, false if the flag was not stored
+  inline bool HasFlag(unsigned node, GenStatusBits bit) const {
+    return (flags_[node] >> bit) & 1u;
+  }
+
+  /// @name Queries by particle
+  /// These give the same results as the functions of the same name in
+  /// FnPredicates.h. `part` does not need to be in the graph itself.
+  /**@{*/
+  /// The daughters in the graph, in input order
+  std::vector<GenParticle *> ExtractDaughters(GenParticle const* part) const;
+  /// The mothers in the graph, in input order
+  std::vector<GenParticle *> ExtractMothers(GenParticle const* part) const;
+  /// All descendants, sorted by GenParticle::index()
+  std::vector<GenParticle *> ExtractDaughtersRecursive(
+      GenParticle const* part) const;
+  /// The status 1 descendants, reached through particles of other status,
+  /// in input order
+  std::vector<GenParticle *> ExtractStableDaughters(
+      GenParticle const* part) const;
+  /**@}*/
+
+ private:
+  void ChildNodes(GenParticle const* part, std::vector<unsigned> & out) const;
+  void NewVisit() const;
+  std::vector<GenParticle *> ToParticles(
+      std::vector<unsigned> const& nodes) const;
+
+  std::vector<GenParticle *> parts_;
+  std::vector<int> node_of_index_;
+  std::vector<unsigned> d_offsets_;
+  std::vector<unsigned> d_nodes_;
+  std::vector<unsigned> m_offsets_;
+  std::vector<unsigned> m_nodes_;
+  std::vector<uint32_t> flags_;
+  // Visit marks for the recursive queries: a node was seen in the current
+  // query if its mark equals visit_, so they need no clearing
+  mutable std::vector<unsigned> marks_;
+  mutable unsigned visit_;
+  mutable std::vector<unsigned> stack_;
+};
+}
+
+#endif
@@ -4,8 +4,7 @@
 #include "TH1F.h"
 #include "TH2F.h"
 
-#include "PhysicsTools/FWLite/interface/TFileService.h"
-#include "CommonTools/Utils/interface/TFileDirectory.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 
 namespace ic {
 
@@ -20,7 +19,7 @@ struct MassPlots {
 	TH1F *m_vis_sm_fine;
 	TH1F *m_vis_mssm;
 	TH1F *m_vis_mssm_fine;
-	MassPlots(TFileDirectory const& dir);
+	MassPlots(FileDirectory const& dir);
 };
 
 struct CoreControlPlots {
@@ -52,7 +51,7 @@ struct CoreControlPlots {
 	TH1F *tau_decay_mode;
 	TH1F *l1_met;
 	TH1F *calo_nohf_met;
-	CoreControlPlots(TFileDirectory const& dir);
+	CoreControlPlots(FileDirectory const& dir);
 };
 
 }
@@ -0,0 +1,98 @@
+#ifndef ICHiggsTauTau_Utilities_HistMorph_h
+#define ICHiggsTauTau_Utilities_HistMorph_h
+
+#include <vector>
+#include <string>
+#include "TH1.h"
+
+namespace ic {
+
+/**
+ * @brief Linear interpolation between two histograms as a function of a
+ * parameter such as a mass, following A. L. Read, NIM A 425 (1999) 357
+ *
+ * This gives the same result as th1fmorph, bin-by-bin, but the cumulative
+ * distributions of the two reference templates are built and walked once in
+ * the constructor. What is left for each target parameter value is a linear
+ * combination of the stored edge positions and a projection onto the output
+ * binning, so morphing to many targets costs little more than morphing to
+ * one. The output binning is the union of the edges of the two references.
+ *
+ * As in th1fmorph the underflow and overflow bins are ignored, and if either
+ * reference is empty every target is empty (and, for the histograms made by
+ * Morphed(), has uniform bins between the outermost edges).
+ */
+class HistMorph {
+ public:
+  HistMorph(TH1 const& hist1, TH1 const& hist2, double par1, double par2);
+
+  /// References given as bin edges and the contents of the bins in between
+  HistMorph(std::vector<double> const& edges1,
+            std::vector<double> const& contents1,
+            std::vector<double> const& edges2,
+            std::vector<double> const& contents2,
+            double par1, double par2);
+
+  /// Contents of the output bins at `par`, normalised to `norm`
+  std::vector<double> Morph(double par, double norm) const;
+
+  /// Morph to each of `pars` in turn, with the corresponding `norms`
+  std::vector<std::vector<double>> Morph(std::vector<double> const& pars,
+                                         std::vector<double> const& norms) const;
+
+  /// The morphed histogram at `par` (not attached to any directory)
+  template <class TH>
+  TH Morphed(std::string const& name, double par, double norm) const {
+    return Hist<TH>(name, Morph(par, norm));
+  }
+
+  /// A histogram in the output binning with the given bin contents, e.g. one
+  /// of those returned by Morph()
+  template <class TH>
+  TH Hist(std::string const& name, std::vector<double> const& contents) const;
+
+  inline std::vector<double> const& edges() const { return edges_; }
+  inline bool empty() const { return empty_; }
+
+ private:
+  void Init(std::vector<double> const& contents1,
+            std::vector<double> const& contents2, double sum1, double sum2);
+  void Weights(double par, double & wt1, double & wt2) const;
+  void Project(std::vector<double> const& xdisn, double norm,
+               double *contents) const;
+  double Width2(double x) const;
+
+  std::vector<double> edges1_;
+  std::vector<double> edges2_;
+  std::vector<double> widths2_;
+  double par1_;
+  double par2_;
+  std::vector<double> edges_;
+  bool empty_;
+  // Points of the interpolated cdf: at cumulative probability y_[i] the
+  // references are at x1_[i] and x2_[i]. Padded with zeros, which the
+  // projection may read past the last point.
+  std::vector<double> x1_;
+  std::vector<double> x2_;
+  std::vector<double> y_;
+  unsigned n_points_;
+};
+
+template <class TH>
+TH HistMorph::Hist(std::string const& name,
+                   std::vector<double> const& contents) const {
+  unsigned nbins = edges_.size() - 1;
+  bool add_dir = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+  TH hist = empty_
+      ? TH(name.c_str(), name.c_str(), nbins, edges_.front(), edges_.back())
+      : TH(name.c_str(), name.c_str(), nbins, &(edges_[0]));
+  TH1::AddDirectory(add_dir);
+  for (unsigned i = 0; i < nbins && i < contents.size(); ++i) {
+    hist.SetBinContent(i + 1, contents[i]);
+  }
+  return hist;
+}
+}
+
+#endif
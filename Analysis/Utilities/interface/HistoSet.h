@@ -4,8 +4,7 @@
 #include "TH1F.h"
 #include "TH2F.h"
 
-#include "PhysicsTools/FWLite/interface/TFileService.h"
-#include "CommonTools/Utils/interface/TFileDirectory.h"
+#include "UserCode/ICHiggsTauTau/Analysis/Core/interface/FileService.h"
 #include "UserCode/ICHiggsTauTau/interface/Objects.hh"
 #include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/FnPredicates.h"
 
@@ -136,7 +135,7 @@ namespace ic {
     TH1F* beff_pass;
 
   public:
-    HttPlots(TFileDirectory const& dir);
+    HttPlots(FileDirectory const& dir);
     void FillVertexPlots(std::vector<Vertex *> const& vertices, double wt = 1.0);
     void FillVertexPlots(unsigned vertices, double wt = 1.0);
 
@@ -181,10 +180,10 @@ namespace ic {
 class DynamicHistoSet : public HistoSet{
   private:
     std::map<std::string, TH1F *> hmap_;
-    TFileDirectory dir_;
+    FileDirectory dir_;
 
   public:
-    DynamicHistoSet(TFileDirectory const& dir) : HistoSet(), dir_(dir) {
+    DynamicHistoSet(FileDirectory const& dir) : HistoSet(), dir_(dir) {
     }
 
     void Create(std::string name, unsigned bins, double min, double max) {
@@ -210,10 +209,10 @@ class DynamicHistoSet : public HistoSet{
  class Dynamic2DHistoSet : public HistoSet{
    private:
      std::map<std::string, TH2F *> hmap_;
-     TFileDirectory dir_;
+     FileDirectory dir_;
 
    public:
-     Dynamic2DHistoSet(TFileDirectory const& dir) : HistoSet(), dir_(dir) {
+     Dynamic2DHistoSet(FileDirectory const& dir) : HistoSet(), dir_(dir) {
      }
 
      void Create(std::string name, unsigned binsx, double minx, double maxx, unsigned binsy, double miny, double maxy) {
@@ -0,0 +1,214 @@
+#ifndef ICHiggsTauTau_Utilities_JetCorrectionTables_h
+#define ICHiggsTauTau_Utilities_JetCorrectionTables_h
+
+#include <vector>
+#include <string>
+#include <map>
+
+namespace ic {
+
+/**
+ * @brief Jet quantities a correction payload can depend on
+ *
+ * The names match those used in the headers of the JetMETObjects text files,
+ * e.g. `{1 JetEta 1 JetPt ...}`.
+ */
+struct JetCorrectionInputs {
+  enum var { JetEta, JetPt, JetE, JetPhi, JetA, Rho, JetEMF, NPV, NVars };
+  double vals[NVars];
+
+  JetCorrectionInputs() {
+    for (unsigned i = 0; i < NVars; ++i) vals[i] = 0.;
+  }
+  inline double & operator[](var v) { return vals[v]; }
+  inline double operator[](var v) const { return vals[v]; }
+
+  /// Return the enum value for a text file variable name, throws if unknown
+  static var Lookup(std::string const& name);
+};
+
+/**
+ * @brief A TFormula-style expression compiled once into a flat stack program
+ *
+ * Supports `x`, `y`, `z` and `t` for up to four parameter variables, `[i]`
+ * for parameters, the arithmetic, comparison and logical operators, `^` for
+ * powers and the usual functions (`exp`, `log`, `log10`, `pow`, `max`,
+ * `min`, `sqrt`, `fabs`, ... and their `TMath::` equivalents). Bind() returns
+ * a copy with the parameters replaced by constants, which is what each bin
+ * of a payload stores.
+ */
+class JetCorrectionFormula {
+ public:
+  JetCorrectionFormula();
+  explicit JetCorrectionFormula(std::string const& expr);
+
+  JetCorrectionFormula Bind(std::vector<double> const& pars) const;
+
+  /// Evaluate with the variable values `x` (x, y, z, t) and parameters `p`
+  double Eval(double const* x, double const* p = nullptr) const;
+
+  inline bool IsValid() const { return !prog_.empty(); }
+  inline unsigned n_pars() const { return n_pars_; }
+
+  struct Instr {
+    int op;
+    int idx;
+    double val;
+    double (*f1)(double);
+    double (*f2)(double, double);
+  };
+
+ private:
+  std::vector<Instr> prog_;
+  unsigned n_pars_;
+  unsigned max_depth_;
+
+  friend class JetCorrectionFormulaParser;
+};
+
+/**
+ * @brief One level of jet energy corrections, e.g. L2Relative, parsed from a
+ * JetMETObjects text file
+ *
+ * Every bin stores its pre-bound formula and the allowed range of each
+ * parameter variable, to which the inputs are clamped as in
+ * SimpleJetCorrector. For the common case of a single binning variable the
+ * bins are sorted and found by binary search. Inputs outside all bins give a
+ * correction of 1.
+ */
+class JetCorrectionLevel {
+ public:
+  JetCorrectionLevel();
+  /// Parse `file`, optionally only the section `[section]`
+  explicit JetCorrectionLevel(std::string const& file,
+                              std::string const& section = "");
+
+  /// Index of the bin for the given inputs or -1
+  int FindBin(JetCorrectionInputs const& in) const;
+
+  double Correction(JetCorrectionInputs const& in) const;
+
+  inline std::string const& level() const { return level_; }
+  inline unsigned n_bins() const { return bins_.size(); }
+
+  /// Names of all `[section]` entries in a text file, in order
+  static std::vector<std::string> Sections(std::string const& file);
+
+ protected:
+  struct Bin {
+    std::vector<double> min;
+    std::vector<double> max;
+    // Raw numbers following the bin variable ranges
+    std::vector<double> pars;
+    std::vector<double> xmin;
+    std::vector<double> xmax;
+    JetCorrectionFormula formula;
+  };
+
+  void Parse(std::string const& file, std::string const& section);
+
+  std::vector<JetCorrectionInputs::var> bin_vars_;
+  std::vector<JetCorrectionInputs::var> par_vars_;
+  std::string formula_str_;
+  std::string level_;
+  std::vector<Bin> bins_;
+  std::vector<double> lo_edges_;
+};
+
+/**
+ * @brief The factorized chain of correction levels, equivalent to
+ * FactorizedJetCorrector
+ *
+ * After each level the jet pt and energy are scaled before they are passed
+ * on to the next one, and SubCorrections() returns the cumulative product
+ * after each level.
+ */
+class JetCorrectionChain {
+ public:
+  JetCorrectionChain();
+  explicit JetCorrectionChain(std::vector<std::string> const& files);
+
+  void AddLevel(JetCorrectionLevel const& level);
+
+  /// Fill `factors` with the cumulative correction after each level
+  void SubCorrections(JetCorrectionInputs in, std::vector<float> & factors) const;
+  std::vector<float> SubCorrections(JetCorrectionInputs const& in) const;
+  double Correction(JetCorrectionInputs const& in) const;
+
+  inline unsigned n_levels() const { return levels_.size(); }
+
+ private:
+  std::vector<JetCorrectionLevel> levels_;
+};
+
+/**
+ * @brief One jet energy scale uncertainty source, equivalent to
+ * JetCorrectionUncertainty
+ *
+ * Each eta bin holds (pt, up, down) triplets and the result is the linear
+ * interpolation in pt, constant beyond the first and last points. Returns
+ * -999 if eta is outside every bin.
+ */
+class JetUncertaintySource : public JetCorrectionLevel {
+ public:
+  JetUncertaintySource();
+  explicit JetUncertaintySource(std::string const& file,
+                                std::string const& section = "");
+
+  double Uncertainty(double eta, double pt, bool up) const;
+
+  /// Uncertainty for `n` jets, written to `out`
+  void Uncertainty(double const* eta, double const* pt, unsigned n, bool up,
+                   double * out) const;
+
+  inline std::string const& name() const { return name_; }
+
+ private:
+  std::string name_;
+};
+
+/**
+ * @brief All the uncertainty sources of a multi-section text file
+ */
+class JetUncertaintySources {
+ public:
+  JetUncertaintySources();
+  /// Read the given sections, or every section in the file if empty
+  explicit JetUncertaintySources(std::string const& file,
+                                 std::vector<std::string> const& sections = {});
+
+  /**
+   * @brief Evaluate every source for every jet in one call
+   * @return A vector with one entry per source, each holding one value per jet
+   */
+  template <class T>
+  std::vector<std::vector<double>> Evaluate(std::vector<T*> const& jets,
+                                            bool up) const {
+    std::vector<double> eta(jets.size());
+    std::vector<double> pt(jets.size());
+    for (unsigned i = 0; i < jets.size(); ++i) {
+      eta[i] = jets[i]->eta();
+      pt[i] = jets[i]->pt();
+    }
+    std::vector<std::vector<double>> result(sources_.size(),
+                                            std::vector<double>(jets.size()));
+    for (unsigned s = 0; s < sources_.size(); ++s) {
+      sources_[s].Uncertainty(eta.data(), pt.data(), jets.size(), up,
+                              result[s].data());
+    }
+    return result;
+  }
+
+  inline unsigned size() const { return sources_.size(); }
+  inline JetUncertaintySource const& operator[](unsigned i) const {
+    return sources_[i];
+  }
+  /// Index of a source by name, or -1
+  int Index(std::string const& name) const;
+
+ private:
+  std::vector<JetUncertaintySource> sources_;
+};
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef ICHiggsTauTau_Utilities_LumiIndex_h
+#define ICHiggsTauTau_Utilities_LumiIndex_h
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include "Utilities/interface/json.h"
+
+namespace ic {
+
+/**
+ * @brief A set of (run, lumi section) pairs stored as a sorted table of runs,
+ * each with a bitset over lumi sections
+ *
+ * Contains() is a binary search over the runs (skipped when the run is the
+ * same as in the previous call) and a single bit test, so checking events
+ * never allocates. Insert() only allocates when a new run is seen or a run
+ * needs a longer bitset. The standard CMS luminosity json format, e.g.
+ * `{"1": [[1, 10], [15, 20]]}`, can be read and written.
+ */
+class LumiIndex {
+ public:
+  LumiIndex();
+
+  static LumiIndex FromJson(Json::Value const& js);
+  static LumiIndex FromFile(std::string const& file);
+
+  inline bool Contains(unsigned run, unsigned ls) const {
+    int idx = FindRun(run);
+    if (idx < 0) return false;
+    std::vector<uint64_t> const& words = bits_[idx];
+    unsigned word = ls >> 6;
+    return word < words.size() && ((words[word] >> (ls & 63)) & 1);
+  }
+
+  inline bool HasRun(unsigned run) const { return FindRun(run) >= 0; }
+
+  void Insert(unsigned run, unsigned ls);
+  void InsertRange(unsigned run, unsigned first, unsigned last);
+
+  /// Add every lumi section in `other` to this one
+  void Merge(LumiIndex const& other);
+  LumiIndex Intersection(LumiIndex const& other) const;
+  /// Lumi sections in this set but not in `other`
+  LumiIndex Difference(LumiIndex const& other) const;
+
+  /// Number of lumi sections in `run`
+  unsigned NLumis(unsigned run) const;
+  /// Total number of lumi sections
+  unsigned NLumis() const;
+
+  inline std::vector<unsigned> const& runs() const { return runs_; }
+  inline bool empty() const { return runs_.empty(); }
+
+  Json::Value ToJson() const;
+  void WriteJson(std::string const& file) const;
+
+ private:
+  inline int FindRun(unsigned run) const {
+    if (last_ >= 0 && runs_[last_] == run) return last_;
+    auto it = std::lower_bound(runs_.begin(), runs_.end(), run);
+    if (it == runs_.end() || *it != run) return -1;
+    last_ = int(it - runs_.begin());
+    return last_;
+  }
+  int AddRun(unsigned run);
+
+  std::vector<unsigned> runs_;
+  std::vector<std::vector<uint64_t>> bits_;
+  mutable int last_;
+};
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef ICHiggsTauTau_Utilities_ShapeCache_h
+#define ICHiggsTauTau_Utilities_ShapeCache_h
+
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include "TH1F.h"
+
+namespace ic {
+
+/**
+ * @brief Read-only view of one histogram held by a ShapeCache
+ *
+ * The arrays point into the cache and stay valid for as long as it does.
+ * `contents` and `errors` have nbins + 2 entries: the underflow, the nbins
+ * bins of the axis and the overflow, numbered as in TH1.
+ */
+struct ShapeView {
+  unsigned nbins;
+  double entries;
+  double const* edges;
+  double const* contents;
+  double const* errors;
+
+  /// Sum of all bins, including the underflow and overflow
+  double Integral() const;
+  /// Error on Integral(), as TH1::IntegralAndError over the same bins
+  double IntegralError() const;
+  /// A new TH1F with this binning, contents and errors (not attached to any
+  /// directory)
+  TH1F MakeTH1F(std::string const& name) const;
+};
+
+/**
+ * @brief Index of every 1D histogram in a set of shape input files (e.g.
+ * the htt_*.inputs-*.root files used in datacards)
+ *
+ * When a file is added all of its 1D histograms, in any directory, are read
+ * once and their binning, contents and errors written to a compact binary
+ * file next to it (or in `cache_dir`, if given). The binary file is then
+ * memory-mapped and every lookup is a hash map find with no further ROOT I/O.
+ * Later jobs using the same input map the existing binary file directly,
+ * unless the size or modification time of the ROOT file has changed since it
+ * was written, in which case the index is rebuilt. If the binary file cannot
+ * be written the index is kept in memory instead.
+ *
+ * Histograms are found by their full path in the file, e.g. "muTau_vbf/ZTT",
+ * or by category, process and (optionally) systematic, where the systematic
+ * is the suffix of the shifted templates, e.g. "CMS_scale_tUp".
+ */
+class ShapeCache {
+ public:
+  explicit ShapeCache(std::string const& cache_dir = "");
+  ~ShapeCache();
+
+  /// Index `filename` under `label` (the filename itself if empty). Returns
+  /// false if the file cannot be read.
+  bool AddFile(std::string const& filename, std::string const& label = "");
+
+  /// nullptr if there is no such file or histogram
+  ShapeView const* Find(std::string const& label, std::string const& path) const;
+  ShapeView const* Find(std::string const& label, std::string const& category,
+                        std::string const& process,
+                        std::string const& systematic = "") const;
+
+  /// True if any indexed histogram is in the directory `dir` of the file
+  bool HasDirectory(std::string const& label, std::string const& dir) const;
+
+  /// A new TH1F made from the histogram at `path`, named after it, or
+  /// nullptr if it is not found. The caller takes ownership.
+  TH1F * GetTH1F(std::string const& label, std::string const& path) const;
+
+ private:
+  struct Block {
+    char * data;
+    std::size_t size;
+    bool mapped;
+    std::vector<char> buffer;
+  };
+  struct Entry {
+    std::unordered_map<std::string, ShapeView> shapes;
+    std::unordered_set<std::string> dirs;
+    Block block;
+  };
+
+  ShapeCache(ShapeCache const&);
+  ShapeCache & operator=(ShapeCache const&);
+
+  std::string CachePath(std::string const& filename) const;
+  static bool Build(std::string const& filename, long long size,
+                    long long mtime, std::vector<char> & out);
+  static bool Validate(Block const& block, std::string const& filename,
+                       long long size, long long mtime);
+  static void Index(Entry & entry);
+
+  std::string cache_dir_;
+  std::map<std::string, Entry> files_;
+};
+}
+
+#endif
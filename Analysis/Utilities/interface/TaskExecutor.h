@@ -0,0 +1,34 @@
+#ifndef ICHiggsTauTau_Utilities_TaskExecutor_h
+#define ICHiggsTauTau_Utilities_TaskExecutor_h
+
+#include <vector>
+#include <functional>
+
+namespace ic {
+
+/**
+ * @brief Runs a list of independent tasks on a fixed number of threads
+ *
+ * Tasks are handed out in order to whichever thread is free, so a task must
+ * only write to its own slot of any shared output. Run() blocks until every
+ * task has finished. If any tasks throw, the exception of the first such task
+ * (in task order) is rethrown once all threads have stopped. With one thread
+ * the tasks are run in order on the calling thread.
+ */
+class TaskExecutor {
+ public:
+  explicit TaskExecutor(unsigned n_threads = 1);
+
+  void Run(std::vector<std::function<void()>> const& tasks) const;
+
+  inline unsigned n_threads() const { return n_threads_; }
+
+  /// Number of hardware threads, or 1 if this is not known
+  static unsigned HardwareThreads();
+
+ private:
+  unsigned n_threads_;
+};
+}
+
+#endif
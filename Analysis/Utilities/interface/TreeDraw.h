@@ -0,0 +1,67 @@
+#ifndef ICHiggsTauTau_Utilities_TreeDraw_h
+#define ICHiggsTauTau_Utilities_TreeDraw_h
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "TH1F.h"
+#include "TEntryList.h"
+#include "Utilities/interface/TaskExecutor.h"
+
+namespace ic {
+
+/**
+ * @brief Split a variable in the "var(n,min,max)" or "var[e0,e1,...]" format
+ * into the expression and an empty histogram with that binning
+ *
+ * Returns false, leaving the arguments unchanged, if the variable does not
+ * end in one of these binning specifications.
+ */
+bool ParseBinnedVariable(std::string const& variable, std::string & expression,
+                         TH1F & binning);
+
+/// One TTree::Draw of `expression` into `binning` with weight `selection`
+struct TreeDrawJob {
+  TreeDrawJob();
+  std::string file;
+  std::string tree;
+  /// (tree, file) of each friend of the tree
+  std::vector<std::pair<std::string, std::string>> friends;
+  std::string expression;
+  std::string selection;
+  /// Entries to draw (owned by the caller), or null for the whole tree
+  TEntryList const* entrylist;
+  /// Number of entries in the tree, or in the entry list if there is one
+  long long entries;
+  TH1F binning;
+};
+
+/**
+ * @brief Run a set of TTree::Draw jobs concurrently, returning one histogram
+ * per job
+ *
+ * Every job is split into tasks of at most `entries_per_task` entries. Each
+ * task opens its own copy of the file and fills its own histogram, and the
+ * histograms of a job are then added in entry order. Since the split does
+ * not depend on the number of threads of `exec`, neither does the result.
+ */
+std::vector<TH1F> DrawTrees(TaskExecutor const& exec,
+                            std::vector<TreeDrawJob> const& jobs,
+                            long long entries_per_task);
+
+/**
+ * @brief As DrawTrees, but jobs that read the same tree (with the same
+ * friends) are filled in one shared pass over its entries
+ *
+ * Each task reads an entry range of a tree once and evaluates the expression
+ * and selection of every job on that tree for each entry, so the cost of
+ * reading the branches is paid once rather than once per job. The entry
+ * lists of the jobs are not used, since every entry is read anyway, and
+ * `entries` must be the number of entries in the tree.
+ */
+std::vector<TH1F> DrawTreesShared(TaskExecutor const& exec,
+                                  std::vector<TreeDrawJob> const& jobs,
+                                  long long entries_per_task);
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef ICHiggsTauTau_Utilities_WeightTable_h
+#define ICHiggsTauTau_Utilities_WeightTable_h
+
+#include <vector>
+#include <string>
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+
+namespace ic {
+
+/**
+ * @brief Flat copy of a TAxis with a fast bin search
+ *
+ * Bin numbers follow the ROOT convention: 0 is the underflow, 1..n are the
+ * regular bins and n+1 is the overflow. For an axis with fixed bins the same
+ * arithmetic as TAxis::FindBin is used, otherwise a branchless binary search
+ * over the contiguous array of edges.
+ */
+class WeightAxis {
+ public:
+  WeightAxis();
+  explicit WeightAxis(TAxis const* axis);
+
+  inline int FindBin(double x) const {
+    if (x < xmin_) return 0;
+    if (!(x < xmax_)) return nbins_ + 1;
+    if (uniform_) return 1 + int(nbins_ * (x - xmin_) / (xmax_ - xmin_));
+    double const* base = edges_.data();
+    unsigned n = nbins_ + 1;
+    while (n > 1) {
+      unsigned half = n / 2;
+      base = (base[half] <= x) ? base + half : base;
+      n -= half;
+    }
+    return int(base - edges_.data()) + 1;
+  }
+
+  inline int nbins() const { return nbins_; }
+  inline double xmin() const { return xmin_; }
+  inline double xmax() const { return xmax_; }
+
+ private:
+  std::vector<double> edges_;
+  int nbins_;
+  double xmin_;
+  double xmax_;
+  bool uniform_;
+};
+
+/**
+ * @brief Base class holding the contents array and the policy applied when a
+ * lookup falls outside the range of the axes
+ *
+ *  - `flow`:    return the underflow/overflow bin content, i.e. identical to
+ *               `h->GetBinContent(h->FindBin(...))`
+ *  - `clamp`:   use the first/last regular bin instead
+ *  - `fixed`:   return the fixed value given in the constructor (1.0 unless
+ *               specified)
+ */
+class WeightTableBase {
+ public:
+  enum class overflow { flow, clamp, fixed };
+
+  WeightTableBase();
+  WeightTableBase(overflow policy, double fixed_value);
+
+  inline bool IsValid() const { return !contents_.empty(); }
+  inline overflow policy() const { return policy_; }
+
+ protected:
+  static inline int ClampBin(int bin, int nbins) {
+    return bin < 1 ? 1 : (bin > nbins ? nbins : bin);
+  }
+
+  /// Limit a ROOT bin number to [0, nbins+1], as TH1::GetBin does
+  static inline int FlowBin(int bin, int nbins) {
+    return bin < 0 ? 0 : (bin > nbins + 1 ? nbins + 1 : bin);
+  }
+
+  std::vector<double> contents_;
+  overflow policy_;
+  double fixed_value_;
+};
+
+class WeightTable1D : public WeightTableBase {
+ public:
+  WeightTable1D();
+  explicit WeightTable1D(TH1 const* hist, overflow policy = overflow::flow,
+                         double fixed_value = 1.0);
+
+  inline int FindBin(double x) const { return xaxis_.FindBin(x); }
+
+  /**
+   * @brief Raw content of a ROOT bin number, under/overflow included
+   *
+   * Bin numbers outside [0, nbins+1] give the under/overflow content, as in
+   * TH1::GetBinContent.
+   */
+  inline double GetBinContent(int bin) const {
+    return contents_[FlowBin(bin, xaxis_.nbins())];
+  }
+
+  inline double Evaluate(double x) const {
+    int bin = xaxis_.FindBin(x);
+    if (bin < 1 || bin > xaxis_.nbins()) {
+      if (policy_ == overflow::fixed) return fixed_value_;
+      if (policy_ == overflow::clamp) bin = ClampBin(bin, xaxis_.nbins());
+    }
+    return contents_[bin];
+  }
+
+  /// Evaluate for `n` values in `x`, writing the results to `out`
+  void Evaluate(double const* x, std::size_t n, double* out) const;
+
+  /**
+   * @brief Evaluate for every object in a collection, where `fn` returns the
+   * lookup value for each object
+   */
+  template <class T, class F>
+  std::vector<double> EvaluateCollection(std::vector<T*> const& objs,
+                                         F fn) const {
+    std::vector<double> result(objs.size());
+    for (unsigned i = 0; i < objs.size(); ++i) result[i] = Evaluate(fn(objs[i]));
+    return result;
+  }
+
+  inline WeightAxis const& xaxis() const { return xaxis_; }
+
+ private:
+  WeightAxis xaxis_;
+};
+
+class WeightTable2D : public WeightTableBase {
+ public:
+  WeightTable2D();
+  explicit WeightTable2D(TH2 const* hist, overflow policy = overflow::flow,
+                         double fixed_value = 1.0);
+
+  inline int FindBinX(double x) const { return xaxis_.FindBin(x); }
+  inline int FindBinY(double y) const { return yaxis_.FindBin(y); }
+
+  /// Raw content of the ROOT bin (binx, biny), under/overflow included and
+  /// with each bin number limited as in GetBinContent(int) of WeightTable1D
+  inline double GetBinContent(int binx, int biny) const {
+    return contents_[FlowBin(binx, xaxis_.nbins()) +
+                     stride_ * FlowBin(biny, yaxis_.nbins())];
+  }
+
+  inline double Evaluate(double x, double y) const {
+    int binx = xaxis_.FindBin(x);
+    int biny = yaxis_.FindBin(y);
+    if (binx < 1 || binx > xaxis_.nbins() || biny < 1 ||
+        biny > yaxis_.nbins()) {
+      if (policy_ == overflow::fixed) return fixed_value_;
+      if (policy_ == overflow::clamp) {
+        binx = ClampBin(binx, xaxis_.nbins());
+        biny = ClampBin(biny, yaxis_.nbins());
+      }
+    }
+    return contents_[binx + stride_ * biny];
+  }
+
+  void Evaluate(double const* x, double const* y, std::size_t n,
+                double* out) const;
+
+  /**
+   * @brief Evaluate for every object in a collection, where `fx` and `fy`
+   * return the x and y lookup values for each object
+   */
+  template <class T, class FX, class FY>
+  std::vector<double> EvaluateCollection(std::vector<T*> const& objs, FX fx,
+                                         FY fy) const {
+    std::vector<double> result(objs.size());
+    for (unsigned i = 0; i < objs.size(); ++i) {
+      result[i] = Evaluate(fx(objs[i]), fy(objs[i]));
+    }
+    return result;
+  }
+
+  inline WeightAxis const& xaxis() const { return xaxis_; }
+  inline WeightAxis const& yaxis() const { return yaxis_; }
+
+ private:
+  WeightAxis xaxis_;
+  WeightAxis yaxis_;
+  int stride_;
+};
+
+class WeightTable3D : public WeightTableBase {
+ public:
+  WeightTable3D();
+  explicit WeightTable3D(TH3 const* hist, overflow policy = overflow::flow,
+                         double fixed_value = 1.0);
+
+  inline int FindBinX(double x) const { return xaxis_.FindBin(x); }
+  inline int FindBinY(double y) const { return yaxis_.FindBin(y); }
+  inline int FindBinZ(double z) const { return zaxis_.FindBin(z); }
+
+  /// As WeightTable2D::GetBinContent, for the ROOT bin (binx, biny, binz)
+  inline double GetBinContent(int binx, int biny, int binz) const {
+    return contents_[FlowBin(binx, xaxis_.nbins()) +
+                     stride_x_ * (FlowBin(biny, yaxis_.nbins()) +
+                                  stride_y_ * FlowBin(binz, zaxis_.nbins()))];
+  }
+
+  inline double Evaluate(double x, double y, double z) const {
+    int binx = xaxis_.FindBin(x);
+    int biny = yaxis_.FindBin(y);
+    int binz = zaxis_.FindBin(z);
+    if (binx < 1 || binx > xaxis_.nbins() || biny < 1 ||
+        biny > yaxis_.nbins() || binz < 1 || binz > zaxis_.nbins()) {
+      if (policy_ == overflow::fixed) return fixed_value_;
+      if (policy_ == overflow::clamp) {
+        binx = ClampBin(binx, xaxis_.nbins());
+        biny = ClampBin(biny, yaxis_.nbins());
+        binz = ClampBin(binz, zaxis_.nbins());
+      }
+    }
+    return contents_[binx + stride_x_ * (biny + stride_y_ * binz)];
+  }
+
+  void Evaluate(double const* x, double const* y, double const* z,
+                std::size_t n, double* out) const;
+
+  template <class T, class FX, class FY, class FZ>
+  std::vector<double> EvaluateCollection(std::vector<T*> const& objs, FX fx,
+                                         FY fy, FZ fz) const {
+    std::vector<double> result(objs.size());
+    for (unsigned i = 0; i < objs.size(); ++i) {
+      result[i] = Evaluate(fx(objs[i]), fy(objs[i]), fz(objs[i]));
+    }
+    return result;
+  }
+
+  inline WeightAxis const& xaxis() const { return xaxis_; }
+  inline WeightAxis const& yaxis() const { return yaxis_; }
+  inline WeightAxis const& zaxis() const { return zaxis_; }
+
+ private:
+  WeightAxis xaxis_;
+  WeightAxis yaxis_;
+  WeightAxis zaxis_;
+  int stride_x_;
+  int stride_y_;
+};
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef ICHiggsTauTau_Utilities_WeightVector_h
+#define ICHiggsTauTau_Utilities_WeightVector_h
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "TH1.h"
+#include "TH2.h"
+#include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
+
+namespace ic {
+
+/**
+ * @brief A set of named weight variations stored contiguously, e.g. the LHE
+ * scale or PDF replica weights of an event
+ *
+ * The list of labels is fixed when the object is constructed and is shared
+ * between copies. Fill() extracts the values from an EventInfo with a single
+ * ordered pass over its weight map, so the per-event cost does not depend on
+ * doing one lookup per variation. A label that is not defined in the event
+ * gets the value 1.0.
+ */
+class WeightVector {
+ public:
+  WeightVector();
+  explicit WeightVector(std::vector<std::string> const& labels);
+
+  /// Build the labels "first", "first+1", ..., "last", as used for LHE weight ids
+  static std::vector<std::string> LabelRange(unsigned first, unsigned last);
+
+  void Fill(EventInfo const* info);
+
+  inline unsigned size() const { return values_.size(); }
+  inline double operator[](unsigned i) const { return values_[i]; }
+  inline double const* data() const { return values_.data(); }
+  inline std::vector<double> const& values() const { return values_; }
+  inline void set(unsigned i, double value) { values_[i] = value; }
+  inline std::vector<std::string> const& labels() const { return *labels_; }
+
+ private:
+  std::shared_ptr<std::vector<std::string> const> labels_;
+  // Indices into labels_ sorted by label, used for the merge with the map
+  std::shared_ptr<std::vector<unsigned> const> order_;
+  // Registered weight slot for each label, or -1
+  std::shared_ptr<std::vector<int> const> slots_;
+  std::vector<double> values_;
+};
+
+/**
+ * @brief Fill one entry of `val` into a grid with one y-bin per variation
+ *
+ * The x-bin is located once and then each y-bin `i+1` receives
+ * `wt * wts[i]`, so N variations cost a single pass over the events.
+ */
+void FillVariations(TH2* grid, double val, double wt, WeightVector const& wts);
+
+/// Same as above but for N separate histograms with identical binning
+void FillVariations(std::vector<TH1*> const& hists, double val, double wt,
+                    WeightVector const& wts);
+}
+
+#endif
@@ -0,0 +1,314 @@
+#include "Utilities/interface/BDTForest.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ic {
+
+namespace {
+
+// Just enough of an XML reader for TMVA weight files: one tag at a time,
+// with its attributes and the text that follows it
+struct XMLTag {
+  std::string name;
+  std::map<std::string, std::string> attrs;
+  std::string text;
+  bool closing;
+  bool empty;
+
+  bool Has(std::string const& attr) const { return attrs.count(attr) > 0; }
+  std::string Get(std::string const& attr) const {
+    auto it = attrs.find(attr);
+    if (it == attrs.end()) {
+      throw std::runtime_error("[BDTForest] Missing attribute " + attr + " of " + name);
+    }
+    return it->second;
+  }
+  double GetDouble(std::string const& attr) const {
+    return std::strtod(Get(attr).c_str(), nullptr);
+  }
+  int GetInt(std::string const& attr) const {
+    return std::atoi(Get(attr).c_str());
+  }
+};
+
+std::string Unescape(std::string const& str) {
+  static const char* entities[5][2] = {
+      {"&lt;", "<"}, {"&gt;", ">"}, {"&quot;", "\""}, {"&apos;", "'"}, {"&amp;", "&"}};
+  std::string result = str;
+  for (auto const& entity : entities) {
+    std::string from = entity[0];
+    for (std::size_t pos = result.find(from); pos != std::string::npos;
+         pos = result.find(from, pos + 1)) {
+      result.replace(pos, from.size(), entity[1]);
+    }
+  }
+  return result;
+}
+
+bool NextTag(std::string const& doc, std::size_t & pos, XMLTag & tag) {
+  while (true) {
+    pos = doc.find('<', pos);
+    if (pos == std::string::npos) return false;
+    if (doc.compare(pos, 4, "<!--") == 0) {
+      pos = doc.find("-->", pos);
+      if (pos == std::string::npos) return false;
+      continue;
+    }
+    if (doc[pos + 1] == '?' || doc[pos + 1] == '!') {
+      pos = doc.find('>', pos);
+      if (pos == std::string::npos) return false;
+      continue;
+    }
+    break;
+  }
+  std::size_t end = doc.find('>', pos);
+  if (end == std::string::npos) return false;
+  std::size_t i = pos + 1;
+  tag.closing = doc[i] == '/';
+  if (tag.closing) ++i;
+  tag.empty = doc[end - 1] == '/';
+  std::size_t stop = tag.empty ? end - 1 : end;
+  std::size_t name_end = doc.find_first_of(" \t\r\n/>", i);
+  tag.name = doc.substr(i, name_end - i);
+  tag.attrs.clear();
+  i = name_end;
+  while (i < stop) {
+    i = doc.find_first_not_of(" \t\r\n", i);
+    if (i == std::string::npos || i >= stop) break;
+    std::size_t eq = doc.find('=', i);
+    if (eq == std::string::npos || eq >= stop) break;
+    std::string attr = doc.substr(i, eq - i);
+    attr.erase(attr.find_last_not_of(" \t\r\n") + 1);
+    std::size_t open = doc.find_first_of("\"'", eq);
+    if (open == std::string::npos || open >= stop) break;
+    std::size_t close = doc.find(doc[open], open + 1);
+    if (close == std::string::npos || close >= stop) break;
+    tag.attrs[attr] = Unescape(doc.substr(open + 1, close - open - 1));
+    i = close + 1;
+  }
+  pos = end + 1;
+  std::size_t next = doc.find('<', pos);
+  tag.text = doc.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+  tag.text.erase(0, tag.text.find_first_not_of(" \t\r\n"));
+  tag.text.erase(tag.text.find_last_not_of(" \t\r\n") + 1);
+  return true;
+}
+
+struct RawNode {
+  int var;
+  float cut;
+  bool cut_type;
+  int node_type;
+  float response;
+  float purity;
+  int child[2];
+};
+}
+
+BDTForest::BDTForest(std::string const& weight_file) : norm_(0.), grad_(false), file_(weight_file) {
+  std::ifstream input(weight_file.c_str());
+  if (!input) throw std::runtime_error("[BDTForest] Unable to open " + weight_file);
+  std::stringstream buffer;
+  buffer << input.rdbuf();
+  std::string const doc = buffer.str();
+
+  std::map<std::string, std::string> options;
+  bool regression_trees = false;
+  std::vector<RawNode> raw;
+  std::vector<int> stack;
+  std::size_t pos = 0;
+  XMLTag tag;
+  bool in_options = false;
+  bool in_tree = false;
+  double tree_weight = 1.;
+  while (NextTag(doc, pos, tag)) {
+    if (tag.name == "MethodSetup" && !tag.closing) {
+      if (tag.Get("Method").compare(0, 5, "BDT::") != 0) {
+        throw std::runtime_error("[BDTForest] " + weight_file + " is not a BDT weight file");
+      }
+    } else if (tag.name == "Options") {
+      in_options = !tag.closing && !tag.empty;
+    } else if (tag.name == "Option" && in_options && !tag.closing) {
+      options[tag.Get("name")] = tag.text;
+    } else if (tag.name == "Variable" && !tag.closing) {
+      unsigned index = tag.GetInt("VarIndex");
+      if (variables_.size() <= index) variables_.resize(index + 1);
+      variables_[index] = tag.Get("Expression");
+    } else if (tag.name == "Transformations" && !tag.closing) {
+      if (tag.Has("NTransformations") && tag.GetInt("NTransformations") != 0) {
+        throw std::runtime_error("[BDTForest] Variable transformations in " + weight_file + " are not supported");
+      }
+    } else if (tag.name == "Weights" && !tag.closing) {
+      // TreeType before TMVA 4.1.0, AnalysisType after: 1 for regression
+      // trees, whose leaves hold a response rather than a node type
+      std::string type = tag.Has("TreeType") ? tag.Get("TreeType") : tag.Get("AnalysisType");
+      regression_trees = std::atoi(type.c_str()) == 1;
+    } else if (tag.name == "BinaryTree") {
+      if (!tag.closing) {
+        in_tree = true;
+        raw.clear();
+        stack.clear();
+        tree_weight = tag.Has("boostWeight") ? tag.GetDouble("boostWeight") : 1.;
+        if (!tag.empty) continue;
+      }
+      if (!in_tree) continue;
+      in_tree = false;
+      if (raw.empty()) {
+        throw std::runtime_error("[BDTForest] Empty tree in " + weight_file);
+      }
+      // Flatten depth-first, so that each node is followed by the nodes
+      // below it
+      bool use_yes_no = options.count("UseYesNoLeaf") ? options["UseYesNoLeaf"] == "True" : true;
+      // Gradient-boosted trees always sum the leaf responses, whatever the
+      // analysis type, as in MethodBDT::GetGradBoostMVA
+      bool use_response = regression_trees || options["BoostType"] == "Grad";
+      unsigned root = nodes_.size();
+      std::vector<std::pair<int, int>> todo = {{0, -1}};
+      while (!todo.empty()) {
+        RawNode const& r = raw[todo.back().first];
+        int parent_slot = todo.back().second;
+        todo.pop_back();
+        unsigned index = nodes_.size();
+        if (parent_slot >= 0) nodes_[parent_slot / 2].child[parent_slot % 2] = index;
+        Node node;
+        node.child[0] = node.child[1] = 0;
+        // As DecisionTree::CheckEvent: only nodes of type 0 are followed
+        if (r.node_type == 0 && r.child[0] >= 0 && r.child[1] >= 0) {
+          if (r.var < 0) {
+            throw std::runtime_error("[BDTForest] Node without a cut variable in " + weight_file);
+          }
+          node.var = r.var;
+          node.value = r.cut;
+          nodes_.push_back(node);
+          // GoesRight is (x >= cut) for cut type 1 and !(x >= cut) for 0
+          int right = r.cut_type ? 1 : 0;
+          todo.push_back(std::make_pair(r.child[1], 2 * index + right));
+          todo.push_back(std::make_pair(r.child[0], 2 * index + (1 - right)));
+        } else if (r.node_type == 0) {
+          throw std::runtime_error("[BDTForest] Intermediate node without children in " + weight_file);
+        } else {
+          node.var = -1;
+          if (use_response) {
+            node.value = r.response;
+          } else {
+            node.value = use_yes_no ? static_cast<float>(r.node_type) : r.purity;
+          }
+          nodes_.push_back(node);
+        }
+      }
+      roots_.push_back(root);
+      weights_.push_back(tree_weight);
+    } else if (tag.name == "Node" && in_tree) {
+      if (tag.closing) {
+        if (!stack.empty()) stack.pop_back();
+        continue;
+      }
+      if (tag.Has("NCoef") && tag.GetInt("NCoef") != 0) {
+        throw std::runtime_error("[BDTForest] Fisher cuts in " + weight_file + " are not supported");
+      }
+      RawNode r;
+      r.var = tag.GetInt("IVar");
+      r.cut = static_cast<float>(tag.GetDouble("Cut"));
+      r.cut_type = tag.GetInt("cType") != 0;
+      r.node_type = tag.GetInt("nType");
+      r.response = tag.Has("res") ? static_cast<float>(tag.GetDouble("res")) : 0.;
+      if (tag.Has("purity")) {
+        r.purity = static_cast<float>(tag.GetDouble("purity"));
+      } else if (tag.Has("nS") && tag.Has("nB")) {
+        double s = tag.GetDouble("nS");
+        double b = tag.GetDouble("nB");
+        r.purity = (s + b) > 0. ? static_cast<float>(s / (s + b)) : -1.;
+      } else {
+        r.purity = 0.;
+      }
+      r.child[0] = r.child[1] = -1;
+      int index = raw.size();
+      raw.push_back(r);
+      if (!stack.empty()) {
+        std::string side = tag.Get("pos");
+        raw[stack.back()].child[side == "r" ? 1 : 0] = index;
+      }
+      if (!tag.empty) stack.push_back(index);
+    }
+  }
+
+  if (roots_.empty()) throw std::runtime_error("[BDTForest] No trees found in " + weight_file);
+  for (auto const& node : nodes_) {
+    if (node.var >= static_cast<int>(variables_.size())) {
+      throw std::runtime_error("[BDTForest] Cut on an unknown variable in " + weight_file);
+    }
+  }
+  grad_ = options["BoostType"] == "Grad";
+  if (grad_ || options["UseWeightedTrees"] == "False") {
+    std::fill(weights_.begin(), weights_.end(), 1.);
+  }
+  for (double weight : weights_) norm_ += weight;
+}
+
+void BDTForest::CheckVariables(std::vector<std::string> const& names) const {
+  if (names != variables_) {
+    std::string expected;
+    for (auto const& var : variables_) expected += (expected.empty() ? "" : ", ") + var;
+    throw std::runtime_error("[BDTForest] The variables of " + file_ +
+                             " are, in order: " + expected);
+  }
+}
+
+bool BDTForest::HasNaN(float const* features) const {
+  for (unsigned i = 0; i < variables_.size(); ++i) {
+    if (std::isnan(features[i])) return true;
+  }
+  return false;
+}
+
+double BDTForest::Finish(double sum) const {
+  if (grad_) return 2.0 / (1.0 + std::exp(-2.0 * sum)) - 1;
+  return norm_ > std::numeric_limits<double>::epsilon() ? sum / norm_ : 0.;
+}
+
+double BDTForest::Evaluate(float const* features) const {
+  if (HasNaN(features)) return -999.;
+  double sum = 0.;
+  for (unsigned t = 0; t < roots_.size(); ++t) {
+    sum += weights_[t] * Tree(roots_[t], features);
+  }
+  return Finish(sum);
+}
+
+void BDTForest::Evaluate(float const* features, std::size_t n, double* out) const {
+  EvaluateBlocks(features, n, out);
+}
+
+void BDTForest::Evaluate(float const* features, std::size_t n, float* out) const {
+  EvaluateBlocks(features, n, out);
+}
+
+template <class T>
+void BDTForest::EvaluateBlocks(float const* features, std::size_t n, T* out) const {
+  // Events are taken in blocks and the trees run over the whole block in
+  // turn, so each tree is read from memory once per block rather than once
+  // per event. Each event still sums the trees in the same order.
+  const std::size_t block = 64;
+  std::size_t nvars = variables_.size();
+  double sums[block];
+  for (std::size_t first = 0; first < n; first += block) {
+    std::size_t size = std::min(block, n - first);
+    float const* rows = features + first * nvars;
+    std::fill(sums, sums + size, 0.);
+    for (unsigned t = 0; t < roots_.size(); ++t) {
+      for (std::size_t i = 0; i < size; ++i) {
+        sums[i] += weights_[t] * Tree(roots_[t], rows + i * nvars);
+      }
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      out[first + i] = HasNaN(rows + i * nvars) ? -999. : Finish(sums[i]);
+    }
+  }
+}
+}
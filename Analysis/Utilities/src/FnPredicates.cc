@@ -1514,33 +1514,13 @@ namespace ic {
   }
 
   std::vector<GenParticle *> ExtractStableDaughters(GenParticle * part, std::vector<GenParticle *> const& input) {
-    std::vector<GenParticle *> tmp = ExtractDaughters(part, input);
-    std::set<GenParticle *> result_set;
-    bool all_found = false;
-    while (!all_found) {
-      std::vector<GenParticle *> tmp_other;
-      unsigned n_st1 = 0;
-      for (unsigned i = 0; i < tmp.size(); ++i) {
-        if (tmp[i]->status() == 1) {
-          ++n_st1;
-          result_set.insert(tmp[i]);
-        } else {
-          std::vector<GenParticle *> tmp_daughters = ExtractDaughters(tmp[i], input);
-          for(unsigned j = 0; j < tmp_daughters.size(); ++j) tmp_other.push_back(tmp_daughters[j]);
-        }
-      }
-      tmp = tmp_other;
-      if (tmp.size() == 0) all_found = true;
-    }
-    std::vector<GenParticle *> result;
-    for (auto it : result_set) result.push_back(it);
-    return result;
+    return GenGraph(input).ExtractStableDaughters(part);
   }
 
   std::vector<GenParticle*> ExtractDaughters(
       GenParticle* part, std::vector<GenParticle*> const& input) {
     std::vector<GenParticle*> result;
-    std::vector<int> daughters = part->daughters();
+    std::vector<int> const& daughters = part->daughters();
     for (unsigned i = 0; i < input.size(); ++i) {
       if (std::find(daughters.begin(), daughters.end(), input[i]->index()) !=
           daughters.end()) {
@@ -1553,7 +1533,7 @@ namespace ic {
   std::vector<GenParticle*> ExtractMothers(
       GenParticle* part, std::vector<GenParticle*> const& input) {
     std::vector<GenParticle*> result;
-    std::vector<int> mothers = part->mothers();
+    std::vector<int> const& mothers = part->mothers();
     for (unsigned i = 0; i < input.size(); ++i) {
       if (std::find(mothers.begin(), mothers.end(), input[i]->index()) !=
           mothers.end()) {
@@ -1566,50 +1546,29 @@ namespace ic {
 
   std::vector<GenParticle*> ExtractDaughtersRecursive(
       GenParticle* part, std::vector<GenParticle*> const& input) {
-    std::vector<GenParticle*> tmp = ExtractDaughters(part, input);
-    std::set<GenParticle*> result_set;
-    bool all_found = false;
-    while (!all_found) {
-      std::vector<GenParticle*> tmp_other;
-      for (unsigned i = 0; i < tmp.size(); ++i) {
-        result_set.insert(tmp[i]);
-        std::vector<GenParticle*> tmp_daughters =
-            ExtractDaughters(tmp[i], input);
-        for (unsigned j = 0; j < tmp_daughters.size(); ++j)
-          tmp_other.push_back(tmp_daughters[j]);
-      }
-      tmp = tmp_other;
-      if (tmp.size() == 0) all_found = true;
-    }
-    std::vector<GenParticle*> result;
-    for (auto it : result_set) result.push_back(it);
-    std::sort(result.begin(), result.end(),
-              [](GenParticle const* p1,
-                 GenParticle const* p2) { return p1->index() < p2->index();
-              });
-    return result;
+    return GenGraph(input).ExtractDaughtersRecursive(part);
   }
 
   std::vector<GenJet> BuildTauJets(std::vector<GenParticle *> const& parts, bool include_leptonic, bool use_prompt) {
+    return BuildTauJets(GenGraph(parts), include_leptonic, use_prompt);
+  }
+
+  std::vector<GenJet> BuildTauJets(GenGraph const& graph, bool include_leptonic, bool use_prompt) {
     std::vector<GenJet> taus;
-    for (unsigned i = 0; i < parts.size(); ++i) {
-        std::vector<bool> status_flags;
-        bool is_prompt=true; 
-        if(use_prompt){
-          status_flags = parts[i]->statusFlags();
-          is_prompt=status_flags[IsPrompt];
-        }
-      if (abs(parts[i]->pdgid()) == 15 && is_prompt) {
-        std::vector<GenParticle *> daughters = ExtractDaughters(parts[i], parts);
+    for (unsigned i = 0; i < graph.size(); ++i) {
+      GenParticle *part = graph.particle(i);
+      bool is_prompt = !use_prompt || graph.HasFlag(i, IsPrompt);
+      if (abs(part->pdgid()) == 15 && is_prompt) {
         bool has_tau_daughter = false;
         bool has_lepton_daughter = false;
-        for (unsigned j = 0; j < daughters.size(); ++j) {
-          if (abs(daughters[j]->pdgid()) == 15) has_tau_daughter = true;
-          if (abs(daughters[j]->pdgid()) == 11 || abs(daughters[j]->pdgid()) == 13) has_lepton_daughter = true;
+        for (unsigned d : graph.Daughters(i)) {
+          int pdgid = abs(graph.particle(d)->pdgid());
+          if (pdgid == 15) has_tau_daughter = true;
+          if (pdgid == 11 || pdgid == 13) has_lepton_daughter = true;
         }
         if (has_tau_daughter) continue;
         if (has_lepton_daughter && !include_leptonic) continue;
-        std::vector<GenParticle *> jet_parts = ExtractStableDaughters(parts[i], parts);
+        std::vector<GenParticle *> jet_parts = graph.ExtractStableDaughters(part);
         taus.push_back(GenJet());
         ROOT::Math::PtEtaPhiEVector vec;
         std::vector<std::size_t> id_vec;
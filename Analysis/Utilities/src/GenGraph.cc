@@ -0,0 +1,162 @@
+#include "Utilities/interface/GenGraph.h"
+#include <algorithm>
+
+namespace ic {
+
+namespace {
+// Fill the offsets and nodes of a compressed sparse row table, where
+// relatives(i) gives the GenParticle::index() values linked to node i
+template <class F>
+void BuildTable(GenGraph const& graph, unsigned n, F relatives,
+                std::vector<unsigned> & offsets, std::vector<unsigned> & nodes) {
+  offsets.assign(n + 1, 0);
+  nodes.clear();
+  for (unsigned i = 0; i < n; ++i) {
+    for (int index : relatives(i)) {
+      int node = graph.NodeOfIndex(index);
+      if (node >= 0) nodes.push_back(node);
+    }
+    offsets[i + 1] = nodes.size();
+    std::sort(nodes.begin() + offsets[i], nodes.end());
+  }
+}
+}
+
+GenGraph::GenGraph() : d_offsets_(1, 0), m_offsets_(1, 0), visit_(0) {}
+
+GenGraph::GenGraph(std::vector<GenParticle *> const& parts) : visit_(0) {
+  Build(parts);
+}
+
+void GenGraph::Build(std::vector<GenParticle *> const& parts) {
+  parts_ = parts;
+  unsigned n = parts_.size();
+  int max_index = -1;
+  for (auto part : parts_) max_index = std::max(max_index, part->index());
+  node_of_index_.assign(max_index + 1, -1);
+  flags_.assign(n, 0);
+  for (unsigned i = 0; i < n; ++i) {
+    if (parts_[i]->index() >= 0) node_of_index_[parts_[i]->index()] = i;
+    std::vector<bool> const& status_flags = parts_[i]->statusFlags();
+    for (unsigned b = 0; b < status_flags.size() && b < 32; ++b) {
+      if (status_flags[b]) flags_[i] |= (1u << b);
+    }
+  }
+  BuildTable(*this, n, [&](unsigned i) -> std::vector<int> const& {
+    return parts_[i]->daughters();
+  }, d_offsets_, d_nodes_);
+  BuildTable(*this, n, [&](unsigned i) -> std::vector<int> const& {
+    return parts_[i]->mothers();
+  }, m_offsets_, m_nodes_);
+  marks_.assign(n, 0);
+  visit_ = 0;
+}
+
+GenGraph const& GenGraph::Get(TreeEvent *event, std::string const& label) {
+  std::string name = "genGraph_" + label;
+  if (!event->ExistsInEvent(name)) {
+    event->Add(name, GenGraph());
+    event->Get<GenGraph>(name).Build(event->GetPtrVec<GenParticle>(label));
+  }
+  return event->Get<GenGraph>(name);
+}
+
+void GenGraph::ChildNodes(GenParticle const* part,
+                          std::vector<unsigned> & out) const {
+  out.clear();
+  int node = Node(part);
+  if (node >= 0) {
+    Nodes daughters = Daughters(node);
+    out.assign(daughters.begin(), daughters.end());
+  } else {
+    for (int index : part->daughters()) {
+      int d = NodeOfIndex(index);
+      if (d >= 0) out.push_back(d);
+    }
+    std::sort(out.begin(), out.end());
+  }
+}
+
+void GenGraph::NewVisit() const {
+  if (++visit_ == 0) {
+    std::fill(marks_.begin(), marks_.end(), 0);
+    visit_ = 1;
+  }
+}
+
+std::vector<GenParticle *> GenGraph::ToParticles(
+    std::vector<unsigned> const& nodes) const {
+  std::vector<GenParticle *> result(nodes.size());
+  for (unsigned i = 0; i < nodes.size(); ++i) result[i] = parts_[nodes[i]];
+  return result;
+}
+
+std::vector<GenParticle *> GenGraph::ExtractDaughters(
+    GenParticle const* part) const {
+  std::vector<unsigned> nodes;
+  ChildNodes(part, nodes);
+  return ToParticles(nodes);
+}
+
+std::vector<GenParticle *> GenGraph::ExtractMothers(
+    GenParticle const* part) const {
+  std::vector<unsigned> nodes;
+  int node = Node(part);
+  if (node >= 0) {
+    Nodes mothers = Mothers(node);
+    nodes.assign(mothers.begin(), mothers.end());
+  } else {
+    for (int index : part->mothers()) {
+      int m = NodeOfIndex(index);
+      if (m >= 0) nodes.push_back(m);
+    }
+    std::sort(nodes.begin(), nodes.end());
+  }
+  return ToParticles(nodes);
+}
+
+std::vector<GenParticle *> GenGraph::ExtractDaughtersRecursive(
+    GenParticle const* part) const {
+  NewVisit();
+  ChildNodes(part, stack_);
+  std::vector<unsigned> nodes;
+  while (!stack_.empty()) {
+    unsigned node = stack_.back();
+    stack_.pop_back();
+    if (marks_[node] == visit_) continue;
+    marks_[node] = visit_;
+    nodes.push_back(node);
+    for (unsigned d : Daughters(node)) {
+      if (marks_[d] != visit_) stack_.push_back(d);
+    }
+  }
+  std::vector<GenParticle *> result = ToParticles(nodes);
+  std::sort(result.begin(), result.end(),
+            [](GenParticle const* p1, GenParticle const* p2) {
+              return p1->index() < p2->index();
+            });
+  return result;
+}
+
+std::vector<GenParticle *> GenGraph::ExtractStableDaughters(
+    GenParticle const* part) const {
+  NewVisit();
+  ChildNodes(part, stack_);
+  std::vector<unsigned> nodes;
+  while (!stack_.empty()) {
+    unsigned node = stack_.back();
+    stack_.pop_back();
+    if (marks_[node] == visit_) continue;
+    marks_[node] = visit_;
+    if (parts_[node]->status() == 1) {
+      nodes.push_back(node);
+    } else {
+      for (unsigned d : Daughters(node)) {
+        if (marks_[d] != visit_) stack_.push_back(d);
+      }
+    }
+  }
+  std::sort(nodes.begin(), nodes.end());
+  return ToParticles(nodes);
+}
+}
@@ -2,7 +2,7 @@
 
 namespace ic {
 
-  MassPlots::MassPlots(TFileDirectory const& dir) {
+  MassPlots::MassPlots(FileDirectory const& dir) {
     TH1F::SetDefaultSumw2();
     m_sv = dir.make<TH1F>("m_sv","m_sv", 70, 0, 350); 
     m_vis = dir.make<TH1F>("m_vis","m_vis",  70, 0, 350); 
@@ -20,7 +20,7 @@ namespace ic {
     m_vis_mssm_fine = dir.make<TH1F>("m_vis_mssm_fine","m_vis_mssm_fine", 31, bins_mssm_fine); 
   };
 
-  CoreControlPlots::CoreControlPlots(TFileDirectory const& dir) {
+  CoreControlPlots::CoreControlPlots(FileDirectory const& dir) {
     TH1F::SetDefaultSumw2();
     n_vtx = dir.make<TH1F>("n_vtx","n_vtx", 40, -0.5, 39.5); 
     mt_1 = dir.make<TH1F>("mt_1","mt_1", 40, 0, 160); 
@@ -0,0 +1,255 @@
+#include "Utilities/interface/HistMorph.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <set>
+#include <stdexcept>
+#include "TAxis.h"
+
+namespace ic {
+
+HistMorph::HistMorph(TH1 const& hist1, TH1 const& hist2, double par1,
+                     double par2)
+    : par1_(par1), par2_(par2), empty_(false), n_points_(0) {
+  TH1 const* hists[2] = {&hist1, &hist2};
+  std::vector<double> contents[2];
+  double sums[2] = {0., 0.};
+  for (unsigned h = 0; h < 2; ++h) {
+    TAxis const* axis = hists[h]->GetXaxis();
+    int nbins = axis->GetNbins();
+    std::vector<double> & edges = h == 0 ? edges1_ : edges2_;
+    for (int i = 1; i <= nbins; ++i) {
+      edges.push_back(axis->GetBinLowEdge(i));
+      contents[h].push_back(hists[h]->GetBinContent(i));
+      if (h == 1) widths2_.push_back(axis->GetBinWidth(i));
+    }
+    edges.push_back(axis->GetBinUpEdge(nbins));
+    // As th1fmorph, whose emptiness check includes the underflow and overflow
+    for (int i = 0; i <= nbins + 1; ++i) sums[h] += hists[h]->GetBinContent(i);
+  }
+  Init(contents[0], contents[1], sums[0], sums[1]);
+}
+
+HistMorph::HistMorph(std::vector<double> const& edges1,
+                     std::vector<double> const& contents1,
+                     std::vector<double> const& edges2,
+                     std::vector<double> const& contents2, double par1,
+                     double par2)
+    : edges1_(edges1),
+      edges2_(edges2),
+      par1_(par1),
+      par2_(par2),
+      empty_(false),
+      n_points_(0) {
+  if (edges1.size() < 2 || edges1.size() != contents1.size() + 1 ||
+      edges2.size() < 2 || edges2.size() != contents2.size() + 1) {
+    throw std::runtime_error(
+        "[HistMorph] Each reference needs n+1 edges for its n bins");
+  }
+  for (unsigned i = 1; i < edges2_.size(); ++i) {
+    widths2_.push_back(edges2_[i] - edges2_[i - 1]);
+  }
+  double sum1 = 0.;
+  double sum2 = 0.;
+  for (auto c : contents1) sum1 += c;
+  for (auto c : contents2) sum2 += c;
+  Init(contents1, contents2, sum1, sum2);
+}
+
+void HistMorph::Init(std::vector<double> const& contents1,
+                     std::vector<double> const& contents2, double sum1,
+                     double sum2) {
+  std::set<double> edges(edges1_.begin(), edges1_.end());
+  edges.insert(edges2_.begin(), edges2_.end());
+  edges_.assign(edges.begin(), edges.end());
+
+  if (sum1 <= 0. || sum2 <= 0.) {
+    std::cout << "Warning! [HistMorph] Empty input histogram, every morphed "
+                 "histogram will be empty" << std::endl;
+    empty_ = true;
+    return;
+  }
+
+  // Normalised cdfs, sigdis[i] being the value at edge i. The walk below
+  // may look one edge past the end, which is given the same value as the
+  // last edge.
+  int nb1 = contents1.size();
+  int nb2 = contents2.size();
+  std::vector<double> sigdis1(nb1 + 2, 0.);
+  std::vector<double> sigdis2(nb2 + 2, 0.);
+  double total = 0.;
+  for (int i = 0; i < nb1; ++i) total += contents1[i];
+  for (int i = 1; i <= nb1; ++i) {
+    sigdis1[i] = contents1[i - 1] / total + sigdis1[i - 1];
+  }
+  total = 0.;
+  for (int i = 0; i < nb2; ++i) total += contents2[i];
+  for (int i = 1; i <= nb2; ++i) {
+    sigdis2[i] = contents2[i - 1] / total + sigdis2[i - 1];
+  }
+  sigdis1[nb1 + 1] = sigdis1[nb1];
+  sigdis2[nb2 + 1] = sigdis2[nb2];
+
+  // Last edges from above with the full integral, and first edges from
+  // below before a non-zero bin
+  int ix1l = nb1;
+  int ix2l = nb2;
+  while (ix1l > 0 && sigdis1[ix1l - 1] >= sigdis1[ix1l]) --ix1l;
+  while (ix2l > 0 && sigdis2[ix2l - 1] >= sigdis2[ix2l]) --ix2l;
+  int ix1 = 0;
+  int ix2 = 0;
+  while (ix1 + 1 < nb1 && sigdis1[ix1 + 1] <= sigdis1[0]) ++ix1;
+  while (ix2 + 1 < nb2 && sigdis2[ix2 + 1] <= sigdis2[0]) ++ix2;
+
+  // Step through the edges of both cdfs in order of increasing cumulative
+  // probability, storing where each reference is at that probability. This
+  // is the part of th1fmorph that does not depend on the target.
+  x1_.push_back(edges1_[ix1]);
+  x2_.push_back(edges2_[ix2]);
+  y_.push_back(0.);
+  double yprev = -1.;
+  while (ix1 < ix1l || ix2 < ix2l) {
+    double x1, x2, y;
+    if ((sigdis1[ix1 + 1] <= sigdis2[ix2 + 1] || ix2 == ix2l) && ix1 < ix1l) {
+      ++ix1;
+      while (sigdis1[ix1 + 1] <= sigdis1[ix1] && ix1 < ix1l) ++ix1;
+      x1 = edges1_[ix1];
+      y = sigdis1[ix1];
+      double y20 = sigdis2[ix2];
+      double y21 = sigdis2[ix2 + 1];
+      x2 = y21 > y20 ? edges2_[ix2] + (edges2_[ix2 + 1] - edges2_[ix2]) * (y - y20) / (y21 - y20)
+                     : edges2_[ix2];
+    } else {
+      ++ix2;
+      while (sigdis2[ix2 + 1] <= sigdis2[ix2] && ix2 < ix2l) ++ix2;
+      x2 = edges2_[ix2];
+      y = sigdis2[ix2];
+      double y10 = sigdis1[ix1];
+      double y11 = sigdis1[ix1 + 1];
+      x1 = y11 > y10 ? edges1_[ix1] + (edges1_[ix1 + 1] - edges1_[ix1]) * (y - y10) / (y11 - y10)
+                     : edges1_[ix1];
+    }
+    if (y > yprev) {
+      yprev = y;
+      x1_.push_back(x1);
+      x2_.push_back(x2);
+      y_.push_back(y);
+    }
+  }
+  n_points_ = y_.size();
+  // The projection may step up to edge 2*nbins of the interpolated cdf
+  unsigned padded = std::max<unsigned>(n_points_ + 1, 2 * (edges_.size() - 1) + 2);
+  x1_.resize(padded, 0.);
+  x2_.resize(padded, 0.);
+  y_.resize(padded, 0.);
+}
+
+void HistMorph::Weights(double par, double & wt1, double & wt2) const {
+  if (par2_ != par1_) {
+    wt1 = 1. - (par - par1_) / (par2_ - par1_);
+    wt2 = 1. + (par - par2_) / (par2_ - par1_);
+  } else {
+    wt1 = 0.5;
+    wt2 = 0.5;
+  }
+  if (wt1 < 0. || wt1 > 1. || wt2 < 0. || wt2 > 1. ||
+      std::fabs(1. - (wt1 + wt2)) > 1.0e-4) {
+    std::cout << "Warning! [HistMorph] This is an extrapolation!! Weights are "
+              << wt1 << " and " << wt2 << " (sum=" << wt1 + wt2 << ")"
+              << std::endl;
+  }
+}
+
+double HistMorph::Width2(double x) const {
+  // As TAxis::GetBinWidth(TAxis::FindBin(x)), which clamps to the first and
+  // last bins
+  int bin = std::upper_bound(edges2_.begin(), edges2_.end(), x) - edges2_.begin();
+  bin = std::min<int>(std::max(bin, 1), widths2_.size());
+  return widths2_[bin - 1];
+}
+
+void HistMorph::Project(std::vector<double> const& xdisn, double norm,
+                        double *contents) const {
+  int nbn = edges_.size() - 1;
+  int nx3 = n_points_ - 1;
+  std::vector<double> sigdisf(nbn + 1, 0.);
+
+  // Output edges after the last point get the full integral, those up to
+  // the first point get nothing
+  int ix = nbn;
+  while (ix >= 0 && edges_[ix] >= xdisn[nx3]) {
+    sigdisf[ix] = y_[nx3];
+    --ix;
+  }
+  int ixl = ix + 1;
+  ix = 0;
+  while (ix < nbn && edges_[ix + 1] <= xdisn[0]) {
+    sigdisf[ix] = y_[0];
+    ++ix;
+  }
+  int ixf = ix;
+
+  // In between, interpolate the cdf at each output edge
+  int ix3 = 0;
+  for (ix = ixf; ix < ixl; ++ix) {
+    double x = edges_[ix];
+    double y;
+    if (x < xdisn[0]) {
+      y = 0.;
+    } else if (x > xdisn[nx3]) {
+      y = 1.;
+    } else {
+      while (xdisn[ix3 + 1] <= x && ix3 < 2 * nbn) ++ix3;
+      if (xdisn[ix3 + 1] - x > 1.1 * Width2(x)) {
+        // Empty bin
+        y = y_[ix3 + 1];
+      } else if (xdisn[ix3 + 1] > xdisn[ix3]) {
+        y = y_[ix3] + (y_[ix3 + 1] - y_[ix3]) * (x - xdisn[ix3]) /
+                          (xdisn[ix3 + 1] - xdisn[ix3]);
+      } else {
+        y = 0.;
+        std::cout << "Warning! [HistMorph] Zero slope solving x(y)" << std::endl;
+      }
+    }
+    sigdisf[ix] = y;
+  }
+
+  for (ix = 0; ix < nbn; ++ix) {
+    contents[ix] = (sigdisf[ix + 1] - sigdisf[ix]) * norm;
+  }
+}
+
+std::vector<double> HistMorph::Morph(double par, double norm) const {
+  return Morph(std::vector<double>(1, par), std::vector<double>(1, norm))[0];
+}
+
+std::vector<std::vector<double>> HistMorph::Morph(
+    std::vector<double> const& pars, std::vector<double> const& norms) const {
+  if (pars.size() != norms.size()) {
+    throw std::runtime_error(
+        "[HistMorph] Need one normalisation per parameter value");
+  }
+  unsigned nbins = edges_.size() - 1;
+  std::vector<std::vector<double>> result(pars.size(),
+                                          std::vector<double>(nbins, 0.));
+  std::vector<double> wt1(pars.size());
+  std::vector<double> wt2(pars.size());
+  for (unsigned t = 0; t < pars.size(); ++t) Weights(pars[t], wt1[t], wt2[t]);
+  if (empty_) return result;
+
+  // The interpolated cdf of every target is a weighted sum of the stored
+  // points, done as one flat loop per target over contiguous arrays
+  unsigned npadded = y_.size();
+  std::vector<double> xdisn(npadded);
+  double const* x1 = &(x1_[0]);
+  double const* x2 = &(x2_[0]);
+  for (unsigned t = 0; t < pars.size(); ++t) {
+    double const w1 = wt1[t];
+    double const w2 = wt2[t];
+    double *xd = &(xdisn[0]);
+    for (unsigned i = 0; i < npadded; ++i) xd[i] = w1 * x1[i] + w2 * x2[i];
+    Project(xdisn, norms[t], &(result[t][0]));
+  }
+  return result;
+}
+}
@@ -5,7 +5,7 @@
 
 namespace ic {
 
-  HttPlots::HttPlots(TFileDirectory const& dir) : HistoSet() {
+  HttPlots::HttPlots(FileDirectory const& dir) : HistoSet() {
     // Vertex plots
     TH1F::SetDefaultSumw2();
     n_good_pv_noweight  = dir.make<TH1F>("n_good_pv_noweight","n_good_pv_noweight", 50, 0, 50);
@@ -0,0 +1,557 @@
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/JetCorrectionTables.h"
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace ic {
+
+namespace {
+enum op {
+  kConst, kVar, kPar, kAdd, kSub, kMul, kDiv, kPow, kNeg, kNot,
+  kLt, kGt, kLe, kGe, kEq, kNe, kAnd, kOr, kFn1, kFn2
+};
+
+double fn_max(double a, double b) { return a > b ? a : b; }
+double fn_min(double a, double b) { return a < b ? a : b; }
+double fn_pow(double a, double b) { return std::pow(a, b); }
+double fn_exp(double a) { return std::exp(a); }
+double fn_log(double a) { return std::log(a); }
+double fn_log10(double a) { return std::log10(a); }
+double fn_sqrt(double a) { return std::sqrt(a); }
+double fn_abs(double a) { return std::fabs(a); }
+double fn_sin(double a) { return std::sin(a); }
+double fn_cos(double a) { return std::cos(a); }
+double fn_tan(double a) { return std::tan(a); }
+double fn_atan(double a) { return std::atan(a); }
+double fn_sinh(double a) { return std::sinh(a); }
+double fn_cosh(double a) { return std::cosh(a); }
+double fn_tanh(double a) { return std::tanh(a); }
+double fn_erf(double a) { return std::erf(a); }
+
+std::string StripTMath(std::string const& name) {
+  return name.compare(0, 7, "TMath::") == 0 ? name.substr(7) : name;
+}
+
+std::vector<std::string> Tokens(std::string const& line) {
+  std::vector<std::string> result;
+  std::istringstream is(line);
+  std::string tok;
+  while (is >> tok) result.push_back(tok);
+  return result;
+}
+
+std::string Trim(std::string const& str) {
+  std::size_t b = str.find_first_not_of(" \t\r\n");
+  if (b == std::string::npos) return "";
+  std::size_t e = str.find_last_not_of(" \t\r\n");
+  return str.substr(b, e - b + 1);
+}
+
+// Parameters are stored as float in JetCorrectorParameters, keep the same
+// precision so results agree
+double AsStored(std::string const& str) {
+  return double(float(std::atof(str.c_str())));
+}
+}
+
+/*
+ * Recursive descent parser, lowest to highest precedence:
+ *   || && (== !=) (< > <= >=) (+ -) (* /) (unary - + !) ^
+ */
+class JetCorrectionFormulaParser {
+ public:
+  JetCorrectionFormulaParser(std::string const& expr, JetCorrectionFormula *f)
+      : s_(expr), pos_(0), f_(f), depth_(0) {}
+
+  void Run() {
+    Or();
+    Skip();
+    if (pos_ != s_.size()) Fail("unexpected character");
+  }
+
+ private:
+  void Skip() {
+    while (pos_ < s_.size() && std::isspace(s_[pos_])) ++pos_;
+  }
+  bool Accept(std::string const& tok) {
+    Skip();
+    if (s_.compare(pos_, tok.size(), tok) == 0) {
+      pos_ += tok.size();
+      return true;
+    }
+    return false;
+  }
+  void Expect(std::string const& tok) {
+    if (!Accept(tok)) Fail("expected '" + tok + "'");
+  }
+  void Fail(std::string const& msg) {
+    throw std::runtime_error("[JetCorrectionFormula] " + msg + " at position " +
+                             std::to_string(pos_) + " in \"" + s_ + "\"");
+  }
+  void Emit(int op, int idx = 0, double val = 0.,
+            double (*f1)(double) = nullptr,
+            double (*f2)(double, double) = nullptr) {
+    JetCorrectionFormula::Instr ins = {op, idx, val, f1, f2};
+    f_->prog_.push_back(ins);
+    if (op == kConst || op == kVar || op == kPar) {
+      ++depth_;
+      f_->max_depth_ = std::max(f_->max_depth_, depth_);
+    } else if (op != kNeg && op != kNot && op != kFn1) {
+      --depth_;
+    }
+  }
+
+  void Or() {
+    And();
+    while (Accept("||")) { And(); Emit(kOr); }
+  }
+  void And() {
+    Equality();
+    while (Accept("&&")) { Equality(); Emit(kAnd); }
+  }
+  void Equality() {
+    Relational();
+    while (true) {
+      if (Accept("==")) { Relational(); Emit(kEq); }
+      else if (Accept("!=")) { Relational(); Emit(kNe); }
+      else break;
+    }
+  }
+  void Relational() {
+    Additive();
+    while (true) {
+      if (Accept("<=")) { Additive(); Emit(kLe); }
+      else if (Accept(">=")) { Additive(); Emit(kGe); }
+      else if (Accept("<")) { Additive(); Emit(kLt); }
+      else if (Accept(">")) { Additive(); Emit(kGt); }
+      else break;
+    }
+  }
+  void Additive() {
+    Multiplicative();
+    while (true) {
+      if (Accept("+")) { Multiplicative(); Emit(kAdd); }
+      else if (Accept("-")) { Multiplicative(); Emit(kSub); }
+      else break;
+    }
+  }
+  void Multiplicative() {
+    Unary();
+    while (true) {
+      if (Accept("*")) { Unary(); Emit(kMul); }
+      else if (Accept("/")) { Unary(); Emit(kDiv); }
+      else break;
+    }
+  }
+  void Unary() {
+    if (Accept("-")) { Unary(); Emit(kNeg); }
+    else if (Accept("+")) { Unary(); }
+    else if (!Peek("!=") && Accept("!")) { Unary(); Emit(kNot); }
+    else Power();
+  }
+  void Power() {
+    Primary();
+    if (Accept("^")) { Unary(); Emit(kPow); }
+  }
+  bool Peek(std::string const& tok) {
+    Skip();
+    return s_.compare(pos_, tok.size(), tok) == 0;
+  }
+  void Primary() {
+    Skip();
+    if (pos_ >= s_.size()) Fail("unexpected end");
+    char c = s_[pos_];
+    if (c == '(') {
+      ++pos_;
+      Or();
+      Expect(")");
+    } else if (c == '[') {
+      ++pos_;
+      std::size_t end = s_.find(']', pos_);
+      if (end == std::string::npos) Fail("unterminated parameter");
+      int idx = std::atoi(s_.substr(pos_, end - pos_).c_str());
+      pos_ = end + 1;
+      f_->n_pars_ = std::max(f_->n_pars_, unsigned(idx + 1));
+      Emit(kPar, idx);
+    } else if (std::isdigit(c) || c == '.') {
+      char *end = nullptr;
+      double val = std::strtod(s_.c_str() + pos_, &end);
+      pos_ = end - s_.c_str();
+      Emit(kConst, 0, val);
+    } else if (std::isalpha(c) || c == '_') {
+      std::size_t start = pos_;
+      while (pos_ < s_.size() &&
+             (std::isalnum(s_[pos_]) || s_[pos_] == '_' || s_[pos_] == ':')) {
+        ++pos_;
+      }
+      std::string name = s_.substr(start, pos_ - start);
+      if (Peek("(")) {
+        Function(StripTMath(name));
+      } else if (name == "x" || name == "y" || name == "z" || name == "t") {
+        Emit(kVar, name == "x" ? 0 : name == "y" ? 1 : name == "z" ? 2 : 3);
+      } else if (StripTMath(name) == "Pi" || name == "pi") {
+        Emit(kConst, 0, 3.14159265358979323846);
+      } else {
+        Fail("unknown identifier '" + name + "'");
+      }
+    } else {
+      Fail("unexpected character");
+    }
+  }
+  void Function(std::string const& name) {
+    static const std::map<std::string, double (*)(double)> f1 = {
+        {"exp", fn_exp},   {"Exp", fn_exp},     {"log", fn_log},
+        {"Log", fn_log},   {"log10", fn_log10}, {"Log10", fn_log10},
+        {"sqrt", fn_sqrt}, {"Sqrt", fn_sqrt},   {"fabs", fn_abs},
+        {"abs", fn_abs},   {"Abs", fn_abs},     {"sin", fn_sin},
+        {"cos", fn_cos},   {"tan", fn_tan},     {"atan", fn_atan},
+        {"ATan", fn_atan}, {"sinh", fn_sinh},   {"cosh", fn_cosh},
+        {"CosH", fn_cosh}, {"tanh", fn_tanh},   {"TanH", fn_tanh},
+        {"erf", fn_erf},   {"Erf", fn_erf}};
+    static const std::map<std::string, double (*)(double, double)> f2 = {
+        {"max", fn_max}, {"Max", fn_max},   {"min", fn_min},
+        {"Min", fn_min}, {"pow", fn_pow},   {"Power", fn_pow}};
+    Expect("(");
+    Or();
+    if (Accept(",")) {
+      Or();
+      Expect(")");
+      auto it = f2.find(name);
+      if (it == f2.end()) Fail("unknown function '" + name + "'");
+      Emit(kFn2, 0, 0., nullptr, it->second);
+    } else {
+      Expect(")");
+      auto it = f1.find(name);
+      if (it == f1.end()) Fail("unknown function '" + name + "'");
+      Emit(kFn1, 0, 0., it->second, nullptr);
+    }
+  }
+
+  std::string s_;
+  std::size_t pos_;
+  JetCorrectionFormula *f_;
+  unsigned depth_;
+};
+
+JetCorrectionInputs::var JetCorrectionInputs::Lookup(std::string const& name) {
+  static const std::map<std::string, var> names = {
+      {"JetEta", JetEta}, {"JetPt", JetPt}, {"JetE", JetE},
+      {"JetPhi", JetPhi}, {"JetA", JetA},   {"Rho", Rho},
+      {"JetEMF", JetEMF}, {"NPV", NPV}};
+  auto it = names.find(name);
+  if (it == names.end()) {
+    throw std::runtime_error("[JetCorrectionInputs] Unknown variable " + name);
+  }
+  return it->second;
+}
+
+JetCorrectionFormula::JetCorrectionFormula() : n_pars_(0), max_depth_(0) {}
+
+JetCorrectionFormula::JetCorrectionFormula(std::string const& expr)
+    : n_pars_(0), max_depth_(0) {
+  JetCorrectionFormulaParser(expr, this).Run();
+}
+
+JetCorrectionFormula JetCorrectionFormula::Bind(
+    std::vector<double> const& pars) const {
+  if (pars.size() < n_pars_) {
+    throw std::runtime_error("[JetCorrectionFormula] Expected " +
+                             std::to_string(n_pars_) + " parameters, got " +
+                             std::to_string(pars.size()));
+  }
+  JetCorrectionFormula result = *this;
+  for (auto & ins : result.prog_) {
+    if (ins.op == kPar) {
+      ins.op = kConst;
+      ins.val = pars[ins.idx];
+    }
+  }
+  result.n_pars_ = 0;
+  return result;
+}
+
+double JetCorrectionFormula::Eval(double const* x, double const* p) const {
+  double stack_buf[32];
+  std::vector<double> stack_vec;
+  double *st = stack_buf;
+  if (max_depth_ > 32) {
+    stack_vec.resize(max_depth_);
+    st = stack_vec.data();
+  }
+  int top = -1;
+  for (auto const& ins : prog_) {
+    switch (ins.op) {
+      case kConst: st[++top] = ins.val; break;
+      case kVar:   st[++top] = x[ins.idx]; break;
+      case kPar:   st[++top] = p[ins.idx]; break;
+      case kAdd:   st[top-1] = st[top-1] + st[top]; --top; break;
+      case kSub:   st[top-1] = st[top-1] - st[top]; --top; break;
+      case kMul:   st[top-1] = st[top-1] * st[top]; --top; break;
+      case kDiv:   st[top-1] = st[top-1] / st[top]; --top; break;
+      case kPow:   st[top-1] = std::pow(st[top-1], st[top]); --top; break;
+      case kLt:    st[top-1] = st[top-1] < st[top];  --top; break;
+      case kGt:    st[top-1] = st[top-1] > st[top];  --top; break;
+      case kLe:    st[top-1] = st[top-1] <= st[top]; --top; break;
+      case kGe:    st[top-1] = st[top-1] >= st[top]; --top; break;
+      case kEq:    st[top-1] = st[top-1] == st[top]; --top; break;
+      case kNe:    st[top-1] = st[top-1] != st[top]; --top; break;
+      case kAnd:   st[top-1] = st[top-1] && st[top]; --top; break;
+      case kOr:    st[top-1] = st[top-1] || st[top]; --top; break;
+      case kNeg:   st[top] = -st[top]; break;
+      case kNot:   st[top] = !st[top]; break;
+      case kFn1:   st[top] = ins.f1(st[top]); break;
+      case kFn2:   st[top-1] = ins.f2(st[top-1], st[top]); --top; break;
+    }
+  }
+  return top >= 0 ? st[top] : 0.;
+}
+
+JetCorrectionLevel::JetCorrectionLevel() {}
+
+JetCorrectionLevel::JetCorrectionLevel(std::string const& file,
+                                       std::string const& section) {
+  Parse(file, section);
+}
+
+std::vector<std::string> JetCorrectionLevel::Sections(std::string const& file) {
+  std::ifstream in(file);
+  if (!in.good()) {
+    throw std::runtime_error("[JetCorrectionLevel] Cannot open " + file);
+  }
+  std::vector<std::string> result;
+  std::string line;
+  while (std::getline(in, line)) {
+    line = Trim(line);
+    if (line.size() > 1 && line.front() == '[' && line.back() == ']') {
+      result.push_back(Trim(line.substr(1, line.size() - 2)));
+    }
+  }
+  return result;
+}
+
+void JetCorrectionLevel::Parse(std::string const& file,
+                               std::string const& section) {
+  std::ifstream in(file);
+  if (!in.good()) {
+    throw std::runtime_error("[JetCorrectionLevel] Cannot open " + file);
+  }
+  std::string line;
+  bool in_section = (section == "");
+  bool found_section = in_section;
+  bool have_header = false;
+  while (std::getline(in, line)) {
+    line = Trim(line);
+    if (line.empty() || line[0] == '#') continue;
+    if (line.front() == '[') {
+      if (found_section && have_header) break;
+      std::string name = Trim(line.substr(1, line.find(']') - 1));
+      in_section = (section == "" || name == section);
+      if (in_section) found_section = true;
+      continue;
+    }
+    if (!in_section) continue;
+    if (line.front() == '{') {
+      std::size_t end = line.find('}');
+      std::vector<std::string> tok = Tokens(line.substr(1, end - 1));
+      unsigned i = 0;
+      unsigned nbin = std::atoi(tok.at(i++).c_str());
+      for (unsigned j = 0; j < nbin; ++j) {
+        bin_vars_.push_back(JetCorrectionInputs::Lookup(tok.at(i++)));
+      }
+      unsigned npar = std::atoi(tok.at(i++).c_str());
+      for (unsigned j = 0; j < npar; ++j) {
+        par_vars_.push_back(JetCorrectionInputs::Lookup(tok.at(i++)));
+      }
+      formula_str_ = tok.at(i++);
+      formula_str_.erase(std::remove(formula_str_.begin(), formula_str_.end(), '"'),
+                         formula_str_.end());
+      level_ = tok.size() > i + 1 ? tok.at(i + 1) : "";
+      have_header = true;
+      continue;
+    }
+    if (!have_header) {
+      throw std::runtime_error("[JetCorrectionLevel] Record before header in " + file);
+    }
+    std::vector<std::string> tok = Tokens(line);
+    unsigned nbin = bin_vars_.size();
+    if (tok.size() < 2 * nbin + 1) {
+      throw std::runtime_error("[JetCorrectionLevel] Malformed record in " + file + ": " + line);
+    }
+    Bin bin;
+    for (unsigned j = 0; j < nbin; ++j) {
+      bin.min.push_back(AsStored(tok[2*j]));
+      bin.max.push_back(AsStored(tok[2*j+1]));
+    }
+    unsigned nvals = std::atoi(tok[2*nbin].c_str());
+    if (nvals != tok.size() - (2 * nbin + 1)) {
+      throw std::runtime_error("[JetCorrectionLevel] Wrong number of parameters in " + file + ": " + line);
+    }
+    for (unsigned j = 2 * nbin + 1; j < tok.size(); ++j) {
+      bin.pars.push_back(AsStored(tok[j]));
+    }
+    bins_.push_back(bin);
+  }
+  if (!found_section || !have_header) {
+    throw std::runtime_error("[JetCorrectionLevel] No payload" +
+                             (section == "" ? "" : " for section " + section) +
+                             " in " + file);
+  }
+  // The uncertainty files have an empty formula and are interpreted by
+  // JetUncertaintySource, otherwise bind the formula for each bin
+  if (formula_str_ != "") {
+    JetCorrectionFormula formula(formula_str_);
+    unsigned npar = par_vars_.size();
+    for (auto & bin : bins_) {
+      if (bin.pars.size() < 2 * npar) {
+        throw std::runtime_error("[JetCorrectionLevel] Missing variable ranges in " + file);
+      }
+      for (unsigned j = 0; j < npar; ++j) {
+        bin.xmin.push_back(bin.pars[2*j]);
+        bin.xmax.push_back(bin.pars[2*j+1]);
+      }
+      bin.formula = formula.Bind(std::vector<double>(bin.pars.begin() + 2 * npar,
+                                                     bin.pars.end()));
+    }
+  }
+  if (bin_vars_.size() == 1) {
+    std::stable_sort(bins_.begin(), bins_.end(), [](Bin const& a, Bin const& b) {
+      return a.min[0] < b.min[0];
+    });
+    for (auto const& bin : bins_) lo_edges_.push_back(bin.min[0]);
+  }
+}
+
+int JetCorrectionLevel::FindBin(JetCorrectionInputs const& in) const {
+  if (bin_vars_.size() == 1) {
+    double x = in[bin_vars_[0]];
+    auto it = std::upper_bound(lo_edges_.begin(), lo_edges_.end(), x);
+    if (it == lo_edges_.begin()) return -1;
+    int idx = int(it - lo_edges_.begin()) - 1;
+    return x < bins_[idx].max[0] ? idx : -1;
+  }
+  for (unsigned i = 0; i < bins_.size(); ++i) {
+    bool inside = true;
+    for (unsigned j = 0; j < bin_vars_.size() && inside; ++j) {
+      double x = in[bin_vars_[j]];
+      inside = (x >= bins_[i].min[j] && x < bins_[i].max[j]);
+    }
+    if (inside) return i;
+  }
+  return -1;
+}
+
+double JetCorrectionLevel::Correction(JetCorrectionInputs const& in) const {
+  int idx = FindBin(in);
+  if (idx < 0) return 1.0;
+  Bin const& bin = bins_[idx];
+  if (!bin.formula.IsValid()) return 1.0;
+  double x[4] = {0., 0., 0., 0.};
+  for (unsigned j = 0; j < par_vars_.size() && j < 4; ++j) {
+    x[j] = std::max(bin.xmin[j], std::min(bin.xmax[j], in[par_vars_[j]]));
+  }
+  return bin.formula.Eval(x);
+}
+
+JetCorrectionChain::JetCorrectionChain() {}
+
+JetCorrectionChain::JetCorrectionChain(std::vector<std::string> const& files) {
+  for (auto const& file : files) AddLevel(JetCorrectionLevel(file));
+}
+
+void JetCorrectionChain::AddLevel(JetCorrectionLevel const& level) {
+  levels_.push_back(level);
+}
+
+void JetCorrectionChain::SubCorrections(JetCorrectionInputs in,
+                                        std::vector<float> & factors) const {
+  factors.resize(levels_.size());
+  float scale = 1.;
+  for (unsigned i = 0; i < levels_.size(); ++i) {
+    float factor = levels_[i].Correction(in);
+    scale *= factor;
+    factors[i] = scale;
+    in[JetCorrectionInputs::JetPt] *= factor;
+    in[JetCorrectionInputs::JetE] *= factor;
+  }
+}
+
+std::vector<float> JetCorrectionChain::SubCorrections(
+    JetCorrectionInputs const& in) const {
+  std::vector<float> factors;
+  SubCorrections(in, factors);
+  return factors;
+}
+
+double JetCorrectionChain::Correction(JetCorrectionInputs const& in) const {
+  std::vector<float> factors;
+  SubCorrections(in, factors);
+  return factors.empty() ? 1.0 : factors.back();
+}
+
+JetUncertaintySource::JetUncertaintySource() {}
+
+JetUncertaintySource::JetUncertaintySource(std::string const& file,
+                                           std::string const& section)
+    : JetCorrectionLevel(file, section), name_(section) {
+  for (auto const& bin : bins_) {
+    if (bin.pars.size() % 3 != 0 || bin.pars.size() < 6) {
+      throw std::runtime_error("[JetUncertaintySource] Bins of " + file +
+                               " must contain at least two (pt, up, down) points");
+    }
+  }
+}
+
+double JetUncertaintySource::Uncertainty(double eta, double pt, bool up) const {
+  JetCorrectionInputs in;
+  in[JetCorrectionInputs::JetEta] = eta;
+  in[JetCorrectionInputs::JetPt] = pt;
+  int idx = FindBin(in);
+  if (idx < 0) return -999.;
+  std::vector<double> const& p = bins_[idx].pars;
+  unsigned n = p.size() / 3;
+  unsigned off = up ? 1 : 2;
+  if (pt <= p[0]) return p[off];
+  if (pt >= p[3*(n-1)]) return p[3*(n-1)+off];
+  // Binary search over the pt points, which are stored with a stride of 3
+  unsigned lo = 0;
+  unsigned hi = n - 1;
+  while (hi - lo > 1) {
+    unsigned mid = (lo + hi) / 2;
+    if (p[3*mid] <= pt) lo = mid; else hi = mid;
+  }
+  double x0 = p[3*lo];
+  double x1 = p[3*hi];
+  double y0 = p[3*lo+off];
+  double y1 = p[3*hi+off];
+  if (x0 == x1) return y0;
+  return y0 + (pt - x0) * (y1 - y0) / (x1 - x0);
+}
+
+void JetUncertaintySource::Uncertainty(double const* eta, double const* pt,
+                                       unsigned n, bool up, double * out) const {
+  for (unsigned i = 0; i < n; ++i) out[i] = Uncertainty(eta[i], pt[i], up);
+}
+
+JetUncertaintySources::JetUncertaintySources() {}
+
+JetUncertaintySources::JetUncertaintySources(
+    std::string const& file, std::vector<std::string> const& sections) {
+  std::vector<std::string> names =
+      sections.empty() ? JetCorrectionLevel::Sections(file) : sections;
+  if (names.empty()) names.push_back("");
+  for (auto const& name : names) {
+    sources_.push_back(JetUncertaintySource(file, name));
+  }
+}
+
+int JetUncertaintySources::Index(std::string const& name) const {
+  for (unsigned i = 0; i < sources_.size(); ++i) {
+    if (sources_[i].name() == name) return i;
+  }
+  return -1;
+}
+}
@@ -0,0 +1,158 @@
+#include "Utilities/interface/LumiIndex.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include "boost/lexical_cast.hpp"
+#include "Utilities/interface/JsonTools.h"
+
+namespace ic {
+
+namespace {
+unsigned PopCount(uint64_t x) {
+  unsigned n = 0;
+  for (; x; ++n) x &= x - 1;
+  return n;
+}
+}
+
+LumiIndex::LumiIndex() : last_(-1) {}
+
+LumiIndex LumiIndex::FromJson(Json::Value const& js) {
+  LumiIndex result;
+  for (auto const& key : js.getMemberNames()) {
+    Json::Value const& run_js = js[key];
+    unsigned run = boost::lexical_cast<unsigned>(key);
+    result.AddRun(run);
+    for (unsigned i = 0; i < run_js.size(); ++i) {
+      if (run_js[i].size() != 2) {
+        throw std::runtime_error(
+            "[LumiIndex] Lumi range not in the form [X,Y]");
+      }
+      unsigned range_min = run_js[i][0].asUInt();
+      unsigned range_max = run_js[i][1].asUInt();
+      if (range_max < range_min) {
+        throw std::runtime_error(
+            "[LumiIndex] Have lumi range [X,Y] where Y < X");
+      }
+      result.InsertRange(run, range_min, range_max);
+    }
+  }
+  return result;
+}
+
+LumiIndex LumiIndex::FromFile(std::string const& file) {
+  return FromJson(ExtractJsonFromFile(file));
+}
+
+int LumiIndex::AddRun(unsigned run) {
+  int idx = FindRun(run);
+  if (idx >= 0) return idx;
+  auto it = std::lower_bound(runs_.begin(), runs_.end(), run);
+  idx = int(it - runs_.begin());
+  runs_.insert(it, run);
+  bits_.insert(bits_.begin() + idx, std::vector<uint64_t>());
+  last_ = idx;
+  return idx;
+}
+
+void LumiIndex::Insert(unsigned run, unsigned ls) {
+  std::vector<uint64_t> & words = bits_[AddRun(run)];
+  unsigned word = ls >> 6;
+  if (word >= words.size()) words.resize(word + 1, 0);
+  words[word] |= (uint64_t(1) << (ls & 63));
+}
+
+void LumiIndex::InsertRange(unsigned run, unsigned first, unsigned last) {
+  std::vector<uint64_t> & words = bits_[AddRun(run)];
+  if ((last >> 6) >= words.size()) words.resize((last >> 6) + 1, 0);
+  for (unsigned ls = first; ls <= last; ++ls) {
+    words[ls >> 6] |= (uint64_t(1) << (ls & 63));
+  }
+}
+
+void LumiIndex::Merge(LumiIndex const& other) {
+  for (unsigned i = 0; i < other.runs_.size(); ++i) {
+    std::vector<uint64_t> const& src = other.bits_[i];
+    std::vector<uint64_t> & dest = bits_[AddRun(other.runs_[i])];
+    if (src.size() > dest.size()) dest.resize(src.size(), 0);
+    for (unsigned w = 0; w < src.size(); ++w) dest[w] |= src[w];
+  }
+}
+
+LumiIndex LumiIndex::Intersection(LumiIndex const& other) const {
+  LumiIndex result;
+  for (unsigned i = 0; i < runs_.size(); ++i) {
+    int j = other.FindRun(runs_[i]);
+    if (j < 0) continue;
+    std::vector<uint64_t> const& a = bits_[i];
+    std::vector<uint64_t> const& b = other.bits_[j];
+    std::vector<uint64_t> words(std::min(a.size(), b.size()));
+    for (unsigned w = 0; w < words.size(); ++w) words[w] = a[w] & b[w];
+    result.runs_.push_back(runs_[i]);
+    result.bits_.push_back(words);
+  }
+  return result;
+}
+
+LumiIndex LumiIndex::Difference(LumiIndex const& other) const {
+  LumiIndex result;
+  for (unsigned i = 0; i < runs_.size(); ++i) {
+    std::vector<uint64_t> words = bits_[i];
+    int j = other.FindRun(runs_[i]);
+    if (j >= 0) {
+      std::vector<uint64_t> const& b = other.bits_[j];
+      for (unsigned w = 0; w < words.size() && w < b.size(); ++w) {
+        words[w] &= ~b[w];
+      }
+    }
+    result.runs_.push_back(runs_[i]);
+    result.bits_.push_back(words);
+  }
+  return result;
+}
+
+unsigned LumiIndex::NLumis(unsigned run) const {
+  int idx = FindRun(run);
+  if (idx < 0) return 0;
+  unsigned n = 0;
+  for (auto w : bits_[idx]) n += PopCount(w);
+  return n;
+}
+
+unsigned LumiIndex::NLumis() const {
+  unsigned n = 0;
+  for (auto const& words : bits_) {
+    for (auto w : words) n += PopCount(w);
+  }
+  return n;
+}
+
+Json::Value LumiIndex::ToJson() const {
+  Json::Value js(Json::objectValue);
+  for (unsigned i = 0; i < runs_.size(); ++i) {
+    std::vector<uint64_t> const& words = bits_[i];
+    std::string run = boost::lexical_cast<std::string>(runs_[i]);
+    unsigned nbits = words.size() * 64;
+    unsigned ls = 0;
+    while (ls < nbits) {
+      if (!((words[ls >> 6] >> (ls & 63)) & 1)) {
+        ++ls;
+        continue;
+      }
+      unsigned first = ls;
+      while (ls < nbits && ((words[ls >> 6] >> (ls & 63)) & 1)) ++ls;
+      Json::Value lumi_pair;
+      lumi_pair.append(first);
+      lumi_pair.append(ls - 1);
+      js[run].append(lumi_pair);
+    }
+  }
+  return js;
+}
+
+void LumiIndex::WriteJson(std::string const& file) const {
+  std::ofstream output(file.c_str());
+  Json::StyledWriter writer;
+  output << writer.write(ToJson());
+}
+}
@@ -0,0 +1,350 @@
+#include "Utilities/interface/ShapeCache.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "TFile.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TH2.h"
+#include "TH3.h"
+
+namespace ic {
+
+namespace {
+
+// Layout of a cache file: a Header, one Record per histogram, the doubles of
+// every histogram (edges, contents, errors) and finally the characters of the
+// source path followed by those of every histogram path
+const char kMagic[8] = {'I', 'C', 'S', 'H', 'A', 'P', 'E', '1'};
+
+struct Header {
+  char magic[8];
+  std::uint64_t source_size;
+  std::int64_t source_mtime;
+  std::uint64_t n_shapes;
+  std::uint64_t n_doubles;
+  std::uint64_t source_length;
+};
+
+struct Record {
+  std::uint64_t name_offset;
+  std::uint64_t name_length;
+  std::uint64_t data_offset;
+  std::uint64_t nbins;
+  double entries;
+};
+
+struct Pending {
+  std::string path;
+  unsigned nbins;
+  double entries;
+  std::size_t data_offset;
+};
+
+void Collect(TDirectory * dir, std::string const& prefix,
+             std::vector<Pending> & shapes, std::vector<double> & data) {
+  // Only the highest cycle of each key is used, as in TDirectory::Get
+  std::map<std::string, TKey *> keys;
+  TIter next(dir->GetListOfKeys());
+  while (TKey * key = static_cast<TKey *>(next())) {
+    auto it = keys.find(key->GetName());
+    if (it == keys.end() || it->second->GetCycle() < key->GetCycle()) {
+      keys[key->GetName()] = key;
+    }
+  }
+  for (auto const& it : keys) {
+    TKey * key = it.second;
+    TClass * cls = TClass::GetClass(key->GetClassName());
+    if (!cls) continue;
+    std::string path = prefix.empty() ? it.first : prefix + "/" + it.first;
+    if (cls->InheritsFrom(TDirectory::Class())) {
+      TDirectory * subdir = dynamic_cast<TDirectory *>(key->ReadObj());
+      if (subdir) Collect(subdir, path, shapes, data);
+      continue;
+    }
+    if (!cls->InheritsFrom(TH1::Class()) || cls->InheritsFrom(TH2::Class()) ||
+        cls->InheritsFrom(TH3::Class())) {
+      continue;
+    }
+    TH1 * hist = dynamic_cast<TH1 *>(key->ReadObj());
+    if (!hist) continue;
+    Pending shape;
+    shape.path = path;
+    shape.nbins = hist->GetNbinsX();
+    shape.entries = hist->GetEntries();
+    shape.data_offset = data.size();
+    TAxis const* axis = hist->GetXaxis();
+    for (unsigned i = 1; i <= shape.nbins; ++i) {
+      data.push_back(axis->GetBinLowEdge(i));
+    }
+    data.push_back(axis->GetBinUpEdge(shape.nbins));
+    for (unsigned i = 0; i <= shape.nbins + 1; ++i) {
+      data.push_back(hist->GetBinContent(i));
+    }
+    for (unsigned i = 0; i <= shape.nbins + 1; ++i) {
+      data.push_back(hist->GetBinError(i));
+    }
+    shapes.push_back(shape);
+    delete hist;
+  }
+}
+
+std::size_t DataStart(std::uint64_t n_shapes) {
+  return sizeof(Header) + n_shapes * sizeof(Record);
+}
+
+std::size_t NamesStart(std::uint64_t n_shapes, std::uint64_t n_doubles) {
+  return DataStart(n_shapes) + n_doubles * sizeof(double);
+}
+
+bool Stat(std::string const& filename, long long & size, long long & mtime) {
+  struct stat info;
+  if (stat(filename.c_str(), &info) != 0) return false;
+  size = info.st_size;
+  mtime = info.st_mtime;
+  return true;
+}
+}
+
+double ShapeView::Integral() const {
+  double sum = 0.;
+  for (unsigned i = 0; i <= nbins + 1; ++i) sum += contents[i];
+  return sum;
+}
+
+double ShapeView::IntegralError() const {
+  double sum = 0.;
+  for (unsigned i = 0; i <= nbins + 1; ++i) sum += errors[i] * errors[i];
+  return std::sqrt(sum);
+}
+
+TH1F ShapeView::MakeTH1F(std::string const& name) const {
+  TH1F result(name.c_str(), name.c_str(), nbins, edges);
+  result.SetDirectory(0);
+  result.Sumw2();
+  for (unsigned i = 0; i <= nbins + 1; ++i) {
+    result.SetBinContent(i, contents[i]);
+    result.SetBinError(i, errors[i]);
+  }
+  result.SetEntries(entries);
+  return result;
+}
+
+ShapeCache::ShapeCache(std::string const& cache_dir) : cache_dir_(cache_dir) {}
+
+ShapeCache::~ShapeCache() {
+  for (auto & it : files_) {
+    if (it.second.block.mapped) munmap(it.second.block.data, it.second.block.size);
+  }
+}
+
+std::string ShapeCache::CachePath(std::string const& filename) const {
+  if (cache_dir_.empty()) return filename + ".shapecache";
+  std::size_t slash = filename.rfind('/');
+  std::string base = slash == std::string::npos ? filename : filename.substr(slash + 1);
+  return cache_dir_ + "/" + base + ".shapecache";
+}
+
+bool ShapeCache::Build(std::string const& filename, long long size,
+                       long long mtime, std::vector<char> & out) {
+  TDirectory::TContext context(gDirectory);
+  TFile file(filename.c_str(), "READ");
+  if (file.IsZombie()) return false;
+  std::vector<Pending> shapes;
+  std::vector<double> data;
+  Collect(&file, "", shapes, data);
+  file.Close();
+
+  std::string names = filename;
+  std::vector<Record> records(shapes.size());
+  for (unsigned i = 0; i < shapes.size(); ++i) {
+    records[i].name_offset = names.size();
+    records[i].name_length = shapes[i].path.size();
+    records[i].data_offset = shapes[i].data_offset;
+    records[i].nbins = shapes[i].nbins;
+    records[i].entries = shapes[i].entries;
+    names += shapes[i].path;
+  }
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.source_size = size;
+  header.source_mtime = mtime;
+  header.n_shapes = shapes.size();
+  header.n_doubles = data.size();
+  header.source_length = filename.size();
+
+  std::size_t names_start = NamesStart(header.n_shapes, header.n_doubles);
+  out.resize(names_start + names.size());
+  std::memcpy(&out[0], &header, sizeof(Header));
+  if (!records.empty()) {
+    std::memcpy(&out[sizeof(Header)], &records[0], records.size() * sizeof(Record));
+  }
+  if (!data.empty()) {
+    std::memcpy(&out[DataStart(header.n_shapes)], &data[0], data.size() * sizeof(double));
+  }
+  std::memcpy(&out[names_start], names.data(), names.size());
+  return true;
+}
+
+bool ShapeCache::Validate(Block const& block, std::string const& filename,
+                          long long size, long long mtime) {
+  if (block.size < sizeof(Header)) return false;
+  Header const* header = reinterpret_cast<Header const*>(block.data);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) return false;
+  if (static_cast<long long>(header->source_size) != size ||
+      header->source_mtime != mtime) {
+    return false;
+  }
+  std::size_t names_start = NamesStart(header->n_shapes, header->n_doubles);
+  if (names_start + header->source_length > block.size) return false;
+  if (std::string(block.data + names_start, header->source_length) != filename) {
+    return false;
+  }
+  Record const* records = reinterpret_cast<Record const*>(block.data + sizeof(Header));
+  for (unsigned i = 0; i < header->n_shapes; ++i) {
+    if (names_start + records[i].name_offset + records[i].name_length > block.size ||
+        records[i].data_offset + 3 * records[i].nbins + 5 > header->n_doubles) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ShapeCache::Index(Entry & entry) {
+  Header const* header = reinterpret_cast<Header const*>(entry.block.data);
+  Record const* records = reinterpret_cast<Record const*>(entry.block.data + sizeof(Header));
+  double const* data = reinterpret_cast<double const*>(entry.block.data + DataStart(header->n_shapes));
+  char const* names = entry.block.data + NamesStart(header->n_shapes, header->n_doubles);
+  entry.shapes.clear();
+  entry.dirs.clear();
+  entry.shapes.reserve(header->n_shapes);
+  for (unsigned i = 0; i < header->n_shapes; ++i) {
+    Record const& rec = records[i];
+    std::string path(names + rec.name_offset, rec.name_length);
+    ShapeView view;
+    view.nbins = rec.nbins;
+    view.entries = rec.entries;
+    view.edges = data + rec.data_offset;
+    view.contents = view.edges + rec.nbins + 1;
+    view.errors = view.contents + rec.nbins + 2;
+    entry.shapes[path] = view;
+    for (std::size_t pos = path.find('/'); pos != std::string::npos;
+         pos = path.find('/', pos + 1)) {
+      entry.dirs.insert(path.substr(0, pos));
+    }
+  }
+}
+
+bool ShapeCache::AddFile(std::string const& filename, std::string const& label) {
+  long long size = 0;
+  long long mtime = 0;
+  if (!Stat(filename, size, mtime)) {
+    std::cerr << "Error in <ShapeCache::AddFile>: File " << filename << " not found" << std::endl;
+    return false;
+  }
+  std::string key = label.empty() ? filename : label;
+  auto existing = files_.find(key);
+  if (existing != files_.end()) {
+    if (existing->second.block.mapped) {
+      munmap(existing->second.block.data, existing->second.block.size);
+    }
+    files_.erase(existing);
+  }
+
+  std::string cache_path = CachePath(filename);
+  Block block;
+  block.data = nullptr;
+  block.size = 0;
+  block.mapped = false;
+  for (unsigned attempt = 0; attempt < 2 && !block.mapped; ++attempt) {
+    int fd = open(cache_path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat info;
+      if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void * addr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+          block.data = static_cast<char *>(addr);
+          block.size = info.st_size;
+          block.mapped = true;
+          if (!Validate(block, filename, size, mtime)) {
+            munmap(addr, info.st_size);
+            block.data = nullptr;
+            block.size = 0;
+            block.mapped = false;
+          }
+        }
+      }
+      close(fd);
+    }
+    if (block.mapped || attempt > 0) break;
+
+    // Missing or out of date: read the ROOT file and write a new cache,
+    // renamed into place so that other jobs never see a partial one
+    if (!Build(filename, size, mtime, block.buffer)) {
+      std::cerr << "Error in <ShapeCache::AddFile>: File " << filename << " cannot be read" << std::endl;
+      return false;
+    }
+    std::string tmp_path = cache_path + ".tmp" + std::to_string(getpid());
+    std::ofstream out(tmp_path.c_str(), std::ios::binary);
+    out.write(&block.buffer[0], block.buffer.size());
+    out.close();
+    if (!out || std::rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+      std::cerr << "Warning in <ShapeCache::AddFile>: Unable to write " << cache_path
+                << ", keeping the index in memory" << std::endl;
+      break;
+    }
+  }
+  Entry & entry = files_[key];
+  entry.block.data = block.data;
+  entry.block.size = block.size;
+  entry.block.mapped = block.mapped;
+  if (!block.mapped) {
+    entry.block.buffer.swap(block.buffer);
+    entry.block.data = &entry.block.buffer[0];
+    entry.block.size = entry.block.buffer.size();
+  }
+  Index(entry);
+  return true;
+}
+
+ShapeView const* ShapeCache::Find(std::string const& label,
+                                  std::string const& path) const {
+  auto file = files_.find(label);
+  if (file == files_.end()) return nullptr;
+  auto it = file->second.shapes.find(path);
+  return it == file->second.shapes.end() ? nullptr : &it->second;
+}
+
+ShapeView const* ShapeCache::Find(std::string const& label,
+                                  std::string const& category,
+                                  std::string const& process,
+                                  std::string const& systematic) const {
+  std::string path = category.empty() ? process : category + "/" + process;
+  if (!systematic.empty()) path += "_" + systematic;
+  return Find(label, path);
+}
+
+bool ShapeCache::HasDirectory(std::string const& label,
+                              std::string const& dir) const {
+  auto file = files_.find(label);
+  if (file == files_.end()) return false;
+  return file->second.dirs.count(dir) > 0;
+}
+
+TH1F * ShapeCache::GetTH1F(std::string const& label,
+                           std::string const& path) const {
+  ShapeView const* view = Find(label, path);
+  if (!view) return nullptr;
+  std::size_t slash = path.rfind('/');
+  return new TH1F(view->MakeTH1F(slash == std::string::npos ? path : path.substr(slash + 1)));
+}
+}
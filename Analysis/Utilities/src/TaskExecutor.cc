@@ -0,0 +1,41 @@
+#include "Utilities/interface/TaskExecutor.h"
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <exception>
+
+namespace ic {
+
+TaskExecutor::TaskExecutor(unsigned n_threads)
+    : n_threads_(n_threads > 0 ? n_threads : 1) {}
+
+unsigned TaskExecutor::HardwareThreads() {
+  unsigned n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+void TaskExecutor::Run(std::vector<std::function<void()>> const& tasks) const {
+  std::vector<std::exception_ptr> errors(tasks.size());
+  std::atomic<unsigned> next(0);
+  auto worker = [&]() {
+    for (unsigned i = next++; i < tasks.size(); i = next++) {
+      try {
+        tasks[i]();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+  unsigned n_workers = std::min<unsigned>(n_threads_, tasks.size());
+  if (n_workers <= 1) {
+    worker();
+  } else {
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < n_workers; ++i) threads.push_back(std::thread(worker));
+    for (auto & thread : threads) thread.join();
+  }
+  for (auto const& err : errors) {
+    if (err) std::rethrow_exception(err);
+  }
+}
+}
@@ -0,0 +1,251 @@
+#include "Utilities/interface/TreeDraw.h"
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+#include "boost/algorithm/string.hpp"
+#include "boost/lexical_cast.hpp"
+#include "TROOT.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+#include "TTreeFormulaManager.h"
+
+namespace ic {
+
+namespace {
+// Open the file of a job and get its tree, with the friends attached. The
+// tree is owned by the file.
+TTree * OpenTree(TreeDrawJob const& job, std::unique_ptr<TFile> & file) {
+  file.reset(TFile::Open(job.file.c_str()));
+  if (!file || file->IsZombie()) {
+    throw std::runtime_error("[DrawTrees] Unable to open " + job.file);
+  }
+  TTree *tree = dynamic_cast<TTree*>(file->Get(job.tree.c_str()));
+  if (!tree) {
+    throw std::runtime_error("[DrawTrees] No tree " + job.tree + " in " + job.file);
+  }
+  for (auto const& fr : job.friends) {
+    tree->AddFriend(fr.first.c_str(), fr.second.c_str());
+  }
+  return tree;
+}
+}
+
+bool ParseBinnedVariable(std::string const& variable, std::string & expression,
+                         TH1F & binning) {
+  bool fixed_bins = false;
+  std::size_t begin = variable.find("[");
+  std::size_t end = variable.find("]");
+  if (begin == variable.npos || end == variable.npos) {
+    begin = variable.find_last_of("(");
+    end = variable.find_last_of(")");
+    fixed_bins = true;
+  }
+  if (begin == variable.npos || end == variable.npos || end < begin) {
+    return false;
+  }
+  std::vector<std::string> strs;
+  std::string bin_str = variable.substr(begin + 1, end - begin - 1);
+  boost::split(strs, bin_str, boost::is_any_of(","));
+  std::vector<double> bins;
+  try {
+    for (auto const& str : strs) {
+      bins.push_back(boost::lexical_cast<double>(boost::trim_copy(str)));
+    }
+  } catch (boost::bad_lexical_cast const&) {
+    // e.g. the "(x)" in "abs(x)"
+    return false;
+  }
+  if (fixed_bins && bins.size() != 3) return false;
+  if (!fixed_bins && bins.size() < 2) return false;
+  bool add_dir = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+  if (fixed_bins) {
+    binning = TH1F("htemp", "htemp", int(bins[0]), bins[1], bins[2]);
+  } else {
+    binning = TH1F("htemp", "htemp", bins.size() - 1, &(bins[0]));
+  }
+  TH1::AddDirectory(add_dir);
+  binning.Sumw2();
+  expression = variable.substr(0, begin);
+  return true;
+}
+
+TreeDrawJob::TreeDrawJob() : entrylist(nullptr), entries(0) {}
+
+std::vector<TH1F> DrawTrees(TaskExecutor const& exec,
+                            std::vector<TreeDrawJob> const& jobs,
+                            long long entries_per_task) {
+  if (exec.n_threads() > 1) ROOT::EnableThreadSafety();
+  if (entries_per_task < 1) entries_per_task = 1;
+
+  // One task per (job, entry range), in job and then entry order
+  struct Range {
+    unsigned job;
+    long long first;
+    long long entries;
+  };
+  std::vector<Range> ranges;
+  std::vector<unsigned> first_range(jobs.size());
+  for (unsigned i = 0; i < jobs.size(); ++i) {
+    first_range[i] = ranges.size();
+    for (long long first = 0; first < jobs[i].entries; first += entries_per_task) {
+      Range range = {i, first, std::min(entries_per_task, jobs[i].entries - first)};
+      ranges.push_back(range);
+    }
+  }
+
+  std::vector<TH1F> partials(ranges.size());
+  std::vector<std::function<void()>> tasks;
+  for (unsigned r = 0; r < ranges.size(); ++r) {
+    tasks.push_back([&, r]() {
+      TreeDrawJob const& job = jobs[ranges[r].job];
+      // Each task needs its own copy of the entry list, which must outlive
+      // the tree
+      std::unique_ptr<TEntryList> entrylist;
+      // TFile::Open makes the file the current directory of this thread,
+      // which is where TTree::Draw looks for the output histogram
+      std::unique_ptr<TFile> file;
+      TTree *tree = OpenTree(job, file);
+      if (job.entrylist) {
+        entrylist.reset(new TEntryList(*job.entrylist));
+        entrylist->SetDirectory(nullptr);
+        entrylist->ResetBit(kCanDelete);
+        tree->SetEntryList(entrylist.get());
+      }
+      std::string name = "hdraw_" + boost::lexical_cast<std::string>(r);
+      TH1F *hist = static_cast<TH1F*>(job.binning.Clone(name.c_str()));
+      hist->SetDirectory(file.get());
+      // With an entry list the range refers to positions in the list
+      Long64_t status = tree->Draw((job.expression + ">>" + name).c_str(),
+          job.selection.c_str(), "goff", ranges[r].entries, ranges[r].first);
+      tree->SetEntryList(nullptr);
+      if (status < 0) {
+        throw std::runtime_error("[DrawTrees] TTree::Draw of " + job.expression +
+                                 " failed for " + job.file);
+      }
+      partials[r] = *hist;
+      partials[r].SetDirectory(nullptr);
+    });
+  }
+  exec.Run(tasks);
+
+  std::vector<TH1F> result(jobs.size());
+  for (unsigned i = 0; i < jobs.size(); ++i) {
+    result[i] = jobs[i].binning;
+    result[i].SetDirectory(nullptr);
+    unsigned end = (i + 1 < jobs.size()) ? first_range[i + 1] : ranges.size();
+    for (unsigned r = first_range[i]; r < end; ++r) result[i].Add(&partials[r]);
+  }
+  return result;
+}
+
+std::vector<TH1F> DrawTreesShared(TaskExecutor const& exec,
+                                  std::vector<TreeDrawJob> const& jobs,
+                                  long long entries_per_task) {
+  if (exec.n_threads() > 1) ROOT::EnableThreadSafety();
+  if (entries_per_task < 1) entries_per_task = 1;
+
+  // Group the jobs by the tree they read
+  std::vector<std::vector<unsigned>> groups;
+  for (unsigned i = 0; i < jobs.size(); ++i) {
+    bool found = false;
+    for (auto & group : groups) {
+      TreeDrawJob const& other = jobs[group.front()];
+      if (other.file == jobs[i].file && other.tree == jobs[i].tree &&
+          other.friends == jobs[i].friends) {
+        group.push_back(i);
+        found = true;
+        break;
+      }
+    }
+    if (!found) groups.push_back(std::vector<unsigned>(1, i));
+  }
+
+  // One task per (tree, entry range), each filling one histogram per job of
+  // the tree
+  struct Range {
+    unsigned group;
+    long long first;
+    long long entries;
+  };
+  std::vector<Range> ranges;
+  for (unsigned g = 0; g < groups.size(); ++g) {
+    long long entries = jobs[groups[g].front()].entries;
+    for (long long first = 0; first < entries; first += entries_per_task) {
+      Range range = {g, first, std::min(entries_per_task, entries - first)};
+      ranges.push_back(range);
+    }
+  }
+
+  std::vector<std::vector<TH1F>> partials(ranges.size());
+  std::vector<std::function<void()>> tasks;
+  for (unsigned r = 0; r < ranges.size(); ++r) {
+    tasks.push_back([&, r]() {
+      std::vector<unsigned> const& group = groups[ranges[r].group];
+      std::unique_ptr<TFile> file;
+      TTree *tree = OpenTree(jobs[group.front()], file);
+      // As in TTree::Draw the variable and selection of a job share a
+      // manager, which fixes the number of instances to fill for arrays
+      std::vector<std::unique_ptr<TTreeFormula>> vars(group.size());
+      std::vector<std::unique_ptr<TTreeFormula>> sels(group.size());
+      std::vector<TTreeFormulaManager*> managers(group.size());
+      partials[r].resize(group.size());
+      for (unsigned k = 0; k < group.size(); ++k) {
+        TreeDrawJob const& job = jobs[group[k]];
+        std::string name = boost::lexical_cast<std::string>(k);
+        vars[k].reset(new TTreeFormula(("var_" + name).c_str(), job.expression.c_str(), tree));
+        if (vars[k]->GetNdim() == 0) {
+          throw std::runtime_error("[DrawTreesShared] Invalid expression " +
+                                   job.expression + " for " + job.file);
+        }
+        managers[k] = new TTreeFormulaManager;
+        managers[k]->Add(vars[k].get());
+        if (job.selection != "") {
+          sels[k].reset(new TTreeFormula(("sel_" + name).c_str(), job.selection.c_str(), tree));
+          if (sels[k]->GetNdim() == 0) {
+            throw std::runtime_error("[DrawTreesShared] Invalid selection " +
+                                     job.selection + " for " + job.file);
+          }
+          managers[k]->Add(sels[k].get());
+        }
+        managers[k]->Sync();
+        partials[r][k] = job.binning;
+        partials[r][k].SetDirectory(nullptr);
+      }
+      long long end = ranges[r].first + ranges[r].entries;
+      for (long long entry = ranges[r].first; entry < end; ++entry) {
+        if (tree->LoadTree(entry) < 0) break;
+        for (unsigned k = 0; k < group.size(); ++k) {
+          int ndata = managers[k]->GetNdata();
+          if (ndata < 1) continue;
+          // Instance 0 has to be evaluated first, it loads the branches
+          double value = vars[k]->EvalInstance(0);
+          double weight = sels[k] ? sels[k]->EvalInstance(0) : 1.;
+          bool multiple = sels[k] && sels[k]->GetMultiplicity();
+          if (weight == 0. && !multiple) continue;
+          for (int i = 0; i < ndata; ++i) {
+            if (i > 0) {
+              value = vars[k]->EvalInstance(i);
+              if (multiple) weight = sels[k]->EvalInstance(i);
+            }
+            if (weight != 0.) partials[r][k].Fill(value, weight * tree->GetWeight());
+          }
+        }
+      }
+    });
+  }
+  exec.Run(tasks);
+
+  std::vector<TH1F> result(jobs.size());
+  for (unsigned i = 0; i < jobs.size(); ++i) {
+    result[i] = jobs[i].binning;
+    result[i].SetDirectory(nullptr);
+  }
+  for (unsigned r = 0; r < ranges.size(); ++r) {
+    std::vector<unsigned> const& group = groups[ranges[r].group];
+    for (unsigned k = 0; k < group.size(); ++k) result[group[k]].Add(&partials[r][k]);
+  }
+  return result;
+}
+}
@@ -0,0 +1,92 @@
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightTable.h"
+#include <stdexcept>
+
+namespace ic {
+
+WeightAxis::WeightAxis()
+    : nbins_(0), xmin_(0.), xmax_(0.), uniform_(true) {}
+
+WeightAxis::WeightAxis(TAxis const* axis) {
+  nbins_ = axis->GetNbins();
+  xmin_ = axis->GetXmin();
+  xmax_ = axis->GetXmax();
+  uniform_ = (axis->GetXbins()->GetSize() == 0);
+  edges_.resize(nbins_ + 1);
+  for (int i = 0; i < nbins_; ++i) edges_[i] = axis->GetBinLowEdge(i + 1);
+  edges_[nbins_] = axis->GetBinUpEdge(nbins_);
+}
+
+WeightTableBase::WeightTableBase()
+    : policy_(overflow::flow), fixed_value_(1.0) {}
+
+WeightTableBase::WeightTableBase(overflow policy, double fixed_value)
+    : policy_(policy), fixed_value_(fixed_value) {}
+
+WeightTable1D::WeightTable1D() : WeightTableBase() {}
+
+WeightTable1D::WeightTable1D(TH1 const* hist, overflow policy,
+                             double fixed_value)
+    : WeightTableBase(policy, fixed_value) {
+  if (!hist) throw std::runtime_error("WeightTable1D: null histogram");
+  xaxis_ = WeightAxis(hist->GetXaxis());
+  contents_.resize(xaxis_.nbins() + 2);
+  for (int i = 0; i < xaxis_.nbins() + 2; ++i) {
+    contents_[i] = hist->GetBinContent(i);
+  }
+}
+
+void WeightTable1D::Evaluate(double const* x, std::size_t n,
+                             double* out) const {
+  for (std::size_t i = 0; i < n; ++i) out[i] = Evaluate(x[i]);
+}
+
+WeightTable2D::WeightTable2D() : WeightTableBase(), stride_(0) {}
+
+WeightTable2D::WeightTable2D(TH2 const* hist, overflow policy,
+                             double fixed_value)
+    : WeightTableBase(policy, fixed_value) {
+  if (!hist) throw std::runtime_error("WeightTable2D: null histogram");
+  xaxis_ = WeightAxis(hist->GetXaxis());
+  yaxis_ = WeightAxis(hist->GetYaxis());
+  stride_ = xaxis_.nbins() + 2;
+  contents_.resize(stride_ * (yaxis_.nbins() + 2));
+  for (int j = 0; j < yaxis_.nbins() + 2; ++j) {
+    for (int i = 0; i < stride_; ++i) {
+      contents_[i + stride_ * j] = hist->GetBinContent(i, j);
+    }
+  }
+}
+
+void WeightTable2D::Evaluate(double const* x, double const* y, std::size_t n,
+                             double* out) const {
+  for (std::size_t i = 0; i < n; ++i) out[i] = Evaluate(x[i], y[i]);
+}
+
+WeightTable3D::WeightTable3D() : WeightTableBase(), stride_x_(0), stride_y_(0) {}
+
+WeightTable3D::WeightTable3D(TH3 const* hist, overflow policy,
+                             double fixed_value)
+    : WeightTableBase(policy, fixed_value) {
+  if (!hist) throw std::runtime_error("WeightTable3D: null histogram");
+  xaxis_ = WeightAxis(hist->GetXaxis());
+  yaxis_ = WeightAxis(hist->GetYaxis());
+  zaxis_ = WeightAxis(hist->GetZaxis());
+  stride_x_ = xaxis_.nbins() + 2;
+  stride_y_ = yaxis_.nbins() + 2;
+  contents_.resize(stride_x_ * stride_y_ * (zaxis_.nbins() + 2));
+  for (int k = 0; k < zaxis_.nbins() + 2; ++k) {
+    for (int j = 0; j < stride_y_; ++j) {
+      for (int i = 0; i < stride_x_; ++i) {
+        contents_[i + stride_x_ * (j + stride_y_ * k)] =
+            hist->GetBinContent(i, j, k);
+      }
+    }
+  }
+}
+
+void WeightTable3D::Evaluate(double const* x, double const* y,
+                             double const* z, std::size_t n,
+                             double* out) const {
+  for (std::size_t i = 0; i < n; ++i) out[i] = Evaluate(x[i], y[i], z[i]);
+}
+}
@@ -0,0 +1,81 @@
+#include "UserCode/ICHiggsTauTau/Analysis/Utilities/interface/WeightVector.h"
+#include <algorithm>
+#include "boost/lexical_cast.hpp"
+
+namespace ic {
+
+WeightVector::WeightVector()
+    : labels_(std::make_shared<std::vector<std::string> const>()),
+      order_(std::make_shared<std::vector<unsigned> const>()),
+      slots_(std::make_shared<std::vector<int> const>()) {}
+
+WeightVector::WeightVector(std::vector<std::string> const& labels)
+    : labels_(std::make_shared<std::vector<std::string> const>(labels)),
+      values_(labels.size(), 1.0) {
+  std::vector<unsigned> order(labels.size());
+  for (unsigned i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+    return labels[a] < labels[b];
+  });
+  order_ = std::make_shared<std::vector<unsigned> const>(order);
+  std::vector<int> slots(labels.size());
+  for (unsigned i = 0; i < slots.size(); ++i) {
+    slots[i] = EventInfo::weight_slot(labels[i]);
+  }
+  slots_ = std::make_shared<std::vector<int> const>(slots);
+}
+
+std::vector<std::string> WeightVector::LabelRange(unsigned first,
+                                                  unsigned last) {
+  std::vector<std::string> labels;
+  for (unsigned i = first; i <= last; ++i) {
+    labels.push_back(boost::lexical_cast<std::string>(i));
+  }
+  return labels;
+}
+
+void WeightVector::Fill(EventInfo const* info) {
+  std::fill(values_.begin(), values_.end(), 1.0);
+  std::vector<std::string> const& labels = *labels_;
+  std::vector<unsigned> const& order = *order_;
+  std::map<std::string, double> const& wts = info->weights();
+  auto it = wts.begin();
+  for (unsigned i = 0; i < order.size() && it != wts.end(); ++i) {
+    std::string const& label = labels[order[i]];
+    while (it != wts.end() && it->first < label) ++it;
+    if (it != wts.end() && it->first == label) values_[order[i]] = it->second;
+  }
+  std::vector<int> const& slots = *slots_;
+  for (unsigned i = 0; i < slots.size(); ++i) {
+    if (slots[i] >= 0 && info->weight_defined(EventInfo::WeightSlot(slots[i]))) {
+      values_[i] = info->weight(EventInfo::WeightSlot(slots[i]));
+    }
+  }
+}
+
+void FillVariations(TH2* grid, double val, double wt, WeightVector const& wts) {
+  int binx = grid->GetXaxis()->FindBin(val);
+  unsigned n = std::min(wts.size(), unsigned(grid->GetNbinsY()));
+  bool sumw2 = grid->GetSumw2N() > 0;
+  for (unsigned i = 0; i < n; ++i) {
+    int bin = grid->GetBin(binx, i + 1);
+    double w = wt * wts[i];
+    grid->AddBinContent(bin, w);
+    if (sumw2) grid->GetSumw2()->fArray[bin] += w * w;
+  }
+  grid->SetEntries(grid->GetEntries() + n);
+}
+
+void FillVariations(std::vector<TH1*> const& hists, double val, double wt,
+                    WeightVector const& wts) {
+  if (hists.empty()) return;
+  int bin = hists[0]->GetXaxis()->FindBin(val);
+  unsigned n = std::min(wts.size(), unsigned(hists.size()));
+  for (unsigned i = 0; i < n; ++i) {
+    double w = wt * wts[i];
+    hists[i]->AddBinContent(bin, w);
+    if (hists[i]->GetSumw2N() > 0) hists[i]->GetSumw2()->fArray[bin] += w * w;
+    hists[i]->SetEntries(hists[i]->GetEntries() + 1);
+  }
+}
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <string>
+#include <set>
+#include <chrono>
+#include "boost/format.hpp"
+#include "boost/program_options.hpp"
+#include "TFile.h"
+#include "TTree.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "UserCode/ICHiggsTauTau/interface/OutputPolicy.hh"
+
+namespace po = boost::program_options;
+
+// Rewrites an ntuple with new compression and basket settings. Every object
+// in the input file is copied to the same path in the output. Trees are
+// copied entry by entry, as a fast clone would keep the original baskets.
+//
+//   RecompressNtuple --input=EventTree.root --output=EventTree_zlib.root
+//                    --compression=ZLIB --level=4 --cluster_align=50000
+
+void CopyDirectory(TDirectory *src, TDirectory *dest,
+                   ic::OutputPolicy const& policy) {
+  std::set<std::string> done;
+  TIter next(src->GetListOfKeys());
+  while (TKey *key = static_cast<TKey *>(next())) {
+    // Keys are ordered newest cycle first, so take only the first of each
+    std::string name = key->GetName();
+    if (!done.insert(name).second) continue;
+    TClass *cl = TClass::GetClass(key->GetClassName());
+    if (!cl) continue;
+    if (cl->InheritsFrom("TDirectory")) {
+      TDirectory *subdir = dest->mkdir(name.c_str(), key->GetTitle());
+      CopyDirectory(static_cast<TDirectory *>(key->ReadObj()), subdir, policy);
+    } else if (cl->InheritsFrom("TTree")) {
+      TTree *in = static_cast<TTree *>(key->ReadObj());
+      dest->cd();
+      TTree *out = in->CloneTree(0);
+      policy.Apply(out);
+      Long64_t n = in->GetEntries();
+      for (Long64_t i = 0; i < n; ++i) {
+        in->GetEntry(i);
+        out->Fill();
+        if (i + 1 == policy.optimize_after) policy.Optimize(out);
+      }
+      out->Write();
+      std::cout << boost::format("%-40s %10i entries, %8.1f -> %8.1f MB\n") %
+                       (std::string(dest->GetPath()) + "/" + name) % n %
+                       (in->GetZipBytes() / 1.E6) %
+                       (out->GetZipBytes() / 1.E6);
+      delete out;
+      delete in;
+    } else {
+      TObject *obj = key->ReadObj();
+      dest->cd();
+      obj->Write(name.c_str());
+      delete obj;
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::string input;
+  std::string output;
+  ic::OutputPolicy policy;
+  po::options_description config("Configuration");
+  config.add_options()
+    ("help,h",        "print the help message")
+    ("input",         po::value<std::string>(&input)->required())
+    ("output",        po::value<std::string>(&output)->required())
+    ("compression",   po::value<std::string>(&policy.algorithm)->default_value("ZLIB"),
+                      "LZMA, ZLIB, LZ4 or ZSTD")
+    ("level",         po::value<int>(&policy.level)->default_value(4))
+    ("basket_size",   po::value<int>(&policy.basket_size)->default_value(0),
+                      "basket size in bytes for all branches, 0 = ROOT default")
+    ("auto_flush",    po::value<long long>(&policy.auto_flush)->default_value(0),
+                      "entries per cluster (bytes if negative), 0 = ROOT default")
+    ("cluster_align", po::value<long long>(&policy.cluster_align)->default_value(0),
+                      "events per analysis job that clusters should divide")
+    ("optimize_after",po::value<unsigned>(&policy.optimize_after)->default_value(500),
+                      "call OptimizeBaskets after this many entries, 0 = never");
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(config).run(), vm);
+  if (vm.count("help")) {
+    std::cout << config << "\n";
+    return 0;
+  }
+  po::notify(vm);
+
+  TFile *in = TFile::Open(input.c_str());
+  if (!in || in->IsZombie()) {
+    std::cerr << "Unable to open " << input << "\n";
+    return 1;
+  }
+  TFile out(output.c_str(), "RECREATE");
+  policy.Apply(&out);
+
+  auto start = std::chrono::steady_clock::now();
+  CopyDirectory(in, &out, policy);
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  std::cout << boost::format("%s (%.1f MB) -> %s (%.1f MB) in %.1f s\n") %
+                   input % (in->GetSize() / 1.E6) % output %
+                   (out.GetEND() / 1.E6) % seconds;
+  out.Close();
+  in->Close();
+  return 0;
+}
@@ -1,3 +1,3 @@
 SUBDIRS 	:=
 LIB_DEPS 	:= Objects Core Utilities Modules
-LIB_EXTRA := -lCondFormatsJetMETObjects
+LIB_EXTRA :=
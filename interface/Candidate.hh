@@ -19,6 +19,19 @@ class Candidate {
   virtual ~Candidate();
   virtual void Print() const;
 
+  /**
+   * @brief Round the stored values to `bits` bits of mantissa, as MiniAOD
+   * does when packing candidates
+   *
+   * The persistent layout is unchanged, so the objects are read back as
+   * before, but the zeroed low bits make the output much smaller after
+   * compression. Here the pt, eta, phi and energy are rounded; derived
+   * classes also round their own floating-point values. The relative change
+   * of each value is at most \f$ 2^{-(bits+1)} \f$. Note that for light
+   * objects this can give a small negative mass.
+   */
+  virtual void ReducePrecision(unsigned bits);
+
   /// @name Properties
   /**@{*/
   /// Four-momentum
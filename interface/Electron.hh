@@ -32,6 +32,8 @@ class Electron : public Candidate {
   Electron();
   virtual ~Electron();
   virtual void Print() const;
+  /// Also rounds the isolation, identification and impact parameter values
+  virtual void ReducePrecision(unsigned bits);
 
   /// @name Properties
   /**@{*/
@@ -8,6 +8,8 @@ typedef char int8_t;
 
 #include <string>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "Rtypes.h"
@@ -114,11 +116,40 @@ class EventInfo {
 
   /// @name Event weights
   /**@{*/
+  /**
+   * @brief Integer handle for a weight label, obtained once per job with
+   * register_weight()
+   * @details Weights set via a slot are stored in a flat transient array
+   * instead of the persisted label maps, so setting them does not allocate.
+   * The string-based methods below transparently use the slot of any
+   * registered label, so both interfaces can be mixed freely.
+   */
+  typedef unsigned WeightSlot;
+
+  /**
+   * @brief Register `label` and return its slot, or the existing slot if the
+   * label is already registered
+   */
+  static WeightSlot register_weight(std::string const& label);
+
+  /// Return the slot for `label`, or -1 if it has not been registered
+  static int weight_slot(std::string const& label);
+
+  /// Return the label of a registered slot
+  static std::string const& weight_label(WeightSlot slot);
+
+  /// Return the number of registered weight slots
+  static unsigned n_weight_slots();
+
   /**
    * @brief Get the the value of a specific weight
    * @return The value of the weight if defined, 1.0 otherwise
    */
   inline double weight(std::string label) const {
+    int slot = weight_slot(label);
+    if (slot >= 0 && weight_defined(WeightSlot(slot))) {
+      return slot_weights_[slot];
+    }
     SDMap::const_iterator it = weights_.find(label);
     if (it != weights_.end()) {
       return it->second;
@@ -128,15 +159,52 @@ class EventInfo {
     }
   }
 
+  /// Get the value of the weight in `slot`, 1.0 if not defined
+  inline double weight(WeightSlot slot) const {
+    return weight_defined(slot) ? slot_weights_[slot] : 1.0;
+  }
+
   /**
    * @brief Check if a specific weight is defined
    * @return `true` if defined, `false` otherwise
    */
   inline bool weight_defined(std::string label) const {
+    int slot = weight_slot(label);
+    if (slot >= 0 && weight_defined(WeightSlot(slot))) return true;
     SDMap::const_iterator it = weights_.find(label);
     return it != weights_.end();
   }
 
+  /// Check if the weight in `slot` has been set for this event
+  inline bool weight_defined(WeightSlot slot) const {
+    return slot < slot_status_.size() && slot_status_[slot] != 0;
+  }
+
+  /**
+   * @brief Set the weight in `slot`, overriding any existing value
+   * @param slot The slot returned by register_weight()
+   * @param weight The weight value
+   * @param enabled Whether the weight should be enabled when calculating the total_weight()
+   */
+  inline void set_weight(WeightSlot slot, double weight,
+                         bool const& enabled = true) {
+    if (slot >= slot_status_.size()) {
+      slot_weights_.resize(slot + 1, 1.0);
+      slot_status_.resize(slot + 1, 0);
+    }
+    if (weight != weight) {
+      std::cerr << " -- weight " << weight_label(slot)
+                << " has NAN value, setting to 1..." << std::endl;
+      weight = 1.0;
+    }
+    // Replacing an enabled weight would need a division to undo, so just
+    // flag the product for recalculation instead
+    if (slot_status_[slot] == 1) slot_total_dirty_ = true;
+    slot_weights_[slot] = weight;
+    slot_status_[slot] = enabled ? 1 : 2;
+    if (enabled && !slot_total_dirty_) slot_total_ *= weight;
+  }
+
   /**
    * @brief Add a new weight, overriding any existing value with the same label
    * @param label The weight label
@@ -145,6 +213,11 @@ class EventInfo {
    */
   inline void set_weight(std::string const& label, double const& weight,
                          bool const& enabled) {
+    int slot = weight_slot(label);
+    if (slot >= 0) {
+      set_weight(WeightSlot(slot), weight, enabled);
+      return;
+    }
     if (weight != weight) {
       std::cerr << " -- weight " << label << " has NAN value, setting to 1..."
                 << std::endl;
@@ -170,17 +243,15 @@ class EventInfo {
         enabled = false;
       }
     }
-    if (weight != weight) {
-      std::cerr << " -- weight " << label << " has NAN value, setting to 1..."
-                << std::endl;
-      weights_[label] = 1.0;
-    } else {
-      weights_[label] = weight;
-    }
-    weight_status_[label] = enabled;
+    set_weight(label, weight, enabled);
   }
 
-  /// Calculate the product of all stored and enabled weights
+  /**
+   * @brief Calculate the product of all stored and enabled weights
+   * @details A label in the persisted map that has also been set through its
+   * slot, e.g. when the weights are recomputed on a skim, only counts once,
+   * with the slot value.
+   */
   inline double total_weight() const {
     SDMap::const_iterator it;
     double weight = 1.0;
@@ -189,13 +260,26 @@ class EventInfo {
       if (st_it != weight_status_.end()) {
         if (!st_it->second) continue;
       }
+      int slot = weight_slot(it->first);
+      if (slot >= 0 && weight_defined(WeightSlot(slot))) continue;
       weight = it->second * weight;
     }
-    return weight;
+    if (slot_total_dirty_) {
+      slot_total_ = 1.0;
+      for (unsigned i = 0; i < slot_status_.size(); ++i) {
+        if (slot_status_[i] == 1) slot_total_ *= slot_weights_[i];
+      }
+      slot_total_dirty_ = false;
+    }
+    return weight * slot_total_;
   }
 
   /// Return `true` if the weight with `label` is enabled, `false` otherwise
   inline bool weight_is_enabled(std::string label) {
+    int slot = weight_slot(label);
+    if (slot >= 0 && weight_defined(WeightSlot(slot))) {
+      return weight_is_enabled(WeightSlot(slot));
+    }
     if (weight_defined(label)) {
       return weight_status_[label];
     } else {
@@ -203,19 +287,72 @@ class EventInfo {
     }
   }
 
+  /// Return `true` if the weight in `slot` is defined and enabled
+  inline bool weight_is_enabled(WeightSlot slot) const {
+    return weight_defined(slot) && slot_status_[slot] == 1;
+  }
+
   /// Enable the weight with `label` in the total_weight() calculation
   inline void enable_weight(std::string label) {
+    int slot = weight_slot(label);
+    if (slot >= 0 && weight_defined(WeightSlot(slot))) {
+      enable_weight(WeightSlot(slot));
+      return;
+    }
     if (weight_defined(label)) {
       weight_status_[label] = true;
     }
   }
 
+  /// @copybrief enable_weight(std::string)
+  inline void enable_weight(WeightSlot slot) {
+    if (weight_defined(slot) && slot_status_[slot] != 1) {
+      slot_status_[slot] = 1;
+      slot_total_dirty_ = true;
+    }
+  }
+
   /// Disable the weight with `label` in the total_weight() calculation
   inline void disable_weight(std::string label) {
+    int slot = weight_slot(label);
+    if (slot >= 0 && weight_defined(WeightSlot(slot))) {
+      disable_weight(WeightSlot(slot));
+      return;
+    }
     if (weight_defined(label)) {
       weight_status_[label] = false;
     }
   }
+
+  /// @copybrief disable_weight(std::string)
+  inline void disable_weight(WeightSlot slot) {
+    if (weight_defined(slot) && slot_status_[slot] == 1) {
+      slot_status_[slot] = 2;
+      slot_total_dirty_ = true;
+    }
+  }
+
+  /**
+   * @brief Copy all weights set via slots into the persisted label maps
+   * @details Slot weights are transient, so this must be called before
+   * writing the object if they should be stored on disk.
+   */
+  void flatten_weights();
+
+  /// The persisted map of weight labels to values, ordered by label
+  inline SDMap const& weights() const { return weights_; }
+
+  /**
+   * @brief Forget all slot weights
+   * @details Slot weights are not touched when a new entry is read into this
+   * object, so code that reads EventInfo itself must call this for each
+   * entry. ic::TreeEvent does so whenever it loads an EventInfo.
+   */
+  inline void clear_slot_weights() {
+    std::fill(slot_status_.begin(), slot_status_.end(), 0);
+    slot_total_ = 1.0;
+    slot_total_dirty_ = false;
+  }
   /**@}*/
 
   /// @name Event filters
@@ -274,6 +411,10 @@ class EventInfo {
   SBMap weight_status_;
   unsigned good_vertices_;
   TBMap filters_;
+  std::vector<double> slot_weights_;  //!
+  std::vector<char> slot_status_;     //! 0: unset, 1: enabled, 2: disabled
+  mutable double slot_total_;         //!
+  mutable bool slot_total_dirty_;     //!
 
  #ifndef SKIP_CINT_DICT
  public:
@@ -23,6 +23,8 @@ class Jet : public Candidate {
   Jet();
   virtual ~Jet();
   virtual void Print() const;
+  /// Also rounds the area, JEC factors and b-tag discriminators
+  virtual void ReducePrecision(unsigned bits);
 
   /// @name Properties
   /**@{*/
@@ -0,0 +1,89 @@
+#ifndef ICHiggsTauTau_LightPFCandidate_hh
+#define ICHiggsTauTau_LightPFCandidate_hh
+#include <vector>
+#include "Rtypes.h"
+
+namespace ic {
+
+/**
+ * @brief Stores the kinematics of a PF or packed candidate in nine bytes. May
+ * be used instead of the ic::PFCandidate class to save file space, e.g. to
+ * keep the candidates around leptons for recomputing isolation.
+ *
+ * The values are stored as integers with a fixed precision:
+ *  - pt on a logarithmic scale between 10 MeV and 10 TeV, with a relative
+ *    precision of about 1E-4
+ *  - eta between -6 and 6 in steps of about 2E-4
+ *  - phi in steps of about 1E-4
+ *
+ * Values outside these ranges are clamped to the nearest end.
+ */
+class LightPFCandidate {
+ public:
+  LightPFCandidate();
+  virtual ~LightPFCandidate();
+  virtual void Print() const;
+
+  /// @name Properties
+  /**@{*/
+  /// The candidate transverse momentum
+  double pt() const;
+
+  /// The candidate pseudorapidity
+  double eta() const;
+
+  /// The candidate azimuthal angle
+  double phi() const;
+
+  /// PDG number to identify the candidate type
+  inline int pdgid() const { return pdgid_; }
+
+  /// The electric charge, from the pdgid()
+  inline int charge() const {
+    switch (pdgid_) {
+      case 211: case -11: case -13: return 1;
+      case -211: case 11: case 13: return -1;
+      default: return 0;
+    }
+  }
+
+  /// The association to the primary vertex, as given by
+  /// pat::PackedCandidate::fromPV(), zero for PF candidates
+  inline unsigned from_pv() const { return from_pv_; }
+  /**@}*/
+
+  /// @name Setters
+  /**@{*/
+  /// @copybrief pt()
+  void set_pt(double const& pt);
+
+  /// @copybrief eta()
+  void set_eta(double const& eta);
+
+  /// @copybrief phi()
+  void set_phi(double const& phi);
+
+  /// @copybrief pdgid()
+  inline void set_pdgid(int const& pdgid) { pdgid_ = pdgid; }
+
+  /// @copybrief from_pv()
+  inline void set_from_pv(unsigned const& from_pv) { from_pv_ = from_pv; }
+  /**@}*/
+
+ private:
+  UShort_t pt_;
+  Short_t eta_;
+  Short_t phi_;
+  Short_t pdgid_;
+  UChar_t from_pv_;
+
+ #ifndef SKIP_CINT_DICT
+ public:
+  ClassDef(LightPFCandidate, 1);
+ #endif
+};
+
+typedef std::vector<ic::LightPFCandidate> LightPFCandidateCollection;
+}
+/** \example plugins/ICLightPFCandidateProducer.hh */
+#endif
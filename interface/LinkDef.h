@@ -83,6 +83,9 @@
 #pragma link C++ class ic::L1TObject+;
 #pragma link C++ class std::vector<ic::L1TObject>+;
 
+#pragma link C++ class ic::LightPFCandidate+;
+#pragma link C++ class std::vector<ic::LightPFCandidate>+;
+
 #pragma link C++ class ic::EventInfo+;
 
 #pragma link C++ class mithep::TH2DAsymErr+;
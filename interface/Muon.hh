@@ -28,6 +28,8 @@ class Muon : public Candidate {
   Muon();
   virtual ~Muon();
   virtual void Print() const;
+  /// Also rounds the isolation, track quality and impact parameter values
+  virtual void ReducePrecision(unsigned bits);
 
 
   /// @name Properties
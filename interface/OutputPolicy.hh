@@ -0,0 +1,71 @@
+#ifndef ICHiggsTauTau_OutputPolicy_hh
+#define ICHiggsTauTau_OutputPolicy_hh
+#include <string>
+#include <map>
+#include "TFile.h"
+#include "TTree.h"
+
+namespace ic {
+
+/**
+ * @brief Compression and basket settings used when writing ntuple trees
+ *
+ * Shared by ICEventProducer and ICHashTreeProducer in cmsRun and by the
+ * standalone RecompressNtuple tool, so that a tree can be written or
+ * rewritten with the same settings. The defaults reproduce the previous
+ * hard-coded behaviour: LZMA at level 5, ROOT's default baskets and
+ * clusters, and a call to TTree::OptimizeBaskets after 500 entries.
+ *
+ * LZMA gives the smallest files but is slow to decompress, which makes
+ * reading the ntuples CPU-bound. ZLIB or LZ4 trade some size for much
+ * faster reads.
+ */
+struct OutputPolicy {
+  /// One of "LZMA", "ZLIB", "LZ4" or "ZSTD"
+  std::string algorithm;
+  /// Compression level from 0 (none) to 9
+  int level;
+  /// Basket size in bytes for all branches, 0 keeps ROOT's default
+  int basket_size;
+  /// Basket sizes for branches matching a name, which may contain wildcards
+  /// (e.g. "pfCandidates*" to include the sub-branches of a split object)
+  std::map<std::string, int> basket_sizes;
+  /// Entries per cluster as in TTree::SetAutoFlush (a negative value is a
+  /// size in bytes), 0 keeps ROOT's default
+  long long auto_flush;
+  /// If non-zero, the number of events each analysis job reads. The number
+  /// of entries per cluster is then chosen to divide it, so that jobs never
+  /// have to decompress a cluster they share with their neighbour.
+  long long cluster_align;
+  /// Call TTree::OptimizeBaskets after this many entries, 0 for never
+  unsigned optimize_after;
+  /// If non-zero, the candidates written through ic::StreamTree are rounded
+  /// to this many mantissa bits first (see Candidate::ReducePrecision).
+  /// This is off by default as it changes the stored values.
+  unsigned mantissa_bits;
+
+  OutputPolicy();
+
+  /// The ROOT compression settings, i.e. 100 * algorithm + level. Throws
+  /// std::runtime_error if the algorithm is unknown or not supported by
+  /// the ROOT version in use.
+  int CompressionSettings() const;
+
+  /// The value to pass to TTree::SetAutoFlush, taking cluster_align into
+  /// account
+  long long AutoFlush() const;
+
+  /// Set the default compression for branches created in `file`
+  void Apply(TFile *file) const;
+
+  /// Set the compression, basket sizes and clustering of the branches
+  /// already booked on `tree`
+  void Apply(TTree *tree) const;
+
+  /// Call TTree::OptimizeBaskets, then restore the basket sizes that were
+  /// set explicitly
+  void Optimize(TTree *tree) const;
+};
+}
+
+#endif
@@ -16,6 +16,8 @@ class PFJet : public Jet {
   PFJet();
   virtual ~PFJet();
   virtual void Print() const;
+  /// Also rounds the constituent energies, beta and the pileup ID values
+  virtual void ReducePrecision(unsigned bits);
 
   /// @name Properties
   /**@{*/
@@ -0,0 +1,50 @@
+#ifndef ICHiggsTauTau_Precision_hh
+#define ICHiggsTauTau_Precision_hh
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <map>
+
+namespace ic {
+
+/**
+ * @brief Rounds `value` to the nearest number with only `bits` significant
+ * bits in the mantissa, as MiniAOD does when packing candidates
+ *
+ * The low bits of the mantissa become zero, so the value compresses much
+ * better on disk while keeping its type. The relative precision is about
+ * \f$ 2^{-(bits+1)} \f$. Values that are not finite are returned unchanged.
+ */
+inline double ReduceMantissa(double value, unsigned bits) {
+  if (bits >= 52 || !std::isfinite(value)) return value;
+  uint64_t i;
+  std::memcpy(&i, &value, sizeof(i));
+  unsigned shift = 52 - bits;
+  // Adding half a step before masking rounds to nearest; a carry into the
+  // exponent gives the next power of two, which is correct
+  i += uint64_t(1) << (shift - 1);
+  i &= ~uint64_t(0) << shift;
+  std::memcpy(&value, &i, sizeof(i));
+  return value;
+}
+
+/// @copydoc ReduceMantissa(double, unsigned)
+inline float ReduceMantissa(float value, unsigned bits) {
+  if (bits >= 23 || !std::isfinite(value)) return value;
+  uint32_t i;
+  std::memcpy(&i, &value, sizeof(i));
+  unsigned shift = 23 - bits;
+  i += uint32_t(1) << (shift - 1);
+  i &= ~uint32_t(0) << shift;
+  std::memcpy(&value, &i, sizeof(i));
+  return value;
+}
+
+/// Reduce the precision of each value in a map
+template <class K, class V>
+inline void ReduceMantissa(std::map<K, V> & values, unsigned bits) {
+  for (auto & it : values) it.second = ReduceMantissa(it.second, bits);
+}
+}
+
+#endif
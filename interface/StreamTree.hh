@@ -0,0 +1,121 @@
+#ifndef ICHiggsTauTau_StreamTree_hh
+#define ICHiggsTauTau_StreamTree_hh
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "TTree.h"
+#include "Candidate.hh"
+
+namespace ic {
+
+/**
+ * @brief Collects the output objects of the producers on every stream so
+ *that one module can write them all to the same TTree
+ *
+ * When cmsRun runs several streams each producer has one instance, and so
+ * one output object, per stream. Every instance registers its object for
+ * its branch with Add(). The module that writes the tree calls Book() once
+ * all streams have started, which makes one branch per name with an object
+ * owned by StreamTree, and then Fill() for each event. Fill() swaps the
+ * objects of the stream that processed the event into the branches, fills
+ * the tree and swaps them back, so the branches have the same names and
+ * types as if the producers had booked them directly.
+ *
+ * Add() may be called from several threads at once. Book() and Fill() must
+ * be called from one thread at a time.
+ */
+class StreamTree {
+ public:
+  template <class T>
+  static void Add(std::string const& name, unsigned stream, T *object);
+
+  /// Create the branches, in the order their names were first added
+  static void Book(TTree *tree);
+
+  /// Fill `tree` with the objects of `stream`
+  static void Fill(TTree *tree, unsigned stream);
+
+  /// Call Candidate::ReducePrecision on every candidate in the objects of
+  /// `stream`, including those in vectors. Other types are left as they are.
+  static void ReducePrecision(unsigned stream, unsigned bits);
+
+  /// Number of branch names added so far
+  static unsigned size();
+
+ private:
+  struct BranchBase {
+    explicit BranchBase(std::string const& n) : name(n) {}
+    virtual ~BranchBase() {}
+    virtual void Book(TTree *tree) = 0;
+    virtual bool Swap(unsigned stream) = 0;
+    virtual void Reduce(unsigned stream, unsigned bits) = 0;
+    std::string name;
+  };
+
+  template <class T>
+  struct Branch : public BranchBase {
+    explicit Branch(std::string const& n) : BranchBase(n), object(new T()) {}
+    ~Branch() { delete object; }
+    void Book(TTree *tree) { tree->Branch(name.c_str(), &object); }
+    bool Swap(unsigned stream) {
+      if (stream >= streams.size() || !streams[stream]) return false;
+      using std::swap;
+      swap(*object, *streams[stream]);
+      return true;
+    }
+    void Reduce(unsigned stream, unsigned bits) {
+      if (stream < streams.size() && streams[stream]) {
+        ReduceObject(*streams[stream], bits);
+      }
+    }
+    T *object;
+    std::vector<T *> streams;
+  };
+
+  template <class T>
+  static typename std::enable_if<std::is_base_of<Candidate, T>::value>::type
+  ReduceObject(T & object, unsigned bits) {
+    object.ReducePrecision(bits);
+  }
+  template <class T>
+  static typename std::enable_if<!std::is_base_of<Candidate, T>::value>::type
+  ReduceObject(T &, unsigned) {}
+  template <class T>
+  static void ReduceObject(std::vector<T> & objects, unsigned bits) {
+    for (auto & obj : objects) ReduceObject(obj, bits);
+  }
+
+  static std::vector<std::unique_ptr<BranchBase> > branches_;
+  static std::mutex mutex_;
+};
+
+template <class T>
+void StreamTree::Add(std::string const& name, unsigned stream, T *object) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Branch<T> *branch = nullptr;
+  for (auto & b : branches_) {
+    if (b->name != name) continue;
+    branch = dynamic_cast<Branch<T> *>(b.get());
+    if (!branch) {
+      throw std::runtime_error("[StreamTree] Branch " + name +
+                               " was added with two different types");
+    }
+  }
+  if (!branch) {
+    branch = new Branch<T>(name);
+    branches_.push_back(std::unique_ptr<BranchBase>(branch));
+  }
+  if (branch->streams.size() <= stream) branch->streams.resize(stream + 1, nullptr);
+  if (branch->streams[stream]) {
+    throw std::runtime_error("[StreamTree] Branch " + name +
+                             " was added twice for the same stream");
+  }
+  branch->streams[stream] = object;
+}
+}
+
+#endif
@@ -23,6 +23,8 @@ class Tau : public Candidate {
   Tau();
   virtual ~Tau();
   virtual void Print() const;
+  /// Also rounds the tau IDs and the leading track values
+  virtual void ReducePrecision(unsigned bits);
 
 
   /// @name Properties
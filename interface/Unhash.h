@@ -3,19 +3,79 @@
 
 #include <map>
 #include <string>
+#include <vector>
+#include <utility>
+
+class TDirectory;
+class TTree;
 
 namespace ic {
 
+/**
+ * @brief Process-wide dictionary from the CityHash64 values stored in the
+ * ntuples back to the strings they were made from
+ *
+ * All strings are kept in one character arena, indexed by an open-addressing
+ * hash table. Entries are added with Add() or Hash(), or read in bulk from
+ * the HashTree written by ICHashTreeProducer with Load(). The same hash
+ * seen with two different strings, e.g. when merging the trees of several
+ * files, is a collision: the first string is kept and the pair is reported
+ * in Collisions().
+ *
+ * Every function may be called from several threads. Lookups read an
+ * immutable snapshot of the table, refreshed only after entries are added,
+ * so concurrent readers do not take a lock.
+ */
 class Unhash {
  public:
+  /// The string for `id`, or the number itself if it is unknown
   static std::string Get(std::size_t id);
+
+  /// Set `str` to the string for `id`, returning false if it is unknown
+  static bool Find(std::size_t id, std::string *str);
+
+  /// CityHash64 of `str`, which is also added to the dictionary
+  static std::size_t Hash(std::string const& str);
+
+  /// Add an entry, returning false if `id` already has a different string
+  static bool Add(std::size_t id, std::string const& str);
+
+  /// Replace the dictionary with the built-in entries and the contents of
+  /// `unhash_map`
   static void SetMap(std::map<std::size_t, std::string> const& unhash_map);
-  ~Unhash();
 
- private:
-  static std::map<std::size_t, std::string> unhash_map_;
-};
+  /// Add `str` as a built-in entry, which SetMap() and Clear() keep
+  static void AddBuiltin(std::string const& str);
+
+  /**
+   * @brief Add the entries of the HashTree at `path` in `dir`
+   * @return The number of entries read, zero if there is no such tree
+   */
+  static unsigned Load(TDirectory *dir,
+                       std::string const& path = "icHashTreeProducer/HashTree");
 
+  /// As above for a file name
+  static unsigned Load(std::string const& file,
+                       std::string const& path = "icHashTreeProducer/HashTree");
+
+  /// Fill `tree` with the dictionary, as branches "id" and "string"
+  static void Fill(TTree *tree);
+
+  /// Write the dictionary to `file` as a TTree that Load() can read back
+  static void Save(std::string const& file,
+                   std::string const& name = "HashTree");
+
+  /// All entries, ordered by hash
+  static std::vector<std::pair<std::size_t, std::string> > Entries();
+
+  /// The pairs of strings found with the same hash
+  static std::vector<std::pair<std::string, std::string> > Collisions();
+
+  static unsigned size();
+
+  /// Remove all entries except the built-in ones, and all collisions
+  static void Clear();
+};
 }
 
 #endif
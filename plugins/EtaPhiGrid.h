@@ -0,0 +1,107 @@
+#ifndef UserCode_ICHiggsTauTau_EtaPhiGrid_h
+#define UserCode_ICHiggsTauTau_EtaPhiGrid_h
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "DataFormats/Math/interface/deltaPhi.h"
+
+/**
+ * @brief Sorts a collection into a grid of eta-phi cells, so that the
+ * objects inside a cone can be found without looping over all of them
+ *
+ * Fill() places each object in its cell with a counting sort, in O(n).
+ * ForEachInCone() only visits the cells that overlap the cone. With cells
+ * about the size of the cone, finding the objects near m reference
+ * directions costs O(n + m + k) for k matches, instead of the O(n * m) of
+ * a nested loop. Objects beyond max_eta go in the outermost cells. Cells are
+ * at least kMinCellSize wide, so that a tiny cone does not need a huge table.
+ */
+class EtaPhiGrid {
+ public:
+  static constexpr double kMinCellSize = 0.05;
+
+  EtaPhiGrid(double cell_size, double max_eta)
+      : cell_size_(cell_size > kMinCellSize ? cell_size : kMinCellSize),
+        max_eta_(max_eta),
+        n_eta_(std::max(1, int(std::ceil(2. * max_eta / cell_size_)))),
+        n_phi_(std::max(1, int(2. * M_PI / cell_size_))),
+        phi_width_(2. * M_PI / n_phi_) {}
+
+  /// Sort the objects in [begin, end), which must have eta() and phi()
+  template <class It>
+  void Fill(It begin, It end) {
+    eta_.clear();
+    phi_.clear();
+    cells_.clear();
+    for (It it = begin; it != end; ++it) {
+      eta_.push_back(it->eta());
+      phi_.push_back(it->phi());
+      cells_.push_back(Cell(EtaBin(it->eta()), PhiBin(it->phi())));
+    }
+    offsets_.assign(n_eta_ * n_phi_ + 1, 0);
+    for (unsigned cell : cells_) ++offsets_[cell + 1];
+    for (unsigned c = 1; c < offsets_.size(); ++c) offsets_[c] += offsets_[c - 1];
+    indices_.resize(cells_.size());
+    std::vector<unsigned> next(offsets_.begin(), offsets_.end() - 1);
+    for (unsigned i = 0; i < cells_.size(); ++i) indices_[next[cells_[i]]++] = i;
+  }
+
+  /// Call func(i) for the index i of every object within dr of (eta, phi)
+  template <class F>
+  void ForEachInCone(double eta, double phi, double dr, F func) const {
+    double dr2 = dr * dr;
+    unsigned eta_lo = EtaBin(eta - dr);
+    unsigned eta_hi = EtaBin(eta + dr);
+    int n_dphi = int(std::ceil(dr / phi_width_));
+    int phi_c = PhiBin(phi);
+    int phi_lo = phi_c - n_dphi;
+    int phi_hi = phi_c + n_dphi;
+    // Don't visit a phi column twice when the cone wraps all the way round
+    if (phi_hi - phi_lo + 1 >= int(n_phi_)) {
+      phi_lo = 0;
+      phi_hi = n_phi_ - 1;
+    }
+    for (unsigned ie = eta_lo; ie <= eta_hi; ++ie) {
+      for (int ip = phi_lo; ip <= phi_hi; ++ip) {
+        unsigned cell = Cell(ie, (ip + n_phi_) % n_phi_);
+        for (unsigned k = offsets_[cell]; k < offsets_[cell + 1]; ++k) {
+          unsigned i = indices_[k];
+          double deta = eta_[i] - eta;
+          double dphi = reco::deltaPhi(phi_[i], phi);
+          if (deta * deta + dphi * dphi <= dr2) func(i);
+        }
+      }
+    }
+  }
+
+  /// The number of objects in the last Fill()
+  inline unsigned size() const { return cells_.size(); }
+
+ private:
+  inline unsigned EtaBin(double eta) const {
+    int bin = int(std::floor((eta + max_eta_) / cell_size_));
+    return std::min(int(n_eta_) - 1, std::max(0, bin));
+  }
+  inline unsigned PhiBin(double phi) const {
+    double x = phi + M_PI;
+    x -= 2. * M_PI * std::floor(x / (2. * M_PI));
+    return std::min(n_phi_ - 1, unsigned(x / phi_width_));
+  }
+  inline unsigned Cell(unsigned eta_bin, unsigned phi_bin) const {
+    return eta_bin * n_phi_ + phi_bin;
+  }
+
+  double cell_size_;
+  double max_eta_;
+  unsigned n_eta_;
+  unsigned n_phi_;
+  double phi_width_;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  std::vector<unsigned> cells_;
+  std::vector<unsigned> offsets_;
+  std::vector<unsigned> indices_;
+};
+
+#endif
@@ -11,7 +11,6 @@
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/L1Trigger/interface/L1MuonParticleFwd.h"
 #include "DataFormats/L1Trigger/interface/L1MuonParticle.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Candidate.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -23,6 +22,7 @@ ICCandidateFromL1MuonProducer::ICCandidateFromL1MuonProducer(const edm::Paramete
       consumes<edm::View<l1extra::L1MuonParticle>>(input_);
   candidates_ = new std::vector<ic::Candidate>();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, candidates_);
 }
 
 ICCandidateFromL1MuonProducer::~ICCandidateFromL1MuonProducer() { delete candidates_; }
@@ -47,10 +47,4 @@ void ICCandidateFromL1MuonProducer::produce(edm::Event& event,
   }
 }
 
-void ICCandidateFromL1MuonProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &candidates_);
-}
-
-void ICCandidateFromL1MuonProducer::endJob() {}
-
 DEFINE_FWK_MODULE(ICCandidateFromL1MuonProducer);
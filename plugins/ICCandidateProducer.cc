@@ -9,7 +9,6 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Candidate.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
@@ -21,6 +20,7 @@ ICCandidateProducer::ICCandidateProducer(const edm::ParameterSet& config)
   consumes<edm::View<reco::Candidate>>(input_);
   candidates_ = new std::vector<ic::Candidate>();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, candidates_);
 }
 
 ICCandidateProducer::~ICCandidateProducer() { delete candidates_; }
@@ -45,10 +45,4 @@ void ICCandidateProducer::produce(edm::Event& event,
   }
 }
 
-void ICCandidateProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &candidates_);
-}
-
-void ICCandidateProducer::endJob() {}
-
 DEFINE_FWK_MODULE(ICCandidateProducer);
@@ -13,7 +13,6 @@
 #include "DataFormats/EgammaCandidates/interface/ConversionFwd.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Vertex.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
@@ -29,6 +28,8 @@ ICConversionProducer::ICConversionProducer(const edm::ParameterSet& config)
   tracks_ = new std::vector<ic::Track>();
   PrintHeaderWithProduces(config, input_, branch_);
   PrintOptional(1, request_trks_, "saveTracks");
+  AddBranch(branch_, vertices_);
+  if (request_trks_) AddBranch(tracks_branch_, tracks_);
 }
 
 ICConversionProducer::~ICConversionProducer() { delete vertices_; }
@@ -85,12 +86,5 @@ void ICConversionProducer::produce(edm::Event& event,
   }
 }
 
-void ICConversionProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &vertices_);
-  if (request_trks_) ic::StaticTree::tree_->Branch(tracks_branch_.c_str(), &tracks_);
-}
-
-void ICConversionProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICConversionProducer);
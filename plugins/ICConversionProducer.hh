@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -17,15 +17,13 @@
 /**
  * @brief See documentation [here](\ref objs-vertex)
  */
-class ICConversionProducer : public edm::EDProducer {
+class ICConversionProducer : public ic::TreeProducer {
  public:
   explicit ICConversionProducer(const edm::ParameterSet&);
   ~ICConversionProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
-  virtual void endJob();
 
   std::vector<ic::Vertex> *vertices_;
   std::vector<ic::Track> *tracks_;
@@ -14,7 +14,6 @@
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Electron.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -88,6 +87,7 @@ ICElectronProducer::ICElectronProducer(const edm::ParameterSet& config)
   PrintOptional(1, do_conversion_matches_, "includeConversionMatches");
   PrintOptional(1, do_pf_iso_03_, "includePFIso03");
   PrintOptional(1, do_pf_iso_04_, "includePFIso04");
+  AddBranch(branch_, electrons_);
 }
 
 ICElectronProducer::~ICElectronProducer() { delete electrons_; }
@@ -255,12 +255,5 @@ void ICElectronProducer::produce(edm::Event& event,
   }
 }
 
-void ICElectronProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &electrons_);
-}
-
-void ICElectronProducer::endJob() {
-}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICElectronProducer);
@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -17,15 +17,13 @@
 /**
  * @brief See documentation [here](\ref objs-electron)
  */
-class ICElectronProducer : public edm::EDProducer {
+class ICElectronProducer : public ic::TreeProducer {
  public:
   explicit ICElectronProducer(const edm::ParameterSet &);
   ~ICElectronProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
 
   std::vector<ic::Electron> *electrons_;
   edm::InputTag input_;
@@ -23,7 +23,6 @@
 #include "SimDataFormats/GeneratorProducts/interface/LHEEventProduct.h"
 #include "SimDataFormats/GeneratorProducts/interface/GenEventInfoProduct.h"
 #include "SimDataFormats/GeneratorProducts/interface/LHERunInfoProduct.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/EventInfo.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -112,6 +111,7 @@ ICEventInfoProducer::ICEventInfoProducer(const edm::ParameterSet& config)
   PrintOptional(1, do_leptons_rho_, "includeLeptonRho");
   PrintOptional(1, do_vertex_count_, "includeVertexCount");
   PrintOptional(1, do_csc_filter_, "includeCSCFilter");
+  AddBranch(branch_, info_);
 }
 
 ICEventInfoProducer::~ICEventInfoProducer() {
@@ -297,11 +297,7 @@ void ICEventInfoProducer::produce(edm::Event& event,
    }
 }
 
-void ICEventInfoProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &info_);
-}
-
-void ICEventInfoProducer::endJob() {
+void ICEventInfoProducer::endStream() {
   if (!observed_filters_.empty()) {
     std::cout << std::string(78, '-') << "\n";
     std::cout << boost::format("%-56s  %20s\n") %
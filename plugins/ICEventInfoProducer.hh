@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -18,16 +18,15 @@
  * **Example usage**
  * @snippet python/default_producers_cfi.py EventInfo
  */
-class ICEventInfoProducer : public edm::EDProducer {
+class ICEventInfoProducer : public ic::TreeProducer {
  public:
   explicit ICEventInfoProducer(const edm::ParameterSet &);
   ~ICEventInfoProducer();
 
  private:
-  virtual void beginJob();
   virtual void endRun(edm::Run const& run, edm::EventSetup const& es);
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
+  virtual void endStream();
 
   ic::EventInfo *info_;
   std::string branch_;
@@ -1,33 +1,69 @@
 #include "UserCode/ICHiggsTauTau/plugins/ICEventProducer.hh"
 #include <memory>
 #include "TTree.h"
-#ifndef CMSSW_4_2_8_patch7
- #include "Compression.h"
-#endif
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
+#include "UserCode/ICHiggsTauTau/interface/StreamTree.hh"
+#include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
+#include "UserCode/ICHiggsTauTau/plugins/OutputPolicyConfig.h"
 
 ICEventProducer::ICEventProducer(const edm::ParameterSet& config)
-    : processed_(0) {
+    : processed_(0), booked_(false), direct_branches_(0) {
+#if CMSSW_MAJOR_VERSION >= 7
+  usesResource(TFileService::kSharedResource);
+#endif
+  PrintHeaderWithBranch(config, "EventTree");
+  policy_ = OutputPolicyFromConfig(config);
   edm::Service<TFileService> fs;
   ic::StaticTree::tree_ = fs->make<TTree>("EventTree", "EventTree");
   #ifndef CMSSW_4_2_8_patch7
-   fs->file().SetCompressionSettings(ROOT::CompressionSettings(ROOT::kLZMA, 5));
+   policy_.Apply(&(fs->file()));
   #endif
 }
 
 ICEventProducer::~ICEventProducer() {}
 
-void ICEventProducer::produce(edm::Event& /*event*/,
+void ICEventProducer::produce(edm::Event& event,
                               const edm::EventSetup& /*setup*/) {
-  ic::StaticTree::tree_->Fill();
+  unsigned stream = 0;
+#if CMSSW_MAJOR_VERSION >= 7
+  stream = event.streamID().value();
+#endif
+  // Every stream has begun by the first event, so all the stream producers
+  // have added their objects
+  if (!booked_) {
+    direct_branches_ = ic::StaticTree::tree_->GetListOfBranches()->GetEntries();
+    ic::StreamTree::Book(ic::StaticTree::tree_);
+    #ifndef CMSSW_4_2_8_patch7
+     policy_.Apply(ic::StaticTree::tree_);
+    #endif
+    booked_ = true;
+  }
+  // A branch booked directly has one object for all streams, which another
+  // stream may already have overwritten
+  if (stream > 0 && direct_branches_ > 0) {
+    throw cms::Exception("ICEventProducer")
+        << direct_branches_ << " EventTree branches were not booked through "
+        << "ic::StreamTree, so only a single stream can be used\n";
+  }
+  if (policy_.mantissa_bits > 0) {
+    ic::StreamTree::ReducePrecision(stream, policy_.mantissa_bits);
+  }
+  try {
+    ic::StreamTree::Fill(ic::StaticTree::tree_, stream);
+  } catch (std::exception const& e) {
+    throw cms::Exception("ICEventProducer") << e.what() << "\n";
+  }
   ++processed_;
-  if (processed_ == 500) ic::StaticTree::tree_->OptimizeBaskets();
+  if (processed_ == policy_.optimize_after) {
+    policy_.Optimize(ic::StaticTree::tree_);
+  }
 }
 
 void ICEventProducer::beginJob() {}
@@ -3,25 +3,49 @@
 
 #include <memory>
 #include "FWCore/Framework/interface/Frameworkfwd.h"
+#if CMSSW_MAJOR_VERSION >= 7
+#include "FWCore/Framework/interface/one/EDProducer.h"
+#else
 #include "FWCore/Framework/interface/EDProducer.h"
+#endif
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "UserCode/ICHiggsTauTau/interface/OutputPolicy.hh"
 
 /**
  * @brief Handles the creation of the ntuple output, and must always be included
  *after the other IC object producers.
  *
+ * From CMSSW 7 this is an edm::one module, so it sees one event at a time
+ * whatever the number of streams. It declares the TFileService shared
+ * resource, so that it is never run at the same time as other modules that
+ * write to the output file. For each event it writes the output
+ * objects the ic::TreeProducer modules filled on the event's stream (see
+ * ic::StreamTree). Producers that still add their branches to
+ * ic::StaticTree::tree_ directly can only be run with a single stream.
+ *
+ * The compression, basket sizes and clustering of the tree are set by the
+ * optional untracked parameters described in OutputPolicyConfig.h.
+ *
  * **Example usage**
  * @snippet python/default_producers_cfi.py Event
  */
+#if CMSSW_MAJOR_VERSION >= 7
+class ICEventProducer
+    : public edm::one::EDProducer<edm::one::SharedResources> {
+#else
 class ICEventProducer : public edm::EDProducer {
+#endif
  public:
   explicit ICEventProducer(const edm::ParameterSet&);
   ~ICEventProducer();
 
  private:
   unsigned processed_;
+  bool booked_;
+  unsigned direct_branches_;
+  ic::OutputPolicy policy_;
   virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
   virtual void endJob();
@@ -11,7 +11,6 @@
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
 #include "UserCode/ICHiggsTauTau/interface/GenJet.hh"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
@@ -31,6 +30,7 @@ ICGenJetProducer::ICGenJetProducer(const edm::ParameterSet& config)
 
   PrintHeaderWithProduces(config, input_, branch_);
   PrintOptional(1, request_gen_particles_, "requestGenParticles");
+  AddBranch(branch_, gen_jets_);
 }
 
 ICGenJetProducer::~ICGenJetProducer() { delete gen_jets_; }
@@ -85,11 +85,5 @@ void ICGenJetProducer::produce(edm::Event& event,
   if (request_gen_particles_) event.put(part_requests, "requestedGenParticles");
 }
 
-void ICGenJetProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &gen_jets_);
-}
-
-void ICGenJetProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICGenJetProducer);
@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -17,15 +17,13 @@
 /**
  * @brief See documentation [here](\ref objs-genjet)
  */
-class ICGenJetProducer : public edm::EDProducer {
+class ICGenJetProducer : public ic::TreeProducer {
  public:
   explicit ICGenJetProducer(const edm::ParameterSet&);
   ~ICGenJetProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
-  virtual void endJob();
 
   std::vector<ic::GenJet>* gen_jets_;
   edm::InputTag input_;
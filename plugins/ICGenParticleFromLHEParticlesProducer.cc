@@ -11,7 +11,6 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/GenParticle.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -27,6 +26,7 @@ ICGenParticleFromLHEParticlesProducer::ICGenParticleFromLHEParticlesProducer(con
   particles_ = new std::vector<ic::GenParticle>();
 
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, particles_);
 }
 
 ICGenParticleFromLHEParticlesProducer::~ICGenParticleFromLHEParticlesProducer() { delete particles_; }
@@ -54,12 +54,5 @@ void ICGenParticleFromLHEParticlesProducer::produce(edm::Event& event,
   }
 }
 
-void ICGenParticleFromLHEParticlesProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &particles_);
-
-}
-
-void ICGenParticleFromLHEParticlesProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICGenParticleFromLHEParticlesProducer);
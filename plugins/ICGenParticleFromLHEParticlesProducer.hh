@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -16,15 +16,13 @@
 /**
  * @brief See documentation [here](\ref objs-genparticle)
  */
-class ICGenParticleFromLHEParticlesProducer : public edm::EDProducer {
+class ICGenParticleFromLHEParticlesProducer : public ic::TreeProducer {
  public:
   explicit ICGenParticleFromLHEParticlesProducer(const edm::ParameterSet &);
   ~ICGenParticleFromLHEParticlesProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
 
   std::vector<ic::GenParticle> *particles_;
   edm::InputTag input_;
@@ -9,7 +9,6 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/GenParticle.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -32,6 +31,12 @@ ICGenParticleProducer::ICGenParticleProducer(const edm::ParameterSet& config)
   PrintOptional(1, store_mothers_, "includeMothers");
   PrintOptional(1, store_daughters_, "includeDaughters");
   PrintOptional(1, store_statusFlags_, "includeStatusFlags");
+#if !(CMSSW_MAJOR_VERSION > 7 || (CMSSW_MAJOR_VERSION == 7 && CMSSW_MINOR_VERSION >= 4))
+  if(store_statusFlags_){
+    throw cms::Exception("OptionNotSupported")<<"status flags not supported for CMSSW versions before 7_4_X\n";
+  }
+#endif
+  AddBranch(branch_, particles_);
 }
 
 ICGenParticleProducer::~ICGenParticleProducer() { delete particles_; }
@@ -90,17 +95,5 @@ void ICGenParticleProducer::produce(edm::Event& event,
   }
 }
 
-void ICGenParticleProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &particles_);
-#if !(CMSSW_MAJOR_VERSION > 7 || (CMSSW_MAJOR_VERSION == 7 && CMSSW_MINOR_VERSION >= 4))
-  if(store_statusFlags_){
-    throw cms::Exception("OptionNotSupported")<<"status flags not supported for CMSSW versions before 7_4_X\n";
-  }
-#endif
-
-}
-
-void ICGenParticleProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICGenParticleProducer);
@@ -9,7 +9,6 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 
@@ -24,6 +23,7 @@ ICGenVertexProducer::ICGenVertexProducer(const edm::ParameterSet& config)
                                                << " not supported\n";
   }
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, vertices_);
 }
 
 ICGenVertexProducer::~ICGenVertexProducer() { delete vertices_; }
@@ -63,11 +63,5 @@ void ICGenVertexProducer::produce(edm::Event& event,
   }
 }
 
-void ICGenVertexProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &vertices_);
-}
-
-void ICGenVertexProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICGenVertexProducer);
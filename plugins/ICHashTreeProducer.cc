@@ -1,25 +1,23 @@
 #include "UserCode/ICHiggsTauTau/plugins/ICHashTreeProducer.hh"
 #include <memory>
 #include "TTree.h"
-#include "Compression.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
+#include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
+#include "UserCode/ICHiggsTauTau/plugins/OutputPolicyConfig.h"
+#include "UserCode/ICHiggsTauTau/interface/Unhash.h"
 
-std::map<std::size_t, std::string> ICHashTreeProducer::unhash_map_;
-
-ICHashTreeProducer::ICHashTreeProducer(const edm::ParameterSet& config) {}
+ICHashTreeProducer::ICHashTreeProducer(const edm::ParameterSet& config) {
+  PrintHeaderWithBranch(config, "HashTree");
+  policy_ = OutputPolicyFromConfig(config);
+}
 
 ICHashTreeProducer::~ICHashTreeProducer() {}
 
-void ICHashTreeProducer::Add(std::size_t const& id, std::string const& str) {
-  unhash_map_[id] = str;
-}
-
 
 void ICHashTreeProducer::produce(edm::Event& /*event*/,
                               const edm::EventSetup& /*setup*/) {}
@@ -29,12 +27,16 @@ void ICHashTreeProducer::beginJob() {}
 void ICHashTreeProducer::endJob() {
   edm::Service<TFileService> fs;
   TTree *tree = fs->make<TTree>("HashTree", "HashTree");
-  fs->file().SetCompressionSettings(ROOT::CompressionSettings(ROOT::kLZMA, 5));
   ULong64_t id;
   std::string str;
   tree->Branch("id", &id);
   tree->Branch("string", &str);
-  for (auto const& vals : unhash_map_) {
+  // Only this tree's branches: the file settings also apply to the
+  // EventTree baskets that are still to be written
+  policy_.Apply(tree);
+  // Everything added to ic::Unhash in this job, e.g. the trigger names
+  // from ICTriggerPathProducer and ICTriggerObjectProducer
+  for (auto const& vals : ic::Unhash::Entries()) {
     id = vals.first;
     str = vals.second;
     tree->Fill();
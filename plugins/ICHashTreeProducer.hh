@@ -7,6 +7,7 @@
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "UserCode/ICHiggsTauTau/interface/OutputPolicy.hh"
 
 
 class ICHashTreeProducer : public edm::EDProducer {
@@ -14,10 +15,8 @@ class ICHashTreeProducer : public edm::EDProducer {
   explicit ICHashTreeProducer(const edm::ParameterSet&);
   ~ICHashTreeProducer();
 
-  static void Add(std::size_t const& id, std::string const& str);
-
  private:
-  static std::map<std::size_t, std::string> unhash_map_;
+  ic::OutputPolicy policy_;
   virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
   virtual void endJob();
@@ -5,7 +5,7 @@
 #include <typeinfo>
 #include "boost/functional/hash.hpp"
 #include "boost/format.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -22,7 +22,6 @@
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
 #include "UserCode/ICHiggsTauTau/plugins/ICJetSrcHelper.hh"
 #include "UserCode/ICHiggsTauTau/plugins/ICJetDestHelper.hh"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/CaloJet.hh"
 #include "UserCode/ICHiggsTauTau/interface/JPTJet.hh"
 #include "UserCode/ICHiggsTauTau/interface/PFJet.hh"
@@ -37,15 +36,13 @@
  * @tparam U The input jet type, e.g. reco::CaloJet, reco::PFJet or pat::Jet
  */
 template <class T, class U>
-class ICJetProducer : public edm::EDProducer {
+class ICJetProducer : public ic::TreeProducer {
  public:
   explicit ICJetProducer(const edm::ParameterSet &);
   ~ICJetProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
   void constructSpecific(edm::Handle<edm::View<U> > const& jets_handle,
                          edm::Event& event, const edm::EventSetup& setup);
 
@@ -77,6 +74,7 @@ ICJetProducer<T, U>::ICJetProducer(const edm::ParameterSet& config)
 
   src_.DoSetup(this);
   dest_.DoSetup(this);
+  AddBranch(branch_, jets_);
 }
 
 
@@ -442,14 +440,5 @@ void ICJetProducer<ic::PFJet, pat::Jet>::constructSpecific(
   }
 }
 
-template <class T, class U>
-void ICJetProducer<T, U>::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &jets_);
-}
-
-template <class T, class U>
-void ICJetProducer<T, U>::endJob() {
-}
-
 
 #endif
@@ -9,7 +9,6 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "DataFormats/L1Trigger/interface/L1EtMissParticle.h"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -21,6 +20,7 @@ ICL1EtMissProducer::ICL1EtMissProducer(const edm::ParameterSet& config)
   consumes<edm::View<l1extra::L1EtMissParticle>>(input_);
   candidates_ = new std::vector<ic::Candidate>();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, candidates_);
 }
 
 ICL1EtMissProducer::~ICL1EtMissProducer() { delete candidates_; }
@@ -46,10 +46,4 @@ void ICL1EtMissProducer::produce(edm::Event& event,
   }
 }
 
-void ICL1EtMissProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &candidates_);
-}
-
-void ICL1EtMissProducer::endJob() {}
-
 DEFINE_FWK_MODULE(ICL1EtMissProducer);
@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -13,15 +13,13 @@
 #include "DataFormats/L1Trigger/interface/L1EtMissParticle.h"
 #include "UserCode/ICHiggsTauTau/interface/Candidate.hh"
 
-class ICL1EtMissProducer : public edm::EDProducer {
+class ICL1EtMissProducer : public ic::TreeProducer {
  public:
   explicit ICL1EtMissProducer(const edm::ParameterSet &);
   ~ICL1EtMissProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
 
   std::vector<ic::Candidate> *candidates_;
   edm::InputTag input_;
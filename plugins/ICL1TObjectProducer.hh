@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"             
 #include "FWCore/Framework/interface/Event.h"                       
 #include "FWCore/Framework/interface/EventSetup.h"                  
@@ -14,7 +14,6 @@
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"           
 #include "UserCode/ICHiggsTauTau/interface/Candidate.hh"            
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"        
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
@@ -49,16 +48,14 @@
 
 
 template <class T>
-class ICL1TObjectProducer : public edm::EDProducer {
+class ICL1TObjectProducer : public ic::TreeProducer {
  
  public:
    explicit ICL1TObjectProducer(const edm::ParameterSet &);
    ~ICL1TObjectProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
   
   void constructSpecific(T const &src, ic::L1TObject &dest);
 
@@ -83,6 +80,7 @@ ICL1TObjectProducer<T>::ICL1TObjectProducer(const edm::ParameterSet& config)
   ic_l1t_object_ = new std::vector<ic::L1TObject>();
   PrintHeaderWithProduces(config, input_, branch_);
   m_EDToken_l1t_object = consumes< BXVector<T> >(input_);
+  AddBranch(branch_, ic_l1t_object_);
 
 }
 
@@ -203,12 +201,4 @@ void ICL1TObjectProducer<l1t::EtSum>::constructSpecific( l1t::EtSum const &src,
                 //}
 }
 
-
-template <class T>
-void ICL1TObjectProducer<T>::beginJob() {
-  ic::StaticTree::tree_->Branch( branch_.c_str(), &ic_l1t_object_ );
-}
-
-template <class T>
-void ICL1TObjectProducer<T>::endJob() {}
 #endif
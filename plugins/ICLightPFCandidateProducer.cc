@@ -0,0 +1,13 @@
+#include "UserCode/ICHiggsTauTau/plugins/ICLightPFCandidateProducer.hh"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+
+typedef ICLightPFCandidateProducer<reco::PFCandidate> ICLightPFProducer;
+DEFINE_FWK_MODULE(ICLightPFProducer);
+
+#if CMSSW_MAJOR_VERSION >= 7
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+
+typedef ICLightPFCandidateProducer<pat::PackedCandidate> ICLightPFFromPackedProducer;
+DEFINE_FWK_MODULE(ICLightPFFromPackedProducer);
+#endif
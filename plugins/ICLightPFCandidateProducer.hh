@@ -0,0 +1,136 @@
+#ifndef UserCode_ICHiggsTauTau_ICLightPFCandidateProducer_h
+#define UserCode_ICHiggsTauTau_ICLightPFCandidateProducer_h
+
+#include <memory>
+#include <vector>
+#include <string>
+#include "boost/format.hpp"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#if CMSSW_MAJOR_VERSION >= 7
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#endif
+#include "UserCode/ICHiggsTauTau/interface/LightPFCandidate.hh"
+#include "UserCode/ICHiggsTauTau/plugins/EtaPhiGrid.h"
+#include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
+#include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
+
+/**
+ * @brief Stores the PF or packed candidates within a cone around a set of
+ * reference objects (e.g. the leptons) as ic::LightPFCandidate
+ *
+ * The candidates are sorted into an EtaPhiGrid once per event, so the cost
+ * grows with the number of candidates plus the number selected rather than
+ * their product. A candidate inside several cones is stored once, and the
+ * stored candidates keep their order in the input collection.
+ *
+ * **Example usage**
+ * @snippet python/default_producers_cfi.py LightPFCandidate
+ */
+template <class T>
+class ICLightPFCandidateProducer : public ic::TreeProducer {
+ public:
+  explicit ICLightPFCandidateProducer(const edm::ParameterSet &);
+  ~ICLightPFCandidateProducer();
+
+ private:
+  virtual void produce(edm::Event &, const edm::EventSetup &);
+  unsigned FromPV(T const& src) const { return 0; }
+
+  std::vector<ic::LightPFCandidate> *cands_;
+  edm::InputTag input_;
+  std::vector<edm::InputTag> references_;
+  std::string branch_;
+  double dr_;
+  double min_pt_;
+  EtaPhiGrid grid_;
+  std::vector<char> selected_;
+};
+
+// =============================
+// Template class implementation
+// =============================
+template <class T>
+ICLightPFCandidateProducer<T>::ICLightPFCandidateProducer(
+    const edm::ParameterSet& config)
+    : input_(config.getParameter<edm::InputTag>("input")),
+      references_(config.getParameter<std::vector<edm::InputTag> >("references")),
+      branch_(config.getParameter<std::string>("branch")),
+      dr_(config.getParameter<double>("deltaR")),
+      min_pt_(config.getParameter<double>("minPt")),
+      grid_(dr_, 5.) {
+  if (!(dr_ > 0.)) {
+    throw cms::Exception("InvalidParameter")
+        << "deltaR must be positive, got " << dr_ << "\n";
+  }
+  consumes<edm::View<T>>(input_);
+  for (auto const& tag : references_) {
+    consumes<edm::View<reco::Candidate>>(tag);
+  }
+  cands_ = new std::vector<ic::LightPFCandidate>();
+  PrintHeaderWithProduces(config, input_, branch_);
+  for (auto const& tag : references_) {
+    std::cout << boost::format("%-15s : %-60s\n") % "Reference" % tag.encode();
+  }
+  std::cout << boost::format("%-15s : %-60s\n") % "DeltaR" % dr_;
+  std::cout << boost::format("%-15s : %-60s\n") % "MinPt" % min_pt_;
+  AddBranch(branch_, cands_);
+}
+
+template <class T>
+ICLightPFCandidateProducer<T>::~ICLightPFCandidateProducer() { delete cands_; }
+
+// =============
+// Main producer
+// =============
+template <class T>
+void ICLightPFCandidateProducer<T>::produce(edm::Event& event,
+                                            const edm::EventSetup& setup) {
+  edm::Handle<edm::View<T> > cands_handle;
+  event.getByLabel(input_, cands_handle);
+
+  grid_.Fill(cands_handle->begin(), cands_handle->end());
+  selected_.assign(cands_handle->size(), 0);
+  for (auto const& tag : references_) {
+    edm::Handle<edm::View<reco::Candidate> > ref_handle;
+    event.getByLabel(tag, ref_handle);
+    for (auto const& ref : *ref_handle) {
+      grid_.ForEachInCone(ref.eta(), ref.phi(), dr_,
+                          [&](unsigned i) { selected_[i] = 1; });
+    }
+  }
+
+  cands_->clear();
+  for (unsigned i = 0; i < cands_handle->size(); ++i) {
+    if (!selected_[i]) continue;
+    T const& src = cands_handle->at(i);
+    if (src.pt() < min_pt_) continue;
+    cands_->push_back(ic::LightPFCandidate());
+    ic::LightPFCandidate& dest = cands_->back();
+    dest.set_pt(src.pt());
+    dest.set_eta(src.eta());
+    dest.set_phi(src.phi());
+    dest.set_pdgid(src.pdgId());
+    dest.set_from_pv(FromPV(src));
+  }
+}
+
+// ==================
+// Specific producers
+// ==================
+#if CMSSW_MAJOR_VERSION >= 7
+template <>
+inline unsigned ICLightPFCandidateProducer<pat::PackedCandidate>::FromPV(
+    pat::PackedCandidate const& src) const {
+  return src.fromPV();
+}
+#endif
+
+#endif
@@ -10,7 +10,6 @@
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Track.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -22,6 +21,7 @@ ICLightTrackProducer::ICLightTrackProducer(const edm::ParameterSet& config)
   consumes<edm::View<reco::Track>>(input_);
   tracks_ = new std::vector<ic::LightTrack>();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, tracks_);
 }
 
 ICLightTrackProducer::~ICLightTrackProducer() { delete tracks_; }
@@ -43,11 +43,5 @@ void ICLightTrackProducer::produce(edm::Event& event, const edm::EventSetup& set
   }
 }
 
-void ICLightTrackProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &tracks_);
-}
-
-void ICLightTrackProducer::endJob() {}
-
 DEFINE_FWK_MODULE(ICLightTrackProducer);
 
@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -16,15 +16,13 @@
 /**
  * @brief See documentation [here](\ref objs-track)
  */
-class ICLightTrackProducer : public edm::EDProducer {
+class ICLightTrackProducer : public ic::TreeProducer {
  public:
   explicit ICLightTrackProducer(const edm::ParameterSet &);
   ~ICLightTrackProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
 
   std::vector<ic::LightTrack> *tracks_;
   edm::InputTag input_;
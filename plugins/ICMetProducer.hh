@@ -7,7 +7,7 @@
 #include "Math/Vector4D.h"
 #include "Math/Vector4Dfwd.h"
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -15,7 +15,6 @@
 #include "DataFormats/METReco/interface/MET.h"
 #include "DataFormats/PatCandidates/interface/MET.h"
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 #include "FWCore/Utilities/interface/Exception.h"
@@ -24,15 +23,13 @@
  * @brief See documentation [here](\ref objs-met)
  */
 template <class T>
-class ICMetProducer : public edm::EDProducer {
+class ICMetProducer : public ic::TreeProducer {
  public:
   explicit ICMetProducer(const edm::ParameterSet&);
   ~ICMetProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
-  virtual void endJob();
   void constructSpecific(edm::Handle<edm::View<T> > const& mets_handle,
                          edm::Event& event, const edm::EventSetup& setup);
   std::vector<ic::Met>* met_;
@@ -111,6 +108,7 @@ ICMetProducer<T>::ICMetProducer(const edm::ParameterSet& config)
   met_ = new std::vector<ic::Met>();
   PrintHeaderWithProduces(config, input_, branch_);
   PrintOptional(1, do_custom_id_, "includeCustomID");
+  AddBranch(branch_, met_);
 }
 
 template <>
@@ -137,6 +135,7 @@ ICMetProducer<pat::MET>::ICMetProducer(const edm::ParameterSet& config)
   PrintOptional(1, do_custom_id_, "includeCustomID");
   PrintOptional(1, do_metuncertainties_, "includeMetUncertainties");
   PrintOptional(1, do_metcorrections_, "includeMetCorrections");
+  AddBranch(branch_, met_);
 }
 
 
@@ -305,14 +304,6 @@ void ICMetProducer<pat::MET>::constructSpecific(
 
 
 
-template <class T>
-void ICMetProducer<T>::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &met_);
-}
-
-template <class T>
-void ICMetProducer<T>::endJob() {}
-
 
 
 
@@ -12,7 +12,6 @@
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Muon.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -83,6 +82,7 @@ ICMuonProducer::ICMuonProducer(const edm::ParameterSet& config)
   PrintOptional(1, do_beamspot_ip_, "includeBeamspotIP");
   PrintOptional(1, do_pf_iso_03_, "includePFIso03");
   PrintOptional(1, do_pf_iso_04_, "includePFIso04");
+  AddBranch(branch_, muons_);
 }
 
 ICMuonProducer::~ICMuonProducer() { delete muons_; }
@@ -283,10 +283,4 @@ void ICMuonProducer::produce(edm::Event& event, const edm::EventSetup& setup) {
   }
 }
 
-void ICMuonProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &muons_);
-}
-
-void ICMuonProducer::endJob() {}
-
 DEFINE_FWK_MODULE(ICMuonProducer);
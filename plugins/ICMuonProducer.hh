@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -18,15 +18,13 @@
 /**
  * @brief See documentation [here](\ref objs-muon)
  */
-class ICMuonProducer : public edm::EDProducer {
+class ICMuonProducer : public ic::TreeProducer {
  public:
   explicit ICMuonProducer(const edm::ParameterSet&);
   ~ICMuonProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
-  virtual void endJob();
 
   std::vector<ic::Muon>* muons_;
   edm::InputTag input_;
@@ -5,7 +5,7 @@
 #include <vector>
 #include "boost/functional/hash.hpp"
 #include "boost/format.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -20,7 +20,6 @@
 #include "DataFormats/RecoCandidate/interface/RecoChargedCandidate.h"
 #include "DataFormats/EgammaCandidates/interface/Conversion.h"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 
@@ -28,15 +27,13 @@
  * @brief See documentation [here](\ref objs-pf-candidate)
  */
 template <class T>
-class ICPFCandidateProducer : public edm::EDProducer {
+class ICPFCandidateProducer : public ic::TreeProducer {
  public:
   explicit ICPFCandidateProducer(const edm::ParameterSet &);
   ~ICPFCandidateProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
   void constructSpecific(edm::Handle<edm::View<T> > const& cands_handle,
                          reco::TrackRefVector* trk_requests,
                          reco::GsfTrackRefVector* gsf_trk_requests,
@@ -78,6 +75,7 @@ ICPFCandidateProducer<T>::ICPFCandidateProducer(const edm::ParameterSet& config)
   // PrintOptional(1, do_vertex_ip_, "includeVertexIP");
   PrintOptional(1, request_trks_, "requestTracks");
   PrintOptional(1, request_trks_, "requestGsfTracks");
+  AddBranch(branch_, cands_);
 }
 
 template <class T>
@@ -233,13 +231,4 @@ void ICPFCandidateProducer<pat::PackedCandidate>::constructSpecific(
 }
 #endif
 
-template <class T>
-void ICPFCandidateProducer<T>::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &cands_);
-}
-
-template <class T>
-void ICPFCandidateProducer<T>::endJob() {
-}
-
 #endif
@@ -13,7 +13,6 @@
 #include "DataFormats/PatCandidates/interface/Photon.h"
 #include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
 #include "RecoEgamma/EgammaTools/interface/ConversionTools.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 
 ICPhotonProducer::IsoTags::IsoTags(edm::ParameterSet const& pset, edm::ConsumesCollector && collector)
@@ -61,6 +60,7 @@ ICPhotonProducer::ICPhotonProducer(const edm::ParameterSet& config)
   PrintOptional(1, do_pf_iso_03_, "includePFIso03");
   PrintOptional(1, do_pf_iso_04_, "includePFIso04");
   PrintOptional(1, do_iso_from_pat_, "includeIsoFromPat");
+  AddBranch(branch_, photons_);
 }
 
 ICPhotonProducer::~ICPhotonProducer() {
@@ -207,11 +207,5 @@ void ICPhotonProducer::produce(edm::Event& event,
   }
 }
 
-void ICPhotonProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &photons_);
-}
-
-void ICPhotonProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICPhotonProducer);
@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -19,15 +19,13 @@
 /**
  * @brief See documentation [here](\ref objs-photon)
  */
-class ICPhotonProducer : public edm::EDProducer {
+class ICPhotonProducer : public ic::TreeProducer {
  public:
   explicit ICPhotonProducer(const edm::ParameterSet &);
   ~ICPhotonProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
 
   std::vector<ic::Photon> *photons_;
   edm::InputTag input_;
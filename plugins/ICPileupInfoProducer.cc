@@ -10,7 +10,6 @@
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
 #include "SimDataFormats/PileupSummaryInfo/interface/PileupSummaryInfo.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/PileupInfo.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
@@ -21,6 +20,7 @@ ICPileupInfoProducer::ICPileupInfoProducer(const edm::ParameterSet& config)
   consumes<edm::View<PileupSummaryInfo>>(input_);
   info_ = new std::vector<ic::PileupInfo>();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, info_);
 }
 
 ICPileupInfoProducer::~ICPileupInfoProducer() { delete info_; }
@@ -40,12 +40,5 @@ void ICPileupInfoProducer::produce(edm::Event& event,
   }
 }
 
-void ICPileupInfoProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &info_);
-}
-
-void ICPileupInfoProducer::endJob() {
-}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICPileupInfoProducer);
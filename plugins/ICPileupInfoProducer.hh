@@ -3,7 +3,7 @@
 #include <memory>
 #include <vector>
 #include <string>
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -13,15 +13,13 @@
 /**
  * @brief See documentation [here](\ref objs-pu-info)
  */
-class ICPileupInfoProducer : public edm::EDProducer {
+class ICPileupInfoProducer : public ic::TreeProducer {
  public:
   explicit ICPileupInfoProducer(const edm::ParameterSet&);
   ~ICPileupInfoProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
-  virtual void endJob();
 
   std::vector<ic::PileupInfo> *info_;
   edm::InputTag input_;
@@ -12,7 +12,6 @@
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/BTauReco/interface/SecondaryVertexTagInfo.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/SecondaryVertex.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -31,6 +30,7 @@ ICSecondaryVertexProducer::ICSecondaryVertexProducer(
   }
   PrintHeaderWithProduces(config, input_, branch_);
   PrintOptional(1, request_trks_, "requestTracks");
+  AddBranch(branch_, vertices_);
 }
 
 ICSecondaryVertexProducer::~ICSecondaryVertexProducer() { delete vertices_; }
@@ -71,11 +71,5 @@ void ICSecondaryVertexProducer::produce(edm::Event& event,
   event.put(trk_requests, "requestedTracks");
 }
 
-void ICSecondaryVertexProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &vertices_);
-}
-
-void ICSecondaryVertexProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICSecondaryVertexProducer);
@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -17,15 +17,13 @@
 /**
  * @brief See documentation [here](\ref objs-sec-vertex)
  */
-class ICSecondaryVertexProducer : public edm::EDProducer {
+class ICSecondaryVertexProducer : public ic::TreeProducer {
  public:
   explicit ICSecondaryVertexProducer(const edm::ParameterSet &);
   ~ICSecondaryVertexProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
 
   std::vector<ic::SecondaryVertex> *vertices_;
   edm::InputTag input_;
@@ -11,7 +11,6 @@
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/METReco/interface/MET.h"
 #include "UserCode/ICHiggsTauTau/interface/Met.hh"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
@@ -22,6 +21,7 @@ ICSingleMetProducer::ICSingleMetProducer(const edm::ParameterSet& config)
   consumes<edm::View<reco::MET>>(input_);
   met_ = new ic::Met();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, met_);
 }
 
 ICSingleMetProducer::~ICSingleMetProducer() {
@@ -52,11 +52,5 @@ void ICSingleMetProducer::produce(edm::Event& event,
   }
 }
 
-void ICSingleMetProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &met_);
-}
-
-void ICSingleMetProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICSingleMetProducer);
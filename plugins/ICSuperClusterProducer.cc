@@ -10,7 +10,6 @@
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/SuperCluster.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -24,6 +23,7 @@ ICSuperClusterProducer::ICSuperClusterProducer(const edm::ParameterSet& config)
   consumes<edm::View<reco::SuperCluster>>(input_endcap_);
   scs_ = new std::vector<ic::SuperCluster>();
   PrintHeaderWithBranch(config, branch_);
+  AddBranch(branch_, scs_);
 }
 
 ICSuperClusterProducer::~ICSuperClusterProducer() { delete scs_; }
@@ -64,11 +64,5 @@ void ICSuperClusterProducer::produce(edm::Event& event,
   }
 }
 
-void ICSuperClusterProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &scs_);
-}
-
-void ICSuperClusterProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICSuperClusterProducer);
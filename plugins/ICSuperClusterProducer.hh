@@ -5,7 +5,7 @@
 #include <vector>
 #include <string>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -20,15 +20,13 @@
  * **Example usage**
  * @snippet python/default_producers_cfi.py SuperCluster
  */
-class ICSuperClusterProducer : public edm::EDProducer {
+class ICSuperClusterProducer : public ic::TreeProducer {
  public:
   explicit ICSuperClusterProducer(const edm::ParameterSet&);
   ~ICSuperClusterProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
-  virtual void endJob();
 
   std::vector<ic::SuperCluster>* scs_;
   edm::InputTag input_barrel_;
@@ -5,7 +5,7 @@
 #include <vector>
 #include "boost/functional/hash.hpp"
 #include "boost/format.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -20,7 +20,6 @@
 #include "DataFormats/GsfTrackReco/interface/GsfTrack.h"
 #include "UserCode/ICHiggsTauTau/interface/Tau.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 
@@ -28,15 +27,14 @@
  * @brief See documentation [here](\ref objs-tau)
  */
 template <class T>
-class ICTauProducer : public edm::EDProducer {
+class ICTauProducer : public ic::TreeProducer {
  public:
   explicit ICTauProducer(const edm::ParameterSet &);
   ~ICTauProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
-  virtual void endJob();
+  virtual void endStream();
   void constructSpecific(edm::Handle<edm::View<T> > const& taus_handle,
                          edm::Event& event, const edm::EventSetup& setup);
 
@@ -107,6 +105,7 @@ ICTauProducer<T>::ICTauProducer(const edm::ParameterSet& config)
   PrintOptional(1, request_trks_, "requestTracks");
   PrintOptional(1, request_cands_, "requestPFCandidates");
   PrintOptional(1, is_slimmed_, "isSlimmed");
+  AddBranch(branch_, taus_);
 }
 
 template <class T>
@@ -310,12 +309,7 @@ void ICTauProducer<pat::Tau>::constructSpecific(
 }
 
 template <class T>
-void ICTauProducer<T>::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &taus_);
-}
-
-template <class T>
-void ICTauProducer<T>::endJob() {
+void ICTauProducer<T>::endStream() {
   std::cout << std::string(78, '-') << "\n";
   std::cout << boost::format("%-56s  %20s\n")
       % std::string("Tau Discriminators") % std::string("Hash Summmary");
@@ -10,7 +10,6 @@
 #include "DataFormats/Common/interface/View.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Track.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -22,6 +21,7 @@ ICTrackProducer::ICTrackProducer(const edm::ParameterSet& config)
   consumes<edm::View<reco::Track>>(input_);
   tracks_ = new std::vector<ic::Track>();
   PrintHeaderWithProduces(config, input_, branch_);
+  AddBranch(branch_, tracks_);
 }
 
 ICTrackProducer::~ICTrackProducer() { delete tracks_; }
@@ -60,10 +60,4 @@ void ICTrackProducer::produce(edm::Event& event, const edm::EventSetup& setup) {
   }
 }
 
-void ICTrackProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &tracks_);
-}
-
-void ICTrackProducer::endJob() {}
-
 DEFINE_FWK_MODULE(ICTrackProducer);
@@ -17,10 +17,9 @@
 #include "PhysicsTools/PatUtils/interface/TriggerHelper.h"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
 #include "UserCode/ICHiggsTauTau/interface/TriggerObject.hh"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
-#include "UserCode/ICHiggsTauTau/plugins/ICHashTreeProducer.hh"
+#include "UserCode/ICHiggsTauTau/interface/Unhash.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 
 ICTriggerObjectProducer::ICTriggerObjectProducer(
@@ -30,7 +29,8 @@ ICTriggerObjectProducer::ICTriggerObjectProducer(
       branch_(config.getParameter<std::string>("branch")),
       hlt_path_(config.getParameter<std::string>("hltPath")),
       store_only_if_fired_(config.getParameter<bool>("storeOnlyIfFired")),
-      input_is_standalone_(config.getParameter<bool>("inputIsStandAlone")) {
+      input_is_standalone_(config.getParameter<bool>("inputIsStandAlone")),
+      path_index_(-1) {
   if(!input_is_standalone_){
     consumes<pat::TriggerEvent>(input_);
   } else {
@@ -42,6 +42,7 @@ ICTriggerObjectProducer::ICTriggerObjectProducer(
   std::cout << boost::format("%-15s : %-60s\n") % "Path" % hlt_path_;
   PrintOptional(1, store_only_if_fired_, "storeOnlyIfFired");
   PrintOptional(1, input_is_standalone_, "inputIsStandAlone");
+  AddBranch(branch_, objects_);
 }
 
 ICTriggerObjectProducer::~ICTriggerObjectProducer() { delete objects_; }
@@ -58,20 +59,23 @@ void ICTriggerObjectProducer::produce(edm::Event& event,
     // Get a vector of all HLT paths
     std::vector<pat::TriggerPath> const* paths = trig_handle->paths();
 
-    // Find the full label of the chosen HLT path (i.e. with the version number)
-    bool fired = true;
-    bool path_found = false;
-    std::string full_name;
-    for (unsigned i = 0; i < paths->size(); ++i) {
-      std::string const& name = paths->at(i).name();
-      if (name.find(hlt_path_) != name.npos) {
-        full_name = name;
-        path_found = true;
-        if (store_only_if_fired_ && !(paths->at(i).wasAccept())) fired = false;
-        break;  // Stop loop after we find the first match
+    // Find the full label of the chosen HLT path (i.e. with the version
+    // number), unless it is still at the same index as in the last event
+    if (path_index_ < 0 || unsigned(path_index_) >= paths->size() ||
+        paths->at(path_index_).name() != full_name_) {
+      path_index_ = -1;
+      for (unsigned i = 0; i < paths->size(); ++i) {
+        std::string const& name = paths->at(i).name();
+        if (name.find(hlt_path_) != name.npos) {
+          full_name_ = name;
+          path_index_ = i;
+          break;  // Stop loop after we find the first match
+        }
       }
     }
-    if (!fired || !path_found) return;
+    if (path_index_ < 0) return;
+    if (store_only_if_fired_ && !(paths->at(path_index_).wasAccept())) return;
+    std::string const& full_name = full_name_;
 
     // Get a vector of the objects used in the chosen path
     pat::TriggerObjectRefVector objects =
@@ -93,8 +97,7 @@ void ICTriggerObjectProducer::produce(edm::Event& event,
       for (unsigned k = 0; k < filters.size(); ++k) {
         // Only store the filter label if the filter was used in the chosen path
         if (!trig_handle->filterInPath(filters[k], full_name, false)) continue;
-        filter_labels.push_back(CityHash64(filters[k]->label()));
-        observed_filters_[filters[k]->label()] = CityHash64(filters[k]->label());
+        filter_labels.push_back(FilterHash(filters[k]->label()));
       }
       dest.set_filters(filter_labels);
 
@@ -121,29 +124,33 @@ void ICTriggerObjectProducer::produce(edm::Event& event,
     event.getByLabel(input_trigres_, trigres_handle);
     edm::TriggerNames const& names = event.triggerNames(*trigres_handle);
 
-    bool fired = true;
-    bool path_found = false;
-    std::string full_name;
-
-    for (unsigned int i = 0, n = trigres_handle->size(); i < n; ++i) {
-      std::string const& name = names.triggerName(i);
-      // std::cout << i << "\t" << name << "\n";
-      if (name.find(hlt_path_) != name.npos) {
-        full_name = name;
-        path_found = true;
-        if (store_only_if_fired_ && !(trigres_handle->accept(i))) fired = false;
-        break;  // Stop loop after we find the first match
+    if (names.parameterSetID() != names_id_) {
+      names_id_ = names.parameterSetID();
+      path_index_ = -1;
+      full_name_.clear();
+      path_filters_.clear();
+      for (unsigned int i = 0, n = trigres_handle->size(); i < n; ++i) {
+        std::string const& name = names.triggerName(i);
+        if (name.find(hlt_path_) != name.npos) {
+          full_name_ = name;
+          path_index_ = i;
+          break;  // Stop loop after we find the first match
+        }
+      }
+      // Have to use the HLTConfigProvider to get the list of
+      // object-producing filter modules that were run in this path
+      if (path_index_ >= 0) {
+        std::vector<std::string> const& filt_vec =
+            hlt_config_.saveTagsModules(full_name_);
+        for (unsigned i = 0; i < filt_vec.size(); ++i) {
+          path_filters_[filt_vec[i]] = CityHash64(filt_vec[i]);
+        }
+        observed_filters_.insert(path_filters_.begin(), path_filters_.end());
       }
     }
-    if (!fired || !path_found) return;
-
-    // Have to use the HLTConfigProvider to get the list of object-producing
-    // filter modules that were run in this path
-    std::set<std::string> path_filters;
-    std::vector<std::string> const& filt_vec =
-        hlt_config_.saveTagsModules(full_name);
-    for (unsigned i = 0; i < filt_vec.size(); ++i)
-      path_filters.insert(filt_vec[i]);
+    if (path_index_ < 0) return;
+    if (store_only_if_fired_ && !(trigres_handle->accept(path_index_))) return;
+    std::string const& full_name = full_name_;
 
     edm::Handle<pat::TriggerObjectStandAloneCollection> trigobj_handle;
     event.getByLabel(input_, trigobj_handle);
@@ -180,9 +187,9 @@ void ICTriggerObjectProducer::produce(edm::Event& event,
       for (unsigned k = 0; k < filters.size(); ++k) {
         // Using the info we got from the HLTConfigProvider we can check if this
         // filter module was actually used in the path we are interested in
-        if (!path_filters.count(filters[k])) continue;
-        filter_labels.push_back(CityHash64(filters[k]));
-        observed_filters_[filters[k]] = CityHash64(filters[k]);
+        auto it = path_filters_.find(filters[k]);
+        if (it == path_filters_.end()) continue;
+        filter_labels.push_back(it->second);
       }
       dest.set_filters(filter_labels);
 
@@ -211,22 +218,29 @@ void ICTriggerObjectProducer::beginRun(edm::Run const& run,
     if (!res)
       throw std::runtime_error(
           "HLTConfigProvider did not initialise correctly");
+    // The filters of the path may change with the menu
+    if (changed) names_id_ = edm::ParameterSetID();
   }
 }
 
-
-void ICTriggerObjectProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &objects_);
+std::size_t ICTriggerObjectProducer::FilterHash(std::string const& label) {
+  auto it = filter_hashes_.find(label);
+  if (it == filter_hashes_.end()) {
+    it = filter_hashes_.emplace(label, CityHash64(label)).first;
+    observed_filters_.insert(*it);
+  }
+  return it->second;
 }
 
-void ICTriggerObjectProducer::endJob() {
+
+void ICTriggerObjectProducer::endStream() {
   std::cout << std::string(78, '-') << "\n";
   std::cout << boost::format("Path: %-50s  %20s\n")
       % hlt_path_ % std::string("Hash Summmary");
   std::map<std::string, std::size_t>::const_iterator iter;
   for (iter = observed_filters_.begin(); iter != observed_filters_.end();
        ++iter) {
-    ICHashTreeProducer::Add(iter->second, iter->first);
+    ic::Unhash::Add(iter->second, iter->first);
     std::cout << boost::format("%-56s| %020i\n") % iter->first % iter->second;
   }
 }
@@ -2,12 +2,14 @@
 #define UserCode_ICHiggsTauTau_ICTriggerObjectProducer_h
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <cstdint>
 #include "boost/functional/hash.hpp"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DataFormats/Provenance/interface/ParameterSetID.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Utilities/interface/InputTag.h"
@@ -18,16 +20,15 @@
 /**
  * @brief See documentation [here](\ref objs-trig-obj)
  */
-class ICTriggerObjectProducer : public edm::EDProducer {
+class ICTriggerObjectProducer : public ic::TreeProducer {
  public:
   explicit ICTriggerObjectProducer(const edm::ParameterSet&);
   ~ICTriggerObjectProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event&, const edm::EventSetup&);
   virtual void beginRun(edm::Run const& run, edm::EventSetup const& es);
-  virtual void endJob();
+  virtual void endStream();
 
   std::vector<ic::TriggerObject>* objects_;
   edm::InputTag input_;
@@ -39,6 +40,19 @@ class ICTriggerObjectProducer : public edm::EDProducer {
   std::map<std::string, std::size_t> observed_filters_;
   HLTConfigProvider hlt_config_;
 
+  std::size_t FilterHash(std::string const& label);
+
+  // The trigger index and full name of hlt_path_, found again only when the
+  // trigger names change: in MiniAOD this is keyed on the ParameterSetID of
+  // the edm::TriggerNames, otherwise the name at path_index_ is checked
+  int path_index_;
+  std::string full_name_;
+  edm::ParameterSetID names_id_;
+  // Hashes of the filter labels seen so far and, in MiniAOD, of the
+  // object-producing filters in the path (all of which go in the summary)
+  std::unordered_map<std::string, std::size_t> filter_hashes_;
+  std::unordered_map<std::string, std::size_t> path_filters_;
+
   union ui64 {
     uint64_t one;
     int16_t four[4];
@@ -16,10 +16,9 @@
 #include "DataFormats/PatCandidates/interface/TriggerEvent.h"
 #include "PhysicsTools/PatUtils/interface/TriggerHelper.h"
 #include "UserCode/ICHiggsTauTau/interface/TriggerPath.hh"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
-#include "UserCode/ICHiggsTauTau/plugins/ICHashTreeProducer.hh"
+#include "UserCode/ICHiggsTauTau/interface/Unhash.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 
 #if CMSSW_MAJOR_VERSION >= 7
@@ -64,6 +63,7 @@ ICTriggerPathProducer::ICTriggerPathProducer(const edm::ParameterSet& config)
   PrintOptional(1, save_strings_, "saveStrings");
   PrintOptional(1, split_version_, "splitVersion");
   PrintOptional(1, input_is_standalone_, "inputIsStandAlone");
+  AddBranch(branch_, paths_);
 }
 
 ICTriggerPathProducer::~ICTriggerPathProducer() { delete paths_; }
@@ -76,6 +76,14 @@ void ICTriggerPathProducer::produce(edm::Event& event,
     edm::Handle<pat::TriggerEvent> trig_handle;
     event.getByLabel(input_, trig_handle);
     std::vector<pat::TriggerPath> const* paths = trig_handle->paths();
+    if (trig_handle->nameHltTable() != hlt_table_ ||
+        paths->size() != path_info_.size()) {
+      hlt_table_ = trig_handle->nameHltTable();
+      path_info_.clear();
+      for (unsigned i = 0; i < paths->size(); ++i) {
+        path_info_.push_back(MakePathInfo(paths->at(i).name()));
+      }
+    }
     paths_->reserve(paths->size());
     for (unsigned i = 0; i < paths->size(); ++i) {
       pat::TriggerPath const& src = paths->at(i);
@@ -84,8 +92,7 @@ void ICTriggerPathProducer::produce(edm::Event& event,
       ic::TriggerPath & dest = paths_->back();
       dest.set_accept(src.wasAccept());
       dest.set_prescale(src.prescale());
-      std::string name = src.name();
-      SetNameInfo(name, &dest);
+      SetNameInfo(path_info_[i], &dest);
     }
   } else {  // i.e. MiniAOD
     edm::Handle<edm::TriggerResults> trigres_handle;
@@ -104,6 +111,13 @@ void ICTriggerPathProducer::produce(edm::Event& event,
 #endif
 
     edm::TriggerNames const& names = event.triggerNames(*trigres_handle);
+    if (names.parameterSetID() != names_id_) {
+      names_id_ = names.parameterSetID();
+      path_info_.clear();
+      for (unsigned i = 0; i < names.size(); ++i) {
+        path_info_.push_back(MakePathInfo(names.triggerName(i)));
+      }
+    }
     paths_->reserve(trigres_handle->size());
     for (unsigned int i = 0, n = trigres_handle->size(); i < n; ++i) {
       if (!trigres_handle->accept(i) && include_if_fired_) continue;
@@ -125,14 +139,16 @@ void ICTriggerPathProducer::produce(edm::Event& event,
 #else
       dest.set_prescale(0);
 #endif
-      std::string name = names.triggerName(i);
-      SetNameInfo(name, &dest);
+      SetNameInfo(path_info_[i], &dest);
     }
   }
 }
 
-void ICTriggerPathProducer::SetNameInfo(std::string name,
-                                        ic::TriggerPath* path) {
+ICTriggerPathProducer::PathInfo ICTriggerPathProducer::MakePathInfo(
+    std::string name) {
+  PathInfo info;
+  info.version = 0;
+  info.has_version = false;
   if (split_version_) {
     std::size_t v_pos = name.find_last_of('v');
     if (v_pos != std::string::npos) {
@@ -141,21 +157,24 @@ void ICTriggerPathProducer::SetNameInfo(std::string name,
       try {
         unsigned v = boost::lexical_cast<unsigned>(post_v);
         name = pre_v;
-        path->set_version(v);
+        info.version = v;
+        info.has_version = true;
       }
       catch(boost::bad_lexical_cast const& e) {
       }
     }
   }
-  std::size_t hash = CityHash64(name);
-  if (save_strings_) {
-    path->set_name(name);
-  } else {
-    if (!observed_paths_.count(name)) {
-      observed_paths_[name] = hash;
-    }
-  }
-  path->set_id(hash);
+  info.name = name;
+  info.hash = CityHash64(name);
+  if (!save_strings_) observed_paths_[name] = info.hash;
+  return info;
+}
+
+void ICTriggerPathProducer::SetNameInfo(PathInfo const& info,
+                                        ic::TriggerPath* path) {
+  if (info.has_version) path->set_version(info.version);
+  if (save_strings_) path->set_name(info.name);
+  path->set_id(info.hash);
 }
 
 void ICTriggerPathProducer::beginRun(edm::Run const& run,
@@ -167,11 +186,7 @@ void ICTriggerPathProducer::beginRun(edm::Run const& run,
         "HLTConfigProvider did not initialise correctly");
 }
 
-void ICTriggerPathProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &paths_);
-}
-
-void ICTriggerPathProducer::endJob() {
+void ICTriggerPathProducer::endStream() {
   // If the trigger path strings were not saved print a summary
   // of the string hashes
   if (!save_strings_) {
@@ -181,7 +196,7 @@ void ICTriggerPathProducer::endJob() {
     std::map<std::string, std::size_t>::const_iterator iter;
     for (iter = observed_paths_.begin(); iter != observed_paths_.end();
          ++iter) {
-      ICHashTreeProducer::Add(iter->second, iter->first);
+      ic::Unhash::Add(iter->second, iter->first);
       std::cout << boost::format("%-56s| %020i\n") % iter->first % iter->second;
     }
   }
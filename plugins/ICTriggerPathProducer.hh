@@ -2,29 +2,40 @@
 #define UserCode_ICHiggsTauTau_ICTriggerPathProducer_h
 
 #include <memory>
+#include <string>
+#include <vector>
+#include <map>
 #include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/EDProducer.h"
+#include "UserCode/ICHiggsTauTau/plugins/TreeProducer.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DataFormats/Provenance/interface/ParameterSetID.h"
 #include "UserCode/ICHiggsTauTau/interface/TriggerPath.hh"
 #include "HLTrigger/HLTcore/interface/HLTConfigProvider.h"
 
 /**
  * @brief See documentation [here](\ref objs-trig-path)
  */
-class ICTriggerPathProducer : public edm::EDProducer {
+class ICTriggerPathProducer : public ic::TreeProducer {
  public:
   explicit ICTriggerPathProducer(const edm::ParameterSet &);
   ~ICTriggerPathProducer();
 
  private:
-  virtual void beginJob();
   virtual void produce(edm::Event &, const edm::EventSetup &);
   virtual void beginRun(edm::Run const& run, edm::EventSetup const& es);
-  virtual void endJob();
+  virtual void endStream();
 
-  void SetNameInfo(std::string name, ic::TriggerPath *path);
+  // Everything about a path that only depends on its name
+  struct PathInfo {
+    std::string name;
+    std::size_t hash;
+    unsigned version;
+    bool has_version;
+  };
+  PathInfo MakePathInfo(std::string name);
+  void SetNameInfo(PathInfo const& info, ic::TriggerPath *path);
 
   std::vector<ic::TriggerPath> *paths_;
   edm::InputTag input_;
@@ -38,6 +49,13 @@ class ICTriggerPathProducer : public edm::EDProducer {
   bool prescale_fallback_;
   std::map<std::string, std::size_t> observed_paths_;
 
+  // PathInfo for each trigger index, rebuilt only when the trigger names
+  // change: in MiniAOD this is keyed on the ParameterSetID of the
+  // edm::TriggerNames, otherwise on the HLT table name and number of paths
+  std::vector<PathInfo> path_info_;
+  edm::ParameterSetID names_id_;
+  std::string hlt_table_;
+
   HLTConfigProvider hlt_config_;
 };
 
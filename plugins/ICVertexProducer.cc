@@ -13,7 +13,6 @@
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
-#include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/interface/Vertex.hh"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
@@ -33,6 +32,7 @@ ICVertexProducer::ICVertexProducer(const edm::ParameterSet& config)
   PrintHeaderWithProduces(config, input_, branch_);
   PrintOptional(1, first_only_, "firstVertexOnly");
   PrintOptional(1, request_trks_, "requestTracks");
+  AddBranch(branch_, vertices_);
 }
 
 ICVertexProducer::~ICVertexProducer() { delete vertices_; }
@@ -75,11 +75,5 @@ void ICVertexProducer::produce(edm::Event& event,
   if (request_trks_) event.put(trk_requests, "requestedTracks");
 }
 
-void ICVertexProducer::beginJob() {
-  ic::StaticTree::tree_->Branch(branch_.c_str(), &vertices_);
-}
-
-void ICVertexProducer::endJob() {}
-
 // define this as a plug-in
 DEFINE_FWK_MODULE(ICVertexProducer);
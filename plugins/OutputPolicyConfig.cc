@@ -0,0 +1,55 @@
+#include "UserCode/ICHiggsTauTau/plugins/OutputPolicyConfig.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include "boost/format.hpp"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "UserCode/ICHiggsTauTau/interface/OutputPolicy.hh"
+
+ic::OutputPolicy OutputPolicyFromConfig(edm::ParameterSet const& config) {
+  ic::OutputPolicy policy;
+  policy.algorithm = config.getUntrackedParameter<std::string>(
+      "compression", policy.algorithm);
+  policy.level =
+      config.getUntrackedParameter<int>("compressionLevel", policy.level);
+  policy.basket_size =
+      config.getUntrackedParameter<int>("basketSize", policy.basket_size);
+  // The branch names may contain wildcards, which are not allowed in
+  // parameter names, so each one is given as a PSet(branch, size)
+  std::vector<edm::ParameterSet> sizes =
+      config.getUntrackedParameter<std::vector<edm::ParameterSet>>(
+          "basketSizes", std::vector<edm::ParameterSet>());
+  for (auto const& size : sizes) {
+    policy.basket_sizes[size.getUntrackedParameter<std::string>("branch")] =
+        size.getUntrackedParameter<int>("size");
+  }
+  policy.auto_flush =
+      config.getUntrackedParameter<long long>("autoFlush", policy.auto_flush);
+  policy.cluster_align = config.getUntrackedParameter<long long>(
+      "clusterAlign", policy.cluster_align);
+  policy.optimize_after = config.getUntrackedParameter<unsigned>(
+      "optimizeAfter", policy.optimize_after);
+  policy.mantissa_bits = config.getUntrackedParameter<unsigned>(
+      "mantissaBits", policy.mantissa_bits);
+
+  std::cout << boost::format("%-15s : %-60s\n") % "Compression" %
+                   (boost::format("%s level %i (%i)") % policy.algorithm %
+                    policy.level % policy.CompressionSettings());
+  if (policy.basket_size > 0) {
+    std::cout << boost::format("%-15s : %-60s\n") % "Basket size" %
+                     policy.basket_size;
+  }
+  for (auto const& it : policy.basket_sizes) {
+    std::cout << boost::format("%-15s : %-60s\n") % "Basket size" %
+                     (boost::format("%s %i") % it.first % it.second);
+  }
+  if (policy.AutoFlush() != 0) {
+    std::cout << boost::format("%-15s : %-60s\n") % "Auto flush" %
+                     policy.AutoFlush();
+  }
+  if (policy.mantissa_bits > 0) {
+    std::cout << boost::format("%-15s : %-60s\n") % "Mantissa bits" %
+                     policy.mantissa_bits;
+  }
+  return policy;
+}
@@ -0,0 +1,25 @@
+#ifndef UserCode_ICHiggsTauTau_OutputPolicyConfig_h
+#define UserCode_ICHiggsTauTau_OutputPolicyConfig_h
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "UserCode/ICHiggsTauTau/interface/OutputPolicy.hh"
+
+/**
+ * Build an ic::OutputPolicy from the untracked parameters of a module:
+ *
+ *     compression      = cms.untracked.string("LZMA"),
+ *     compressionLevel = cms.untracked.int32(5),
+ *     basketSize       = cms.untracked.int32(0),
+ *     basketSizes      = cms.untracked.VPSet(
+ *       cms.PSet(branch = cms.untracked.string("pfCandidates*"),
+ *                size   = cms.untracked.int32(...))),
+ *     autoFlush        = cms.untracked.int64(0),
+ *     clusterAlign     = cms.untracked.int64(0),
+ *     optimizeAfter    = cms.untracked.uint32(500)
+ *
+ * Any that are missing take the ic::OutputPolicy defaults. The settings are
+ * printed below the module header.
+ */
+ic::OutputPolicy OutputPolicyFromConfig(edm::ParameterSet const& config);
+
+#endif
@@ -9,11 +9,13 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "DataFormats/Math/interface/deltaR.h"
 #include "UserCode/ICHiggsTauTau/interface/city.h"
 #include "UserCode/ICHiggsTauTau/interface/StaticTree.hh"
 #include "UserCode/ICHiggsTauTau/plugins/PrintConfigTools.h"
+#include "UserCode/ICHiggsTauTau/plugins/EtaPhiGrid.h"
 #include "UserCode/ICHiggsTauTau/plugins/Consumes.h"
 
 template <class T>
@@ -30,6 +32,8 @@ class RequestByDeltaR : public edm::EDProducer {
   edm::InputTag input_;
   edm::InputTag reference_;
   double dr_;
+  EtaPhiGrid grid_;
+  std::vector<char> selected_;
 
   typedef std::vector<T> Vec;
   typedef edm::RefVector<Vec> RefVectorVec;
@@ -43,7 +47,12 @@ template <class T>
 RequestByDeltaR<T>::RequestByDeltaR(const edm::ParameterSet& config)
     : input_(config.getParameter<edm::InputTag>("src")),
       reference_(config.getParameter<edm::InputTag>("reference")),
-      dr_(config.getParameter<double>("deltaR")) {
+      dr_(config.getParameter<double>("deltaR")),
+      grid_(dr_, 5.) {
+  if (!(dr_ > 0.)) {
+    throw cms::Exception("InvalidParameter")
+        << "deltaR must be positive, got " << dr_ << "\n";
+  }
   consumes<edm::View<T> >(input_);
   consumes<edm::View<reco::Candidate> >(reference_);
   produces<RefVectorVec>();
@@ -70,14 +79,18 @@ void RequestByDeltaR<T>::produce(edm::Event& event,
 
   std::auto_ptr<RefVectorVec> product(new RefVectorVec());
 
+  // Mark the inputs near each reference, then request them in their
+  // original order
+  grid_.Fill(in_handle->begin(), in_handle->end());
+  selected_.assign(in_handle->size(), 0);
+  for (unsigned j = 0; j < ref_handle->size(); ++j) {
+    reco::Candidate const& ref = ref_handle->at(j);
+    grid_.ForEachInCone(ref.eta(), ref.phi(), dr_,
+                        [&](unsigned i) { selected_[i] = 1; });
+  }
   for (unsigned i = 0; i < in_handle->size(); ++i) {
-    for (unsigned j = 0; j < ref_handle->size(); ++j) {
-      double dr = reco::deltaR(in_handle->at(i), ref_handle->at(j));
-      if (dr <= dr_) {
-        product->push_back(in_handle->refAt(i).template castTo<RefVec>());
-        break;
-      }
-    }
+    if (!selected_[i]) continue;
+    product->push_back(in_handle->refAt(i).template castTo<RefVec>());
   }
   event.put(product);
 }
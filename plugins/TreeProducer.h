@@ -0,0 +1,67 @@
+#ifndef UserCode_ICHiggsTauTau_TreeProducer_h
+#define UserCode_ICHiggsTauTau_TreeProducer_h
+#include <string>
+#include <vector>
+#include <functional>
+#if CMSSW_MAJOR_VERSION >= 7
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#else
+#include "FWCore/Framework/interface/EDProducer.h"
+#endif
+#include "UserCode/ICHiggsTauTau/interface/StreamTree.hh"
+
+namespace ic {
+
+/**
+ * @brief Base class of the producers that write a branch of the EventTree
+ *
+ * From CMSSW 7 this is an edm::stream::EDProducer: cmsRun makes one instance
+ * per stream and runs the streams concurrently. Each instance passes its
+ * output objects to AddBranch() in its constructor, and they are given to
+ * ic::StreamTree along with the stream index when the stream begins.
+ * ICEventProducer then writes the objects of each event's stream to the
+ * tree. The producers must therefore come before ICEventProducer on the same
+ * path, as before.
+ *
+ * Before CMSSW 7 this is a legacy edm::EDProducer on a single stream 0.
+ * Summaries that used to be printed in endJob() go in endStream(), which is
+ * called once per instance in both cases.
+ */
+#if CMSSW_MAJOR_VERSION >= 7
+class TreeProducer : public edm::stream::EDProducer<> {
+#else
+class TreeProducer : public edm::EDProducer {
+#endif
+ public:
+  inline unsigned stream() const { return stream_; }
+
+ protected:
+  TreeProducer() : stream_(0) {}
+
+  template <class T>
+  void AddBranch(std::string const& name, T *object) {
+    branches_.push_back([name, object](unsigned stream) {
+      StreamTree::Add(name, stream, object);
+    });
+  }
+
+#if CMSSW_MAJOR_VERSION >= 7
+  virtual void beginStream(edm::StreamID id) { Register(id.value()); }
+#else
+  virtual void beginJob() { Register(0); }
+  virtual void endJob() { endStream(); }
+  virtual void endStream() {}
+#endif
+
+ private:
+  void Register(unsigned stream) {
+    stream_ = stream;
+    for (auto const& add : branches_) add(stream);
+  }
+
+  unsigned stream_;
+  std::vector<std::function<void(unsigned)> > branches_;
+};
+}
+
+#endif
@@ -25,6 +25,21 @@ icPFFromPackedProducer = cms.EDProducer('ICPFFromPackedProducer',
 )
 ## [PFCandidate]
 
+## [LightPFCandidate]
+icLightPFFromPackedProducer = cms.EDProducer('ICLightPFFromPackedProducer',
+  branch              = cms.string("lightPFCandidates"),
+  input               = cms.InputTag("packedPFCandidates", "", "PAT"),
+  # Candidates within deltaR of any object in these collections are stored
+  references          = cms.VInputTag(
+    cms.InputTag("slimmedElectrons"),
+    cms.InputTag("slimmedMuons"),
+    cms.InputTag("slimmedTaus")
+  ),
+  deltaR              = cms.double(0.5),
+  minPt               = cms.double(0.0)
+)
+## [LightPFCandidate]
+
 ## [Electron]
 icElectronProducer = cms.EDProducer('ICElectronProducer',
     branch                    = cms.string("electrons"),
@@ -565,6 +580,27 @@ icEventInfoProducer = cms.EDProducer('ICEventInfoProducer',
 ## [EventInfo]
 
 ## [Event]
-icEventProducer = cms.EDProducer('ICEventProducer')
+icEventProducer = cms.EDProducer('ICEventProducer',
+  # Output settings, all optional. LZMA gives the smallest files, but ZLIB
+  # or LZ4 are much faster to read back.
+  compression       = cms.untracked.string("LZMA"),
+  compressionLevel  = cms.untracked.int32(5),
+  # Basket size in bytes for every branch, 0 = ROOT default, and for the
+  # branches matching a name, e.g. for a split object:
+  #   cms.PSet(branch = cms.untracked.string("pfCandidates*"),
+  #            size   = cms.untracked.int32(256000))
+  basketSize        = cms.untracked.int32(0),
+  basketSizes       = cms.untracked.VPSet(),
+  # Entries per cluster (bytes if negative), 0 = ROOT default
+  autoFlush         = cms.untracked.int64(0),
+  # Events per analysis job: clusters are chosen to divide it, 0 = off
+  clusterAlign      = cms.untracked.int64(0),
+  # Call OptimizeBaskets after this many events, 0 = never
+  optimizeAfter     = cms.untracked.uint32(500),
+  # Round the floating-point values of the candidates to this many mantissa
+  # bits before writing, as MiniAOD does, 0 = off. 10 bits keeps a relative
+  # precision of 0.05%, and the files get much smaller after compression.
+  mantissaBits      = cms.untracked.uint32(0)
+)
 ## [Event]
 
@@ -1,4 +1,5 @@
 #include "../interface/Candidate.hh"
+#include "../interface/Precision.hh"
 
 namespace ic {
 // Constructors/Destructors
@@ -10,4 +11,11 @@ void Candidate::Print() const {
   std::cout << "[pt,eta,phi,e] = " << vector_ << " charge = " << charge_
             << std::endl;
 }
+
+void Candidate::ReducePrecision(unsigned bits) {
+  vector_.SetCoordinates(ReduceMantissa(vector_.Pt(), bits),
+                         ReduceMantissa(vector_.Eta(), bits),
+                         ReduceMantissa(vector_.Phi(), bits),
+                         ReduceMantissa(vector_.E(), bits));
+}
 }
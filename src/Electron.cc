@@ -1,4 +1,5 @@
 #include "../interface/Electron.hh"
+#include "../interface/Precision.hh"
 #include "../interface/city.h"
 #include "boost/format.hpp"
 
@@ -85,4 +86,24 @@ void Electron::Print() const {
   std::cout << "-dr04_pfiso_gamma " << this->dr04_pfiso_gamma() << std::endl;
   std::cout << "-dr04_pfiso_pu " << this->dr04_pfiso_pu() << std::endl;
 }
+
+void Electron::ReducePrecision(unsigned bits) {
+  Candidate::ReducePrecision(bits);
+  float *floats[] = {&dr03_tk_sum_pt_, &dr03_ecal_rechit_sum_et_,
+                     &dr03_hcal_tower_sum_et_, &ecal_pf_cluster_iso_,
+                     &hcal_pf_cluster_iso_, &dr03_pfiso_charged_all_,
+                     &dr03_pfiso_charged_, &dr03_pfiso_neutral_,
+                     &dr03_pfiso_gamma_, &dr03_pfiso_pu_,
+                     &dr04_pfiso_charged_all_, &dr04_pfiso_charged_,
+                     &dr04_pfiso_neutral_, &dr04_pfiso_gamma_, &dr04_pfiso_pu_,
+                     &hadronic_over_em_, &full5x5_sigma_IetaIeta_,
+                     &sigma_IetaIeta_, &dphi_sc_tk_at_vtx_,
+                     &deta_sc_tk_at_vtx_, &conv_dist_, &conv_dcot_, &f_brem_,
+                     &sc_eta_, &sc_seed_eta_, &sc_theta_, &sc_e_over_p_,
+                     &sc_energy_, &r9_, &hcal_sum_, &ecal_energy_};
+  for (float *f : floats) *f = ReduceMantissa(*f, bits);
+  double *doubles[] = {&dxy_vertex_, &dz_vertex_, &dxy_beamspot_};
+  for (double *d : doubles) *d = ReduceMantissa(*d, bits);
+  ReduceMantissa(elec_idiso_, bits);
+}
 }
@@ -1,6 +1,20 @@
 #include "../interface/EventInfo.hh"
 #include "boost/format.hpp"
 
+namespace {
+// The weight registry is shared by all EventInfo objects in the job. Labels
+// are only looked up here at registration or via the string-based interface.
+std::vector<std::string>& WeightLabels() {
+  static std::vector<std::string> labels;
+  return labels;
+}
+
+std::map<std::string, unsigned>& WeightSlots() {
+  static std::map<std::string, unsigned> slots;
+  return slots;
+}
+}
+
 namespace ic {
 EventInfo::EventInfo()
     : is_data_(false),
@@ -13,10 +27,42 @@ EventInfo::EventInfo()
       gen_ht_(0.),
       n_outgoing_partons_(0),
       gen_mll_(0.),
-      good_vertices_(0) {}
+      good_vertices_(0),
+      slot_total_(1.),
+      slot_total_dirty_(false) {}
 
 EventInfo::~EventInfo() {}
 
+EventInfo::WeightSlot EventInfo::register_weight(std::string const& label) {
+  auto it = WeightSlots().find(label);
+  if (it != WeightSlots().end()) return it->second;
+  WeightSlot slot = WeightLabels().size();
+  WeightLabels().push_back(label);
+  WeightSlots()[label] = slot;
+  return slot;
+}
+
+int EventInfo::weight_slot(std::string const& label) {
+  if (WeightLabels().empty()) return -1;
+  auto it = WeightSlots().find(label);
+  return it != WeightSlots().end() ? int(it->second) : -1;
+}
+
+std::string const& EventInfo::weight_label(WeightSlot slot) {
+  return WeightLabels().at(slot);
+}
+
+unsigned EventInfo::n_weight_slots() { return WeightLabels().size(); }
+
+void EventInfo::flatten_weights() {
+  for (unsigned i = 0; i < slot_status_.size(); ++i) {
+    if (slot_status_[i] == 0) continue;
+    weights_[weight_label(i)] = slot_weights_[i];
+    weight_status_[weight_label(i)] = (slot_status_[i] == 1);
+  }
+  clear_slot_weights();
+}
+
 void EventInfo::Print() const {
   std::cout << boost::format("%s\n") % std::string(30, '=');
   std::cout << boost::format("%-17s | %10i\n")   % "event"          % event_;
@@ -34,6 +80,11 @@ void EventInfo::Print() const {
     std::cout << boost::format("%-17s | %6.3f %3i\n") % it->first % it->second %
                      its->second;
   }
+  for (unsigned i = 0; i < slot_status_.size(); ++i) {
+    if (slot_status_[i] == 0) continue;
+    std::cout << boost::format("%-17s | %6.3f %3i\n") % weight_label(i) %
+                     slot_weights_[i] % (slot_status_[i] == 1);
+  }
   if (filters_.size() > 0) {
     std::cout << boost::format("%s\n") % std::string(30, '-');
     std::cout << boost::format("%-17s\n")   % "filters";
@@ -1,8 +1,10 @@
 #include "../interface/Jet.hh"
+#include "../interface/Precision.hh"
 #include <map>
 #include <string>
 #include <vector>
 #include "../interface/city.h"
+#include "../interface/Unhash.h"
 #include "boost/format.hpp"
 
 namespace ic {
@@ -27,7 +29,7 @@ Jet::~Jet() {}
   }
 
   void Jet::SetJecFactor(std::string const& name, float const& factor) {
-    jec_factors_[CityHash64(name)] = factor;
+    jec_factors_[Unhash::Hash(name)] = factor;
   }
 
   float Jet::GetJecFactor(std::string const& name) const {
@@ -42,7 +44,7 @@ Jet::~Jet() {}
   }
 
   void Jet::SetBDiscriminator(std::string const& name, float const& value) {
-    b_discriminators_[CityHash64(name)] = value;
+    b_discriminators_[Unhash::Hash(name)] = value;
   }
 
   float Jet::GetBDiscriminator(std::string const& name) const {
@@ -57,20 +59,17 @@ Jet::~Jet() {}
   }
 
   std::string Jet::UnHashJecFactor(std::size_t jec) const {
-    static TSmap dict;
-    static bool is_set = false;
-    if (!is_set) {
-      dict[CityHash64("Uncorrected")] = "Uncorrected";
-      dict[CityHash64("L1Offset")] = "L1Offset";
-      dict[CityHash64("L1FastJet")] = "L1FastJet";
-      dict[CityHash64("L2Relative")] = "L2Relative";
-      dict[CityHash64("L3Absolute")] = "L3Absolute";
-      dict[CityHash64("L2L3Residual")] = "L2L3Residual";
-    }
-    is_set = true;
-    TSmap::const_iterator it = dict.find(jec);
-    if (it != dict.end()) {
-      return it->second;
+    // Make sure the standard labels can be found even if they were never
+    // set in this job, or the dictionary was replaced with SetMap()
+    static bool const is_set = [] {
+      for (auto label : {"Uncorrected", "L1Offset", "L1FastJet", "L2Relative",
+                         "L3Absolute", "L2L3Residual"})
+        Unhash::AddBuiltin(label);
+      return true;
+    }();
+    std::string name;
+    if (is_set && Unhash::Find(jec, &name)) {
+      return name;
     } else {
       std::cerr << "Warning in <Jet>: Unable to unhash \"" << jec
                 << "\", returning empty string" << std::endl;
@@ -79,37 +78,34 @@ Jet::~Jet() {}
   }
 
   std::string Jet::UnHashDiscr(std::size_t dis) const {
-    static TSmap dict;
-    static bool is_set = false;
-    if (!is_set) {
-      dict[CityHash64("combinedSecondaryVertexBJetTags")] =
-          "combinedSecondaryVertexBJetTags";
-      dict[CityHash64("pfCombinedSecondaryVertexV2BJetTags")] =
-          "pfCombinedSecondaryVertexV2BJetTags";
-      dict[CityHash64("combinedSecondaryVertexMVABJetTags")] =
-          "combinedSecondaryVertexMVABJetTags";
-      dict[CityHash64("jetBProbabilityBJetTags")] = "jetBProbabilityBJetTags";
-      dict[CityHash64("jetProbabilityBJetTags")] = "jetProbabilityBJetTags";
-      dict[CityHash64("simpleSecondaryVertexHighEffBJetTags")] =
-          "simpleSecondaryVertexHighEffBJetTags";
-      dict[CityHash64("simpleSecondaryVertexHighPurBJetTags")] =
-          "simpleSecondaryVertexHighPurBJetTags";
-      dict[CityHash64("softMuonBJetTags")] = "softMuonBJetTags";
-      dict[CityHash64("softMuonByIP3dBJetTags")] = "softMuonByIP3dBJetTags";
-      dict[CityHash64("softMuonByPtBJetTags")] = "softMuonByPtBJetTags";
-      dict[CityHash64("trackCountingHighEffBJetTags")] =
-          "trackCountingHighEffBJetTags";
-      dict[CityHash64("trackCountingHighPurBJetTags")] =
-          "trackCountingHighPurBJetTags";
-    }
-    is_set = true;
-    TSmap::const_iterator it = dict.find(dis);
-    if (it != dict.end()) {
-      return it->second;
+    static bool const is_set = [] {
+      for (auto label : {"combinedSecondaryVertexBJetTags",
+                         "pfCombinedSecondaryVertexV2BJetTags",
+                         "combinedSecondaryVertexMVABJetTags",
+                         "jetBProbabilityBJetTags", "jetProbabilityBJetTags",
+                         "simpleSecondaryVertexHighEffBJetTags",
+                         "simpleSecondaryVertexHighPurBJetTags",
+                         "softMuonBJetTags", "softMuonByIP3dBJetTags",
+                         "softMuonByPtBJetTags", "trackCountingHighEffBJetTags",
+                         "trackCountingHighPurBJetTags"})
+        Unhash::AddBuiltin(label);
+      return true;
+    }();
+    std::string name;
+    if (is_set && Unhash::Find(dis, &name)) {
+      return name;
     } else {
       std::cerr << "Warning in <Jet>: Unable to unhash \"" << dis
                 << "\", returning empty string" << std::endl;
     }
     return "";
   }
-  }
+
+void Jet::ReducePrecision(unsigned bits) {
+  Candidate::ReducePrecision(bits);
+  jet_area_ = ReduceMantissa(jet_area_, bits);
+  uncorrected_energy_ = ReduceMantissa(uncorrected_energy_, bits);
+  ReduceMantissa(jec_factors_, bits);
+  ReduceMantissa(b_discriminators_, bits);
+}
+}
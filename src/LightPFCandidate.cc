@@ -0,0 +1,55 @@
+#include "../interface/LightPFCandidate.hh"
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+namespace ic {
+
+namespace {
+// The encoding of each value, see the class description
+double const kLogPtMin = std::log(0.01);
+double const kLogPtStep = std::log(1E6) / 65535.;
+double const kEtaStep = 6. / 32767.;
+double const kPhiStep = M_PI / 32767.;
+
+// Round to the nearest step, clamped to [lo, hi]
+long Encode(double value, double step, long lo, long hi) {
+  long code = std::lround(value / step);
+  return std::min(hi, std::max(lo, code));
+}
+}
+
+// Constructors/Destructors
+LightPFCandidate::LightPFCandidate()
+    : pt_(0), eta_(0), phi_(0), pdgid_(0), from_pv_(0) {}
+
+LightPFCandidate::~LightPFCandidate() {}
+
+void LightPFCandidate::Print() const {
+  std::cout << "[LightPFCandidate] pt=" << pt() << " eta=" << eta()
+            << " phi=" << phi() << " pdgid=" << pdgid()
+            << " from_pv=" << from_pv() << "\n";
+}
+
+double LightPFCandidate::pt() const {
+  return std::exp(kLogPtMin + pt_ * kLogPtStep);
+}
+
+double LightPFCandidate::eta() const { return eta_ * kEtaStep; }
+
+double LightPFCandidate::phi() const { return phi_ * kPhiStep; }
+
+void LightPFCandidate::set_pt(double const& pt) {
+  double log_pt = pt > 0. ? std::log(pt) : kLogPtMin;
+  pt_ = Encode(log_pt - kLogPtMin, kLogPtStep, 0, 65535);
+}
+
+void LightPFCandidate::set_eta(double const& eta) {
+  eta_ = Encode(eta, kEtaStep, -32767, 32767);
+}
+
+void LightPFCandidate::set_phi(double const& phi) {
+  // Bring into [-pi, pi] first so that the clamp never applies
+  phi_ = Encode(std::remainder(phi, 2. * M_PI), kPhiStep, -32767, 32767);
+}
+}
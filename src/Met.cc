@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include "../interface/city.h"
+#include "../interface/Unhash.h"
 #include "boost/format.hpp"
 
 namespace ic {
@@ -29,11 +30,11 @@ namespace ic {
   }
 
   void Met::SetCorrectedMet(std::string const& name, ic::Met::BasicMet const& factor) {
-    correctedmets_[CityHash64(name)] = factor;
+    correctedmets_[Unhash::Hash(name)] = factor;
   }
 
   void Met::SetShiftedMet(std::string const& name, ic::Met::BasicMet const& factor) {
-    shiftedmets_[CityHash64(name)] = factor;
+    shiftedmets_[Unhash::Hash(name)] = factor;
   }
 
   ic::Met::BasicMet Met::GetCorrectedMet(std::string const& name) const {
@@ -67,25 +68,18 @@ namespace ic {
   }
 
   std::string Met::UnHashMetCor(std::size_t cor) const {
-    static TSmap dict;
-    static bool is_set = false;
-    if (!is_set) {
-      dict[CityHash64("Raw")] = "Raw";
-      dict[CityHash64("Type1")] = "Type1";
-      dict[CityHash64("Type01")] = "Type01";
-      dict[CityHash64("TypeXY")] = "TypeXY";
-      dict[CityHash64("Type1XY")] = "Type1XY";
-      dict[CityHash64("Type01XY")] = "Type01XY";
-      dict[CityHash64("Type1Smear")] = "Type1Smear";
-      dict[CityHash64("Type01Smear")] = "Type01Smear";
-      dict[CityHash64("Type1SmearXY")] = "Type1SmearXY";
-      dict[CityHash64("Type01SmearXY")] = "Type01SmearXY";
-      dict[CityHash64("RawCalo")] = "RawCalo";
-    }
-    is_set = true;
-    TSmap::const_iterator it = dict.find(cor);
-    if (it != dict.end()) {
-      return it->second;
+    // Make sure the standard labels can be found even if they were never
+    // set in this job, or the dictionary was replaced with SetMap()
+    static bool const is_set = [] {
+      for (auto label : {"Raw", "Type1", "Type01", "TypeXY", "Type1XY",
+                         "Type01XY", "Type1Smear", "Type01Smear",
+                         "Type1SmearXY", "Type01SmearXY", "RawCalo"})
+        Unhash::AddBuiltin(label);
+      return true;
+    }();
+    std::string name;
+    if (is_set && Unhash::Find(cor, &name)) {
+      return name;
     } else {
       std::cerr << "Warning in <Met>: Unable to unhash \"" << cor
                 << "\", returning empty string" << std::endl;
@@ -94,29 +88,18 @@ namespace ic {
   }
 
   std::string Met::UnHashMetUnc(std::size_t unc) const {
-    static TSmap dict;
-    static bool is_set = false;
-    if (!is_set) {
-      dict[CityHash64("JetResUp")] = "JetResUp";
-      dict[CityHash64("JetResDown")] = "JetResDown";
-      dict[CityHash64("JetEnUp")] = "JetEnUp";
-      dict[CityHash64("JetEnDown")] = "JetEnDown";
-      dict[CityHash64("MuonEnUp")] = "MuonEnUp";
-      dict[CityHash64("MuonEnDown")] = "MuonEnDown";
-      dict[CityHash64("ElectronEnUp")] = "ElectronEnUp";
-      dict[CityHash64("ElectronEnDown")] = "ElectronEnDown";
-      dict[CityHash64("TauEnUp")] = "TauEnUp";
-      dict[CityHash64("TauEnDown")] = "TauEnDown";
-      dict[CityHash64("UnclusteredEnUp")] = "UnclusteredEnUp";
-      dict[CityHash64("UnclusteredEnDown")] = "UnclusteredEnDown";
-      dict[CityHash64("PhotonEnUp")] = "PhotonEnUp";
-      dict[CityHash64("PhotonEnDown")] = "PhotonEnDown";
-      dict[CityHash64("NoShift")] = "NoShift";
-    }
-    is_set = true;
-    TSmap::const_iterator it = dict.find(unc);
-    if (it != dict.end()) {
-      return it->second;
+    static bool const is_set = [] {
+      for (auto label : {"JetResUp", "JetResDown", "JetEnUp", "JetEnDown",
+                         "MuonEnUp", "MuonEnDown", "ElectronEnUp",
+                         "ElectronEnDown", "TauEnUp", "TauEnDown",
+                         "UnclusteredEnUp", "UnclusteredEnDown", "PhotonEnUp",
+                         "PhotonEnDown", "NoShift"})
+        Unhash::AddBuiltin(label);
+      return true;
+    }();
+    std::string name;
+    if (is_set && Unhash::Find(unc, &name)) {
+      return name;
     } else {
       std::cerr << "Warning in <Met>: Unable to unhash \"" << unc
                 << "\", returning empty string" << std::endl;
@@ -1,4 +1,5 @@
 #include "../interface/Muon.hh"
+#include "../interface/Precision.hh"
 #include "../interface/city.h"
 
 namespace ic {
@@ -61,4 +62,21 @@ Muon::Muon()
   void Muon::Print() const {
     Candidate::Print();
   }
+
+void Muon::ReducePrecision(unsigned bits) {
+  Candidate::ReducePrecision(bits);
+  float *floats[] = {&dr03_tk_sum_pt_, &dr03_ecal_rechit_sum_et_,
+                     &dr03_hcal_tower_sum_et_, &dr03_pfiso_charged_all_,
+                     &dr03_pfiso_charged_, &dr03_pfiso_neutral_,
+                     &dr03_pfiso_gamma_, &dr03_pfiso_pu_,
+                     &dr04_pfiso_charged_all_, &dr04_pfiso_charged_,
+                     &dr04_pfiso_neutral_, &dr04_pfiso_gamma_, &dr04_pfiso_pu_,
+                     &cq_chi2_localposition_, &cq_trk_kink_,
+                     &segment_compatibility_};
+  for (float *f : floats) *f = ReduceMantissa(*f, bits);
+  double *doubles[] = {&gt_normalized_chi2_, &it_valid_fraction_, &dxy_vertex_,
+                       &dz_vertex_, &dxy_beamspot_};
+  for (double *d : doubles) *d = ReduceMantissa(*d, bits);
+  ReduceMantissa(muon_idiso_, bits);
+}
 }
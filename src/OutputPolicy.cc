@@ -0,0 +1,87 @@
+#include "../interface/OutputPolicy.hh"
+#include <stdexcept>
+#include "RVersion.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+#include "boost/lexical_cast.hpp"
+
+namespace ic {
+
+namespace {
+void SetBranchCompression(TObjArray *branches, int settings) {
+  for (int i = 0; i < branches->GetEntriesFast(); ++i) {
+    TBranch *branch = static_cast<TBranch *>(branches->At(i));
+    branch->SetCompressionSettings(settings);
+    SetBranchCompression(branch->GetListOfBranches(), settings);
+  }
+}
+}
+
+OutputPolicy::OutputPolicy()
+    : algorithm("LZMA"),
+      level(5),
+      basket_size(0),
+      auto_flush(0),
+      cluster_align(0),
+      optimize_after(500),
+      mantissa_bits(0) {}
+
+int OutputPolicy::CompressionSettings() const {
+  if (level < 0 || level > 9) {
+    throw std::runtime_error("[OutputPolicy] Compression level " +
+                             boost::lexical_cast<std::string>(level) +
+                             " is not between 0 and 9");
+  }
+  // Numbering of ROOT::ECompressionAlgorithm, written out as the enum names
+  // have changed between ROOT versions
+  int algo = 0;
+  if (algorithm == "ZLIB") {
+    algo = 1;
+  } else if (algorithm == "LZMA") {
+    algo = 2;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 10, 0)
+  } else if (algorithm == "LZ4") {
+    algo = 4;
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 20, 0)
+  } else if (algorithm == "ZSTD") {
+    algo = 5;
+#endif
+  } else {
+    throw std::runtime_error("[OutputPolicy] Compression algorithm " +
+                             algorithm +
+                             " is unknown or not supported by this ROOT version");
+  }
+  return 100 * algo + level;
+}
+
+long long OutputPolicy::AutoFlush() const {
+  if (cluster_align <= 0) return auto_flush;
+  if (auto_flush <= 0 || auto_flush >= cluster_align) return cluster_align;
+  // Largest cluster no bigger than requested that divides a job
+  long long entries = auto_flush;
+  while (cluster_align % entries != 0) --entries;
+  return entries;
+}
+
+void OutputPolicy::Apply(TFile *file) const {
+  file->SetCompressionSettings(CompressionSettings());
+}
+
+void OutputPolicy::Apply(TTree *tree) const {
+  SetBranchCompression(tree->GetListOfBranches(), CompressionSettings());
+  if (basket_size > 0) tree->SetBasketSize("*", basket_size);
+  for (auto const& it : basket_sizes) {
+    tree->SetBasketSize(it.first.c_str(), it.second);
+  }
+  long long flush = AutoFlush();
+  if (flush != 0) tree->SetAutoFlush(flush);
+}
+
+void OutputPolicy::Optimize(TTree *tree) const {
+  tree->OptimizeBaskets();
+  for (auto const& it : basket_sizes) {
+    tree->SetBasketSize(it.first.c_str(), it.second);
+  }
+}
+}
@@ -1,4 +1,5 @@
 #include "../interface/PFJet.hh"
+#include "../interface/Precision.hh"
 
 namespace ic {
 
@@ -32,4 +33,15 @@ PFJet::PFJet()
 PFJet::~PFJet() {}
 
 void PFJet::Print() const { Candidate::Print(); }
+
+void PFJet::ReducePrecision(unsigned bits) {
+  Jet::ReducePrecision(bits);
+  float *floats[] = {&charged_em_energy_, &neutral_em_energy_,
+                     &charged_had_energy_, &neutral_had_energy_,
+                     &photon_energy_, &electron_energy_, &muon_energy_,
+                     &HF_had_energy_, &HF_em_energy_, &charged_mu_energy_,
+                     &beta_, &beta_max_, &pu_id_mva_value_,
+                     &linear_radial_moment_};
+  for (float *f : floats) *f = ReduceMantissa(*f, bits);
+}
 }
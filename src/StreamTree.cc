@@ -0,0 +1,39 @@
+#include "../interface/StreamTree.hh"
+#include "boost/lexical_cast.hpp"
+
+namespace ic {
+
+std::vector<std::unique_ptr<StreamTree::BranchBase> > StreamTree::branches_;
+std::mutex StreamTree::mutex_;
+
+void StreamTree::Book(TTree *tree) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto & b : branches_) b->Book(tree);
+}
+
+void StreamTree::Fill(TTree *tree, unsigned stream) {
+  for (auto & b : branches_) {
+    if (!b->Swap(stream)) {
+      // Swap back the branches done so far before giving up
+      for (auto & done : branches_) {
+        if (done == b) break;
+        done->Swap(stream);
+      }
+      throw std::runtime_error(
+          "[StreamTree] Branch " + b->name + " has no object for stream " +
+          boost::lexical_cast<std::string>(stream));
+    }
+  }
+  tree->Fill();
+  for (auto & b : branches_) b->Swap(stream);
+}
+
+void StreamTree::ReducePrecision(unsigned stream, unsigned bits) {
+  for (auto & b : branches_) b->Reduce(stream, bits);
+}
+
+unsigned StreamTree::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return branches_.size();
+}
+}
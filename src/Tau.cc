@@ -1,4 +1,5 @@
 #include "../interface/Tau.hh"
+#include "../interface/Precision.hh"
 #include "../interface/city.h"
 // #include "boost/format.hpp"
 
@@ -35,4 +36,12 @@ float Tau::GetTauID(std::string const& name) const {
 bool Tau::HasTauID(std::string const& name) const {
   return tau_ids_.count(CityHash64(name)) > 0;
 }
+
+void Tau::ReducePrecision(unsigned bits) {
+  Candidate::ReducePrecision(bits);
+  float *floats[] = {&lead_ecal_energy_, &lead_hcal_energy_, &lead_p_,
+                     &lead_dxy_vertex_, &lead_dz_vertex_};
+  for (float *f : floats) *f = ReduceMantissa(*f, bits);
+  ReduceMantissa(tau_ids_, bits);
+}
 }
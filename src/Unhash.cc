@@ -1,29 +1,277 @@
 #include "../interface/Unhash.h"
 #include <string>
 #include <map>
-#include "boost/format.hpp"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
 #include "boost/lexical_cast.hpp"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "../interface/city.h"
 
 namespace ic {
 
-std::map<std::size_t, std::string> Unhash::unhash_map_;
+namespace {
+// One entry of the open-addressing table. The hashes are well mixed
+// already, so the low bits pick the first slot and collisions are resolved
+// by linear probing. A writer sets id and size before publishing the
+// string pointer, and never changes a slot once it is published, so a
+// reader that sees a non-null pointer can read the rest without a lock.
+struct Slot {
+  uint64_t id;
+  uint32_t size;
+  std::atomic<char const *> str;
+
+  Slot() : id(0), size(0), str(nullptr) {}
+};
+
+struct Index {
+  explicit Index(std::size_t n) : mask(n - 1), slots(new Slot[n]) {}
+  std::size_t mask;
+  std::unique_ptr<Slot[]> slots;
+};
+
+// The strings live in fixed blocks of the arena, so they never move. When
+// the index gets more than 3/4 full it is replaced by one twice the size.
+// Replaced indices and blocks are kept until the end of the job, as a
+// reader may still be using them.
+struct State {
+  static const std::size_t kBlockSize = 1 << 16;
+
+  std::mutex mutex;
+  std::atomic<Index *> index;
+  std::atomic<unsigned> count;
+  std::vector<std::unique_ptr<Index> > indices;
+  std::vector<std::unique_ptr<char[]> > blocks;
+  char *block;
+  std::size_t block_used;
+  std::vector<std::pair<std::string, std::string> > collisions;
+  std::vector<std::string> builtins;
+
+  State()
+      : index(nullptr), count(0), block(nullptr), block_used(kBlockSize) {
+    Reset();
+  }
+
+  void Reset() {
+    indices.push_back(std::unique_ptr<Index>(new Index(16)));
+    index.store(indices.back().get(), std::memory_order_release);
+    count.store(0);
+  }
+
+  Slot const* Find(uint64_t id) const {
+    Index const* idx = index.load(std::memory_order_acquire);
+    for (std::size_t i = id & idx->mask;; i = (i + 1) & idx->mask) {
+      Slot const& slot = idx->slots[i];
+      if (!slot.str.load(std::memory_order_acquire)) return nullptr;
+      if (slot.id == id) return &slot;
+    }
+  }
+
+  char const* Store(std::string const& str) {
+    // A slot with a null string is empty, so empty strings need a pointer
+    // of their own
+    if (str.empty()) return "";
+    // Long strings get a block of their own
+    if (str.size() > kBlockSize / 4) {
+      blocks.push_back(std::unique_ptr<char[]>(new char[str.size()]));
+      std::memcpy(blocks.back().get(), str.data(), str.size());
+      return blocks.back().get();
+    }
+    if (block_used + str.size() > kBlockSize) {
+      blocks.push_back(std::unique_ptr<char[]>(new char[kBlockSize]));
+      block = blocks.back().get();
+      block_used = 0;
+    }
+    char *dest = block + block_used;
+    std::memcpy(dest, str.data(), str.size());
+    block_used += str.size();
+    return dest;
+  }
+
+  static void Place(Index *idx, uint64_t id, uint32_t size, char const* str) {
+    std::size_t i = id & idx->mask;
+    while (idx->slots[i].str.load(std::memory_order_relaxed)) {
+      i = (i + 1) & idx->mask;
+    }
+    idx->slots[i].id = id;
+    idx->slots[i].size = size;
+    idx->slots[i].str.store(str, std::memory_order_release);
+  }
+
+  // Must be called with the lock held, for an id not in the table
+  void Insert(uint64_t id, std::string const& str) {
+    Index *idx = index.load(std::memory_order_relaxed);
+    std::size_t n_slots = idx->mask + 1;
+    if ((count + 1) * 4 > n_slots * 3) {
+      Index *bigger = new Index(n_slots * 2);
+      for (std::size_t i = 0; i < n_slots; ++i) {
+        Slot const& slot = idx->slots[i];
+        char const* s = slot.str.load(std::memory_order_relaxed);
+        if (s) Place(bigger, slot.id, slot.size, s);
+      }
+      indices.push_back(std::unique_ptr<Index>(bigger));
+      index.store(bigger, std::memory_order_release);
+      idx = bigger;
+    }
+    Place(idx, id, str.size(), Store(str));
+    ++count;
+  }
+
+  // Must be called with the lock held
+  bool Add(uint64_t id, std::string const& str) {
+    Slot const* slot = Find(id);
+    if (!slot) {
+      Insert(id, str);
+      return true;
+    }
+    std::string existing(slot->str.load(std::memory_order_acquire), slot->size);
+    if (existing == str) return true;
+    collisions.push_back(std::make_pair(existing, str));
+    std::cerr << "Warning in <Unhash>: Hash " << id << " of \"" << str
+              << "\" is already used by \"" << existing
+              << "\", keeping the first" << std::endl;
+    return false;
+  }
+};
+
+State & GetState() {
+  static State state;
+  return state;
+}
+
+std::string ToString(Slot const* slot) {
+  return std::string(slot->str.load(std::memory_order_acquire), slot->size);
+}
+}
 
 std::string Unhash::Get(std::size_t id) {
-  auto it = unhash_map_.find(id);
-  if (it != unhash_map_.end()) {
-    return it->second;
+  std::string str;
+  if (Find(id, &str)) {
+    return str;
   } else {
     return boost::lexical_cast<std::string>(id);
   }
 }
 
+bool Unhash::Find(std::size_t id, std::string *str) {
+  Slot const* slot = GetState().Find(id);
+  if (!slot) return false;
+  *str = ToString(slot);
+  return true;
+}
+
+std::size_t Unhash::Hash(std::string const& str) {
+  std::size_t id = CityHash64(str);
+  // Only take the lock for strings not seen before
+  if (!GetState().Find(id)) Add(id, str);
+  return id;
+}
+
+bool Unhash::Add(std::size_t id, std::string const& str) {
+  State & state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.Add(id, str);
+}
+
 void Unhash::SetMap(std::map<std::size_t, std::string> const& unhash_map) {
-  unhash_map_ = unhash_map;
+  State & state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.Reset();
+  state.collisions.clear();
+  for (auto const& str : state.builtins) state.Add(CityHash64(str), str);
+  for (auto const& it : unhash_map) state.Add(it.first, it.second);
 }
 
+void Unhash::AddBuiltin(std::string const& str) {
+  State & state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (std::find(state.builtins.begin(), state.builtins.end(), str) ==
+      state.builtins.end()) {
+    state.builtins.push_back(str);
+  }
+  state.Add(CityHash64(str), str);
+}
 
+unsigned Unhash::Load(TDirectory *dir, std::string const& path) {
+  TTree *tree = dynamic_cast<TTree *>(dir->Get(path.c_str()));
+  if (!tree) return 0;
+  ULong64_t id = 0;
+  std::string *str = nullptr;
+  tree->SetBranchAddress("id", &id);
+  tree->SetBranchAddress("string", &str);
+  // Read everything first so that the lock is only taken once
+  std::vector<std::pair<uint64_t, std::string> > entries;
+  entries.reserve(tree->GetEntries());
+  for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+    tree->GetEntry(i);
+    entries.push_back(std::make_pair(id, *str));
+  }
+  tree->ResetBranchAddresses();
+  delete str;
+  State & state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  for (auto const& entry : entries) state.Add(entry.first, entry.second);
+  return entries.size();
+}
 
-Unhash::~Unhash() { ; }
+unsigned Unhash::Load(std::string const& file, std::string const& path) {
+  std::unique_ptr<TFile> f(TFile::Open(file.c_str()));
+  if (!f || f->IsZombie()) {
+    std::cerr << "Warning in <Unhash>: Unable to open \"" << file << "\""
+              << std::endl;
+    return 0;
+  }
+  return Load(f.get(), path);
+}
 
+void Unhash::Fill(TTree *tree) {
+  ULong64_t id;
+  std::string str;
+  tree->Branch("id", &id);
+  tree->Branch("string", &str);
+  for (auto const& entry : Entries()) {
+    id = entry.first;
+    str = entry.second;
+    tree->Fill();
+  }
+  tree->ResetBranchAddresses();
+}
+
+void Unhash::Save(std::string const& file, std::string const& name) {
+  TFile f(file.c_str(), "RECREATE");
+  TTree *tree = new TTree(name.c_str(), name.c_str());
+  Fill(tree);
+  tree->Write();
+  f.Close();
+}
 
-}
\ No newline at end of file
+std::vector<std::pair<std::size_t, std::string> > Unhash::Entries() {
+  std::vector<std::pair<std::size_t, std::string> > entries;
+  Index const* idx = GetState().index.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i <= idx->mask; ++i) {
+    Slot const& slot = idx->slots[i];
+    if (slot.str.load(std::memory_order_acquire)) {
+      entries.push_back(std::make_pair(slot.id, ToString(&slot)));
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+  return entries;
+}
+
+std::vector<std::pair<std::string, std::string> > Unhash::Collisions() {
+  State & state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.collisions;
+}
+
+unsigned Unhash::size() { return GetState().count.load(); }
+
+void Unhash::Clear() { SetMap(std::map<std::size_t, std::string>()); }
+}
@@ -27,6 +27,7 @@
 #include "UserCode/ICHiggsTauTau/interface/TH2DAsymErr.h"
 #include "UserCode/ICHiggsTauTau/interface/MultiDraw.hh"
 #include "UserCode/ICHiggsTauTau/interface/L1TObject.hh"
+#include "UserCode/ICHiggsTauTau/interface/LightPFCandidate.hh"
 #include "DataFormats/Common/interface/Wrapper.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "DataFormats/BTauReco/interface/SecondaryVertexTagInfo.h"
@@ -98,6 +99,8 @@ namespace { struct dictionary {
   edm::Wrapper<edm::ValueMap<std::vector<int> > > dummy58;
   ic::L1TObject              dictL1TObject;
   std::vector<ic::L1TObject> dictL1TObjectCollection;
+  ic::LightPFCandidate              dictLightPFCandidate;
+  std::vector<ic::LightPFCandidate> dictLightPFCandidateCollection;
 };
 }
 